@@ -534,6 +534,7 @@ public:
     friend class SenderUnittest;
     friend class ConfigUpdatorUnittest;
     friend class MultiServerConfigUpdatorUnitest;
+    friend class CheckPointJournalUnittest;
     friend class UtilUnittest;
     friend class AppConfigUnittest;
     friend class PipelineUnittest;
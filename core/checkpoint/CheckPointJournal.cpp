@@ -0,0 +1,516 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "checkpoint/CheckPointJournal.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string_view>
+#include <thread>
+
+#include "checkpoint/CheckPointManager.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "common/StringTools.h"
+#include "common/memory/MappedFileWindow.h"
+#include "logger/Logger.h"
+#include "monitor/AlarmManager.h"
+
+DEFINE_FLAG_INT32(check_point_journal_compact_ratio,
+                  "compact checkpoint journal when its records exceed the live checkpoints by the ratio",
+                  4);
+
+using namespace std;
+
+namespace logtail {
+
+namespace {
+
+enum JournalRecordType : uint8_t {
+    FILE_CHECKPOINT = 1,
+    FILE_CHECKPOINT_REMOVAL = 2,
+    DIR_CHECKPOINT = 3,
+    DIR_CHECKPOINT_REMOVAL = 4,
+    COMMIT = 5,
+};
+
+enum FileCheckPointFlag : uint8_t {
+    FILE_OPEN = 1,
+    CONTAINER_STOPPED = 1 << 1,
+    LAST_FORCE_READ = 1 << 2,
+};
+
+const char kJournalMagic[4] = {'L', 'C', 'P', 'J'};
+const size_t kHeaderSize = sizeof(kJournalMagic) + sizeof(uint32_t) * 2;
+const size_t kRecordHeaderSize = sizeof(uint32_t) * 2;
+// small journals are not worth compacting
+const size_t kMinCompactRecordCount = 1024;
+
+struct JournalRecord {
+    uint8_t mType = 0;
+    std::string mKey;
+    std::shared_ptr<CheckPoint> mFileCheckPoint;
+    std::shared_ptr<DirCheckPoint> mDirCheckPoint;
+    size_t mHash = 0;
+};
+
+class PayloadReader {
+public:
+    PayloadReader(const char* data, size_t size) : mData(data), mSize(size) {}
+
+    template <typename T>
+    bool Get(T& value) {
+        if (mSize - mPos < sizeof(T)) {
+            return false;
+        }
+        memcpy(&value, mData + mPos, sizeof(T));
+        mPos += sizeof(T);
+        return true;
+    }
+
+    bool GetString(std::string& str) {
+        uint32_t len = 0;
+        if (!Get(len) || mSize - mPos < len) {
+            return false;
+        }
+        str.assign(mData + mPos, len);
+        mPos += len;
+        return true;
+    }
+
+    bool IsEnd() const { return mPos == mSize; }
+
+private:
+    const char* mData = nullptr;
+    size_t mSize = 0;
+    size_t mPos = 0;
+};
+
+} // namespace
+
+static uint32_t Checksum(const char* data, size_t size) {
+    // FNV-1a, which is enough to detect a torn record
+    uint32_t hash = 2166136261U;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(data[i]);
+        hash *= 16777619U;
+    }
+    return hash;
+}
+
+template <typename T>
+static void Put(std::string& buffer, T value) {
+    buffer.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+static void PutString(std::string& buffer, const std::string& str) {
+    Put<uint32_t>(buffer, static_cast<uint32_t>(str.size()));
+    buffer.append(str);
+}
+
+static size_t HashPayload(const char* data, size_t size) {
+    return hash<string_view>()(string_view(data, size));
+}
+
+static void AppendRecord(const std::string& payload, std::string& buffer) {
+    Put<uint32_t>(buffer, static_cast<uint32_t>(payload.size()));
+    Put<uint32_t>(buffer, Checksum(payload.data(), payload.size()));
+    buffer.append(payload);
+}
+
+static void AppendCommitRecord(std::string& buffer) {
+    string payload;
+    Put<uint8_t>(payload, COMMIT);
+    Put<int32_t>(payload, static_cast<int32_t>(time(NULL)));
+    AppendRecord(payload, buffer);
+}
+
+static string GetFileCheckPointKey(const CheckPoint& checkPoint) {
+    // the same as the key in the json checkpoint file
+    return checkPoint.mFileName + "*" + ToString(checkPoint.mDevInode.dev) + "*"
+        + ToString(checkPoint.mDevInode.inode) + "*" + checkPoint.mConfigName;
+}
+
+static void SerializeFileCheckPoint(const CheckPoint& checkPoint, std::string& payload) {
+    Put<uint8_t>(payload, FILE_CHECKPOINT);
+    Put<uint64_t>(payload, checkPoint.mDevInode.dev);
+    Put<uint64_t>(payload, checkPoint.mDevInode.inode);
+    Put<int64_t>(payload, checkPoint.mOffset);
+    Put<uint64_t>(payload, checkPoint.mSignatureHash);
+    Put<uint32_t>(payload, checkPoint.mSignatureSize);
+    Put<int32_t>(payload, checkPoint.mLastUpdateTime);
+    Put<int32_t>(payload, checkPoint.mIdxInReaderArray);
+    uint8_t flags = (checkPoint.mFileOpenFlag ? FILE_OPEN : 0) | (checkPoint.mContainerStopped ? CONTAINER_STOPPED : 0)
+        | (checkPoint.mLastForceRead ? LAST_FORCE_READ : 0);
+    Put<uint8_t>(payload, flags);
+    PutString(payload, checkPoint.mFileName);
+    PutString(payload, checkPoint.mRealFileName);
+    PutString(payload, checkPoint.mConfigName);
+    PutString(payload, checkPoint.mContainerID);
+}
+
+static void SerializeDirCheckPoint(const DirCheckPoint& checkPoint, std::string& payload) {
+    Put<uint8_t>(payload, DIR_CHECKPOINT);
+    Put<int32_t>(payload, checkPoint.mUpdateTime);
+    PutString(payload, checkPoint.mParentName);
+    Put<uint32_t>(payload, static_cast<uint32_t>(checkPoint.mSubDir.size()));
+    for (const auto& subDir : checkPoint.mSubDir) {
+        PutString(payload, subDir);
+    }
+}
+
+static void SerializeRemoval(JournalRecordType type, const std::string& key, std::string& payload) {
+    Put<uint8_t>(payload, type);
+    PutString(payload, key);
+}
+
+static bool ParseRecord(const char* data, size_t size, JournalRecord& record) {
+    PayloadReader reader(data, size);
+    if (!reader.Get(record.mType)) {
+        return false;
+    }
+    switch (record.mType) {
+        case FILE_CHECKPOINT: {
+            auto checkPoint = make_shared<CheckPoint>();
+            uint8_t flags = 0;
+            if (!reader.Get(checkPoint->mDevInode.dev) || !reader.Get(checkPoint->mDevInode.inode)
+                || !reader.Get(checkPoint->mOffset) || !reader.Get(checkPoint->mSignatureHash)
+                || !reader.Get(checkPoint->mSignatureSize) || !reader.Get(checkPoint->mLastUpdateTime)
+                || !reader.Get(checkPoint->mIdxInReaderArray) || !reader.Get(flags)
+                || !reader.GetString(checkPoint->mFileName) || !reader.GetString(checkPoint->mRealFileName)
+                || !reader.GetString(checkPoint->mConfigName) || !reader.GetString(checkPoint->mContainerID)) {
+                return false;
+            }
+            checkPoint->mFileOpenFlag = (flags & FILE_OPEN) != 0;
+            checkPoint->mContainerStopped = (flags & CONTAINER_STOPPED) != 0;
+            checkPoint->mLastForceRead = (flags & LAST_FORCE_READ) != 0;
+            record.mKey = GetFileCheckPointKey(*checkPoint);
+            record.mFileCheckPoint = std::move(checkPoint);
+            break;
+        }
+        case DIR_CHECKPOINT: {
+            auto checkPoint = make_shared<DirCheckPoint>();
+            uint32_t subDirCnt = 0;
+            if (!reader.Get(checkPoint->mUpdateTime) || !reader.GetString(checkPoint->mParentName)
+                || !reader.Get(subDirCnt)) {
+                return false;
+            }
+            string subDir;
+            for (uint32_t i = 0; i < subDirCnt; ++i) {
+                if (!reader.GetString(subDir)) {
+                    return false;
+                }
+                checkPoint->mSubDir.insert(subDir);
+            }
+            record.mKey = checkPoint->mParentName;
+            record.mDirCheckPoint = std::move(checkPoint);
+            break;
+        }
+        case FILE_CHECKPOINT_REMOVAL:
+        case DIR_CHECKPOINT_REMOVAL:
+            if (!reader.GetString(record.mKey)) {
+                return false;
+            }
+            break;
+        case COMMIT: {
+            int32_t dumpTime = 0;
+            if (!reader.Get(dumpTime)) {
+                return false;
+            }
+            break;
+        }
+        default:
+            return false;
+    }
+    record.mHash = HashPayload(data, size);
+    return reader.IsEnd();
+}
+
+bool CheckPointJournal::Load(const std::string& path,
+                             int32_t& checkPointVersion,
+                             std::vector<std::shared_ptr<CheckPoint>>& fileCheckPoints,
+                             std::vector<std::shared_ptr<DirCheckPoint>>& dirCheckPoints) {
+    Reset();
+    shared_ptr<MappedFileWindow> window;
+    string content;
+    const char* data = nullptr;
+    size_t size = 0;
+#if defined(__linux__)
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat buf;
+    if (fstat(fd, &buf) == 0 && buf.st_size > 0) {
+        // the mapping stays valid after the fd is closed
+        window = MappedFileWindow::Create(fd, 0, static_cast<size_t>(buf.st_size));
+    }
+    close(fd);
+#endif
+    if (window) {
+        data = window->GetData();
+        size = window->GetSize();
+    } else {
+        ifstream fin(path, ios::binary);
+        if (!fin) {
+            return false;
+        }
+        content.assign(istreambuf_iterator<char>(fin), istreambuf_iterator<char>());
+        data = content.data();
+        size = content.size();
+    }
+
+    uint32_t formatVersion = 0;
+    uint32_t version = 0;
+    if (size < kHeaderSize || memcmp(data, kJournalMagic, sizeof(kJournalMagic)) != 0) {
+        LOG_ERROR(sLogger, ("load checkpoint journal fail, invalid header", path));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "header of checkpoint journal is invalid");
+        return false;
+    }
+    memcpy(&formatVersion, data + sizeof(kJournalMagic), sizeof(uint32_t));
+    memcpy(&version, data + sizeof(kJournalMagic) + sizeof(uint32_t), sizeof(uint32_t));
+    if (formatVersion != kFormatVersion) {
+        LOG_ERROR(sLogger,
+                  ("load checkpoint journal fail, unsupported format version", formatVersion)("path", path));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
+                                               "unsupported checkpoint journal format version: "
+                                                   + ToString(formatVersion));
+        return false;
+    }
+
+    unordered_map<string, JournalRecord> fileRecords;
+    unordered_map<string, JournalRecord> dirRecords;
+    vector<JournalRecord> pendingRecords;
+    size_t pos = kHeaderSize;
+    size_t committedPos = pos;
+    size_t recordCount = 0;
+    size_t committedRecordCount = 0;
+    while (size - pos >= kRecordHeaderSize) {
+        uint32_t payloadSize = 0;
+        uint32_t checksum = 0;
+        memcpy(&payloadSize, data + pos, sizeof(uint32_t));
+        memcpy(&checksum, data + pos + sizeof(uint32_t), sizeof(uint32_t));
+        const char* payload = data + pos + kRecordHeaderSize;
+        if (payloadSize == 0 || size - pos - kRecordHeaderSize < payloadSize
+            || Checksum(payload, payloadSize) != checksum) {
+            break;
+        }
+        JournalRecord record;
+        if (!ParseRecord(payload, payloadSize, record)) {
+            break;
+        }
+        pos += kRecordHeaderSize + payloadSize;
+        ++recordCount;
+        if (record.mType != COMMIT) {
+            pendingRecords.emplace_back(std::move(record));
+            continue;
+        }
+        for (auto& item : pendingRecords) {
+            switch (item.mType) {
+                case FILE_CHECKPOINT:
+                    fileRecords[item.mKey] = std::move(item);
+                    break;
+                case FILE_CHECKPOINT_REMOVAL:
+                    fileRecords.erase(item.mKey);
+                    break;
+                case DIR_CHECKPOINT:
+                    dirRecords[item.mKey] = std::move(item);
+                    break;
+                case DIR_CHECKPOINT_REMOVAL:
+                    dirRecords.erase(item.mKey);
+                    break;
+                default:
+                    break;
+            }
+        }
+        pendingRecords.clear();
+        committedPos = pos;
+        committedRecordCount = recordCount;
+    }
+
+    checkPointVersion = static_cast<int32_t>(version);
+    for (auto& item : fileRecords) {
+        fileCheckPoints.emplace_back(item.second.mFileCheckPoint);
+    }
+    for (auto& item : dirRecords) {
+        dirCheckPoints.emplace_back(item.second.mDirCheckPoint);
+    }
+    if (committedPos != size) {
+        // left by a crash during dump, the next dump rewrites the journal so that nothing follows the torn part
+        LOG_WARNING(sLogger,
+                    ("discard uncommitted part of checkpoint journal, path", path)("offset", committedPos)("size",
+                                                                                                        size));
+        return true;
+    }
+    mPath = path;
+    mCheckPointVersion = checkPointVersion;
+    for (const auto& item : fileRecords) {
+        mFileRecordHashes.emplace(item.first, item.second.mHash);
+    }
+    for (const auto& item : dirRecords) {
+        mDirRecordHashes.emplace(item.first, item.second.mHash);
+    }
+    mRecordCount = committedRecordCount;
+    return true;
+}
+
+bool CheckPointJournal::Dump(const std::string& path,
+                             int32_t checkPointVersion,
+                             const std::vector<const CheckPoint*>& fileCheckPoints,
+                             const std::vector<const DirCheckPoint*>& dirCheckPoints) {
+    unordered_map<string, size_t> fileRecordHashes;
+    unordered_map<string, size_t> dirRecordHashes;
+    fileRecordHashes.reserve(fileCheckPoints.size());
+    dirRecordHashes.reserve(dirCheckPoints.size());
+    string changes;
+    size_t changeCount = 0;
+    string payload;
+    for (const auto* checkPoint : fileCheckPoints) {
+        payload.clear();
+        SerializeFileCheckPoint(*checkPoint, payload);
+        size_t hash = HashPayload(payload.data(), payload.size());
+        auto res = fileRecordHashes.emplace(GetFileCheckPointKey(*checkPoint), hash);
+        if (!res.second) {
+            continue;
+        }
+        auto it = mFileRecordHashes.find(res.first->first);
+        if (it == mFileRecordHashes.end() || it->second != hash) {
+            AppendRecord(payload, changes);
+            ++changeCount;
+        }
+    }
+    for (const auto& item : mFileRecordHashes) {
+        if (fileRecordHashes.find(item.first) == fileRecordHashes.end()) {
+            payload.clear();
+            SerializeRemoval(FILE_CHECKPOINT_REMOVAL, item.first, payload);
+            AppendRecord(payload, changes);
+            ++changeCount;
+        }
+    }
+    for (const auto* checkPoint : dirCheckPoints) {
+        payload.clear();
+        SerializeDirCheckPoint(*checkPoint, payload);
+        size_t hash = HashPayload(payload.data(), payload.size());
+        auto res = dirRecordHashes.emplace(checkPoint->mParentName, hash);
+        if (!res.second) {
+            continue;
+        }
+        auto it = mDirRecordHashes.find(checkPoint->mParentName);
+        if (it == mDirRecordHashes.end() || it->second != hash) {
+            AppendRecord(payload, changes);
+            ++changeCount;
+        }
+    }
+    for (const auto& item : mDirRecordHashes) {
+        if (dirRecordHashes.find(item.first) == dirRecordHashes.end()) {
+            payload.clear();
+            SerializeRemoval(DIR_CHECKPOINT_REMOVAL, item.first, payload);
+            AppendRecord(payload, changes);
+            ++changeCount;
+        }
+    }
+
+    size_t liveCount = fileRecordHashes.size() + dirRecordHashes.size();
+    size_t compactRatio = static_cast<size_t>(max(1, INT32_FLAG(check_point_journal_compact_ratio)));
+    bool needCompact = path != mPath || checkPointVersion != mCheckPointVersion || !CheckExistance(path)
+        || mRecordCount + changeCount + 1 > (liveCount + kMinCompactRecordCount) * compactRatio;
+    if (needCompact) {
+        string records;
+        for (const auto* checkPoint : fileCheckPoints) {
+            payload.clear();
+            SerializeFileCheckPoint(*checkPoint, payload);
+            AppendRecord(payload, records);
+        }
+        for (const auto* checkPoint : dirCheckPoints) {
+            payload.clear();
+            SerializeDirCheckPoint(*checkPoint, payload);
+            AppendRecord(payload, records);
+        }
+        AppendCommitRecord(records);
+        if (!Compact(path, checkPointVersion, records)) {
+            Reset();
+            return false;
+        }
+        mPath = path;
+        mCheckPointVersion = checkPointVersion;
+        mRecordCount = liveCount + 1;
+    } else if (changeCount > 0) {
+        AppendCommitRecord(changes);
+        ofstream fout(path, ios::binary | ios::app);
+        if (!fout || !fout.write(changes.data(), changes.size()) || !fout.flush()) {
+            LOG_ERROR(sLogger, ("append checkpoint journal fail", path)("errno", errno));
+            AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "append checkpoint journal failed");
+            Reset();
+            return false;
+        }
+        mRecordCount += changeCount + 1;
+    }
+    mFileRecordHashes.swap(fileRecordHashes);
+    mDirRecordHashes.swap(dirRecordHashes);
+    LOG_DEBUG(sLogger,
+              ("dump checkpoint journal, changed records", changeCount)("live records", liveCount)(
+                  "records in journal", mRecordCount)("compacted", needCompact));
+    return true;
+}
+
+void CheckPointJournal::Reset() {
+    mPath.clear();
+    mCheckPointVersion = 0;
+    mFileRecordHashes.clear();
+    mDirRecordHashes.clear();
+    mRecordCount = 0;
+}
+
+bool CheckPointJournal::Compact(const std::string& path, int32_t checkPointVersion, const std::string& records) {
+    string tmpPath = path + ".bak";
+    ofstream fout(tmpPath, ios::binary | ios::trunc);
+    if (!fout) {
+        LOG_ERROR(sLogger, ("open checkpoint journal fail", tmpPath)("errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "open checkpoint journal failed");
+        return false;
+    }
+    string header(kJournalMagic, sizeof(kJournalMagic));
+    Put<uint32_t>(header, kFormatVersion);
+    Put<uint32_t>(header, static_cast<uint32_t>(checkPointVersion));
+    fout.write(header.data(), header.size());
+    fout.write(records.data(), records.size());
+    fout.close();
+    if (!fout) {
+        LOG_ERROR(sLogger, ("write checkpoint journal fail", tmpPath));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM, "write checkpoint journal failed");
+        return false;
+    }
+#if defined(_MSC_VER)
+    // The rename on Windows will fail if the destination is existing.
+    remove(path.c_str());
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+#endif
+    if (rename(tmpPath.c_str(), path.c_str()) == -1) {
+        LOG_ERROR(sLogger, ("rename checkpoint journal fail, errno", errno));
+        AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
+                                               "rename checkpoint journal fail, errno " + ToString(errno));
+        return false;
+    }
+    return true;
+}
+
+} // namespace logtail
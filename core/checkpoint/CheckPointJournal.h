@@ -0,0 +1,73 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace logtail {
+
+class CheckPoint;
+class DirCheckPoint;
+
+// CheckPointJournal persists file and dir checkpoints in an append-only binary file. A dump appends only the
+// checkpoints changed since the last dump, plus removal records for the ones no longer present, so readers making no
+// progress cost nothing. Once the records in the file outnumber the live checkpoints by
+// check_point_journal_compact_ratio, the journal is rewritten with the live checkpoints only.
+//
+// Layout, in host byte order:
+//   header:  magic "LCPJ" | uint32 format version | uint32 checkpoint version
+//   record:  uint32 payload size | uint32 payload checksum | payload
+//   payload: uint8 record type | fields of the type
+// The records of a dump are followed by a commit record, and are only applied on load if the commit is intact, so a
+// dump interrupted by a crash leaves the state of the previous dump.
+class CheckPointJournal {
+public:
+    static const uint32_t kFormatVersion = 1;
+
+    // @return false if the journal does not exist or is not a valid journal, in which case the outputs are untouched.
+    bool Load(const std::string& path,
+              int32_t& checkPointVersion,
+              std::vector<std::shared_ptr<CheckPoint>>& fileCheckPoints,
+              std::vector<std::shared_ptr<DirCheckPoint>>& dirCheckPoints);
+    bool Dump(const std::string& path,
+              int32_t checkPointVersion,
+              const std::vector<const CheckPoint*>& fileCheckPoints,
+              const std::vector<const DirCheckPoint*>& dirCheckPoints);
+    // Forget what has been written, so that the next dump rewrites the whole journal.
+    void Reset();
+
+private:
+    bool Compact(const std::string& path, int32_t checkPointVersion, const std::string& records);
+
+    std::string mPath;
+    int32_t mCheckPointVersion = 0;
+    // hash of the payload last written for each key
+    std::unordered_map<std::string, size_t> mFileRecordHashes;
+    std::unordered_map<std::string, size_t> mDirRecordHashes;
+    size_t mRecordCount = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CheckPointJournalUnittest;
+#endif
+};
+
+} // namespace logtail
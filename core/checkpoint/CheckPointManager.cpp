@@ -16,6 +16,7 @@
 
 #include <fcntl.h>
 
+#include <algorithm>
 #include <fstream>
 #include <string>
 #include <thread>
@@ -40,6 +41,10 @@ DEFINE_FLAG_INT32(check_point_version, "now check point version xx.xx.xx such as
 DEFINE_FLAG_INT32(check_point_dump_interval, "default 15 min", 15 * 60);
 DEFINE_FLAG_INT32(check_point_max_count, "max check point count", 100000);
 DEFINE_FLAG_INT32(checkpoint_find_max_file_count, "", 1000);
+DEFINE_FLAG_BOOL(enable_check_point_journal,
+                 "dump file checkpoints to an incremental binary journal instead of a json file, the json file is "
+                 "removed once migrated, so versions without the journal cannot load the checkpoints any more",
+                 false);
 
 namespace logtail {
 
@@ -109,6 +114,10 @@ CheckPointManager::DevInodeCheckPointHashMap& CheckPointManager::GetAllFileCheck
     return mDevInodeCheckPointPtrMap;
 }
 
+string CheckPointManager::GetCheckPointJournalPath() {
+    return AppConfig::GetInstance()->GetCheckPointFilePath() + ".journal";
+}
+
 
 void CheckPointManager::AddDirCheckPoint(const string& dirname) {
     if (dirname.size() == 0)
@@ -128,6 +137,9 @@ void CheckPointManager::AddDirCheckPoint(const string& dirname) {
     ptr->mSubDir.insert(dirname);
 }
 void CheckPointManager::LoadCheckPoint() {
+    if (BOOL_FLAG(enable_check_point_journal) && LoadCheckPointJournal()) {
+        return;
+    }
     Json::Value root;
     ParseConfResult cptRes = ParseConfig(AppConfig::GetInstance()->GetCheckPointFilePath(), root);
     // if new checkpoint file not exist, check old checkpoint file.
@@ -135,6 +147,10 @@ void CheckPointManager::LoadCheckPoint() {
         cptRes = ParseConfig(GetCheckPointFileName(), root);
     }
     if (cptRes != CONFIG_OK) {
+        // switched back from the journal, whose checkpoints are migrated to json on next dump
+        if (cptRes == CONFIG_NOT_EXIST && !BOOL_FLAG(enable_check_point_journal) && LoadCheckPointJournal()) {
+            return;
+        }
         if (cptRes == CONFIG_NOT_EXIST)
             LOG_INFO(sLogger, ("no check point file to load", AppConfig::GetInstance()->GetCheckPointFilePath()));
         else if (cptRes == CONFIG_INVALID_FORMAT) {
@@ -156,6 +172,42 @@ void CheckPointManager::LoadCheckPoint() {
     LOG_INFO(sLogger,
              ("load checkpoint, version", mLoadVersion)("file check point", mDevInodeCheckPointPtrMap.size())(
                  "dir check point", mDirNameMap.size()));
+    if (BOOL_FLAG(enable_check_point_journal)) {
+        LOG_INFO(sLogger, ("json checkpoint will be migrated to journal on next dump", GetCheckPointJournalPath()));
+    }
+}
+
+bool CheckPointManager::LoadCheckPointJournal() {
+    int32_t version = NO_CHECKPOINT_VERSION;
+    vector<CheckPointPtr> fileCheckPoints;
+    vector<DirCheckPointPtr> dirCheckPoints;
+    if (!mJournal.Load(GetCheckPointJournalPath(), version, fileCheckPoints, dirCheckPoints)) {
+        return false;
+    }
+    mLoadVersion = version;
+
+    int32_t now = time(NULL);
+    for (auto& dir : dirCheckPoints) {
+        if (dir->mUpdateTime >= now - INT32_FLAG(file_check_point_time_out)) {
+            dir->mUpdateTime = now;
+            mDirNameMap[dir->mParentName] = dir;
+        } else {
+            LOG_INFO(sLogger,
+                     ("load timeout dir check point, ignore", dir->mParentName)(ToString(dir->mUpdateTime), now));
+        }
+    }
+    mReaderCount = fileCheckPoints.size();
+    for (auto& checkPoint : fileCheckPoints) {
+        if (!checkPoint->mDevInode.IsValid()) {
+            LOG_WARNING(sLogger, ("can not find check point dev inode, discard it", checkPoint->mFileName));
+            continue;
+        }
+        mDevInodeCheckPointPtrMap[CheckPointKey(checkPoint->mDevInode, checkPoint->mConfigName)] = checkPoint;
+    }
+    LOG_INFO(sLogger,
+             ("load checkpoint journal, version", mLoadVersion)("file check point", mDevInodeCheckPointPtrMap.size())(
+                 "dir check point", mDirNameMap.size()));
+    return true;
 }
 
 void CheckPointManager::LoadDirCheckPoint(const Json::Value& root) {
@@ -330,7 +382,6 @@ void CheckPointManager::LoadFileCheckPoint(const Json::Value& root) {
 bool CheckPointManager::DumpCheckPointToLocal() {
     mLastDumpTime = time(NULL);
     string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
-    string checkPointTempFile = checkPointFile + ".bak";
 
     if (!Mkdirs(ParentPath(checkPointFile))) {
         LOG_ERROR(sLogger, ("open check point file dir error", checkPointFile));
@@ -338,70 +389,74 @@ bool CheckPointManager::DumpCheckPointToLocal() {
         return false;
     }
 
-    Json::Value root;
     mReaderCount = mDevInodeCheckPointPtrMap.size();
-    if (mDevInodeCheckPointPtrMap.size() <= (size_t)INT32_FLAG(check_point_max_count)) {
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            CheckPoint* checkPointPtr = it->second.get();
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
-    } else {
-        vector<CheckPoint*> sortedCheckPointVec;
-        CheckPointManager::DevInodeCheckPointHashMap::iterator it;
-        for (it = mDevInodeCheckPointPtrMap.begin(); it != mDevInodeCheckPointPtrMap.end(); ++it) {
-            sortedCheckPointVec.push_back(it->second.get());
-        }
-        sort(sortedCheckPointVec.begin(), sortedCheckPointVec.end(), CheckPointManager::CheckPointCmpByUpdateTime);
-        for (int32_t i = 0; i < INT32_FLAG(check_point_max_count); ++i) {
-            CheckPoint* checkPointPtr = sortedCheckPointVec[i];
-            Json::Value leaf;
-            leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
-            leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
-            leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
-            leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
-            leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
-            leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
-            leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
-            leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
-            leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
-            leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
-            leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
-            leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
-            leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
-            // forward compatible
-            leaf["sig"] = Json::Value(string(""));
-            leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
-            // use filename + dev + inode + configName to prevent same filename conflict
-            root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
-                 + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
-                = leaf;
-        }
+    vector<const CheckPoint*> checkPoints;
+    checkPoints.reserve(mDevInodeCheckPointPtrMap.size());
+    for (const auto& item : mDevInodeCheckPointPtrMap) {
+        checkPoints.push_back(item.second.get());
+    }
+    if (checkPoints.size() > (size_t)INT32_FLAG(check_point_max_count)) {
+        sort(checkPoints.begin(), checkPoints.end(), CheckPointManager::CheckPointCmpByUpdateTime);
+        checkPoints.resize(INT32_FLAG(check_point_max_count));
         LOG_WARNING(sLogger, ("Too many check point", mDevInodeCheckPointPtrMap.size()));
         AlarmManager::GetInstance()->SendAlarm(CHECKPOINT_ALARM,
                                                "Too many check point:" + ToString(mDevInodeCheckPointPtrMap.size()));
     }
+    if (BOOL_FLAG(enable_check_point_journal)) {
+        return DumpCheckPointJournal(checkPoints);
+    }
+    return DumpCheckPointJson(checkPoints);
+}
 
+bool CheckPointManager::DumpCheckPointJournal(const vector<const CheckPoint*>& checkPoints) {
+    vector<const DirCheckPoint*> dirCheckPoints;
+    dirCheckPoints.reserve(mDirNameMap.size());
+    for (const auto& item : mDirNameMap) {
+        dirCheckPoints.push_back(item.second.get());
+    }
+    if (!mJournal.Dump(GetCheckPointJournalPath(), INT32_FLAG(check_point_version), checkPoints, dirCheckPoints)) {
+        return false;
+    }
+    // the json checkpoint files, if any, have been migrated to the journal and would be stale from now on
+    const string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
+    remove(checkPointFile.c_str());
+    if (checkPointFile != GetCheckPointFileName()) {
+        remove(GetCheckPointFileName().c_str());
+    }
+    LOG_DEBUG(sLogger,
+              ("dump checkpoint journal, version", INT32_FLAG(check_point_version))(
+                  "file check point", checkPoints.size())("dir check point", mDirNameMap.size()));
+    return true;
+}
+
+bool CheckPointManager::DumpCheckPointJson(const vector<const CheckPoint*>& checkPoints) {
+    string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
+    string checkPointTempFile = checkPointFile + ".bak";
+
+    Json::Value root;
+    for (const auto* checkPointPtr : checkPoints) {
+        Json::Value leaf;
+        leaf["file_name"] = Json::Value(checkPointPtr->mFileName);
+        leaf["real_file_name"] = Json::Value(checkPointPtr->mRealFileName);
+        leaf["offset"] = Json::Value(ToString(checkPointPtr->mOffset));
+        leaf["sig_size"] = Json::Value(Json::UInt(checkPointPtr->mSignatureSize));
+        leaf["sig_hash"] = Json::Value(Json::UInt64(checkPointPtr->mSignatureHash));
+        leaf["update_time"] = Json::Value(checkPointPtr->mLastUpdateTime);
+        leaf["inode"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.inode));
+        leaf["dev"] = Json::Value(Json::UInt64(checkPointPtr->mDevInode.dev));
+        leaf["file_open"] = Json::Value(checkPointPtr->mFileOpenFlag ? 1 : 0);
+        leaf["container_stopped"] = Json::Value(checkPointPtr->mContainerStopped ? 1 : 0);
+        leaf["container_id"] = Json::Value(checkPointPtr->mContainerID);
+        leaf["last_force_read"] = Json::Value(checkPointPtr->mLastForceRead ? 1 : 0);
+        leaf["config_name"] = Json::Value(checkPointPtr->mConfigName);
+        // forward compatible
+        leaf["sig"] = Json::Value(string(""));
+        leaf["idx_in_reader_array"] = Json::Value(checkPointPtr->mIdxInReaderArray);
+        // use filename + dev + inode + configName to prevent same filename conflict
+        root[checkPointPtr->mFileName + "*" + ToString(checkPointPtr->mDevInode.dev) + "*"
+             + ToString(checkPointPtr->mDevInode.inode) + "*" + checkPointPtr->mConfigName]
+            = leaf;
+    }
 
     Json::Value dirJson;
     for (unordered_map<string, DirCheckPointPtr>::iterator it = mDirNameMap.begin(); it != mDirNameMap.end(); ++it) {
@@ -447,8 +502,10 @@ bool CheckPointManager::DumpCheckPointToLocal() {
     }
     LOG_DEBUG(sLogger,
               ("dump checkpoint, version", INT32_FLAG(check_point_version))(
-                  "file check point", mDevInodeCheckPointPtrMap.size())("dir check point", mDirNameMap.size()));
-
+                  "file check point", checkPoints.size())("dir check point", mDirNameMap.size()));
+    // the journal would be stale if switched back to it later
+    mJournal.Reset();
+    remove(GetCheckPointJournalPath().c_str());
     return true;
 }
 
@@ -565,6 +622,8 @@ void CheckPointManager::RemoveLocalCheckPoint() {
     std::string checkPointFile = AppConfig::GetInstance()->GetCheckPointFilePath();
     if (remove(checkPointFile.c_str()) == -1) {
     }
+    remove(GetCheckPointJournalPath().c_str());
+    mJournal.Reset();
 }
 
 void CheckPointManager::PrintStatus() {
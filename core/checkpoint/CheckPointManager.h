@@ -21,10 +21,12 @@
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include "boost/optional.hpp"
 #include "json/json.h"
 
+#include "checkpoint/CheckPointJournal.h"
 #include "common/DevInode.h"
 #include "common/EncodingConverter.h"
 #include "common/SplitedFilePath.h"
@@ -122,9 +124,14 @@ private:
     int32_t mLastDumpTime;
     int32_t mLoadVersion;
     int32_t mReaderCount;
+    CheckPointJournal mJournal;
     CheckPointManager()
         : mLastCheckTime(time(NULL)), mLastDumpTime(time(NULL)), mLoadVersion(NO_CHECKPOINT_VERSION), mReaderCount(0) {}
 
+    bool LoadCheckPointJournal();
+    bool DumpCheckPointJournal(const std::vector<const CheckPoint*>& checkPoints);
+    bool DumpCheckPointJson(const std::vector<const CheckPoint*>& checkPoints);
+
 public:
     bool CheckVersion();
     void AddCheckPoint(CheckPoint* checkPointPtr);
@@ -149,6 +156,10 @@ public:
         return &checkPointManager;
     }
 
+    // The binary checkpoint journal lives beside the json checkpoint file, which it replaces when
+    // enable_check_point_journal is set.
+    static std::string GetCheckPointJournalPath();
+
     static bool CheckPointCmpByUpdateTime(const CheckPoint* left, const CheckPoint* right) {
         return left->mLastUpdateTime > right->mLastUpdateTime;
     }
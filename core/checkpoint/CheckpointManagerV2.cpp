@@ -29,6 +29,10 @@ DEFINE_FLAG_INT32(logtail_checkpoint_gc_threshold_sec, "30 minutes", 30 * 60);
 DEFINE_FLAG_DOUBLE(logtail_checkpoint_max_gc_count_ratio_per_round, "10%", 0.1);
 DEFINE_FLAG_INT64(logtail_checkpoint_max_used_time_per_round_in_msec, "500ms", 500);
 DEFINE_FLAG_INT32(logtail_checkpoint_expired_threshold_sec, "6 hours", 6 * 60 * 60);
+DEFINE_FLAG_INT32(logtail_checkpoint_batch_write_interval_ms,
+                  "interval to group commit checkpoint writes, 0 means write directly",
+                  10);
+DEFINE_FLAG_INT32(logtail_checkpoint_config_gc_interval_sec, "10 minutes", 10 * 60);
 
 DECLARE_FLAG_INT32(max_exactly_once_concurrency);
 
@@ -93,9 +97,13 @@ std::string CheckpointManagerV2::MakeRangeKey(const std::string& primaryKey, uin
 }
 
 CheckpointManagerV2::CheckpointManagerV2() {
+    // With group commit, sync is paid once per batch instead of once per checkpoint.
     mDefaultWriteOption.sync = AppConfig::GetInstance()->EnableCheckpointSyncWrite();
 
     if (open()) {
+        if (INT32_FLAG(logtail_checkpoint_batch_write_interval_ms) > 0) {
+            mWriteThreadPtr.reset(new std::thread([&]() { runWriteLoop(); }));
+        }
         mGCThreadPtr.reset(new std::thread([&]() { runGCLoop(); }));
     }
 }
@@ -106,6 +114,19 @@ CheckpointManagerV2::~CheckpointManagerV2() {
         mGCThreadPtr->join();
         mGCThreadPtr.reset();
     }
+    if (mWriteThreadPtr) {
+        {
+            std::lock_guard<std::mutex> lock(mPendingMux);
+            mStopWriteThread = true;
+        }
+        mPendingCV.notify_all();
+        mWriteThreadPtr->join();
+        mWriteThreadPtr.reset();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mWriteMux);
+        flushPendingWrites();
+    }
 
     close();
 }
@@ -131,7 +152,9 @@ void CheckpointManagerV2::appendCheckpointKeys(const std::string& primaryKey,
 int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exactlyOnceConfigs,
                                              std::vector<std::pair<std::string, PrimaryCheckpointPB>>* checkpoints,
                                              std::vector<std::string>& shouldDeleteCptKeys,
-                                             uint64_t limitScanTimeInMs) {
+                                             uint64_t limitScanTimeInMs,
+                                             const std::string& configName,
+                                             std::string* lastScannedKey) {
     bool doFullScan = !exactlyOnceConfigs.empty();
     if (doFullScan) {
         limitScanTimeInMs = 0;
@@ -151,37 +174,46 @@ int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exa
         mDatabase->ReleaseSnapshot(options.snapshot);
     });
 
-    static std::string sLastScannedKey;
+    // Keys of other configs sharing the prefix, e.g. config-a for config, are possible, so
+    //  primary checkpoints are filtered by config name again.
+    const std::string prefix = configName.empty() ? "" : configName + "-";
+    const bool scanFromStart = lastScannedKey == nullptr || lastScannedKey->empty();
+    uint64_t writeCountAtStart = 0;
+    if (!configName.empty()) {
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        auto item = mConfigIndex.find(configName);
+        if (item != mConfigIndex.end()) {
+            writeCountAtStart = item->second.mWriteCount;
+        }
+    }
     auto initIterator = [&]() {
-        if (doFullScan || sLastScannedKey.empty()) {
-            iter->SeekToFirst();
+        if (!scanFromStart) {
+            iter->Seek(*lastScannedKey);
+        } else if (!prefix.empty()) {
+            iter->Seek(prefix);
         } else {
-            iter->Seek(sLastScannedKey);
-            if (!iter->Valid()) {
-                iter->SeekToFirst();
-            }
+            iter->SeekToFirst();
         }
     };
+    auto isInRange = [&]() { return iter->Valid() && (prefix.empty() || iter->key().starts_with(prefix)); };
     auto const scanStartTime = GetCurrentTimeInMilliSeconds();
     int64_t scannedCount = 0;
     auto canAccessIterator = [&]() {
         if (doFullScan || limitScanTimeInMs == 0) {
-            return iter->Valid();
+            return isInRange();
         }
-        auto r = (GetCurrentTimeInMilliSeconds() - scanStartTime > limitScanTimeInMs) ? false : iter->Valid();
+        auto r = (GetCurrentTimeInMilliSeconds() - scanStartTime > limitScanTimeInMs) ? false : isInRange();
         if (!r) {
             LOG_DEBUG(sLogger, ("scanned count", scannedCount));
         }
         return r;
     };
     auto forwardIterator = [&]() {
-        if (!doFullScan) {
-            sLastScannedKey.assign(iter->key().data(), iter->key().size());
-        }
         ++scannedCount;
         iter->Next();
     };
 
+    std::set<std::string> aliveConfigNames;
     std::unordered_set<std::string> missingPrimaryKeysCache;
     for (initIterator(); canAccessIterator(); forwardIterator()) {
         const auto& key = iter->key();
@@ -221,6 +253,9 @@ int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exa
             appendCheckpointKeys(key.ToString(), INT32_FLAG(max_exactly_once_concurrency), shouldDeleteCptKeys);
             continue;
         }
+        if (!configName.empty() && cpt.config_name() != configName) {
+            continue;
+        }
 
         // Only full scan should validate config and v1 checkpoint.
         if (doFullScan) {
@@ -234,6 +269,7 @@ int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exa
                 CheckPointPtr v1Cpt;
                 if (sV1CptM->GetCheckPoint(DevInode(cpt.dev(), cpt.inode()), cpt.config_name(), v1Cpt)) {
                     LOG_DEBUG(sLogger, ("existing v1 checkpoint, skip", key.ToString()));
+                    aliveConfigNames.insert(cpt.config_name());
                     continue;
                 }
             }
@@ -265,6 +301,7 @@ int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exa
         }
 
         // Valid primary checkpoint.
+        aliveConfigNames.insert(cpt.config_name());
         if (checkpoints) {
             checkpoints->resize(checkpoints->size() + 1);
             checkpoints->back().first.assign(key.data(), key.size());
@@ -272,6 +309,41 @@ int64_t CheckpointManagerV2::scanCheckpoints(const std::vector<std::string>& exa
         }
     }
 
+    // Record where to resume, or start over next time if the end is reached.
+    const bool finished = !isInRange();
+    if (lastScannedKey) {
+        if (finished) {
+            lastScannedKey->clear();
+        } else {
+            lastScannedKey->assign(iter->key().data(), iter->key().size());
+        }
+    }
+
+    // Update config index by what has been found.
+    {
+        const auto curTime = time(NULL);
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        if (configName.empty()) {
+            for (auto& name : aliveConfigNames) {
+                mConfigIndex[name].mLastGCScanTime = curTime;
+            }
+            if (finished) {
+                mConfigIndexBuilt = true;
+            }
+        } else if (finished) {
+            auto item = mConfigIndex.find(configName);
+            if (item != mConfigIndex.end()) {
+                // Nothing written during the scan, so the config has no checkpoint anymore.
+                if (scanFromStart && aliveConfigNames.empty() && item->second.mWriteCount == writeCountAtStart) {
+                    LOG_DEBUG(sLogger, ("no more checkpoint, remove config from index", configName));
+                    mConfigIndex.erase(item);
+                } else {
+                    item->second.mLastGCScanTime = curTime;
+                }
+            }
+        }
+    }
+
     return GetCurrentTimeInMilliSeconds() - scanStartTime;
 }
 
@@ -287,8 +359,31 @@ CheckpointManagerV2::ScanCheckpoints(const std::vector<std::string>& exactlyOnce
         return checkpoints;
     }
 
+    FlushPendingWrites(GetLastWriteSeq());
+
+    // Once the config index is built, only the key ranges of indexed configs are scanned.
+    bool indexBuilt = false;
+    std::vector<std::string> configNames;
+    {
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        indexBuilt = mConfigIndexBuilt;
+        if (indexBuilt) {
+            for (auto& item : mConfigIndex) {
+                configNames.push_back(item.first);
+            }
+        }
+    }
     std::vector<std::string> toDeleteKeys;
-    auto scanUsedTimeInMs = scanCheckpoints(exactlyOnceConfigs, &checkpoints, toDeleteKeys);
+    int64_t scanUsedTimeInMs = 0;
+    if (!indexBuilt) {
+        scanUsedTimeInMs = scanCheckpoints(exactlyOnceConfigs, &checkpoints, toDeleteKeys);
+    } else {
+        std::vector<std::string> keys;
+        for (auto& name : configNames) {
+            scanUsedTimeInMs += scanCheckpoints(exactlyOnceConfigs, &checkpoints, keys, 0, name);
+            toDeleteKeys.insert(toDeleteKeys.end(), keys.begin(), keys.end());
+        }
+    }
     auto deleteUsedTimeInMs = DeleteCheckpoints(toDeleteKeys);
     LOG_INFO(sLogger,
              ("finish scanning checkpoints for exactly once configs", "")("checkpoint count", checkpoints.size())(
@@ -307,6 +402,8 @@ uint64_t CheckpointManagerV2::DeleteCheckpoints(const std::vector<std::string>&
     for (auto& k : keys) {
         batch.Delete(k);
     }
+    std::lock_guard<std::mutex> lock(mWriteMux);
+    erasePendingWrites(keys);
     auto status = mDatabase->Write(mDefaultWriteOption, &batch);
     auto const usedTimeInMs = GetCurrentTimeInMilliSeconds() - startTimeInMs;
     if (status.ok()) {
@@ -322,6 +419,7 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
 #define METHOD_LOG_PATTERN ("method", "UpdatePrimaryCheckpoints")("count", checkpoints.size())
     auto const startTimeInMs = GetCurrentTimeInMilliSeconds();
     leveldb::WriteBatch batch;
+    std::vector<std::string> keys;
     for (auto& cptPair : checkpoints) {
         auto& key = cptPair->first;
         auto& cpt = cptPair->second;
@@ -331,8 +429,15 @@ uint64_t CheckpointManagerV2::UpdatePrimaryCheckpoints(
             continue;
         }
         batch.Put(key, data);
+        keys.push_back(key);
+        indexConfig(cpt.config_name());
+    }
+    leveldb::Status status;
+    {
+        std::lock_guard<std::mutex> lock(mWriteMux);
+        erasePendingWrites(keys);
+        status = mDatabase->Write(mDefaultWriteOption, &batch);
     }
-    auto status = mDatabase->Write(mDefaultWriteOption, &batch);
     if (status.ok()) {
         return GetCurrentTimeInMilliSeconds() - startTimeInMs;
     } else {
@@ -391,7 +496,7 @@ bool CheckpointManagerV2::readDatabase(const std::string& key, std::string& valu
 }
 
 bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
-    if (!readDatabase(key, value)) {
+    if (!readPendingWrites(key, value) && !readDatabase(key, value)) {
         return false;
     }
 
@@ -411,14 +516,148 @@ bool CheckpointManagerV2::read(const std::string& key, std::string& value) {
 bool CheckpointManagerV2::write(const std::string& key, const std::string& value) {
     ASSERT_LEVELDB_STATUS;
 
-    leveldb::Status s = mDatabase->Put(mDefaultWriteOption, key, value);
-    if (s.ok()) {
+    if (!mWriteThreadPtr) {
+        std::lock_guard<std::mutex> lock(mWriteMux);
+        leveldb::Status s = mDatabase->Put(mDefaultWriteOption, key, value);
+        if (s.ok()) {
+            return true;
+        }
+        detail::logDatabaseError("write", key, s);
+        return false;
+    }
+
+    // Later writes of the same key override earlier ones, only the last is flushed.
+    bool wasEmpty = false;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMux);
+        wasEmpty = mPendingWrites.empty();
+        mPendingWrites[key] = value;
+        ++mWriteSeq;
+    }
+    if (wasEmpty) {
+        mPendingCV.notify_one();
+    }
+    return true;
+}
+
+bool CheckpointManagerV2::SetPB(const std::string& key, const PrimaryCheckpointPB& value) {
+    std::string data;
+    if (!value.SerializeToString(&data)) {
+        return false;
+    }
+
+    if (!write(key, data)) {
+        return false;
+    }
+    indexConfig(value.config_name());
+    return true;
+}
+
+void CheckpointManagerV2::indexConfig(const std::string& configName) {
+    std::lock_guard<std::mutex> lock(mIndexMux);
+    auto res = mConfigIndex.emplace(configName, ConfigIndexItem());
+    if (res.second) {
+        // Newly written checkpoints need no GC for now.
+        res.first->second.mLastGCScanTime = time(NULL);
+    }
+    ++res.first->second.mWriteCount;
+}
+
+bool CheckpointManagerV2::readPendingWrites(const std::string& key, std::string& value) {
+    std::lock_guard<std::mutex> lock(mPendingMux);
+    auto iter = mPendingWrites.find(key);
+    if (iter != mPendingWrites.end()) {
+        value = iter->second;
+        return true;
+    }
+    iter = mFlushingWrites.find(key);
+    if (iter != mFlushingWrites.end()) {
+        value = iter->second;
         return true;
     }
-    detail::logDatabaseError("write", key, s);
     return false;
 }
 
+void CheckpointManagerV2::erasePendingWrites(const std::vector<std::string>& keys) {
+    std::lock_guard<std::mutex> lock(mPendingMux);
+    if (mPendingWrites.empty()) {
+        return;
+    }
+    for (auto& key : keys) {
+        mPendingWrites.erase(key);
+    }
+}
+
+bool CheckpointManagerV2::flushPendingWrites() {
+    uint64_t seq = 0;
+    {
+        std::lock_guard<std::mutex> lock(mPendingMux);
+        if (mPendingWrites.empty()) {
+            return true;
+        }
+        mFlushingWrites.swap(mPendingWrites);
+        seq = mWriteSeq.load();
+    }
+
+    // mFlushingWrites is only modified with both mWriteMux and mPendingMux held, so it is
+    //  safe to iterate without mPendingMux.
+    leveldb::Status status;
+    if (nullptr == mDatabase) {
+        status = leveldb::Status::IOError("checkpoint database is closed");
+    } else {
+        leveldb::WriteBatch batch;
+        for (auto& item : mFlushingWrites) {
+            batch.Put(item.first, item.second);
+        }
+        status = mDatabase->Write(mDefaultWriteOption, &batch);
+    }
+
+    std::lock_guard<std::mutex> lock(mPendingMux);
+    if (status.ok()) {
+        LOG_DEBUG(sLogger, ("flush checkpoints, count", mFlushingWrites.size()));
+        mFlushedSeq = seq;
+    } else {
+        detail::logDatabaseError("batch_write", std::to_string(mFlushingWrites.size()), status);
+        // Keep newer writes which happened during the flush.
+        for (auto& item : mFlushingWrites) {
+            mPendingWrites.emplace(item.first, std::move(item.second));
+        }
+    }
+    mFlushingWrites.clear();
+    return status.ok();
+}
+
+void CheckpointManagerV2::FlushPendingWrites(uint64_t seq) {
+    if (mFlushedSeq.load() >= seq) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mWriteMux);
+    if (mFlushedSeq.load() >= seq) {
+        return;
+    }
+    flushPendingWrites();
+}
+
+void CheckpointManagerV2::runWriteLoop() {
+    const auto interval = std::chrono::milliseconds(INT32_FLAG(logtail_checkpoint_batch_write_interval_ms));
+    bool lastFailed = false;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mPendingMux);
+            mPendingCV.wait(lock, [this]() { return mStopWriteThread || !mPendingWrites.empty(); });
+            // Collect writes coming within the interval into the batch, and back off if the
+            //  last flush failed.
+            if (mPendingCV.wait_for(
+                    lock, lastFailed ? std::chrono::seconds(1) : interval, [this]() { return mStopWriteThread; })) {
+                break;
+            }
+        }
+        std::lock_guard<std::mutex> lock(mWriteMux);
+        lastFailed = !flushPendingWrites();
+    }
+    LOG_INFO(sLogger, ("runWriteLoop exit", "done"));
+}
+
 void CheckpointManagerV2::MarkGC(const std::string& primaryKey) {
     {
         std::lock_guard<std::mutex> lock(mMutex);
@@ -481,13 +720,27 @@ void CheckpointManagerV2::runGCLoop() {
         return;
     }
 
+    // Until the config index is built by a scan of the whole database, scan all keys.
+    std::string lastScannedKey;
     while (!mStopGCThread) {
         std::this_thread::sleep_for(std::chrono::seconds(INT32_FLAG(logtail_checkpoint_check_gc_interval_sec)));
 
+        FlushPendingWrites(GetLastWriteSeq());
         checkGCItems();
 
+        bool indexBuilt = false;
+        {
+            std::lock_guard<std::mutex> lock(mIndexMux);
+            indexBuilt = mConfigIndexBuilt;
+        }
+        if (indexBuilt) {
+            gcConfigCheckpoints(100);
+            continue;
+        }
+
         std::vector<std::string> toDeleteCptKeys;
-        auto scanUsedTimeInMs = scanCheckpoints(std::vector<std::string>(), nullptr, toDeleteCptKeys, 100);
+        auto scanUsedTimeInMs
+            = scanCheckpoints(std::vector<std::string>(), nullptr, toDeleteCptKeys, 100, "", &lastScannedKey);
         auto deleteUsedTimeInMs = DeleteCheckpoints(toDeleteCptKeys);
         if (!toDeleteCptKeys.empty()) {
             LOG_INFO(sLogger,
@@ -498,8 +751,62 @@ void CheckpointManagerV2::runGCLoop() {
     LOG_INFO(sLogger, ("runGCLoop exit", "done"));
 }
 
+void CheckpointManagerV2::gcConfigCheckpoints(uint64_t limitScanTimeInMs) {
+    const auto curTime = time(NULL);
+    std::vector<std::pair<std::string, /* config name */
+                          std::string /* last scanned key */>>
+        candidates;
+    {
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        for (auto& item : mConfigIndex) {
+            if (!item.second.mLastScannedKey.empty()
+                || curTime - item.second.mLastGCScanTime >= INT32_FLAG(logtail_checkpoint_config_gc_interval_sec)) {
+                candidates.emplace_back(item.first, item.second.mLastScannedKey);
+            }
+        }
+    }
+
+    uint64_t scanUsedTimeInMs = 0;
+    std::vector<std::string> toDeleteCptKeys;
+    std::vector<std::string> keys;
+    for (auto& candidate : candidates) {
+        if (mStopGCThread || scanUsedTimeInMs >= limitScanTimeInMs) {
+            break;
+        }
+        scanUsedTimeInMs += scanCheckpoints(std::vector<std::string>(),
+                                            nullptr,
+                                            keys,
+                                            limitScanTimeInMs - scanUsedTimeInMs,
+                                            candidate.first,
+                                            &candidate.second);
+        toDeleteCptKeys.insert(toDeleteCptKeys.end(), keys.begin(), keys.end());
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        auto item = mConfigIndex.find(candidate.first);
+        if (item != mConfigIndex.end()) {
+            item->second.mLastScannedKey = candidate.second;
+        }
+    }
+    auto deleteUsedTimeInMs = DeleteCheckpoints(toDeleteCptKeys);
+    if (!toDeleteCptKeys.empty()) {
+        LOG_INFO(sLogger,
+                 ("delete checkpoints", toDeleteCptKeys.size())("candidate configs", candidates.size())(
+                     "scan used time", scanUsedTimeInMs)("delete used time", deleteUsedTimeInMs));
+    }
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void CheckpointManagerV2::rebuild() {
+    {
+        std::lock_guard<std::mutex> writeLock(mWriteMux);
+        std::lock_guard<std::mutex> pendingLock(mPendingMux);
+        mPendingWrites.clear();
+        mFlushedSeq = mWriteSeq.load();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mIndexMux);
+        mConfigIndex.clear();
+        mConfigIndexBuilt = false;
+    }
     bool opened = close();
     leveldb::DestroyDB(detail::getDatabasePath(), leveldb::Options());
     if (opened) {
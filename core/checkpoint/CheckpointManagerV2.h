@@ -15,6 +15,9 @@
  */
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -47,6 +50,14 @@ namespace logtail {
 //  range checkpoints, that is why we call N concurrency.
 // - If order is import, the 1 primary checkpoint + N range checkpoints model downgrades
 //  to 1 primary + 1 range, ie. there is only one concurrency for the file.
+//
+// Writes are group committed: they are coalesced by key in memory and flushed to the
+//  database as one batch by the write thread every logtail_checkpoint_batch_write_interval_ms,
+//  or at once by FlushPendingWrites, which must be called before anything depending on the
+//  durability of a checkpoint, e.g. sending the data of a prepared range checkpoint.
+//
+// Keys of checkpoints are prefixed by their config names, so configs having checkpoints are
+//  indexed, and GC and rescans after config update only seek to the prefixes of the configs.
 class CheckpointManagerV2 {
 public:
     static std::string MakeRangeKey(const std::string& primaryKey, uint32_t idx);
@@ -96,6 +107,16 @@ public:
         return write(key, data);
     }
 
+    // Primary checkpoints also add their config to the config index.
+    bool SetPB(const std::string& key, const PrimaryCheckpointPB& value);
+
+    // @return the sequence of the last write, which is durable once FlushPendingWrites
+    //  is called with it.
+    uint64_t GetLastWriteSeq() const { return mWriteSeq.load(); }
+
+    // Flush pending writes if the write of seq has not been flushed.
+    void FlushPendingWrites(uint64_t seq);
+
     // Add primaryKey to GC list, called in destructor of LogFileReader.
     //
     // GetPB will remove primaryKey from GC list, so for config update case, primary
@@ -136,9 +157,27 @@ private:
     bool read(const std::string& key, std::string& value);
     bool write(const std::string& key, const std::string& value);
 
+    // Read the value of key from writes not flushed yet.
+    bool readPendingWrites(const std::string& key, std::string& value);
+    // Drop pending writes of keys, which are written or deleted in the database directly.
+    // mWriteMux must be held.
+    void erasePendingWrites(const std::vector<std::string>& keys);
+    // Write pending writes to the database as one batch, put them back if failed.
+    // mWriteMux must be held.
+    bool flushPendingWrites();
+
+    // Routine of write thread.
+    void runWriteLoop();
+
     // Routine of GC thread.
     void runGCLoop();
 
+    // Scan the checkpoints of indexed configs whose last GC scan is older than
+    //  logtail_checkpoint_config_gc_interval_sec, resuming from where the last round stopped.
+    void gcConfigCheckpoints(uint64_t limitScanTimeInMs);
+
+    void indexConfig(const std::string& configName);
+
     void checkGCItems();
 
     // Scan whole database according to mode.
@@ -156,12 +195,18 @@ private:
     // @checkpoints: valid primary checkpoints found by this scan, if nullptr, ignore.
     // @shouldDeleteCptKeys: keys of checkpoints that should be deleted.
     // @limitScanTimeInMs: 0 means unlimited.
+    // @configName: if not empty, only scan keys prefixed by the config name, otherwise scan
+    //  the whole database and build the config index.
+    // @lastScannedKey: position to resume from, updated by the scan and cleared once the scan
+    //  reaches the end, if nullptr, scan from start.
     //
     // @return used time in milliseconds.
     int64_t scanCheckpoints(const std::vector<std::string>& exactlyOnceConfigs,
                             std::vector<std::pair<std::string, PrimaryCheckpointPB>>* checkpoints,
                             std::vector<std::string>& shouldDeleteCptKeys,
-                            uint64_t limitScanTimeInMs = 0);
+                            uint64_t limitScanTimeInMs = 0,
+                            const std::string& configName = "",
+                            std::string* lastScannedKey = nullptr);
 
     // Append the key of primary checkpoint and range checkpoints to keys.
     void appendCheckpointKeys(const std::string& primaryKey, uint32_t rgCptCount, std::vector<std::string>& keys);
@@ -178,6 +223,30 @@ private:
                        time_t /* create time */>
         mGCItems;
 
+    // Serializes writes of the database, so that a batch being flushed never overrides
+    //  direct writes or deletions issued after it.
+    std::mutex mWriteMux;
+    std::mutex mPendingMux;
+    std::condition_variable mPendingCV;
+    bool mStopWriteThread = false;
+    std::unordered_map<std::string, std::string> mPendingWrites;
+    // Writes being flushed, which are still visible to read.
+    std::unordered_map<std::string, std::string> mFlushingWrites;
+    std::atomic_uint64_t mWriteSeq{0};
+    std::atomic_uint64_t mFlushedSeq{0};
+    std::unique_ptr<std::thread> mWriteThreadPtr;
+
+    struct ConfigIndexItem {
+        // number of primary checkpoints written, to tell if the config is written during a scan
+        uint64_t mWriteCount = 0;
+        time_t mLastGCScanTime = 0;
+        std::string mLastScannedKey;
+    };
+    std::mutex mIndexMux;
+    std::map<std::string, ConfigIndexItem> mConfigIndex;
+    // The index is complete only after a scan of the whole database.
+    bool mConfigIndexBuilt = false;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class CheckpointManagerV2Unittest;
     friend class ExactlyOnceReaderUnittest;
@@ -22,6 +22,7 @@ void RangeCheckpoint::save() {
     static auto sCptM = CheckpointManagerV2::GetInstance();
     data.set_update_time(time(NULL));
     sCptM->SetPB(key, data);
+    mWriteSeq = sCptM->GetLastWriteSeq();
 }
 
 } // namespace logtail
@@ -45,8 +45,14 @@ public:
 
     inline bool IsComplete() const { return data.has_hash_key(); }
 
+    // Saves are group committed by checkpoint manager, the last save is durable once
+    //  CheckpointManagerV2::FlushPendingWrites is called with the returned sequence.
+    inline uint64_t GetWriteSeq() const { return mWriteSeq; }
+
 private:
     void save();
+
+    uint64_t mWriteSeq = 0;
 };
 
 typedef std::shared_ptr<RangeCheckpoint> RangeCheckpointPtr;
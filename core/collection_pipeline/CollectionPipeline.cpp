@@ -18,7 +18,9 @@
 
 #include <cstdint>
 
+#include <algorithm>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <utility>
 
@@ -39,6 +41,13 @@
 #include "plugin/processor/ProcessorParseApsaraNative.h"
 #include "plugin/processor/inner/ProcessorTagNative.h"
 
+DEFINE_FLAG_INT32(parallel_processing_min_chunk_events,
+                  "min number of events in each chunk when a group is processed in parallel",
+                  1024);
+DEFINE_FLAG_INT32(fused_processing_block_events,
+                  "number of events in each block when processors are fused, should keep a block in cache",
+                  256);
+
 DECLARE_FLAG_INT32(default_plugin_log_queue_size);
 
 using namespace std;
@@ -385,7 +394,9 @@ void CollectionPipeline::Start() {
     LOG_INFO(sLogger, ("pipeline start", "succeeded")("config", mName));
 }
 
-void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_t inputIndex) {
+void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList,
+                                 size_t inputIndex,
+                                 const ParallelExecutor& executor) {
     for (const auto& logGroup : logGroupList) {
         ADD_COUNTER(mProcessorsInEventsTotal, logGroup.GetEvents().size());
         ADD_COUNTER(mProcessorsInSizeBytes, logGroup.DataSize());
@@ -394,9 +405,7 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
 
     auto before = chrono::system_clock::now();
     if (inputIndex < mInputs.size()) {
-        for (auto& p : mInputs[inputIndex]->GetInnerProcessors()) {
-            p->Process(logGroupList);
-        }
+        ProcessLine(mInputs[inputIndex]->GetInnerProcessors(), logGroupList);
     } else {
         LOG_WARNING(sLogger,
                     ("input index out of range", "skip inner processing")(
@@ -410,15 +419,128 @@ void CollectionPipeline::Process(vector<PipelineEventGroup>& logGroupList, size_
             GetContext().GetConfigName(),
             GetContext().GetLogstoreName());
     }
-    for (auto& p : mPipelineInnerProcessorLine) {
-        p->Process(logGroupList);
-    }
-    for (auto& p : mProcessorLine) {
-        p->Process(logGroupList);
+    ProcessLine(mPipelineInnerProcessorLine, logGroupList);
+    if (executor && mContext.GetGlobalConfig().mEnableParallelProcessing) {
+        ProcessInParallel(logGroupList, executor);
+    } else {
+        ProcessLine(mProcessorLine, logGroupList);
     }
     ADD_COUNTER(mProcessorsTotalProcessTimeMs, chrono::system_clock::now() - before);
 }
 
+void CollectionPipeline::ProcessInParallel(vector<PipelineEventGroup>& logGroupList, const ParallelExecutor& executor) {
+    size_t minChunkEvents = static_cast<size_t>(max(1, INT32_FLAG(parallel_processing_min_chunk_events)));
+    size_t maxChunkCnt = static_cast<size_t>(max(1, AppConfig::GetInstance()->GetProcessThreadCount()));
+    vector<size_t> chunkCnts(logGroupList.size());
+    bool needSplit = false;
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        chunkCnts[i] = max<size_t>(1, min(maxChunkCnt, logGroupList[i].GetEvents().size() / minChunkEvents));
+        needSplit = needSplit || chunkCnts[i] > 1;
+    }
+    if (mProcessorLine.empty() || !needSplit) {
+        ProcessLine(mProcessorLine, logGroupList);
+        return;
+    }
+
+    // chunks of all groups, each chunk is processed as a group list by one task
+    vector<vector<PipelineEventGroup>> chunks;
+    vector<size_t> chunkEnds(logGroupList.size());
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        for (auto& chunk : logGroupList[i].SplitIntoChunks(chunkCnts[i])) {
+            chunks.emplace_back();
+            chunks.back().emplace_back(std::move(chunk));
+        }
+        chunkEnds[i] = chunks.size();
+    }
+    vector<function<void()>> tasks;
+    tasks.reserve(chunks.size());
+    for (size_t i = 0, chunkIdx = 0; i < logGroupList.size(); ++i) {
+        // group level data is counted in metrics with the first chunk of each group only
+        for (size_t first = chunkIdx; chunkIdx < chunkEnds[i]; ++chunkIdx) {
+            auto& chunk = chunks[chunkIdx];
+            bool partial = chunkIdx != first;
+            tasks.emplace_back([this, &chunk, partial]() { ProcessLine(mProcessorLine, chunk, partial); });
+        }
+    }
+    executor(tasks);
+
+    // the original groups are kept during processing, since chunk data may refer to their source buffers
+    size_t chunkIdx = 0;
+    for (size_t i = 0; i < logGroupList.size(); ++i) {
+        vector<PipelineEventGroup> processed;
+        for (; chunkIdx < chunkEnds[i]; ++chunkIdx) {
+            for (auto& group : chunks[chunkIdx]) {
+                processed.emplace_back(std::move(group));
+            }
+        }
+        logGroupList[i].MergeChunks(std::move(processed));
+    }
+}
+
+void CollectionPipeline::ProcessLine(vector<unique_ptr<ProcessorInstance>>& line,
+                                     vector<PipelineEventGroup>& logGroupList,
+                                     bool partial) {
+    if (!mContext.GetGlobalConfig().mEnableFusedProcessing) {
+        for (auto& p : line) {
+            p->Process(logGroupList, partial);
+        }
+        return;
+    }
+    // consecutive processors supporting fused processing are fused, others are run on the whole groups as usual
+    size_t begin = 0;
+    while (begin < line.size()) {
+        size_t end = begin;
+        while (end < line.size() && line[end]->SupportFusedProcessing()) {
+            ++end;
+        }
+        if (end - begin > 1) {
+            ProcessFused(line, begin, end, logGroupList, partial);
+            begin = end;
+        } else {
+            line[begin]->Process(logGroupList, partial);
+            ++begin;
+        }
+    }
+}
+
+void CollectionPipeline::ProcessFused(vector<unique_ptr<ProcessorInstance>>& line,
+                                      size_t begin,
+                                      size_t end,
+                                      vector<PipelineEventGroup>& logGroupList,
+                                      bool partial) {
+    size_t blockEvents = static_cast<size_t>(max(1, INT32_FLAG(fused_processing_block_events)));
+    vector<PipelineEventGroup> blockList;
+    blockList.reserve(1);
+    EventsContainer events, processed;
+    for (auto& logGroup : logGroupList) {
+        // the group itself carries the blocks one after another, so that metadata and tags are not copied per block
+        blockList.emplace_back(std::move(logGroup));
+        auto& block = blockList[0];
+        block.SetExactlyOnceCheckpoint(logGroup.GetExactlyOnceCheckpoint());
+        block.SwapEvents(events);
+        processed.reserve(events.size());
+        // each block runs through all fused processors while it is still in cache
+        for (size_t pos = 0; pos < events.size(); pos += blockEvents) {
+            auto& blockEventList = block.MutableEvents();
+            for (size_t j = pos; j < min(events.size(), pos + blockEvents); ++j) {
+                blockEventList.emplace_back(std::move(events[j]));
+            }
+            for (size_t i = begin; i < end; ++i) {
+                // group level data is counted in metrics with the first block only
+                line[i]->Process(blockList, partial || pos != 0);
+            }
+            for (auto& e : block.MutableEvents()) {
+                processed.emplace_back(std::move(e));
+            }
+            block.MutableEvents().clear();
+        }
+        events.clear();
+        block.SwapEvents(processed);
+        logGroup = std::move(block);
+        blockList.clear();
+    }
+}
+
 bool CollectionPipeline::Send(vector<PipelineEventGroup>&& groupList) {
     for (const auto& group : groupList) {
         ADD_COUNTER(mFlushersInEventsTotal, group.GetEvents().size());
@@ -17,6 +17,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <optional>
 #include <string>
@@ -39,13 +40,22 @@ namespace logtail {
 
 class CollectionPipeline {
 public:
+    // runs all the tasks, possibly in parallel, and returns after all of them are finished
+    using ParallelExecutor = std::function<void(std::vector<std::function<void()>>&)>;
+
     static std::string GenPluginTypeWithID(const std::string& pluginType, const std::string& pluginID);
 
     // copy/move control functions are deleted because of mContext
     bool Init(CollectionConfig&& config);
     void Start();
     void Stop(bool isRemoving);
-    void Process(std::vector<PipelineEventGroup>& logGroupList, size_t inputIndex);
+    // If parallel processing is enabled and an executor is given, large groups are split into chunks after inner
+    // processing, and the chunks are processed by the processor line in parallel. Chunks are then reassembled in the
+    // original order, so that each group is sent as a whole. If fused processing is enabled, consecutive processors
+    // supporting it are run block by block on each group, so that events stay in cache from one processor to the next.
+    void Process(std::vector<PipelineEventGroup>& logGroupList,
+                 size_t inputIndex,
+                 const ParallelExecutor& executor = nullptr);
     bool Send(std::vector<PipelineEventGroup>&& groupList);
     bool FlushBatch();
     void RemoveProcessQueue() const;
@@ -89,6 +99,16 @@ private:
     void CopyNativeGlobalParamToGoPipeline(Json::Value& root);
     void CopyTagParamToGoPipeline(Json::Value& root, const Json::Value* config);
     bool ShouldAddPluginToGoPipelineWithInput() const { return mInputs.empty() && mProcessorLine.empty(); }
+    void ProcessInParallel(std::vector<PipelineEventGroup>& logGroupList, const ParallelExecutor& executor);
+    // partial has the same meaning as in ProcessorInstance::Process
+    void ProcessLine(std::vector<std::unique_ptr<ProcessorInstance>>& line,
+                     std::vector<PipelineEventGroup>& logGroupList,
+                     bool partial = false);
+    void ProcessFused(std::vector<std::unique_ptr<ProcessorInstance>>& line,
+                      size_t begin,
+                      size_t end,
+                      std::vector<PipelineEventGroup>& logGroupList,
+                      bool partial);
     void WaitAllItemsInProcessFinished();
 
     std::string mName;
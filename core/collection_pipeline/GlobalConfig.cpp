@@ -29,6 +29,8 @@ const unordered_set<string> GlobalConfig::sNativeParam = {"TopicType",
                                                           "Priority",
                                                           "EnableTimestampNanosecond",
                                                           "UsingOldContentTag",
+                                                          "EnableParallelProcessing",
+                                                          "EnableFusedProcessing",
                                                           "PipelineMetaTagKey",
                                                           "AgentMetaTagKey"};
 
@@ -153,6 +155,32 @@ bool GlobalConfig::Init(const Json::Value& config, const CollectionPipelineConte
                               ctx.GetRegion());
     }
 
+    // EnableParallelProcessing
+    if (!GetOptionalBoolParam(config, "EnableParallelProcessing", mEnableParallelProcessing, errorMsg)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              errorMsg,
+                              mEnableParallelProcessing,
+                              moduleName,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    }
+
+    // EnableFusedProcessing
+    if (!GetOptionalBoolParam(config, "EnableFusedProcessing", mEnableFusedProcessing, errorMsg)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              errorMsg,
+                              mEnableFusedProcessing,
+                              moduleName,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    }
+
     for (auto itr = config.begin(); itr != config.end(); ++itr) {
         if (sNativeParam.find(itr.name()) == sNativeParam.end()) {
             extendedParams[itr.name()] = *itr;
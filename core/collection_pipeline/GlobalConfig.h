@@ -39,6 +39,8 @@ struct GlobalConfig {
     uint32_t mPriority = 1U;
     bool mEnableTimestampNanosecond = false;
     bool mUsingOldContentTag = false;
+    bool mEnableParallelProcessing = false;
+    bool mEnableFusedProcessing = false;
 };
 
 } // namespace logtail
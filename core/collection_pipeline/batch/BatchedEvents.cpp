@@ -22,28 +22,25 @@ namespace logtail {
 
 template <class T>
 void DestroyEvents(vector<PipelineEventPtr>&& events) {
-    unordered_map<EventPool*, vector<T*>> eventsPoolMap;
-    // for most cases, all events have the same origin. So we cache the pool pointer and iterator for efficiency
-    EventPool* cachedPoolPtr = nullptr;
-    typename unordered_map<EventPool*, vector<T*>>::iterator cachedIt;
-    bool firstEvent = true;
+    // for most cases, all events have the same origin, so the whole group is released to the pool in one batch
+    vector<pair<EventPool*, vector<T*>>> eventsPoolList;
     for (auto& item : events) {
         if (item && item.IsFromEventPool()) {
             item->Reset();
-            if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
-                cachedPoolPtr = item.GetEventPool();
-                cachedIt = eventsPoolMap.find(cachedPoolPtr);
-                if (cachedIt == eventsPoolMap.end()) {
-                    eventsPoolMap.emplace(cachedPoolPtr, vector<T*>());
-                    cachedIt = eventsPoolMap.find(cachedPoolPtr);
-                    cachedIt->second.reserve(events.size());
-                }
-                firstEvent = false;
+            EventPool* pool = item.GetEventPool();
+            auto it = eventsPoolList.begin();
+            while (it != eventsPoolList.end() && it->first != pool) {
+                ++it;
             }
-            cachedIt->second.emplace_back(static_cast<T*>(item.Release()));
+            if (it == eventsPoolList.end()) {
+                eventsPoolList.emplace_back(pool, vector<T*>());
+                it = prev(eventsPoolList.end());
+                it->second.reserve(events.size());
+            }
+            it->second.emplace_back(static_cast<T*>(item.Release()));
         }
     }
-    for (auto& item : eventsPoolMap) {
+    for (auto& item : eventsPoolList) {
         if (item.first) {
             item.first->Release(std::move(item.second));
         } else {
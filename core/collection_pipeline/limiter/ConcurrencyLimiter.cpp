@@ -14,12 +14,52 @@
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
 
+#include <cmath>
+
+#include <algorithm>
+
+#include "common/Flags.h"
 #include "common/StringTools.h"
 #include "logger/Logger.h"
 
+DEFINE_FLAG_BOOL(enable_adaptive_concurrency_limiter, "adjust send concurrency by response time as well", false);
+DEFINE_FLAG_DOUBLE(concurrency_limiter_rtt_tolerance,
+                   "the ratio of response time to its baseline before send concurrency is decreased",
+                   1.5);
+
 using namespace std;
 
 namespace logtail {
+
+// weight of each window in the long-term response time
+static const double kLongRttSmoothing = 0.1;
+// weight of the new limit calculated in each window
+static const double kLimitSmoothing = 0.2;
+// the limit is never cut by more than half in one window because of the response time
+static const double kMinGradient = 0.5;
+
+ConcurrencyLimiter::ConcurrencyLimiter(const string& description,
+                                       uint32_t maxConcurrency,
+                                       uint32_t minConcurrency,
+                                       double concurrencyFastFallBackRatio,
+                                       double concurrencySlowFallBackRatio)
+    : mDescription(description),
+      mAdaptive(BOOL_FLAG(enable_adaptive_concurrency_limiter)),
+      mMaxConcurrency(maxConcurrency),
+      mMinConcurrency(minConcurrency),
+      mCurrenctConcurrency(maxConcurrency),
+      mConcurrencyFastFallBackRatio(concurrencyFastFallBackRatio),
+      mConcurrencySlowFallBackRatio(concurrencySlowFallBackRatio),
+      mEstimatedLimit(maxConcurrency) {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_COMPONENT,
+        {{METRIC_LABEL_KEY_COMPONENT_NAME, METRIC_LABEL_VALUE_COMPONENT_NAME_CONCURRENCY_LIMITER},
+         {METRIC_LABEL_KEY_LIMITER_NAME, mDescription}});
+    mLimit = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_LIMITER_CONCURRENCY_LIMIT);
+    mRttMs = mMetricsRecordRef.CreateIntGauge(METRIC_COMPONENT_LIMITER_RTT_MS);
+    SET_GAUGE(mLimit, mCurrenctConcurrency);
+}
 #ifdef APSARA_UNIT_TEST_MAIN
 uint32_t ConcurrencyLimiter::GetCurrentLimit() const {
     lock_guard<mutex> lock(mLimiterMux);
@@ -29,6 +69,7 @@ uint32_t ConcurrencyLimiter::GetCurrentLimit() const {
 void ConcurrencyLimiter::SetCurrentLimit(uint32_t limit) {
     lock_guard<mutex> lock(mLimiterMux);
     mCurrenctConcurrency = limit;
+    mEstimatedLimit = limit;
 }
 
 void ConcurrencyLimiter::SetInSendingCount(uint32_t count) {
@@ -42,6 +83,11 @@ uint32_t ConcurrencyLimiter::GetStatisticThreshold() const {
     return CONCURRENCY_STATISTIC_THRESHOLD;
 }
 
+double ConcurrencyLimiter::GetLongRttMs() const {
+    lock_guard<mutex> lock(mLimiterMux);
+    return mLongRttMs;
+}
+
 #endif
 
 bool ConcurrencyLimiter::IsValidToPop() {
@@ -60,18 +106,21 @@ void ConcurrencyLimiter::OnSendDone() {
     --mInSendingCnt;
 }
 
-void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point currentTime) {
-    AdjustConcurrency(true, currentTime);
+void ConcurrencyLimiter::OnSuccess(std::chrono::system_clock::time_point currentTime,
+                                   std::chrono::milliseconds responseTime) {
+    AdjustConcurrency(true, currentTime, responseTime);
 }
 
 void ConcurrencyLimiter::OnFail(std::chrono::system_clock::time_point currentTime) {
-    AdjustConcurrency(false, currentTime);
+    AdjustConcurrency(false, currentTime, chrono::milliseconds::zero());
 }
 
 void ConcurrencyLimiter::Increase() {
     lock_guard<mutex> lock(mLimiterMux);
     if (mCurrenctConcurrency != mMaxConcurrency) {
         ++mCurrenctConcurrency;
+        mEstimatedLimit = mCurrenctConcurrency;
+        SET_GAUGE(mLimit, mCurrenctConcurrency);
         if (mCurrenctConcurrency == mMaxConcurrency) {
             LOG_DEBUG(
                 sLogger,
@@ -89,18 +138,55 @@ void ConcurrencyLimiter::Decrease(double fallBackRatio) {
     if (mCurrenctConcurrency != mMinConcurrency) {
         auto old = mCurrenctConcurrency;
         mCurrenctConcurrency = std::max(static_cast<uint32_t>(mCurrenctConcurrency * fallBackRatio), mMinConcurrency);
+        mEstimatedLimit = mCurrenctConcurrency;
+        SET_GAUGE(mLimit, mCurrenctConcurrency);
         LOG_DEBUG(sLogger, ("decrease send concurrency, type", mDescription)("from", old)("to", mCurrenctConcurrency));
     } else {
         if (mMinConcurrency == 0) {
             mCurrenctConcurrency = 1;
+            mEstimatedLimit = mCurrenctConcurrency;
+            SET_GAUGE(mLimit, mCurrenctConcurrency);
             LOG_INFO(sLogger, ("decrease send concurrency to min, type", mDescription)("to", mCurrenctConcurrency));
         }
     }
 }
 
+void ConcurrencyLimiter::UpdateByGradient(double sampleRttMs) {
+    lock_guard<mutex> lock(mLimiterMux);
+    if (mLongRttMs == 0.0) {
+        mLongRttMs = sampleRttMs;
+    } else {
+        mLongRttMs = mLongRttMs * (1 - kLongRttSmoothing) + sampleRttMs * kLongRttSmoothing;
+        if (mLongRttMs > sampleRttMs * 2) {
+            // the destination has recovered from a long slowdown, let the baseline catch up faster
+            mLongRttMs *= 0.95;
+        }
+    }
+    SET_GAUGE(mRttMs, static_cast<uint64_t>(mLongRttMs));
+
+    double gradient = DOUBLE_FLAG(concurrency_limiter_rtt_tolerance) * mLongRttMs / sampleRttMs;
+    gradient = std::max(kMinGradient, std::min(1.0, gradient));
+    // the square root leaves some room for requests to queue, so that the limit can keep growing when gradient is 1
+    double newLimit = mEstimatedLimit * gradient + std::sqrt(mEstimatedLimit);
+    newLimit = mEstimatedLimit * (1 - kLimitSmoothing) + newLimit * kLimitSmoothing;
+    mEstimatedLimit = std::max(static_cast<double>(std::max(mMinConcurrency, 1U)),
+                               std::min(static_cast<double>(mMaxConcurrency), newLimit));
+
+    auto old = mCurrenctConcurrency;
+    mCurrenctConcurrency = static_cast<uint32_t>(mEstimatedLimit);
+    SET_GAUGE(mLimit, mCurrenctConcurrency);
+    if (old != mCurrenctConcurrency) {
+        LOG_DEBUG(sLogger,
+                  ("adjust send concurrency by response time, type", mDescription)("from", old)(
+                      "to", mCurrenctConcurrency)("rtt ms", sampleRttMs)("long rtt ms", mLongRttMs));
+    }
+}
 
-void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime) {
+void ConcurrencyLimiter::AdjustConcurrency(bool success,
+                                           std::chrono::system_clock::time_point currentTime,
+                                           std::chrono::milliseconds responseTime) {
     uint32_t failPercentage = 0;
+    double avgRttMs = 0.0;
     bool finishStatistics = false;
     {
         lock_guard<mutex> lock(mStatisticsMux);
@@ -108,6 +194,10 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
         if (!success) {
             mStatisticsFailTotal++;
         }
+        if (responseTime.count() > 0) {
+            mStatisticsRttTotalMs += responseTime.count();
+            ++mStatisticsRttCnt;
+        }
         if (mLastStatisticsTime == std::chrono::system_clock::time_point()) {
             mLastStatisticsTime = currentTime;
         }
@@ -115,17 +205,24 @@ void ConcurrencyLimiter::AdjustConcurrency(bool success, std::chrono::system_clo
             || chrono::duration_cast<chrono::seconds>(currentTime - mLastStatisticsTime).count()
                 > CONCURRENCY_STATISTIC_INTERVAL_THRESHOLD_SECONDS) {
             failPercentage = mStatisticsFailTotal * 100 / mStatisticsTotal;
+            if (mStatisticsRttCnt > 0) {
+                avgRttMs = static_cast<double>(mStatisticsRttTotalMs) / mStatisticsRttCnt;
+            }
             LOG_DEBUG(sLogger,
                       ("AdjustConcurrency", mDescription)("mStatisticsFailTotal",
                                                           mStatisticsFailTotal)("mStatisticsTotal", mStatisticsTotal));
             mStatisticsTotal = 0;
             mStatisticsFailTotal = 0;
+            mStatisticsRttTotalMs = 0;
+            mStatisticsRttCnt = 0;
             mLastStatisticsTime = currentTime;
             finishStatistics = true;
         }
     }
     if (finishStatistics) {
-        if (failPercentage == 0) {
+        if (mAdaptive && failPercentage <= NO_FALL_BACK_FAIL_PERCENTAGE && avgRttMs > 0.0) {
+            UpdateByGradient(avgRttMs);
+        } else if (failPercentage == 0) {
             // 成功
             Increase();
         } else if (failPercentage <= NO_FALL_BACK_FAIL_PERCENTAGE) {
@@ -24,28 +24,36 @@
 #include <string>
 
 #include "app_config/AppConfig.h"
+#include "monitor/MetricManager.h"
 #include "monitor/metric_constants/MetricConstants.h"
 
 namespace logtail {
+
+// ConcurrencyLimiter limits the number of in-flight requests to a destination.
+//
+// By default, the limit is adjusted by the failure rate of each statistics window: it is increased by 1 when there is
+// no failure, and multiplied by the fall back ratios when there are too many failures.
+//
+// When enable_adaptive_concurrency_limiter is set, the limit is also driven by the response time (gradient mode). The
+// average response time of each window is compared with a long-term baseline, and the limit shrinks by their ratio
+// once the response time exceeds the baseline by the tolerance, i.e. requests begin to queue at the destination.
+// Otherwise the limit grows by the square root of itself, so it converges on the largest in-flight count the
+// destination can take without queueing. Failures still cut the limit multiplicatively as before.
 class ConcurrencyLimiter {
 public:
     ConcurrencyLimiter(const std::string& description,
                        uint32_t maxConcurrency,
                        uint32_t minConcurrency = 1,
                        double concurrencyFastFallBackRatio = 0.5,
-                       double concurrencySlowFallBackRatio = 0.8)
-        : mDescription(description),
-          mMaxConcurrency(maxConcurrency),
-          mMinConcurrency(minConcurrency),
-          mCurrenctConcurrency(maxConcurrency),
-          mConcurrencyFastFallBackRatio(concurrencyFastFallBackRatio),
-          mConcurrencySlowFallBackRatio(concurrencySlowFallBackRatio) {}
+                       double concurrencySlowFallBackRatio = 0.8);
 
     bool IsValidToPop();
     void PostPop();
     void OnSendDone();
 
-    void OnSuccess(std::chrono::system_clock::time_point currentTime);
+    // @param responseTime the response time of the request, 0 means unknown and is not used in gradient mode
+    void OnSuccess(std::chrono::system_clock::time_point currentTime,
+                   std::chrono::milliseconds responseTime = std::chrono::milliseconds::zero());
     void OnFail(std::chrono::system_clock::time_point currentTime);
 
 
@@ -67,11 +75,13 @@ public:
     void SetInSendingCount(uint32_t count);
     uint32_t GetInSendingCount() const;
     uint32_t GetStatisticThreshold() const;
+    double GetLongRttMs() const;
 
 #endif
 
 private:
     const std::string mDescription;
+    const bool mAdaptive = false;
 
     std::atomic_uint32_t mInSendingCnt = 0U;
 
@@ -90,10 +100,23 @@ private:
     std::chrono::system_clock::time_point mLastStatisticsTime;
     uint32_t mStatisticsTotal = 0;
     uint32_t mStatisticsFailTotal = 0;
+    uint64_t mStatisticsRttTotalMs = 0;
+    uint32_t mStatisticsRttCnt = 0;
+
+    // gradient mode only, protected by mLimiterMux
+    double mEstimatedLimit = 0.0;
+    double mLongRttMs = 0.0;
+
+    mutable MetricsRecordRef mMetricsRecordRef;
+    IntGaugePtr mLimit;
+    IntGaugePtr mRttMs;
 
     void Increase();
     void Decrease(double fallBackRatio);
-    void AdjustConcurrency(bool success, std::chrono::system_clock::time_point currentTime);
+    void UpdateByGradient(double sampleRttMs);
+    void AdjustConcurrency(bool success,
+                           std::chrono::system_clock::time_point currentTime,
+                           std::chrono::milliseconds responseTime);
 };
 
 } // namespace logtail
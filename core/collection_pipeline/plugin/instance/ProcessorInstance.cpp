@@ -43,13 +43,13 @@ bool ProcessorInstance::Init(const Json::Value& config, CollectionPipelineContex
     return true;
 }
 
-void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
+void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList, bool partial) {
     if (eventGroupList.empty()) {
         return;
     }
     for (const auto& eventGroup : eventGroupList) {
         ADD_COUNTER(mInEventsTotal, eventGroup.GetEvents().size());
-        ADD_COUNTER(mInSizeBytes, eventGroup.DataSize());
+        ADD_COUNTER(mInSizeBytes, partial ? eventGroup.EventsDataSize() : eventGroup.DataSize());
     }
 
     auto before = chrono::system_clock::now();
@@ -58,7 +58,7 @@ void ProcessorInstance::Process(vector<PipelineEventGroup>& eventGroupList) {
 
     for (const auto& eventGroup : eventGroupList) {
         ADD_COUNTER(mOutEventsTotal, eventGroup.GetEvents().size());
-        ADD_COUNTER(mOutSizeBytes, eventGroup.DataSize());
+        ADD_COUNTER(mOutSizeBytes, partial ? eventGroup.EventsDataSize() : eventGroup.DataSize());
     }
 }
 
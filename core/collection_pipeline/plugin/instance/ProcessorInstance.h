@@ -35,7 +35,10 @@ public:
     const std::string& Name() const override { return mPlugin->Name(); };
 
     bool Init(const Json::Value& config, CollectionPipelineContext& context);
-    void Process(std::vector<PipelineEventGroup>& logGroupList);
+    // If partial is true, the groups are parts of larger groups, and group level data such as tags has been counted
+    // in metrics with another part, so only the events are counted.
+    void Process(std::vector<PipelineEventGroup>& logGroupList, bool partial = false);
+    bool SupportFusedProcessing() const { return mPlugin->SupportFusedProcessing(); }
 
 private:
     std::unique_ptr<Processor> mPlugin;
@@ -30,6 +30,9 @@ public:
 
     virtual bool Init(const Json::Value& config) = 0;
     virtual void Process(std::vector<PipelineEventGroup>& logGroupList);
+    // Whether each event is processed independently without touching group level data, so that the processor can be
+    // run on blocks of events of a group, fused with its neighbouring processors.
+    virtual bool SupportFusedProcessing() const { return false; }
 
 protected:
     virtual bool IsSupportedEvent(const PipelineEventPtr& e) const = 0;
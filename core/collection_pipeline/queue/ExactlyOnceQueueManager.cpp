@@ -14,8 +14,10 @@
 
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 
+#include "checkpoint/CheckpointManagerV2.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
+#include "collection_pipeline/queue/SLSSenderQueueItem.h"
 #include "common/Flags.h"
 #include "common/TimeUtil.h"
 #include "logger/Logger.h"
@@ -179,9 +181,22 @@ int ExactlyOnceQueueManager::PushSenderQueue(QueueKey key, unique_ptr<SenderQueu
 }
 
 void ExactlyOnceQueueManager::GetAvailableSenderQueueItems(std::vector<SenderQueueItem*>& item, int32_t itemsCntLimit) {
-    lock_guard<mutex> lock(mSenderQueueMux);
-    for (auto iter = mSenderQueues.begin(); iter != mSenderQueues.end(); ++iter) {
-        iter->second.GetAvailableItems(item, itemsCntLimit);
+    uint64_t maxWriteSeq = 0;
+    {
+        lock_guard<mutex> lock(mSenderQueueMux);
+        const size_t startIdx = item.size();
+        for (auto iter = mSenderQueues.begin(); iter != mSenderQueues.end(); ++iter) {
+            iter->second.GetAvailableItems(item, itemsCntLimit);
+        }
+        for (size_t idx = startIdx; idx < item.size(); ++idx) {
+            const auto& cpt = static_cast<SLSSenderQueueItem*>(item[idx])->mExactlyOnceCheckpoint;
+            maxWriteSeq = max(maxWriteSeq, cpt->GetWriteSeq());
+        }
+    }
+    // Prepared checkpoints must be durable before their data is sent. They are flushed as one group outside the
+    // lock, so that pushing to and popping from the queues are not blocked by disk io.
+    if (maxWriteSeq > 0) {
+        CheckpointManagerV2::GetInstance()->FlushPendingWrites(maxWriteSeq);
     }
 }
 
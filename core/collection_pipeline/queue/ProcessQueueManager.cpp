@@ -14,6 +14,7 @@
 
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 
+#include "app_config/AppConfig.h"
 #include "collection_pipeline/queue/BoundedProcessQueue.h"
 #include "collection_pipeline/queue/CircularProcessQueue.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
@@ -21,6 +22,9 @@
 #include "common/Flags.h"
 
 DEFINE_FLAG_INT32(bounded_process_queue_capacity, "", 5);
+DEFINE_FLAG_BOOL(enable_sharded_process_queue_scheduling,
+                 "each processor thread owns a shard of process queues and steals from others when idle",
+                 false);
 
 DECLARE_FLAG_INT32(process_thread_count);
 
@@ -28,8 +32,22 @@ using namespace std;
 
 namespace logtail {
 
+ProcessQueueManager::ProcessQueueShard::ProcessQueueShard() {
+    for (size_t i = 0; i <= sMaxPriority; ++i) {
+        mCurrentQueue[i] = mQueues[i].end();
+    }
+}
+
 ProcessQueueManager::ProcessQueueManager() : mBoundedQueueParam(INT32_FLAG(bounded_process_queue_capacity)) {
     ResetCurrentQueueIndex();
+    mShardedScheduling = BOOL_FLAG(enable_sharded_process_queue_scheduling);
+    InitShards(static_cast<uint32_t>(max(1, AppConfig::GetInstance()->GetProcessThreadCount())));
+}
+
+void ProcessQueueManager::Feedback(QueueKey key) {
+    // the key belongs to the downstream sender queue, so all shards have to be rescanned
+    SetShardsReady();
+    Trigger();
 }
 
 bool ProcessQueueManager::CreateOrUpdateBoundedQueue(QueueKey key,
@@ -71,7 +89,10 @@ bool ProcessQueueManager::CreateOrUpdateCircularQueue(QueueKey key,
             DeleteQueueEntity(iter->second.first);
             CreateCircularQueue(key, priority, capacity, ctx);
         } else {
-            static_cast<CircularProcessQueue*>(iter->second.first->get())->Reset(capacity);
+            {
+                auto shardLock = LockShard(key);
+                static_cast<CircularProcessQueue*>(iter->second.first->get())->Reset(capacity);
+            }
             if ((*iter->second.first)->GetPriority() == priority) {
                 return false;
             }
@@ -99,9 +120,22 @@ bool ProcessQueueManager::DeleteQueue(QueueKey key) {
 }
 
 bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
+    if (mShardedScheduling) {
+        auto* shard = GetShard(key);
+        lock_guard<mutex> shardLock(shard->mMux);
+        auto iter = shard->mQueueMap.find(key);
+        if (iter != shard->mQueueMap.end()) {
+            if (iter->second.second == QueueType::BOUNDED) {
+                return static_cast<BoundedProcessQueue*>(iter->second.first)->IsValidToPush();
+            }
+            return true;
+        }
+        return ExactlyOnceQueueManager::GetInstance()->IsValidToPushProcessQueue(key);
+    }
     lock_guard<mutex> lock(mQueueMux);
     auto iter = mQueues.find(key);
     if (iter != mQueues.end()) {
+        auto shardLock = LockShard(key);
         if (iter->second.second == QueueType::BOUNDED) {
             return static_cast<BoundedProcessQueue*>(iter->second.first->get())->IsValidToPush();
         } else {
@@ -112,6 +146,20 @@ bool ProcessQueueManager::IsValidToPush(QueueKey key) const {
 }
 
 QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueueItem>&& item) {
+    if (mShardedScheduling) {
+        auto* shard = GetShard(key);
+        unique_lock<mutex> shardLock(shard->mMux);
+        auto iter = shard->mQueueMap.find(key);
+        if (iter != shard->mQueueMap.end()) {
+            if (!iter->second.first->Push(std::move(item))) {
+                return QueueStatus::QUEUE_FULL;
+            }
+            shard->mReadyMask.fetch_or(1U << iter->second.first->GetPriority());
+            shardLock.unlock();
+            Trigger();
+            return QueueStatus::OK;
+        }
+    }
     {
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
@@ -130,8 +178,23 @@ QueueStatus ProcessQueueManager::PushQueue(QueueKey key, unique_ptr<ProcessQueue
     return QueueStatus::OK;
 }
 
-bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
+bool ProcessQueueManager::PopItem(int64_t threadNo,
+                                  unique_ptr<ProcessQueueItem>& item,
+                                  string& configName,
+                                  bool* isStolen) {
     configName.clear();
+    if (isStolen != nullptr) {
+        *isStolen = false;
+    }
+    bool res = mShardedScheduling ? PopItemFromShards(threadNo, item, configName, isStolen)
+                                  : PopItemFromQueues(threadNo, item, configName);
+    if (res) {
+        NotifyPop();
+    }
+    return res;
+}
+
+bool ProcessQueueManager::PopItemFromQueues(int64_t threadNo, unique_ptr<ProcessQueueItem>& item, string& configName) {
     lock_guard<mutex> lock(mQueueMux);
     for (size_t i = 0; i <= sMaxPriority; ++i) {
         ProcessQueueIterator iter;
@@ -170,22 +233,9 @@ bool ProcessQueueManager::PopItem(int64_t threadNo, unique_ptr<ProcessQueueItem>
             return true;
         }
         // find exactly once queues next
-        {
-            lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
-            for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].begin();
-                 iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[i].end();
-                 ++iter) {
-                // process queue for exactly once can only be assgined to one specific thread
-                if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
-                    continue;
-                }
-                if (!iter->Pop(item)) {
-                    continue;
-                }
-                configName = iter->GetConfigName();
-                ResetCurrentQueueIndex();
-                return true;
-            }
+        if (PopExactlyOnceItem(threadNo, i, item, configName)) {
+            ResetCurrentQueueIndex();
+            return true;
         }
     }
     ResetCurrentQueueIndex();
@@ -200,6 +250,7 @@ bool ProcessQueueManager::IsAllQueueEmpty() const {
     {
         lock_guard<mutex> lock(mQueueMux);
         for (const auto& q : mQueues) {
+            auto shardLock = LockShard(q.first);
             if (!(*q.second.first)->Empty()) {
                 return false;
             }
@@ -214,6 +265,7 @@ bool ProcessQueueManager::SetDownStreamQueues(QueueKey key, vector<BoundedSender
     if (iter == mQueues.end()) {
         return false;
     }
+    auto shardLock = LockShard(key);
     (*iter->second.first)->SetDownStreamQueues(std::move(ques));
     return true;
 }
@@ -227,6 +279,7 @@ bool ProcessQueueManager::SetFeedbackInterface(QueueKey key, vector<FeedbackInte
     if (iter->second.second == QueueType::CIRCULAR) {
         return false;
     }
+    auto shardLock = LockShard(key);
     static_cast<BoundedProcessQueue*>(iter->second.first->get())->SetUpStreamFeedbacks(std::move(feedback));
     return true;
 }
@@ -237,6 +290,7 @@ void ProcessQueueManager::DisablePop(const string& configName, bool isPipelineRe
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            auto shardLock = LockShard(key);
             (*iter->second.first)->DisablePop();
         }
     } else {
@@ -250,8 +304,10 @@ void ProcessQueueManager::EnablePop(const string& configName) {
         lock_guard<mutex> lock(mQueueMux);
         auto iter = mQueues.find(key);
         if (iter != mQueues.end()) {
+            auto shardLock = LockShard(key);
             (*iter->second.first)->EnablePop();
         }
+        SetShardsReady();
     } else {
         ExactlyOnceQueueManager::GetInstance()->EnablePopProcessQueue(configName);
     }
@@ -271,11 +327,28 @@ bool ProcessQueueManager::Wait(uint64_t ms) {
 void ProcessQueueManager::Trigger() {
     {
         lock_guard<mutex> lock(mStateMux);
+        ++mTriggerVersion;
         mValidToPop = true;
     }
     mCond.notify_one();
 }
 
+void ProcessQueueManager::WaitForPop(uint64_t version, uint64_t ms) {
+    unique_lock<mutex> lock(mPopMux);
+    ++mPopWaiterCnt;
+    mPopCond.wait_for(lock, chrono::milliseconds(ms), [this, version] { return mPopVersion.load() != version; });
+    --mPopWaiterCnt;
+}
+
+void ProcessQueueManager::NotifyPop() {
+    ++mPopVersion;
+    // the waiter count is increased before the version is checked, so no waiter can miss the new version
+    if (mPopWaiterCnt.load() > 0) {
+        lock_guard<mutex> lock(mPopMux);
+        mPopCond.notify_all();
+    }
+}
+
 void ProcessQueueManager::CreateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx) {
     mPriorityQueue[priority].emplace_back(make_unique<BoundedProcessQueue>(mBoundedQueueParam.GetCapacity(),
                                                                            mBoundedQueueParam.GetLowWatermark(),
@@ -284,6 +357,8 @@ void ProcessQueueManager::CreateBoundedQueue(QueueKey key, uint32_t priority, co
                                                                            priority,
                                                                            ctx));
     mQueues[key] = make_pair(prev(mPriorityQueue[priority].end()), QueueType::BOUNDED);
+    auto shardLock = LockShard(key);
+    AddQueueToShard(mPriorityQueue[priority].back().get());
 }
 
 void ProcessQueueManager::CreateCircularQueue(QueueKey key,
@@ -292,13 +367,22 @@ void ProcessQueueManager::CreateCircularQueue(QueueKey key,
                                               const CollectionPipelineContext& ctx) {
     mPriorityQueue[priority].emplace_back(make_unique<CircularProcessQueue>(capacity, key, priority, ctx));
     mQueues[key] = make_pair(prev(mPriorityQueue[priority].end()), QueueType::CIRCULAR);
+    auto shardLock = LockShard(key);
+    AddQueueToShard(mPriorityQueue[priority].back().get());
 }
 
 void ProcessQueueManager::AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority) {
     uint32_t oldPriority = (*iter)->GetPriority();
     auto nextQueIter = next(iter);
     mPriorityQueue[priority].splice(mPriorityQueue[priority].end(), mPriorityQueue[oldPriority], iter);
-    (*iter)->SetPriority(priority);
+    if (mShardedScheduling) {
+        auto shardLock = LockShard((*iter)->GetKey());
+        RemoveQueueFromShard(iter->get());
+        (*iter)->SetPriority(priority);
+        AddQueueToShard(iter->get());
+    } else {
+        (*iter)->SetPriority(priority);
+    }
     if (mCurrentQueueIndex.first == oldPriority && mCurrentQueueIndex.second == iter) {
         if (nextQueIter == mPriorityQueue[oldPriority].end()) {
             mCurrentQueueIndex.second = mPriorityQueue[oldPriority].begin();
@@ -310,6 +394,10 @@ void ProcessQueueManager::AdjustQueuePriority(const ProcessQueueIterator& iter,
 
 void ProcessQueueManager::DeleteQueueEntity(const ProcessQueueIterator& iter) {
     uint32_t priority = (*iter)->GetPriority();
+    if (mShardedScheduling) {
+        auto shardLock = LockShard((*iter)->GetKey());
+        RemoveQueueFromShard(iter->get());
+    }
     auto nextQueIter = mPriorityQueue[priority].erase(iter);
     if (mCurrentQueueIndex.first == priority && mCurrentQueueIndex.second == iter) {
         if (nextQueIter == mPriorityQueue[priority].end()) {
@@ -325,6 +413,166 @@ void ProcessQueueManager::ResetCurrentQueueIndex() {
     mCurrentQueueIndex.second = mPriorityQueue[0].begin();
 }
 
+bool ProcessQueueManager::PopExactlyOnceItem(int64_t threadNo,
+                                             uint32_t priority,
+                                             unique_ptr<ProcessQueueItem>& item,
+                                             string& configName) {
+    lock_guard<mutex> lock(ExactlyOnceQueueManager::GetInstance()->mProcessQueueMux);
+    for (auto iter = ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].begin();
+         iter != ExactlyOnceQueueManager::GetInstance()->mProcessPriorityQueue[priority].end();
+         ++iter) {
+        // process queue for exactly once can only be assgined to one specific thread
+        if (iter->GetKey() % INT32_FLAG(process_thread_count) != threadNo) {
+            continue;
+        }
+        if (!iter->Pop(item)) {
+            continue;
+        }
+        configName = iter->GetConfigName();
+        return true;
+    }
+    return false;
+}
+
+void ProcessQueueManager::InitShards(uint32_t shardCnt) {
+    mShards.clear();
+    for (uint32_t i = 0; i < shardCnt; ++i) {
+        mShards.emplace_back(make_unique<ProcessQueueShard>());
+    }
+}
+
+ProcessQueueManager::ProcessQueueShard* ProcessQueueManager::GetShard(QueueKey key) const {
+    return mShards[static_cast<size_t>(key) % mShards.size()].get();
+}
+
+unique_lock<mutex> ProcessQueueManager::LockShard(QueueKey key) const {
+    if (!mShardedScheduling) {
+        return unique_lock<mutex>();
+    }
+    return unique_lock<mutex>(GetShard(key)->mMux);
+}
+
+// queue lock and shard lock should be held by the caller
+void ProcessQueueManager::AddQueueToShard(ProcessQueueInterface* que) {
+    if (!mShardedScheduling) {
+        return;
+    }
+    auto shard = GetShard(que->GetKey());
+    shard->mQueueMap[que->GetKey()] = make_pair(que, mQueues.at(que->GetKey()).second);
+    auto& queues = shard->mQueues[que->GetPriority()];
+    queues.push_back(que);
+    if (shard->mCurrentQueue[que->GetPriority()] == queues.end()) {
+        shard->mCurrentQueue[que->GetPriority()] = queues.begin();
+    }
+    shard->mReadyMask.fetch_or(1U << que->GetPriority());
+}
+
+// shard lock should be held by the caller
+void ProcessQueueManager::RemoveQueueFromShard(ProcessQueueInterface* que) {
+    auto shard = GetShard(que->GetKey());
+    shard->mQueueMap.erase(que->GetKey());
+    uint32_t priority = que->GetPriority();
+    auto& queues = shard->mQueues[priority];
+    for (auto iter = queues.begin(); iter != queues.end(); ++iter) {
+        if (*iter != que) {
+            continue;
+        }
+        bool isCurrent = shard->mCurrentQueue[priority] == iter;
+        auto nextQueIter = queues.erase(iter);
+        if (isCurrent) {
+            shard->mCurrentQueue[priority] = nextQueIter == queues.end() ? queues.begin() : nextQueIter;
+        }
+        return;
+    }
+}
+
+void ProcessQueueManager::SetShardsReady() {
+    if (!mShardedScheduling) {
+        return;
+    }
+    for (auto& shard : mShards) {
+        shard->mReadyMask.store((1U << (sMaxPriority + 1)) - 1);
+    }
+}
+
+bool ProcessQueueManager::PopItemFromShards(int64_t threadNo,
+                                            unique_ptr<ProcessQueueItem>& item,
+                                            string& configName,
+                                            bool* isStolen) {
+    uint64_t triggerVersion = mTriggerVersion.load();
+    size_t ownIdx = static_cast<size_t>(threadNo) % mShards.size();
+    for (uint32_t i = 0; i <= sMaxPriority; ++i) {
+        // the shard owned by the thread goes first
+        auto& ownShard = *mShards[ownIdx];
+        if (ownShard.mReadyMask.load() & (1U << i)) {
+            lock_guard<mutex> lock(ownShard.mMux);
+            if (PopItemFromShard(ownShard, i, item, configName)) {
+                return true;
+            }
+        }
+        // then steal from other shards with the same priority, busy shards are skipped to avoid contention
+        for (size_t j = 1; j < mShards.size(); ++j) {
+            auto& shard = *mShards[(ownIdx + j) % mShards.size()];
+            if (!(shard.mReadyMask.load() & (1U << i))) {
+                continue;
+            }
+            unique_lock<mutex> lock(shard.mMux, try_to_lock);
+            if (!lock.owns_lock()) {
+                continue;
+            }
+            if (PopItemFromShard(shard, i, item, configName)) {
+                if (isStolen != nullptr) {
+                    *isStolen = true;
+                }
+                return true;
+            }
+        }
+        // exactly once queues are always pinned to one thread, so they are never stolen
+        if (PopExactlyOnceItem(threadNo, i, item, configName)) {
+            return true;
+        }
+    }
+    {
+        unique_lock<mutex> lock(mStateMux);
+        // the scan is done without the state lock, a trigger during it may be for an item the scan has missed
+        if (mTriggerVersion.load() == triggerVersion) {
+            mValidToPop = false;
+        }
+    }
+    return false;
+}
+
+// shard lock should be held by the caller
+bool ProcessQueueManager::PopItemFromShard(ProcessQueueShard& shard,
+                                           uint32_t priority,
+                                           unique_ptr<ProcessQueueItem>& item,
+                                           string& configName) {
+    // ready bit is cleared before scanning, so that any feedback arriving during the scan will set it again
+    shard.mReadyMask.fetch_and(~(1U << priority));
+    auto& queues = shard.mQueues[priority];
+    if (queues.empty()) {
+        return false;
+    }
+    auto& cur = shard.mCurrentQueue[priority];
+    if (cur == queues.end()) {
+        cur = queues.begin();
+    }
+    auto iter = cur;
+    do {
+        if ((*iter)->Pop(item)) {
+            configName = (*iter)->GetConfigName();
+            cur = ++iter == queues.end() ? queues.begin() : iter;
+            // the queue may still have more items
+            shard.mReadyMask.fetch_or(1U << priority);
+            return true;
+        }
+        if (++iter == queues.end()) {
+            iter = queues.begin();
+        }
+    } while (iter != cur);
+    return false;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void ProcessQueueManager::Clear() {
     lock_guard<mutex> lock(mQueueMux);
@@ -333,6 +581,7 @@ void ProcessQueueManager::Clear() {
         mPriorityQueue[i].clear();
     }
     ResetCurrentQueueIndex();
+    InitShards(static_cast<uint32_t>(mShards.size()));
 }
 #endif
 
@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <condition_variable>
 #include <list>
 #include <memory>
@@ -53,7 +54,7 @@ public:
         return &instance;
     }
 
-    void Feedback(QueueKey key) override { Trigger(); }
+    void Feedback(QueueKey key) override;
 
     bool CreateOrUpdateBoundedQueue(QueueKey key, uint32_t priority, const CollectionPipelineContext& ctx);
     bool
@@ -62,7 +63,11 @@ public:
     bool IsValidToPush(QueueKey key) const;
     // 0: success, 1: queue is full, 2: queue not found
     QueueStatus PushQueue(QueueKey key, std::unique_ptr<ProcessQueueItem>&& item);
-    bool PopItem(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    // isStolen is set to true when the item is taken from a shard not owned by the thread (sharded scheduling only)
+    bool PopItem(int64_t threadNo,
+                 std::unique_ptr<ProcessQueueItem>& item,
+                 std::string& configName,
+                 bool* isStolen = nullptr);
     bool IsAllQueueEmpty() const;
     bool SetDownStreamQueues(QueueKey key, std::vector<BoundedSenderQueueInterface*>&& ques);
     bool SetFeedbackInterface(QueueKey key, std::vector<FeedbackInterface*>&& feedback);
@@ -72,7 +77,26 @@ public:
     bool Wait(uint64_t ms);
     void Trigger();
 
+    // Producers blocked by a full queue should get the version before pushing, and wait with it after the push fails,
+    // so that they are woken up as soon as any item is popped, including the ones popped before waiting.
+    uint64_t GetPopVersion() const { return mPopVersion.load(); }
+    void WaitForPop(uint64_t version, uint64_t ms);
+
 private:
+    // In sharded scheduling mode, each processor thread owns the queues whose key is mapped to its shard. Queue
+    // operations only need the shard lock, and the ready state of each priority is kept in an atomic bitmask so that
+    // threads can skip shards with nothing to pop without taking any lock.
+    struct ProcessQueueShard {
+        ProcessQueueShard();
+
+        std::mutex mMux;
+        // queues of the shard by key, so that push does not need the global queue lock
+        std::unordered_map<QueueKey, std::pair<ProcessQueueInterface*, QueueType>> mQueueMap;
+        std::list<ProcessQueueInterface*> mQueues[sMaxPriority + 1];
+        std::list<ProcessQueueInterface*>::iterator mCurrentQueue[sMaxPriority + 1];
+        std::atomic_uint32_t mReadyMask{0};
+    };
+
     ProcessQueueManager();
     ~ProcessQueueManager() = default;
 
@@ -81,6 +105,27 @@ private:
     void AdjustQueuePriority(const ProcessQueueIterator& iter, uint32_t priority);
     void DeleteQueueEntity(const ProcessQueueIterator& iter);
     void ResetCurrentQueueIndex();
+    bool PopItemFromQueues(int64_t threadNo, std::unique_ptr<ProcessQueueItem>& item, std::string& configName);
+    void NotifyPop();
+    bool PopExactlyOnceItem(int64_t threadNo,
+                            uint32_t priority,
+                            std::unique_ptr<ProcessQueueItem>& item,
+                            std::string& configName);
+
+    void InitShards(uint32_t shardCnt);
+    ProcessQueueShard* GetShard(QueueKey key) const;
+    std::unique_lock<std::mutex> LockShard(QueueKey key) const;
+    void AddQueueToShard(ProcessQueueInterface* que);
+    void RemoveQueueFromShard(ProcessQueueInterface* que);
+    void SetShardsReady();
+    bool PopItemFromShards(int64_t threadNo,
+                           std::unique_ptr<ProcessQueueItem>& item,
+                           std::string& configName,
+                           bool* isStolen);
+    bool PopItemFromShard(ProcessQueueShard& shard,
+                          uint32_t priority,
+                          std::unique_ptr<ProcessQueueItem>& item,
+                          std::string& configName);
 
     BoundedQueueParam mBoundedQueueParam;
 
@@ -89,9 +134,20 @@ private:
     std::list<std::unique_ptr<ProcessQueueInterface>> mPriorityQueue[sMaxPriority + 1];
     std::pair<uint32_t, ProcessQueueIterator> mCurrentQueueIndex;
 
+    bool mShardedScheduling = false;
+    std::vector<std::unique_ptr<ProcessQueueShard>> mShards;
+
     mutable std::mutex mStateMux;
     mutable std::condition_variable mCond;
     bool mValidToPop = false;
+    // increased by each Trigger, so that a lock-free scan which finds nothing does not reset a trigger arriving during
+    // the scan
+    std::atomic_uint64_t mTriggerVersion{0};
+
+    std::mutex mPopMux;
+    std::condition_variable mPopCond;
+    std::atomic_uint64_t mPopVersion{0};
+    std::atomic_uint32_t mPopWaiterCnt{0};
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
@@ -15,6 +15,8 @@
 #include "collection_pipeline/serializer/SLSSerializer.h"
 
 #include <array>
+#include <chrono>
+#include <cstdio>
 #include <vector>
 
 #include "json/json.h"
@@ -28,6 +30,9 @@
 #include "plugin/flusher/sls/FlusherSLS.h"
 
 DEFINE_FLAG_BOOL(debug_sls_serializer, "", false);
+DEFINE_FLAG_INT32(sls_serializer_chunk_size,
+                  "size of each chunk handed over to the compressor when serializing and compressing at the same time",
+                  64 * 1024);
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
 
@@ -58,40 +63,148 @@ std::string SerializeSpanEventsToString(const SpanEvent& event) {
     return Json::writeString(writer, jsonEvents);
 }
 
+void MetricEventContentCache::Reset(size_t eventCnt) {
+    mValues.clear();
+    mValueEnds.clear();
+    mEventBegins.clear();
+    mEventBegins.reserve(eventCnt + 1);
+    mLabelSizes.clear();
+    mLabelSizes.reserve(eventCnt);
+}
+
+void MetricEventContentCache::StartEvent() {
+    mEventBegins.push_back(static_cast<uint32_t>(mValueEnds.size()));
+    mLabelSizes.push_back(0);
+}
+
+void MetricEventContentCache::AddValue(double value) {
+    // same format as std::to_string
+    char buf[64];
+    int len = snprintf(buf, sizeof(buf), "%f", value);
+    if (len >= 0 && static_cast<size_t>(len) < sizeof(buf)) {
+        mValues.append(buf, len);
+    } else {
+        mValues.append(to_string(value));
+    }
+    mValueEnds.push_back(static_cast<uint32_t>(mValues.size()));
+}
+
+StringView MetricEventContentCache::GetValue(size_t eventIdx, size_t valueIdx) const {
+    size_t idx = mEventBegins[eventIdx] + valueIdx;
+    size_t begin = idx == 0 ? 0 : mValueEnds[idx - 1];
+    return StringView(mValues.data() + begin, mValueEnds[idx] - begin);
+}
+
 bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, string& errorMsg) {
+    SerializeContext ctx;
+    if (!CalculateLogGroupSize(group, ctx, errorMsg)) {
+        return false;
+    }
+
+    thread_local LogGroupSerializer serializer;
+    serializer.Prepare(ctx.mLogGroupSZ);
+    SerializeLogGroup(serializer, group, ctx);
+    res = std::move(serializer.GetResult());
+
+    // when function stablize, remove the following logic
+    if (BOOL_FLAG(debug_sls_serializer)) {
+        sls_logs::LogGroup logGroup;
+        if (!logGroup.ParseFromString(res)) {
+            JsonEventGroupSerializer ser(const_cast<Flusher*>(mFlusher));
+            string jsonStr;
+            ser.DoSerialize(std::move(group), jsonStr, errorMsg);
+            LOG_ERROR(sLogger,
+                      ("failed to parse log group", jsonStr)("config", mFlusher->GetContext().GetConfigName()));
+            return false;
+        }
+    }
+    return true;
+}
+
+bool SLSEventGroupSerializer::DoSerializeAndCompress(BatchedEvents&& group,
+                                                     Compressor& compressor,
+                                                     string& output,
+                                                     size_t& rawSize,
+                                                     string& errorMsg,
+                                                     bool& compressFailed) {
+    auto inputSize = GetInputSize(group);
+    ADD_COUNTER(mInItemsTotal, 1);
+    ADD_COUNTER(mInItemSizeBytes, inputSize);
+
+    compressFailed = false;
+    auto before = chrono::system_clock::now();
+    bool res = false;
+    if (!compressor.IsStreamSupported() || BOOL_FLAG(debug_sls_serializer)) {
+        string serialized;
+        res = Serialize(std::move(group), serialized, errorMsg);
+        if (res) {
+            rawSize = serialized.size();
+            compressFailed = !compressor.DoCompress(serialized, output, errorMsg);
+        }
+    } else {
+        SerializeContext ctx;
+        res = CalculateLogGroupSize(group, ctx, errorMsg);
+        if (res) {
+            rawSize = ctx.mLogGroupSZ;
+            compressFailed = !compressor.DoStartStream(rawSize, output, errorMsg);
+        }
+        if (res && !compressFailed) {
+            thread_local LogGroupSerializer serializer;
+            serializer.PrepareChunks(INT32_FLAG(sls_serializer_chunk_size), [&](StringView chunk) {
+                return compressor.DoAppendStream(chunk, output, errorMsg);
+            });
+            SerializeLogGroup(serializer, group, ctx);
+            compressFailed = !serializer.FinishChunks() || !compressor.DoFinishStream(output, errorMsg);
+        }
+    }
+    ADD_COUNTER(mTotalProcessMs, chrono::system_clock::now() - before);
+
+    if (res) {
+        ADD_COUNTER(mOutItemsTotal, 1);
+        ADD_COUNTER(mOutItemSizeBytes, rawSize);
+    } else {
+        ADD_COUNTER(mDiscardedItemsTotal, 1);
+        ADD_COUNTER(mDiscardedItemSizeBytes, inputSize);
+    }
+    return res && !compressFailed;
+}
+
+bool SLSEventGroupSerializer::CalculateLogGroupSize(const BatchedEvents& group,
+                                                    SerializeContext& ctx,
+                                                    string& errorMsg) const {
     if (group.mEvents.empty()) {
         errorMsg = "empty event group";
         return false;
     }
 
-    PipelineEvent::Type eventType = group.mEvents[0]->GetType();
-    if (eventType == PipelineEvent::Type::NONE) {
+    ctx.mEventType = group.mEvents[0]->GetType();
+    if (ctx.mEventType == PipelineEvent::Type::NONE) {
         // should not happen
         errorMsg = "unsupported event type in event group";
         return false;
     }
 
-    bool enableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
+    ctx.mEnableNs = mFlusher->GetContext().GetGlobalConfig().mEnableTimestampNanosecond;
 
     // caculate serialized logGroup size first, where some critical results can be cached
-    vector<size_t> logSZ(group.mEvents.size());
-    vector<MetricEventContentCacheItem> metricEventContentCache(group.mEvents.size());
-    vector<array<string, 6>> spanEventContentCache(group.mEvents.size());
-    size_t logGroupSZ = 0;
-    switch (eventType) {
+    ctx.mLogSZ.resize(group.mEvents.size());
+    size_t& logGroupSZ = ctx.mLogGroupSZ;
+    switch (ctx.mEventType) {
         case PipelineEvent::Type::LOG: {
-            CalculateLogEventSize(group, logGroupSZ, logSZ, enableNs);
+            CalculateLogEventSize(group, logGroupSZ, ctx.mLogSZ, ctx.mEnableNs);
             break;
         }
         case PipelineEvent::Type::METRIC: {
-            CalculateMetricEventSize(group, logGroupSZ, metricEventContentCache, logSZ);
+            ctx.mMetricEventContentCache.Reset(group.mEvents.size());
+            CalculateMetricEventSize(group, logGroupSZ, ctx.mMetricEventContentCache, ctx.mLogSZ);
             break;
         }
         case PipelineEvent::Type::SPAN:
-            CalculateSpanEventSize(group, logGroupSZ, spanEventContentCache, logSZ);
+            ctx.mSpanEventContentCache.resize(group.mEvents.size());
+            CalculateSpanEventSize(group, logGroupSZ, ctx.mSpanEventContentCache, ctx.mLogSZ);
             break;
         case PipelineEvent::Type::RAW:
-            CalculateRawEventSize(group, logGroupSZ, logSZ, enableNs);
+            CalculateRawEventSize(group, logGroupSZ, ctx.mLogSZ, ctx.mEnableNs);
             break;
         default:
             break;
@@ -116,21 +229,24 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             + "\tsize limit: " + ToString(INT32_FLAG(max_send_log_group_size));
         return false;
     }
+    return true;
+}
 
-    thread_local LogGroupSerializer serializer;
-    serializer.Prepare(logGroupSZ);
-    switch (eventType) {
+void SLSEventGroupSerializer::SerializeLogGroup(LogGroupSerializer& serializer,
+                                                BatchedEvents& group,
+                                                SerializeContext& ctx) const {
+    switch (ctx.mEventType) {
         case PipelineEvent::Type::LOG:
-            SerializeLogEvent(serializer, group, logSZ, enableNs);
+            SerializeLogEvent(serializer, group, ctx.mLogSZ, ctx.mEnableNs);
             break;
         case PipelineEvent::Type::METRIC:
-            SerializeMetricEvent(serializer, group, metricEventContentCache, logSZ);
+            SerializeMetricEvent(serializer, group, ctx.mMetricEventContentCache, ctx.mLogSZ);
             break;
         case PipelineEvent::Type::SPAN:
-            SerializeSpanEvent(serializer, group, spanEventContentCache, logSZ);
+            SerializeSpanEvent(serializer, group, ctx.mSpanEventContentCache, ctx.mLogSZ);
             break;
         case PipelineEvent::Type::RAW:
-            SerializeRawEvent(serializer, group, logSZ, enableNs);
+            SerializeRawEvent(serializer, group, ctx.mLogSZ, ctx.mEnableNs);
             break;
         default:
             break;
@@ -146,21 +262,6 @@ bool SLSEventGroupSerializer::Serialize(BatchedEvents&& group, string& res, stri
             serializer.AddLogTag(tag.first, tag.second);
         }
     }
-    res = std::move(serializer.GetResult());
-
-    // when function stablize, remove the following logic
-    if (BOOL_FLAG(debug_sls_serializer)) {
-        sls_logs::LogGroup logGroup;
-        if (!logGroup.ParseFromString(res)) {
-            JsonEventGroupSerializer ser(const_cast<Flusher*>(mFlusher));
-            string jsonStr;
-            ser.DoSerialize(std::move(group), jsonStr, errorMsg);
-            LOG_ERROR(sLogger,
-                      ("failed to parse log group", jsonStr)("config", mFlusher->GetContext().GetConfigName()));
-            return false;
-        }
-    }
-    return true;
 }
 
 void SLSEventGroupSerializer::CalculateLogEventSize(const BatchedEvents& group,
@@ -183,10 +284,11 @@ void SLSEventGroupSerializer::CalculateLogEventSize(const BatchedEvents& group,
 void SLSEventGroupSerializer::CalculateMetricEventSize(
     const BatchedEvents& group,
     size_t& logGroupSZ,
-    std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+    MetricEventContentCache& metricEventContentCache,
     std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         const auto& e = group.mEvents[i].Cast<MetricEvent>();
+        metricEventContentCache.StartEvent();
         if (e.GetTimestamp() < 1e9) {
             LOG_WARNING(sLogger,
                         ("metric event timestamp is less than 1e9", "discard event")("timestamp", e.GetTimestamp())(
@@ -194,16 +296,15 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
             continue;
         }
         if (e.Is<UntypedSingleValue>()) {
-            metricEventContentCache[i].mMetricEventContentCache.push_back(
-                to_string(e.GetValue<UntypedSingleValue>()->mValue));
-            metricEventContentCache[i].mLabelSize = GetMetricLabelSize(e);
+            metricEventContentCache.AddValue(e.GetValue<UntypedSingleValue>()->mValue);
+            metricEventContentCache.SetLabelSize(GetMetricLabelSize(e));
             size_t contentSZ = 0;
             contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_NAME.size(), e.GetName().size());
             contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_VALUE.size(),
-                                           metricEventContentCache[i].mMetricEventContentCache[0].size());
+                                           metricEventContentCache.GetValue(i, 0).size());
             contentSZ
                 += GetLogContentSize(METRIC_RESERVED_KEY_TIME_NANO.size(), e.GetTimestampNanosecond() ? 19U : 10U);
-            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), metricEventContentCache[i].mLabelSize);
+            contentSZ += GetLogContentSize(METRIC_RESERVED_KEY_LABELS.size(), metricEventContentCache.GetLabelSize(i));
             logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
         } else if (e.Is<UntypedMultiDoubleValues>()) {
             if (e.GetValue<UntypedMultiDoubleValues>()->ValuesSize() == 0) {
@@ -220,10 +321,10 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
                 contentSZ += GetLogContentSize(it->first.size(), it->second.size());
             }
             const auto* const multiValue = e.GetValue<UntypedMultiDoubleValues>();
-            for (auto it = multiValue->ValuesBegin(); it != multiValue->ValuesEnd(); ++it) {
-                string valueStr = to_string(it->second.Value);
-                metricEventContentCache[i].mMetricEventContentCache.push_back(valueStr); // value
-                contentSZ += GetLogContentSize(it->first.size(), valueStr.size());
+            size_t valueIdx = 0;
+            for (auto it = multiValue->ValuesBegin(); it != multiValue->ValuesEnd(); ++it, ++valueIdx) {
+                metricEventContentCache.AddValue(it->second.Value);
+                contentSZ += GetLogContentSize(it->first.size(), metricEventContentCache.GetValue(i, valueIdx).size());
             }
             logGroupSZ += GetLogSize(contentSZ, false, logSZ[i]);
         } else {
@@ -233,6 +334,7 @@ void SLSEventGroupSerializer::CalculateMetricEventSize(
             continue;
         }
     }
+    metricEventContentCache.Finish();
 }
 
 void SLSEventGroupSerializer::CalculateSpanEventSize(const BatchedEvents& group,
@@ -335,7 +437,7 @@ void SLSEventGroupSerializer::SerializeLogEvent(LogGroupSerializer& serializer,
 //      value2: 456
 void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serializer,
                                                    BatchedEvents& group,
-                                                   std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                                                   MetricEventContentCache& metricEventContentCache,
                                                    std::vector<size_t>& logSZ) const {
     for (size_t i = 0; i < group.mEvents.size(); ++i) {
         auto& e = group.mEvents[i].Cast<MetricEvent>();
@@ -343,7 +445,7 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             continue;
         }
         if (e.Is<UntypedSingleValue>()) {
-            if (metricEventContentCache[i].mMetricEventContentCache.empty()) {
+            if (metricEventContentCache.ValuesSize(i) == 0) {
                 LOG_ERROR(sLogger,
                           ("metric event single value size mismatch", "should never happen")(
                               "config", mFlusher->GetContext().GetConfigName())("expected", 1)("actual", 0));
@@ -352,17 +454,17 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             serializer.StartToAddLog(logSZ[i]);
             serializer.AddLogTime(e.GetTimestamp());
             e.SortTags();
-            serializer.AddLogContentMetricLabel(e, metricEventContentCache[i].mLabelSize);
+            serializer.AddLogContentMetricLabel(e, metricEventContentCache.GetLabelSize(i));
             serializer.AddLogContentMetricTimeNano(e);
-            serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache[i].mMetricEventContentCache[0]);
+            serializer.AddLogContent(METRIC_RESERVED_KEY_VALUE, metricEventContentCache.GetValue(i, 0));
             serializer.AddLogContent(METRIC_RESERVED_KEY_NAME, e.GetName());
         } else if (e.Is<UntypedMultiDoubleValues>()) {
             const auto* const multiValue = e.GetValue<UntypedMultiDoubleValues>();
-            if (metricEventContentCache[i].mMetricEventContentCache.size() != multiValue->ValuesSize()) {
+            if (metricEventContentCache.ValuesSize(i) != multiValue->ValuesSize()) {
                 LOG_ERROR(sLogger,
                           ("metric event multi value size mismatch", "should never happen")(
                               "config", mFlusher->GetContext().GetConfigName())("expected", multiValue->ValuesSize())(
-                              "actual", metricEventContentCache[i].mMetricEventContentCache.size()));
+                              "actual", metricEventContentCache.ValuesSize(i)));
                 continue;
             }
             serializer.StartToAddLog(logSZ[i]);
@@ -373,8 +475,7 @@ void SLSEventGroupSerializer::SerializeMetricEvent(LogGroupSerializer& serialize
             }
             size_t currentValueIdx = 0;
             for (auto it = multiValue->ValuesBegin(); it != multiValue->ValuesEnd(); ++it) {
-                serializer.AddLogContent(it->first,
-                                         metricEventContentCache[i].mMetricEventContentCache[currentValueIdx]);
+                serializer.AddLogContent(it->first, metricEventContentCache.GetValue(i, currentValueIdx));
                 ++currentValueIdx;
             }
         } else {
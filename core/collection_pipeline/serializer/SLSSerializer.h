@@ -16,33 +16,82 @@
 
 #pragma once
 
+#include <array>
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "collection_pipeline/serializer/Serializer.h"
+#include "common/StringView.h"
+#include "common/compression/Compressor.h"
 #include "protobuf/sls/LogGroupSerializer.h"
 
 namespace logtail {
 
-struct MetricEventContentCacheItem {
-    std::vector<std::string> mMetricEventContentCache;
-    size_t mLabelSize = 0;
+// Formatted values and label sizes of all metric events in a group. Values are kept in one contiguous buffer instead
+// of a vector of strings per event, so that calculating the size of a group does not allocate for each sample.
+class MetricEventContentCache {
+public:
+    void Reset(size_t eventCnt);
+    // must be called for each event in order, before its values are added
+    void StartEvent();
+    void SetLabelSize(size_t labelSize) { mLabelSizes.back() = labelSize; }
+    void AddValue(double value);
+    void Finish() { mEventBegins.push_back(static_cast<uint32_t>(mValueEnds.size())); }
+
+    size_t ValuesSize(size_t eventIdx) const { return mEventBegins[eventIdx + 1] - mEventBegins[eventIdx]; }
+    StringView GetValue(size_t eventIdx, size_t valueIdx) const;
+    size_t GetLabelSize(size_t eventIdx) const { return mLabelSizes[eventIdx]; }
+
+private:
+    std::string mValues;
+    // end offset of each value in mValues
+    std::vector<uint32_t> mValueEnds;
+    // index in mValueEnds of the first value of each event, followed by the total number of values
+    std::vector<uint32_t> mEventBegins;
+    std::vector<size_t> mLabelSizes;
 };
 
 class SLSEventGroupSerializer : public Serializer<BatchedEvents> {
 public:
     SLSEventGroupSerializer(Flusher* f) : Serializer<BatchedEvents>(f) {}
 
+    // Serialize and compress the group in one pass. Serialized data is handed over to the compressor chunk by chunk,
+    // so the whole serialized log group is never kept in memory. The output is the same as compressing the result of
+    // DoSerialize with DoCompress. If the compressor does not support stream compression (e.g. lz4, whose block format
+    // can only be produced in one shot), or debug_sls_serializer is enabled, the group is serialized first and then
+    // compressed as a whole.
+    // @param rawSize the size of the serialized log group
+    // @param compressFailed true if the group is serialized but failed to be compressed
+    bool DoSerializeAndCompress(BatchedEvents&& p,
+                                Compressor& compressor,
+                                std::string& output,
+                                size_t& rawSize,
+                                std::string& errorMsg,
+                                bool& compressFailed);
+
 private:
+    struct SerializeContext {
+        PipelineEvent::Type mEventType = PipelineEvent::Type::NONE;
+        bool mEnableNs = false;
+        size_t mLogGroupSZ = 0;
+        std::vector<size_t> mLogSZ;
+        MetricEventContentCache mMetricEventContentCache;
+        std::vector<std::array<std::string, 6>> mSpanEventContentCache;
+    };
+
     bool Serialize(BatchedEvents&& p, std::string& res, std::string& errorMsg) override;
 
+    bool CalculateLogGroupSize(const BatchedEvents& group, SerializeContext& ctx, std::string& errorMsg) const;
+    void SerializeLogGroup(LogGroupSerializer& serializer, BatchedEvents& group, SerializeContext& ctx) const;
+
     void CalculateLogEventSize(const BatchedEvents& group,
                                size_t& logGroupSZ,
                                std::vector<size_t>& logSZ,
                                bool enableNs) const;
     void CalculateMetricEventSize(const BatchedEvents& group,
                                   size_t& logGroupSZ,
-                                  std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                                  MetricEventContentCache& metricEventContentCache,
                                   std::vector<size_t>& logSZ) const;
     void CalculateSpanEventSize(const BatchedEvents& group,
                                 size_t& logGroupSZ,
@@ -59,7 +108,7 @@ private:
                            bool enableNs) const;
     void SerializeMetricEvent(LogGroupSerializer& serializer,
                               BatchedEvents& group,
-                              std::vector<MetricEventContentCacheItem>& metricEventContentCache,
+                              MetricEventContentCache& metricEventContentCache,
                               std::vector<size_t>& logSZ) const;
     void SerializeSpanEvent(LogGroupSerializer& serializer,
                             const BatchedEvents& group,
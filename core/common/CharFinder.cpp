@@ -0,0 +1,111 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/CharFinder.h"
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef LOGTAIL_CHAR_FINDER_X86
+#include <immintrin.h>
+#endif
+
+namespace logtail {
+
+namespace {
+
+inline void FindAllCharsScalarImpl(const char* data, size_t size, char c, size_t base, std::vector<size_t>& offsets) {
+    const char* begin = data;
+    const char* end = data + size;
+    while (begin < end) {
+        const char* pos = static_cast<const char*>(memchr(begin, c, end - begin));
+        if (pos == nullptr) {
+            break;
+        }
+        offsets.push_back(base + (pos - data));
+        begin = pos + 1;
+    }
+}
+
+#ifdef LOGTAIL_CHAR_FINDER_X86
+inline void AppendMask(uint32_t mask, size_t base, std::vector<size_t>& offsets) {
+    while (mask) {
+        offsets.push_back(base + __builtin_ctz(mask));
+        mask &= mask - 1;
+    }
+}
+#endif
+
+} // namespace
+
+void FindAllCharsScalar(const char* data, size_t size, char c, std::vector<size_t>& offsets) {
+    FindAllCharsScalarImpl(data, size, c, 0, offsets);
+}
+
+#ifdef LOGTAIL_CHAR_FINDER_X86
+void FindAllCharsSSE2(const char* data, size_t size, char c, std::vector<size_t>& offsets) {
+    const __m128i needle = _mm_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        AppendMask(static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle))), i, offsets);
+    }
+    FindAllCharsScalarImpl(data + i, size - i, c, i, offsets);
+}
+
+__attribute__((target("avx2"))) void
+FindAllCharsAVX2(const char* data, size_t size, char c, std::vector<size_t>& offsets) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        // two loads per iteration to hide latency, most chunks have few or no matches
+        __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        uint64_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(lo, needle)))
+            | (static_cast<uint64_t>(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(hi, needle))))
+               << 32);
+        while (mask) {
+            offsets.push_back(i + __builtin_ctzll(mask));
+            mask &= mask - 1;
+        }
+    }
+    for (; i + 32 <= size; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        AppendMask(static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle))), i, offsets);
+    }
+    FindAllCharsScalarImpl(data + i, size - i, c, i, offsets);
+}
+#endif
+
+using FindAllCharsFunc = void (*)(const char*, size_t, char, std::vector<size_t>&);
+
+static FindAllCharsFunc SelectFindAllChars() {
+#ifdef LOGTAIL_CHAR_FINDER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return FindAllCharsAVX2;
+    }
+    // SSE2 is part of x86-64 baseline
+    return FindAllCharsSSE2;
+#else
+    return FindAllCharsScalar;
+#endif
+}
+
+void FindAllChars(const char* data, size_t size, char c, std::vector<size_t>& offsets) {
+    static const FindAllCharsFunc sFindAllChars = SelectFindAllChars();
+    sFindAllChars(data, size, c, offsets);
+}
+
+} // namespace logtail
@@ -0,0 +1,37 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+
+#include <vector>
+
+namespace logtail {
+
+// Append the offsets of all occurrences of @c in [@data, @data + @size) to @offsets in ascending order.
+// On x86-64, the buffer is scanned 32 (AVX2) or 16 (SSE2) bytes at a time, the implementation is chosen at runtime.
+void FindAllChars(const char* data, size_t size, char c, std::vector<size_t>& offsets);
+
+// implementations, exposed for test
+void FindAllCharsScalar(const char* data, size_t size, char c, std::vector<size_t>& offsets);
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LOGTAIL_CHAR_FINDER_X86
+void FindAllCharsSSE2(const char* data, size_t size, char c, std::vector<size_t>& offsets);
+void FindAllCharsAVX2(const char* data, size_t size, char c, std::vector<size_t>& offsets);
+#endif
+
+} // namespace logtail
@@ -269,6 +269,48 @@ bool BoostRegexSearch(const char* buffer, const boost::regex& reg, string& excep
     }
 }
 
+string GetRegexLiteralPrefix(const string& pattern) {
+    // alternation may appear anywhere, be conservative
+    if (pattern.find('|') != string::npos) {
+        return "";
+    }
+    static const string sMetaChars = ".[]()*+?{}$^";
+    string prefix;
+    size_t i = 0;
+    if (!pattern.empty() && pattern[0] == '^') {
+        ++i;
+    }
+    while (i < pattern.size()) {
+        char c = pattern[i];
+        if (c == '\\') {
+            // escaped alphanumeric is a class, an anchor or a special sequence, and so are \< \> \` \' in boost
+            if (i + 1 >= pattern.size() || isalnum(static_cast<unsigned char>(pattern[i + 1]))
+                || strchr("<>`'", pattern[i + 1]) != nullptr) {
+                break;
+            }
+            c = pattern[i + 1];
+            i += 2;
+        } else if (sMetaChars.find(c) != string::npos) {
+            break;
+        } else {
+            ++i;
+        }
+        if (i < pattern.size()) {
+            char next = pattern[i];
+            if (next == '*' || next == '?' || next == '{') {
+                // the char is optional
+                break;
+            }
+            if (next == '+') {
+                prefix.push_back(c);
+                break;
+            }
+        }
+        prefix.push_back(c);
+    }
+    return prefix;
+}
+
 uint32_t GetLittelEndianValue32(const uint8_t* buffer) {
     return buffer[3] << 24 | buffer[2] << 16 | buffer[1] << 8 | buffer[0];
 }
@@ -136,6 +136,10 @@ bool BoostRegexMatch(const char* buffer, const boost::regex& reg, std::string& e
 bool BoostRegexSearch(const char* buffer, size_t size, const boost::regex& reg, std::string& exception);
 bool BoostRegexSearch(const char* buffer, const boost::regex& reg, std::string& exception);
 
+// Get the literal string that any input matched by BoostRegexSearch with @pattern (i.e. matched from the beginning of
+// the input) must start with, e.g. \[\d+ -> "[". Empty if no such literal can be determined.
+std::string GetRegexLiteralPrefix(const std::string& pattern);
+
 // GetLittelEndianValue32 converts @buffer in little endian to uint32_t.
 uint32_t GetLittelEndianValue32(const uint8_t* buffer);
 
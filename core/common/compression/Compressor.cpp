@@ -22,6 +22,17 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+struct StreamState {
+    size_t mInputSize = 0;
+    chrono::nanoseconds mProcessTime{0};
+};
+
+thread_local StreamState sStreamState;
+
+} // namespace
+
 void Compressor::SetMetricRecordRef(MetricLabels&& labels, DynamicMetricLabels&& dynamicLabels) {
     WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
         mMetricsRecordRef, MetricCategory::METRIC_CATEGORY_COMPONENT, std::move(labels), std::move(dynamicLabels));
@@ -56,4 +67,54 @@ bool Compressor::DoCompress(const string& input, string& output, string& errorMs
     return res;
 }
 
+bool Compressor::DoStartStream(size_t inputSize, string& output, string& errorMsg) {
+    sStreamState.mInputSize = inputSize;
+    auto before = chrono::system_clock::now();
+    auto res = StartStream(inputSize, output, errorMsg);
+    sStreamState.mProcessTime = chrono::system_clock::now() - before;
+    return res;
+}
+
+bool Compressor::DoAppendStream(StringView input, string& output, string& errorMsg) {
+    auto before = chrono::system_clock::now();
+    auto res = AppendStream(input, output, errorMsg);
+    sStreamState.mProcessTime += chrono::system_clock::now() - before;
+    return res;
+}
+
+bool Compressor::DoFinishStream(string& output, string& errorMsg) {
+    auto before = chrono::system_clock::now();
+    auto res = FinishStream(output, errorMsg);
+    sStreamState.mProcessTime += chrono::system_clock::now() - before;
+
+    if (mMetricsRecordRef != nullptr) {
+        ADD_COUNTER(mInItemsTotal, 1);
+        ADD_COUNTER(mInItemSizeBytes, sStreamState.mInputSize);
+        ADD_COUNTER(mTotalProcessMs, sStreamState.mProcessTime);
+        if (res) {
+            ADD_COUNTER(mOutItemsTotal, 1);
+            ADD_COUNTER(mOutItemSizeBytes, output.size());
+        } else {
+            ADD_COUNTER(mDiscardedItemsTotal, 1);
+            ADD_COUNTER(mDiscardedItemSizeBytes, sStreamState.mInputSize);
+        }
+    }
+    return res;
+}
+
+bool Compressor::StartStream(size_t inputSize, string& output, string& errorMsg) {
+    errorMsg = "stream compression is not supported";
+    return false;
+}
+
+bool Compressor::AppendStream(StringView input, string& output, string& errorMsg) {
+    errorMsg = "stream compression is not supported";
+    return false;
+}
+
+bool Compressor::FinishStream(string& output, string& errorMsg) {
+    errorMsg = "stream compression is not supported";
+    return false;
+}
+
 } // namespace logtail
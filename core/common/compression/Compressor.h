@@ -18,6 +18,7 @@
 
 #include <string>
 
+#include "common/StringView.h"
 #include "common/compression/CompressType.h"
 #include "monitor/MetricManager.h"
 
@@ -30,6 +31,14 @@ public:
 
     bool DoCompress(const std::string& input, std::string& output, std::string& errorMsg);
 
+    // Compress input that is produced piece by piece, the result is in the same format as DoCompress. The total input
+    // size must be known in advance. Only one stream can be in progress in a thread at a time. Only available when
+    // IsStreamSupported returns true.
+    virtual bool IsStreamSupported() const { return false; }
+    bool DoStartStream(size_t inputSize, std::string& output, std::string& errorMsg);
+    bool DoAppendStream(StringView input, std::string& output, std::string& errorMsg);
+    bool DoFinishStream(std::string& output, std::string& errorMsg);
+
 #ifdef APSARA_UNIT_TEST_MAIN
     // buffer shoudl be reserved for output before calling this function
     virtual bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
@@ -51,6 +60,11 @@ protected:
 private:
     virtual bool Compress(const std::string& input, std::string& output, std::string& errorMsg) = 0;
 
+    // by default, stream compression is not supported
+    virtual bool StartStream(size_t inputSize, std::string& output, std::string& errorMsg);
+    virtual bool AppendStream(StringView input, std::string& output, std::string& errorMsg);
+    virtual bool FinishStream(std::string& output, std::string& errorMsg);
+
     CompressType mType = CompressType::NONE;
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -20,6 +20,19 @@ using namespace std;
 
 namespace logtail {
 
+namespace {
+
+struct ZstdStreamState {
+    ~ZstdStreamState() { ZSTD_freeCCtx(mCtx); }
+
+    ZSTD_CCtx* mCtx = nullptr;
+    size_t mOutputPos = 0;
+};
+
+thread_local ZstdStreamState sZstdStreamState;
+
+} // namespace
+
 bool ZstdCompressor::Compress(const string& input, string& output, string& errorMsg) {
     size_t encodingSize = ZSTD_compressBound(input.size());
     output.resize(encodingSize);
@@ -37,6 +50,65 @@ bool ZstdCompressor::Compress(const string& input, string& output, string& error
     return false;
 }
 
+bool ZstdCompressor::StartStream(size_t inputSize, string& output, string& errorMsg) {
+    auto& state = sZstdStreamState;
+    if (state.mCtx == nullptr) {
+        state.mCtx = ZSTD_createCCtx();
+        if (state.mCtx == nullptr) {
+            errorMsg = "failed to create zstd context";
+            return false;
+        }
+    }
+    ZSTD_CCtx_reset(state.mCtx, ZSTD_reset_session_and_parameters);
+    size_t res = ZSTD_CCtx_setParameter(state.mCtx, ZSTD_c_compressionLevel, mCompressionLevel);
+    if (!ZSTD_isError(res)) {
+        res = ZSTD_CCtx_setPledgedSrcSize(state.mCtx, inputSize);
+    }
+    if (ZSTD_isError(res)) {
+        errorMsg = ZSTD_getErrorName(res);
+        return false;
+    }
+    // the bound of one-shot compression also holds for a single frame compressed by stream
+    output.resize(ZSTD_compressBound(inputSize));
+    state.mOutputPos = 0;
+    return true;
+}
+
+bool ZstdCompressor::AppendStream(StringView input, string& output, string& errorMsg) {
+    auto& state = sZstdStreamState;
+    ZSTD_inBuffer in{input.data(), input.size(), 0};
+    ZSTD_outBuffer out{const_cast<char*>(output.data()), output.size(), state.mOutputPos};
+    while (in.pos < in.size) {
+        size_t res = ZSTD_compressStream2(state.mCtx, &out, &in, ZSTD_e_continue);
+        if (ZSTD_isError(res)) {
+            errorMsg = ZSTD_getErrorName(res);
+            return false;
+        }
+    }
+    state.mOutputPos = out.pos;
+    return true;
+}
+
+bool ZstdCompressor::FinishStream(string& output, string& errorMsg) {
+    auto& state = sZstdStreamState;
+    ZSTD_inBuffer in{nullptr, 0, 0};
+    ZSTD_outBuffer out{const_cast<char*>(output.data()), output.size(), state.mOutputPos};
+    size_t remaining = 0;
+    do {
+        remaining = ZSTD_compressStream2(state.mCtx, &out, &in, ZSTD_e_end);
+        if (ZSTD_isError(remaining)) {
+            errorMsg = ZSTD_getErrorName(remaining);
+            return false;
+        }
+    } while (remaining != 0 && out.pos < out.size);
+    if (remaining != 0) {
+        errorMsg = "output buffer is too small";
+        return false;
+    }
+    output.resize(out.pos);
+    return true;
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 bool ZstdCompressor::UnCompress(const string& input, string& output, string& errorMsg) {
     try {
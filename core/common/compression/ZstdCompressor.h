@@ -24,6 +24,8 @@ class ZstdCompressor : public Compressor {
 public:
     explicit ZstdCompressor(CompressType type, int32_t level = 1) : Compressor(type), mCompressionLevel(level) {}
 
+    bool IsStreamSupported() const override { return true; }
+
 #ifdef APSARA_UNIT_TEST_MAIN
     bool UnCompress(const std::string& input, std::string& output, std::string& errorMsg) override;
 #endif
@@ -31,6 +33,11 @@ public:
 private:
     bool Compress(const std::string& input, std::string& output, std::string& errorMsg) override;
 
+    // data is compressed as soon as it is appended, and the frame header carries the total input size
+    bool StartStream(size_t inputSize, std::string& output, std::string& errorMsg) override;
+    bool AppendStream(StringView input, std::string& output, std::string& errorMsg) override;
+    bool FinishStream(std::string& output, std::string& errorMsg) override;
+
     int32_t mCompressionLevel = 1;
 };
 
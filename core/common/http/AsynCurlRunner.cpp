@@ -19,19 +19,31 @@
 #include "common/StringTools.h"
 #include "common/http/Curl.h"
 #include "logger/Logger.h"
+#include "monitor/metric_constants/MetricConstants.h"
 
 using namespace std;
 
 namespace logtail {
 
+AsynCurlRunner::AsynCurlRunner() {
+    WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+        mMetricsRecordRef,
+        MetricCategory::METRIC_CATEGORY_RUNNER,
+        {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_ASYN_CURL}});
+    mInItemsTotal = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_ITEMS_TOTAL);
+    mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+    mSuccessfulItemTotalFirstByteTimeMs
+        = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_FIRST_BYTE_TIME_MS);
+    mSendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL);
+}
+
 bool AsynCurlRunner::Init() {
     if (mInited) {
         return true;
     }
 
-    mClient = curl_multi_init();
     mIsFlush = false;
-    if (mClient == nullptr) {
+    if (!mEventLoop.Init()) {
         LOG_ERROR(sLogger, ("failed to init async curl runner", "failed to init curl client"));
         return false;
     }
@@ -45,6 +57,7 @@ void AsynCurlRunner::Stop() {
         return;
     }
     mIsFlush = true;
+    mEventLoop.Wakeup();
     if (!mThreadRes.valid()) {
         return;
     }
@@ -59,91 +72,49 @@ void AsynCurlRunner::Stop() {
 
 bool AsynCurlRunner::AddRequest(unique_ptr<AsynHttpRequest>&& request) {
     mQueue.Push(std::move(request));
+    // send it at once if the runner is waiting for running requests
+    mEventLoop.Wakeup();
     return true;
 }
 
 void AsynCurlRunner::Run() {
+    int runningHandlers = 0;
     while (true) {
+        SET_GAUGE(mLastRunTime,
+                  chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
         unique_ptr<AsynHttpRequest> request;
-        if (mQueue.WaitAndPop(request, 500)) {
-            LOG_DEBUG(
-                sLogger,
-                ("got request from queue, request address", request.get())("try cnt", ToString(request->mTryCnt)));
-            if (!AddRequestToMultiCurlHandler(mClient, std::move(request))) {
+        if (runningHandlers == 0) {
+            // nothing to wait for in curl, so wait for new requests
+            if (mQueue.WaitAndPop(request, 500)) {
+                if (AddRequestToClient(std::move(request))) {
+                    ++runningHandlers;
+                }
+            } else if (mIsFlush && mQueue.Empty()) {
+                break;
+            }
+            if (runningHandlers == 0) {
                 continue;
             }
-        } else if (mIsFlush && mQueue.Empty()) {
-            break;
-        } else {
-            continue;
         }
-        DoRun();
-    }
-    auto mc = curl_multi_cleanup(mClient);
-    if (mc != CURLM_OK) {
-        LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
-    }
-}
-
-void AsynCurlRunner::DoRun() {
-    CURLMcode mc;
-    int runningHandlers = 1;
-    while (runningHandlers) {
-        if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
-            LOG_ERROR(
-                sLogger,
-                ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
-            this_thread::sleep_for(chrono::milliseconds(100));
-            continue;
-        }
-        HandleCompletedAsynRequests(mClient, runningHandlers);
-
-        unique_ptr<AsynHttpRequest> request;
-        if (mQueue.TryPop(request)) {
-            LOG_DEBUG(sLogger,
-                      ("got item from flusher runner, request address", request.get())("try cnt",
-                                                                                       ToString(request->mTryCnt)));
-            if (AddRequestToMultiCurlHandler(mClient, std::move(request))) {
+        while (mQueue.TryPop(request)) {
+            if (AddRequestToClient(std::move(request))) {
                 ++runningHandlers;
             }
         }
 
-        struct timeval timeout {
-            1, 0
-        };
-        long curlTimeout = -1;
-        if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
-            LOG_WARNING(
-                sLogger,
-                ("failed to call curl_multi_timeout", "use default timeout 1s")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (curlTimeout >= 0) {
-            auto sec = curlTimeout / 1000;
-            // special treatment, do not know why
-            if (sec <= 1) {
-                timeout.tv_sec = sec;
-                timeout.tv_usec = (curlTimeout % 1000) * 1000;
-            }
-        }
-
-        int maxfd = -1;
-        fd_set fdread;
-        fd_set fdwrite;
-        fd_set fdexcep;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-        if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
-            LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (maxfd == -1) {
-            // sleep min(timeout, 100ms) according to libcurl
-            int64_t sleepMs = (curlTimeout >= 0 && curlTimeout < 100) ? curlTimeout : 100;
-            this_thread::sleep_for(chrono::milliseconds(sleepMs));
-        } else {
-            select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
-        }
+        mEventLoop.Wait(1000);
+        runningHandlers = mEventLoop.GetRunningHandles();
+        HandleCompletedAsynRequests(mEventLoop.GetClient(), runningHandlers, mSuccessfulItemTotalFirstByteTimeMs);
+        SET_GAUGE(mSendingItemsTotal, runningHandlers);
     }
+    mEventLoop.Cleanup();
+}
+
+bool AsynCurlRunner::AddRequestToClient(unique_ptr<AsynHttpRequest>&& request) {
+    ADD_COUNTER(mInItemsTotal, 1);
+    LOG_DEBUG(sLogger,
+              ("got request from queue, request address", request.get())("try cnt", ToString(request->mTryCnt)));
+    return AddRequestToMultiCurlHandler(mEventLoop.GetClient(), std::move(request));
 }
 
 } // namespace logtail
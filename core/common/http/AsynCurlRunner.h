@@ -22,10 +22,10 @@
 #include <memory>
 #include <mutex>
 
-#include "curl/multi.h"
-
 #include "common/SafeQueue.h"
+#include "common/http/CurlEventLoop.h"
 #include "common/http/HttpRequest.h"
+#include "monitor/MetricManager.h"
 
 namespace logtail {
 
@@ -44,19 +44,25 @@ public:
     bool AddRequest(std::unique_ptr<AsynHttpRequest>&& request);
 
 private:
-    AsynCurlRunner() = default;
+    AsynCurlRunner();
     ~AsynCurlRunner() = default;
 
     void Run();
-    void DoRun();
+    bool AddRequestToClient(std::unique_ptr<AsynHttpRequest>&& request);
 
-    CURLM* mClient = nullptr;
+    CurlEventLoop mEventLoop;
     SafeQueue<std::unique_ptr<AsynHttpRequest>> mQueue;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
     std::atomic_bool mInited = false;
 
+    mutable MetricsRecordRef mMetricsRecordRef;
+    CounterPtr mInItemsTotal;
+    TimeCounterPtr mSuccessfulItemTotalFirstByteTimeMs;
+    IntGaugePtr mSendingItemsTotal;
+    IntGaugePtr mLastRunTime;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class HttpRequestTimerEventUnittest;
 #endif
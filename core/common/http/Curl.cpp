@@ -131,11 +131,12 @@ CURL* CreateCurlHandler(const string& method,
                         const string& intf,
                         bool followRedirects,
                         const optional<CurlTLS>& tls,
-                        const optional<CurlSocket>& socket // socket is used async, the lifespan must be longer
+                        const optional<CurlSocket>& socket, // socket is used async, the lifespan must be longer
+                        CURL* reusedHandler // options of the handler should have been reset
 ) {
     static DnsCache* dnsCache = DnsCache::GetInstance();
 
-    CURL* curl = curl_easy_init();
+    CURL* curl = reusedHandler != nullptr ? reusedHandler : curl_easy_init();
     if (curl == nullptr) {
         return nullptr;
     }
@@ -314,7 +315,7 @@ bool AddRequestToMultiCurlHandler(CURLM* multiCurl, unique_ptr<AsynHttpRequest>&
     return true;
 }
 
-void HandleCompletedAsynRequests(CURLM* multiCurl, int& runningHandlers) {
+void HandleCompletedAsynRequests(CURLM* multiCurl, int& runningHandlers, const TimeCounterPtr& firstByteTimeMs) {
     int msgsLeft = 0;
     CURLMsg* msg = curl_multi_info_read(multiCurl, &msgsLeft);
     while (msg) {
@@ -330,6 +331,11 @@ void HandleCompletedAsynRequests(CURLM* multiCurl, int& runningHandlers) {
                     curl_off_t responseTime;
                     curl_easy_getinfo(handler, CURLINFO_TOTAL_TIME_T, &responseTime);
                     auto responseTimeMs = responseTime / 1000;
+                    if (firstByteTimeMs) {
+                        curl_off_t firstByteTime = 0;
+                        curl_easy_getinfo(handler, CURLINFO_STARTTRANSFER_TIME_T, &firstByteTime);
+                        ADD_COUNTER(firstByteTimeMs, chrono::microseconds(firstByteTime));
+                    }
                     request->mResponse.SetNetworkStatus(NetworkCode::Ok, "");
                     request->mResponse.SetStatusCode(statusCode);
                     request->mResponse.SetResponseTime(chrono::milliseconds(responseTimeMs));
@@ -27,6 +27,7 @@
 
 #include "common/http/HttpRequest.h"
 #include "common/http/HttpResponse.h"
+#include "monitor/metric_models/MetricTypes.h"
 
 namespace logtail {
 
@@ -47,12 +48,16 @@ CURL* CreateCurlHandler(const std::string& method,
                         const std::string& intf = "",
                         bool followRedirects = false,
                         const std::optional<CurlTLS>& tls = std::nullopt,
-                        const std::optional<CurlSocket>& socket = std::nullopt);
+                        const std::optional<CurlSocket>& socket = std::nullopt,
+                        CURL* reusedHandler = nullptr);
 
 bool SendHttpRequest(std::unique_ptr<HttpRequest>&& request, HttpResponse& response);
 
 bool AddRequestToMultiCurlHandler(CURLM* multiCurl, std::unique_ptr<AsynHttpRequest>&& request);
 void SendAsynRequests(CURLM* multiCurl);
-void HandleCompletedAsynRequests(CURLM* multiCurl, int& runningHandlers);
+// @param firstByteTimeMs optional, time to the first byte of successful requests is added to it
+void HandleCompletedAsynRequests(CURLM* multiCurl,
+                                 int& runningHandlers,
+                                 const TimeCounterPtr& firstByteTimeMs = nullptr);
 
 } // namespace logtail
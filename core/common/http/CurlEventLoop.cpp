@@ -0,0 +1,241 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/http/CurlEventLoop.h"
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#endif
+
+#include <algorithm>
+#if !defined(__linux__)
+#include <thread>
+#endif
+
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+#if defined(__linux__)
+static const int kMaxEpollEvents = 256;
+#endif
+
+CurlEventLoop::~CurlEventLoop() {
+    Cleanup();
+}
+
+bool CurlEventLoop::Init() {
+    mClient = curl_multi_init();
+    if (mClient == nullptr) {
+        LOG_ERROR(sLogger, ("failed to init curl event loop", "failed to init curl multi client"));
+        return false;
+    }
+#if defined(__linux__)
+    mEpollFd = epoll_create1(EPOLL_CLOEXEC);
+    mWakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mEpollFd < 0 || mWakeupFd < 0) {
+        LOG_ERROR(sLogger, ("failed to init curl event loop", "failed to create epoll or eventfd")("errno", errno));
+        Cleanup();
+        return false;
+    }
+    epoll_event ev{};
+    ev.events = EPOLLIN;
+    ev.data.fd = mWakeupFd;
+    epoll_ctl(mEpollFd, EPOLL_CTL_ADD, mWakeupFd, &ev);
+#endif
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETFUNCTION, SocketCallback);
+    curl_multi_setopt(mClient, CURLMOPT_SOCKETDATA, this);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERFUNCTION, TimerCallback);
+    curl_multi_setopt(mClient, CURLMOPT_TIMERDATA, this);
+    return true;
+}
+
+void CurlEventLoop::Cleanup() {
+    if (mClient != nullptr) {
+        auto mc = curl_multi_cleanup(mClient);
+        if (mc != CURLM_OK) {
+            LOG_ERROR(sLogger,
+                      ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
+        }
+        mClient = nullptr;
+    }
+#if defined(__linux__)
+    if (mEpollFd >= 0) {
+        close(mEpollFd);
+        mEpollFd = -1;
+    }
+    if (mWakeupFd >= 0) {
+        close(mWakeupFd);
+        mWakeupFd = -1;
+    }
+#else
+    mSockets.clear();
+#endif
+    mTimeoutDeadline.reset();
+    mRunningHandles = 0;
+}
+
+void CurlEventLoop::Wait(int maxWaitMs) {
+    int waitMs = maxWaitMs;
+    if (mTimeoutDeadline) {
+        auto remaining = chrono::ceil<chrono::milliseconds>(*mTimeoutDeadline - chrono::steady_clock::now()).count();
+        waitMs = static_cast<int>(max<int64_t>(0, min<int64_t>(remaining, waitMs)));
+    }
+
+#if defined(__linux__)
+    epoll_event events[kMaxEpollEvents];
+    int n = epoll_wait(mEpollFd, events, kMaxEpollEvents, waitMs);
+    if (n < 0 && errno != EINTR) {
+        LOG_ERROR(sLogger, ("failed to call epoll_wait", strerror(errno)));
+    }
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.fd == mWakeupFd) {
+            uint64_t cnt = 0;
+            while (read(mWakeupFd, &cnt, sizeof(cnt)) > 0) {
+            }
+            continue;
+        }
+        int evBitmask = 0;
+        if (events[i].events & EPOLLIN) {
+            evBitmask |= CURL_CSELECT_IN;
+        }
+        if (events[i].events & EPOLLOUT) {
+            evBitmask |= CURL_CSELECT_OUT;
+        }
+        if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+            evBitmask |= CURL_CSELECT_ERR;
+        }
+        SocketAction(events[i].data.fd, evBitmask);
+    }
+#else
+    if (mSockets.empty()) {
+        // nothing to select, sleep min(timeout, 100ms) according to libcurl
+        this_thread::sleep_for(chrono::milliseconds(min(waitMs, 100)));
+    } else {
+        fd_set fdread;
+        fd_set fdwrite;
+        fd_set fdexcep;
+        FD_ZERO(&fdread);
+        FD_ZERO(&fdwrite);
+        FD_ZERO(&fdexcep);
+        curl_socket_t maxfd = 0;
+        for (const auto& item : mSockets) {
+            if (item.second & CURL_POLL_IN) {
+                FD_SET(item.first, &fdread);
+            }
+            if (item.second & CURL_POLL_OUT) {
+                FD_SET(item.first, &fdwrite);
+            }
+            FD_SET(item.first, &fdexcep);
+            maxfd = max(maxfd, item.first);
+        }
+        // new requests are only checked after select returns, so do not wait too long
+        waitMs = min(waitMs, 100);
+        struct timeval timeout {
+            waitMs / 1000, (waitMs % 1000) * 1000
+        };
+        if (select(static_cast<int>(maxfd) + 1, &fdread, &fdwrite, &fdexcep, &timeout) > 0) {
+            // callbacks may change mSockets
+            auto sockets = mSockets;
+            for (const auto& item : sockets) {
+                int evBitmask = 0;
+                if (FD_ISSET(item.first, &fdread)) {
+                    evBitmask |= CURL_CSELECT_IN;
+                }
+                if (FD_ISSET(item.first, &fdwrite)) {
+                    evBitmask |= CURL_CSELECT_OUT;
+                }
+                if (FD_ISSET(item.first, &fdexcep)) {
+                    evBitmask |= CURL_CSELECT_ERR;
+                }
+                if (evBitmask != 0) {
+                    SocketAction(item.first, evBitmask);
+                }
+            }
+        }
+    }
+#endif
+
+    if (mTimeoutDeadline && chrono::steady_clock::now() >= *mTimeoutDeadline) {
+        // the timeout may be set again by curl in the action
+        mTimeoutDeadline.reset();
+        SocketAction(CURL_SOCKET_TIMEOUT, 0);
+    }
+}
+
+void CurlEventLoop::Wakeup() {
+#if defined(__linux__)
+    if (mWakeupFd >= 0) {
+        uint64_t one = 1;
+        auto res = write(mWakeupFd, &one, sizeof(one));
+        (void)res;
+    }
+#endif
+}
+
+void CurlEventLoop::SocketAction(curl_socket_t s, int evBitmask) {
+    auto mc = curl_multi_socket_action(mClient, s, evBitmask, &mRunningHandles);
+    if (mc != CURLM_OK) {
+        LOG_ERROR(sLogger, ("failed to call curl_multi_socket_action", curl_multi_strerror(mc)));
+    }
+}
+
+int CurlEventLoop::SocketCallback(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp) {
+    auto* loop = static_cast<CurlEventLoop*>(userp);
+#if defined(__linux__)
+    if (what == CURL_POLL_REMOVE) {
+        epoll_ctl(loop->mEpollFd, EPOLL_CTL_DEL, s, nullptr);
+        return 0;
+    }
+    epoll_event ev{};
+    if (what & CURL_POLL_IN) {
+        ev.events |= EPOLLIN;
+    }
+    if (what & CURL_POLL_OUT) {
+        ev.events |= EPOLLOUT;
+    }
+    ev.data.fd = s;
+    if (epoll_ctl(loop->mEpollFd, EPOLL_CTL_MOD, s, &ev) != 0 && errno == ENOENT) {
+        if (epoll_ctl(loop->mEpollFd, EPOLL_CTL_ADD, s, &ev) != 0) {
+            LOG_ERROR(sLogger, ("failed to add socket to epoll", strerror(errno))("socket", s));
+        }
+    }
+#else
+    if (what == CURL_POLL_REMOVE) {
+        loop->mSockets.erase(s);
+    } else {
+        loop->mSockets[s] = what;
+    }
+#endif
+    return 0;
+}
+
+int CurlEventLoop::TimerCallback(CURLM* multi, long timeoutMs, void* userp) {
+    auto* loop = static_cast<CurlEventLoop*>(userp);
+    if (timeoutMs < 0) {
+        loop->mTimeoutDeadline.reset();
+    } else {
+        loop->mTimeoutDeadline = chrono::steady_clock::now() + chrono::milliseconds(timeoutMs);
+    }
+    return 0;
+}
+
+} // namespace logtail
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <chrono>
+#include <optional>
+
+#include "curl/multi.h"
+
+#if !defined(__linux__)
+#include <unordered_map>
+#endif
+
+namespace logtail {
+
+// CurlEventLoop drives a curl multi handle by curl_multi_socket_action. curl tells which sockets to watch and when its
+// timeout expires by callbacks, so only the sockets with events are handled on each wake-up.
+//
+// On Linux, sockets are watched by epoll, so there is no FD_SETSIZE limit and the cost of each wake-up does not grow
+// with the number of connections. Wakeup() interrupts Wait() by an eventfd, so that newly added requests are sent at
+// once. On other platforms, sockets are watched by select.
+//
+// All methods except Wakeup() should be called in the same thread.
+class CurlEventLoop {
+public:
+    CurlEventLoop() = default;
+    ~CurlEventLoop();
+    CurlEventLoop(const CurlEventLoop&) = delete;
+    CurlEventLoop& operator=(const CurlEventLoop&) = delete;
+
+    bool Init();
+    void Cleanup();
+    CURLM* GetClient() const { return mClient; }
+
+    // Wait until any socket is ready, the timeout of curl expires, Wakeup() is called or maxWaitMs passes, and let curl
+    // handle the ready sockets and the timeout. Completed transfers can be read by curl_multi_info_read afterwards.
+    void Wait(int maxWaitMs);
+    // thread safe
+    void Wakeup();
+    // the number of transfers still running after the last Wait()
+    int GetRunningHandles() const { return mRunningHandles; }
+
+private:
+    static int SocketCallback(CURL* easy, curl_socket_t s, int what, void* userp, void* socketp);
+    static int TimerCallback(CURLM* multi, long timeoutMs, void* userp);
+
+    void SocketAction(curl_socket_t s, int evBitmask);
+
+    CURLM* mClient = nullptr;
+    int mRunningHandles = 0;
+    std::optional<std::chrono::steady_clock::time_point> mTimeoutDeadline;
+#if defined(__linux__)
+    int mEpollFd = -1;
+    int mWakeupFd = -1;
+#else
+    // socket -> CURL_POLL_IN/CURL_POLL_OUT/CURL_POLL_INOUT
+    std::unordered_map<curl_socket_t, int> mSockets;
+#endif
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CurlEventLoopUnittest;
+#endif
+};
+
+} // namespace logtail
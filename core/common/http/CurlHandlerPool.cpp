@@ -0,0 +1,93 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/http/CurlHandlerPool.h"
+
+#include "logger/Logger.h"
+
+using namespace std;
+
+namespace logtail {
+
+CurlHandlerPool::CurlHandlerPool(size_t maxIdleHandlersPerHost) : mMaxIdleHandlersPerHost(maxIdleHandlersPerHost) {
+    mShare = curl_share_init();
+    if (mShare == nullptr) {
+        LOG_WARNING(sLogger, ("failed to init curl share handle", "tls sessions will not be shared between handlers"));
+        return;
+    }
+    // the pool is used in a single thread, so no lock function is needed
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+    curl_share_setopt(mShare, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+}
+
+CurlHandlerPool::~CurlHandlerPool() {
+    Clear();
+    if (mShare != nullptr) {
+        curl_share_cleanup(mShare);
+    }
+}
+
+string CurlHandlerPool::GetHostKey(bool httpsFlag, const string& host, int32_t port) {
+    string key = httpsFlag ? "https://" : "http://";
+    key.append(host).append(":").append(to_string(port));
+    return key;
+}
+
+CURL* CurlHandlerPool::Acquire(const string& hostKey) {
+    CURL* curl = nullptr;
+    auto it = mIdleHandlers.find(hostKey);
+    if (it != mIdleHandlers.end() && !it->second.empty()) {
+        curl = it->second.back();
+        it->second.pop_back();
+        // options are reset, while the caches of the handler are kept
+        curl_easy_reset(curl);
+    } else {
+        curl = curl_easy_init();
+        if (curl == nullptr) {
+            return nullptr;
+        }
+    }
+    if (mShare != nullptr) {
+        curl_easy_setopt(curl, CURLOPT_SHARE, mShare);
+    }
+    return curl;
+}
+
+void CurlHandlerPool::Release(const string& hostKey, CURL* curl) {
+    if (curl == nullptr) {
+        return;
+    }
+    auto& handlers = mIdleHandlers[hostKey];
+    if (handlers.size() >= mMaxIdleHandlersPerHost) {
+        curl_easy_cleanup(curl);
+        return;
+    }
+    handlers.push_back(curl);
+}
+
+void CurlHandlerPool::Clear() {
+    for (auto& item : mIdleHandlers) {
+        for (auto* curl : item.second) {
+            curl_easy_cleanup(curl);
+        }
+    }
+    mIdleHandlers.clear();
+}
+
+size_t CurlHandlerPool::GetIdleHandlerCnt(const string& hostKey) const {
+    auto it = mIdleHandlers.find(hostKey);
+    return it == mIdleHandlers.end() ? 0 : it->second.size();
+}
+
+} // namespace logtail
@@ -0,0 +1,63 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "curl/curl.h"
+
+namespace logtail {
+
+// CurlHandlerPool keeps idle easy handles per endpoint, so that handles are not created and destroyed for each request.
+// All handles from the pool share the TLS session cache and the DNS cache, so a new connection to a known endpoint
+// resumes the TLS session instead of doing a full handshake. Idle connections themselves are kept by the multi handle
+// that the easy handles are added to.
+//
+// The pool is not thread safe, and should be used in the thread driving the multi handle.
+class CurlHandlerPool {
+public:
+    explicit CurlHandlerPool(size_t maxIdleHandlersPerHost);
+    ~CurlHandlerPool();
+    CurlHandlerPool(const CurlHandlerPool&) = delete;
+    CurlHandlerPool& operator=(const CurlHandlerPool&) = delete;
+
+    static std::string GetHostKey(bool httpsFlag, const std::string& host, int32_t port);
+
+    // @return an idle handler of the host with all options reset, or a new one if there is none. nullptr is returned
+    // if a new handler cannot be created.
+    CURL* Acquire(const std::string& hostKey);
+    // The handler should have been removed from the multi handle. It is destroyed if the pool of the host is full.
+    void Release(const std::string& hostKey, CURL* curl);
+    void Clear();
+
+    size_t GetIdleHandlerCnt(const std::string& hostKey) const;
+
+private:
+    size_t mMaxIdleHandlersPerHost;
+    CURLSH* mShare = nullptr;
+    std::unordered_map<std::string, std::vector<CURL*>> mIdleHandlers;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class CurlHandlerPoolUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -72,7 +72,8 @@ class HttpResponse {
                                    const std::string& intf,
                                    bool followRedirects,
                                    const std::optional<CurlTLS>& tls,
-                                   const std::optional<CurlSocket>& socket);
+                                   const std::optional<CurlSocket>& socket,
+                                   void* reusedHandler);
 
 public:
     HttpResponse()
@@ -0,0 +1,95 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/memory/MappedFileWindow.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+namespace logtail {
+
+#if defined(__linux__)
+namespace {
+
+// process_vm_readv may be denied by seccomp in containers, in which case data can not be read safely from the mapping
+bool IsSafeCopySupported() {
+    char src = 0;
+    char dst = 0;
+    struct iovec local = {&dst, 1};
+    struct iovec remote = {&src, 1};
+    return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == 1;
+}
+
+} // namespace
+#endif
+
+shared_ptr<MappedFileWindow> MappedFileWindow::Create(int fd, int64_t offset, size_t size) {
+#if defined(__linux__)
+    if (fd < 0 || offset < 0 || size == 0) {
+        return nullptr;
+    }
+    static const bool sSafeCopySupported = IsSafeCopySupported();
+    if (!sSafeCopySupported) {
+        return nullptr;
+    }
+    static const long sPageSize = sysconf(_SC_PAGESIZE);
+    int64_t alignedOffset = offset - offset % sPageSize;
+    size_t mapSize = size + static_cast<size_t>(offset - alignedOffset);
+    void* addr = mmap(nullptr, mapSize, PROT_READ, MAP_PRIVATE, fd, alignedOffset);
+    if (addr == MAP_FAILED) {
+        return nullptr;
+    }
+    madvise(addr, mapSize, MADV_SEQUENTIAL);
+    return shared_ptr<MappedFileWindow>(
+        new MappedFileWindow(addr, mapSize, static_cast<const char*>(addr) + (offset - alignedOffset), size));
+#else
+    return nullptr;
+#endif
+}
+
+MappedFileWindow::~MappedFileWindow() {
+#if defined(__linux__)
+    if (mAddr != nullptr) {
+        munmap(mAddr, mMapSize);
+    }
+#endif
+}
+
+size_t MappedFileWindow::Read(char* dst, size_t size) const {
+    size = min(size, mSize);
+    size_t copied = 0;
+#if defined(__linux__)
+    // the kernel copies the data for us and stops at a page no longer backed by the file with a short count or EFAULT,
+    // where a plain memcpy would be killed by SIGBUS
+    while (copied < size) {
+        struct iovec local = {dst + copied, size - copied};
+        struct iovec remote = {const_cast<char*>(mData) + copied, size - copied};
+        ssize_t n = process_vm_readv(getpid(), &local, 1, &remote, 1, 0);
+        if (n <= 0) {
+            break;
+        }
+        copied += static_cast<size_t>(n);
+    }
+#endif
+    return copied;
+}
+
+} // namespace logtail
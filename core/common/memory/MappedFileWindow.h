@@ -0,0 +1,56 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <memory>
+
+namespace logtail {
+
+// A read-only mapping of a file range [offset, offset + size). The mapping is released when the last reference is
+// dropped.
+//
+// Accessing a page beyond the end of file raises SIGBUS, which happens when the file is truncated while the window is
+// alive. Data that may be truncated concurrently should be copied out with Read instead of being accessed directly.
+class MappedFileWindow {
+public:
+    // return nullptr if mmap is not supported or fails
+    static std::shared_ptr<MappedFileWindow> Create(int fd, int64_t offset, size_t size);
+
+    MappedFileWindow(const MappedFileWindow&) = delete;
+    MappedFileWindow& operator=(const MappedFileWindow&) = delete;
+    ~MappedFileWindow();
+
+    const char* GetData() const { return mData; }
+    size_t GetSize() const { return mSize; }
+    // copy the first size bytes of the window to dst without raising SIGBUS, return the number of bytes copied, which
+    // is less than size if part of the window is no longer backed by the file
+    size_t Read(char* dst, size_t size) const;
+
+private:
+    MappedFileWindow(void* addr, size_t mapSize, const char* data, size_t size)
+        : mAddr(addr), mMapSize(mapSize), mData(data), mSize(size) {}
+
+    void* mAddr = nullptr;
+    size_t mMapSize = 0;
+    const char* mData = nullptr;
+    size_t mSize = 0;
+};
+
+} // namespace logtail
@@ -168,8 +168,13 @@ public:
     StringBuffer CopyString(const std::string& s) { return CopyString(s.data(), s.length()); }
     StringBuffer CopyString(StringView s) { return CopyString(s.data(), s.length()); }
 
+    // memory not allocated by the source buffer (e.g. source buffers of merged groups) but referenced by string views in the
+    // group should be kept alive as long as the source buffer.
+    void AddExternalBuffer(std::shared_ptr<void> buffer) { mExternalBuffers.emplace_back(std::move(buffer)); }
+
 private:
     BufferAllocator mAllocator;
+    std::vector<std::shared_ptr<void>> mExternalBuffers;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class LogEventUnittest;
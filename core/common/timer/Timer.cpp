@@ -57,53 +57,62 @@ void Timer::Stop() {
 
 void Timer::PushEvent(unique_ptr<TimerEvent>&& e) {
     lock_guard<mutex> lock(mQueueMux);
-    if (mQueue.empty() || e->GetExecTime() < mQueue.top()->GetExecTime()) {
-        mQueue.push(std::move(e));
+    bool earlier = e->GetExecTime() < mNextWakeUpTime;
+    mWheel.Push(std::move(e));
+    if (earlier) {
+        mCV.notify_one();
+    }
+}
+
+void Timer::PushEvents(vector<unique_ptr<TimerEvent>>&& events) {
+    lock_guard<mutex> lock(mQueueMux);
+    bool earlier = false;
+    for (auto& e : events) {
+        earlier = earlier || e->GetExecTime() < mNextWakeUpTime;
+        mWheel.Push(std::move(e));
+    }
+    events.clear();
+    if (earlier) {
         mCV.notify_one();
-    } else {
-        mQueue.push(std::move(e));
     }
 }
 
 void Timer::Run() {
     LOG_INFO(sLogger, ("timer", "started"));
+    vector<unique_ptr<TimerEvent>> expired;
     unique_lock<mutex> threadLock(mThreadRunningMux);
     while (mIsThreadRunning) {
-        unique_lock<mutex> queueLock(mQueueMux);
-        if (mQueue.empty()) {
-            queueLock.unlock();
-            mCV.wait(threadLock, [this]() { return !mIsThreadRunning || !mQueue.empty(); });
-        } else {
-            auto now = chrono::steady_clock::now();
-            while (!mQueue.empty()) {
-                auto& e = mQueue.top();
-                if (now < e->GetExecTime()) {
-                    auto timeout = e->GetExecTime() - now + chrono::milliseconds(1);
-                    queueLock.unlock();
-                    mCV.wait_for(threadLock, timeout);
-                    break;
-                } else {
-                    auto e = std::move(const_cast<unique_ptr<TimerEvent>&>(mQueue.top()));
-                    mQueue.pop();
-                    queueLock.unlock();
-                    if (!e->IsValid()) {
-                        LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
-                    } else {
-                        e->Execute();
-                    }
-                    queueLock.lock();
-                }
+        chrono::steady_clock::time_point nextWakeUpTime;
+        {
+            lock_guard<mutex> queueLock(mQueueMux);
+            mWheel.PopExpired(chrono::steady_clock::now(), expired);
+            // no need to be woken up by new events while executing the expired ones
+            nextWakeUpTime = expired.empty() ? mWheel.GetNextTurnTime() : chrono::steady_clock::time_point::min();
+            mNextWakeUpTime = nextWakeUpTime;
+        }
+        if (expired.empty()) {
+            if (nextWakeUpTime == chrono::steady_clock::time_point::max()) {
+                mCV.wait(threadLock, [this]() { return !mIsThreadRunning || !mWheel.Empty(); });
+            } else {
+                mCV.wait_until(threadLock, nextWakeUpTime);
             }
+            continue;
         }
+        for (auto& e : expired) {
+            if (!e->IsValid()) {
+                LOG_INFO(sLogger, ("invalid timer event", "task is cancelled"));
+            } else {
+                e->Execute();
+            }
+        }
+        expired.clear();
     }
 }
 
 #ifdef APSARA_UNIT_TEST_MAIN
 void Timer::Clear() {
     lock_guard<mutex> lock(mQueueMux);
-    while (!mQueue.empty()) {
-        mQueue.pop();
-    }
+    mWheel.Clear();
 }
 #endif
 
@@ -16,22 +16,18 @@
 
 #pragma once
 
+#include <chrono>
 #include <condition_variable>
 #include <future>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 #include "common/timer/TimerEvent.h"
+#include "common/timer/TimingWheel.h"
 
 namespace logtail {
 
-struct TimerEventCompare {
-    bool operator()(const std::unique_ptr<TimerEvent>& lhs, const std::unique_ptr<TimerEvent>& rhs) const {
-        return lhs->GetExecTime() > rhs->GetExecTime();
-    }
-};
-
 class Timer {
 public:
     ~Timer();
@@ -46,6 +42,8 @@ public:
     void Init();
     void Stop();
     void PushEvent(std::unique_ptr<TimerEvent>&& e);
+    // push all events with the lock held only once
+    void PushEvents(std::vector<std::unique_ptr<TimerEvent>>&& events);
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
 #endif
@@ -55,8 +53,9 @@ private:
     void Run();
 
     mutable std::mutex mQueueMux;
-    std::priority_queue<std::unique_ptr<TimerEvent>, std::vector<std::unique_ptr<TimerEvent>>, TimerEventCompare>
-        mQueue;
+    TimingWheel mWheel;
+    // the time when the timer thread will wake up, events earlier than it need to wake up the thread
+    std::chrono::steady_clock::time_point mNextWakeUpTime = std::chrono::steady_clock::time_point::max();
 
     std::future<void> mThreadRes;
     mutable std::mutex mThreadRunningMux;
@@ -65,6 +64,7 @@ private:
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class TimerUnittest;
+    friend class TimerBenchmark;
     friend class ScrapeSchedulerUnittest;
     friend class HostMonitorInputRunnerUnittest;
 #endif
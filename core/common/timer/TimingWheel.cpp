@@ -0,0 +1,224 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/timer/TimingWheel.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace std;
+
+namespace logtail {
+
+static constexpr uint64_t kSlotMask = TimingWheel::kSlotCnt - 1;
+static constexpr uint64_t kMaxDelta = (1ULL << (TimingWheel::kSlotBits * TimingWheel::kLevelCnt)) - 1;
+
+static inline size_t LevelShift(size_t level) {
+    return level * TimingWheel::kSlotBits;
+}
+
+// @return the distance in [1, kSlotCnt] from slot idx to the next occupied slot after it, or 0 if no slot is occupied
+static size_t DistanceToNextOccupied(uint64_t occupied, size_t idx) {
+    if (occupied == 0) {
+        return 0;
+    }
+    size_t rotation = (idx + 1) & kSlotMask;
+    uint64_t bits = occupied;
+    if (rotation != 0) {
+        bits = (occupied >> rotation) | (occupied << (TimingWheel::kSlotCnt - rotation));
+    }
+    size_t dist = 1;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        ++dist;
+    }
+    return dist;
+}
+
+TimingWheel::TimingWheel(chrono::steady_clock::time_point start) : mStart(start) {
+}
+
+void TimingWheel::Push(unique_ptr<TimerEvent>&& e) {
+    Place(std::move(e));
+    ++mSize;
+}
+
+void TimingWheel::PopExpired(chrono::steady_clock::time_point now, vector<unique_ptr<TimerEvent>>& res) {
+    uint64_t nowTick = ToTick(now, false);
+    while (mCurrentTick < nowTick) {
+        // nothing happens before the next turn tick, so jump to it directly
+        uint64_t nextTick = GetNextTurnTick();
+        if (nextTick > nowTick) {
+            mCurrentTick = nowTick;
+            break;
+        }
+        mCurrentTick = nextTick - 1;
+        Turn();
+    }
+    if (mExpired.empty()) {
+        return;
+    }
+    mSize -= mExpired.size();
+    res.reserve(res.size() + mExpired.size());
+    for (auto& e : mExpired) {
+        res.emplace_back(std::move(e));
+    }
+    mExpired.clear();
+}
+
+chrono::steady_clock::time_point TimingWheel::GetNextTurnTime() const {
+    if (!mExpired.empty()) {
+        return mStart + chrono::milliseconds(mCurrentTick);
+    }
+    uint64_t nextTick = GetNextTurnTick();
+    if (nextTick == numeric_limits<uint64_t>::max()) {
+        return chrono::steady_clock::time_point::max();
+    }
+    return mStart + chrono::milliseconds(nextTick);
+}
+
+uint64_t TimingWheel::GetNextTurnTick() const {
+    uint64_t nextTick = numeric_limits<uint64_t>::max();
+    for (size_t level = 0; level < kLevelCnt; ++level) {
+        uint64_t levelTick = mCurrentTick >> LevelShift(level);
+        size_t dist = DistanceToNextOccupied(mOccupied[level], levelTick & kSlotMask);
+        if (dist != 0) {
+            // the slot is cascaded (or expires for level 0) when the wheel turns to its beginning
+            nextTick = min(nextTick, (levelTick + dist) << LevelShift(level));
+        }
+    }
+    return nextTick;
+}
+
+void TimingWheel::Clear() {
+    for (auto& level : mSlots) {
+        for (auto& slot : level) {
+            slot.clear();
+        }
+    }
+    mOccupied.fill(0);
+    mExpired.clear();
+    mSize = 0;
+}
+
+uint64_t TimingWheel::ToTick(chrono::steady_clock::time_point t, bool roundUp) const {
+    if (t <= mStart) {
+        return 0;
+    }
+    auto duration = t - mStart;
+    auto ms = chrono::duration_cast<chrono::milliseconds>(duration);
+    uint64_t tick = ms.count();
+    if (roundUp && ms < duration) {
+        ++tick;
+    }
+    return tick;
+}
+
+void TimingWheel::Place(unique_ptr<TimerEvent>&& e) {
+    uint64_t tick = ToTick(e->GetExecTime(), true);
+    if (tick <= mCurrentTick) {
+        mExpired.emplace_back(std::move(e));
+        return;
+    }
+    // too far away, wait in the highest level until it comes into the range of the wheel
+    tick = min(tick, mCurrentTick + kMaxDelta);
+    uint64_t delta = tick - mCurrentTick;
+    size_t level = 0;
+    while (level + 1 < kLevelCnt && delta >= (1ULL << LevelShift(level + 1))) {
+        ++level;
+    }
+    size_t idx = (tick >> LevelShift(level)) & kSlotMask;
+    mSlots[level][idx].emplace_back(std::move(e));
+    mOccupied[level] |= 1ULL << idx;
+}
+
+void TimingWheel::Cascade(size_t level) {
+    size_t idx = (mCurrentTick >> LevelShift(level)) & kSlotMask;
+    if ((mOccupied[level] & (1ULL << idx)) == 0) {
+        return;
+    }
+    Slot events;
+    events.swap(mSlots[level][idx]);
+    mOccupied[level] &= ~(1ULL << idx);
+    for (auto& e : events) {
+        Place(std::move(e));
+    }
+}
+
+void TimingWheel::Turn() {
+    ++mCurrentTick;
+    // cascade from the highest level, so that events cascaded to a lower level whose slot is also due are handled
+    for (size_t level = kLevelCnt - 1; level > 0; --level) {
+        if ((mCurrentTick & ((1ULL << LevelShift(level)) - 1)) == 0) {
+            Cascade(level);
+        }
+    }
+    size_t idx = mCurrentTick & kSlotMask;
+    if (mOccupied[0] & (1ULL << idx)) {
+        auto& slot = mSlots[0][idx];
+        for (auto& e : slot) {
+            mExpired.emplace_back(std::move(e));
+        }
+        slot.clear();
+        mOccupied[0] &= ~(1ULL << idx);
+    }
+}
+
+#ifdef APSARA_UNIT_TEST_MAIN
+const unique_ptr<TimerEvent>& TimingWheel::Top() const {
+    const unique_ptr<TimerEvent>* res = nullptr;
+    auto update = [&res](const Slot& slot) {
+        for (const auto& e : slot) {
+            if (res == nullptr || e->GetExecTime() < (*res)->GetExecTime()) {
+                res = &e;
+            }
+        }
+    };
+    update(mExpired);
+    for (const auto& level : mSlots) {
+        for (const auto& slot : level) {
+            update(slot);
+        }
+    }
+    return *res;
+}
+
+void TimingWheel::Pop() {
+    const auto* top = Top().get();
+    auto erase = [top](Slot& slot) {
+        auto it = find_if(slot.begin(), slot.end(), [top](const unique_ptr<TimerEvent>& e) { return e.get() == top; });
+        if (it == slot.end()) {
+            return false;
+        }
+        slot.erase(it);
+        return true;
+    };
+    --mSize;
+    if (erase(mExpired)) {
+        return;
+    }
+    for (size_t level = 0; level < kLevelCnt; ++level) {
+        for (size_t idx = 0; idx < kSlotCnt; ++idx) {
+            if (erase(mSlots[level][idx])) {
+                if (mSlots[level][idx].empty()) {
+                    mOccupied[level] &= ~(1ULL << idx);
+                }
+                return;
+            }
+        }
+    }
+}
+#endif
+
+} // namespace logtail
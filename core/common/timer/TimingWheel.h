@@ -0,0 +1,87 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common/timer/TimerEvent.h"
+
+namespace logtail {
+
+// TimingWheel is a hierarchical timing wheel of timer events with a resolution of 1ms. Pushing an event and popping an
+// expired one are both O(1), no matter how many events there are.
+//
+// Each level has kSlotCnt slots. A slot of level 0 covers 1ms, and a slot of level i covers a whole round of level i-1.
+// An event is put into the lowest level whose round covers its exec time, and is cascaded down to the lower levels when
+// the wheel turns to its slot. Events later than the round of the highest level are put into the last slot of the
+// highest level and are cascaded again until they are due.
+class TimingWheel {
+public:
+    static constexpr size_t kLevelCnt = 5;
+    static constexpr size_t kSlotBits = 6;
+    static constexpr size_t kSlotCnt = 1 << kSlotBits;
+
+    explicit TimingWheel(std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now());
+
+    void Push(std::unique_ptr<TimerEvent>&& e);
+    // Turn the wheel to now, and append all events whose exec time is not later than now to res in the order of exec
+    // time in milliseconds. The order of events within the same millisecond is not kept, since events cascaded from
+    // the higher levels are appended after those pushed directly into the slot of level 0.
+    void PopExpired(std::chrono::steady_clock::time_point now, std::vector<std::unique_ptr<TimerEvent>>& res);
+    // The wheel should be turned again no later than the returned time, which may be earlier than the exec time of the
+    // next event when it is in the higher levels. time_point::max() is returned if the wheel is empty.
+    std::chrono::steady_clock::time_point GetNextTurnTime() const;
+
+    bool Empty() const { return mSize == 0; }
+    size_t Size() const { return mSize; }
+    void Clear();
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    // O(n), only for tests
+    const std::unique_ptr<TimerEvent>& Top() const;
+    void Pop();
+#endif
+
+private:
+    using Slot = std::vector<std::unique_ptr<TimerEvent>>;
+
+    // @return the first tick after mCurrentTick when a slot expires or is cascaded, or uint64_t max if there is none
+    uint64_t GetNextTurnTick() const;
+    uint64_t ToTick(std::chrono::steady_clock::time_point t, bool roundUp) const;
+    void Place(std::unique_ptr<TimerEvent>&& e);
+    void Cascade(size_t level);
+    void Turn();
+
+    std::chrono::steady_clock::time_point mStart;
+    // all events with tick not later than mCurrentTick are in mExpired
+    uint64_t mCurrentTick = 0;
+    std::array<std::array<Slot, kSlotCnt>, kLevelCnt> mSlots;
+    // bit i is set if slot i of the level is not empty
+    std::array<uint64_t, kLevelCnt> mOccupied{};
+    Slot mExpired;
+    size_t mSize = 0;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class TimingWheelUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -0,0 +1,135 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/FileDiscoveryConfigIndex.h"
+
+#include "common/FileSystemUtil.h"
+
+using namespace std;
+
+namespace logtail {
+
+static void SplitPath(const string& path, vector<string>& components) {
+    size_t begin = 0;
+    while (begin < path.size()) {
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        if (end > begin) {
+            components.emplace_back(path.substr(begin, end - begin));
+        }
+        begin = end + 1;
+    }
+}
+
+bool FileDiscoveryConfigIndex::GetIndexedComponents(const FileDiscoveryOptions& opts, vector<string>& components) {
+    if (opts.IsContainerDiscoveryEnabled()) {
+        return false;
+    }
+    const auto& wildcardPaths = opts.GetWildcardPaths();
+    if (wildcardPaths.empty()) {
+        // the base path is compared literally
+        SplitPath(opts.GetBasePath(), components);
+        return true;
+    }
+    // the base path is a fnmatch pattern, in which only the components before the first special character are literal
+    SplitPath(wildcardPaths[0], components);
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (components[i].find_first_of("*?[\\") != string::npos) {
+            components.resize(i);
+            break;
+        }
+    }
+    return true;
+}
+
+void FileDiscoveryConfigIndex::Add(const string& name, const FileDiscoveryConfig& config) {
+    Remove(name);
+    Node* node = &mUnindexed;
+    vector<string> components;
+    if (GetIndexedComponents(*config.first, components)) {
+        node = &mRoot;
+        for (auto& component : components) {
+            auto& child = node->mChildren[component];
+            if (!child) {
+                child = make_unique<Node>();
+                child->mParent = node;
+                child->mComponent = component;
+            }
+            node = child.get();
+        }
+    }
+    node->mConfigs[name] = config;
+    mConfigNodes[name] = node;
+}
+
+void FileDiscoveryConfigIndex::Remove(const string& name) {
+    auto it = mConfigNodes.find(name);
+    if (it == mConfigNodes.end()) {
+        return;
+    }
+    Node* node = it->second;
+    mConfigNodes.erase(it);
+    node->mConfigs.erase(name);
+    // release the nodes no longer leading to any config
+    while (node->mParent != nullptr && node->mConfigs.empty() && node->mChildren.empty()) {
+        Node* parent = node->mParent;
+        parent->mChildren.erase(node->mComponent);
+        node = parent;
+    }
+}
+
+void FileDiscoveryConfigIndex::Clear() {
+    mRoot.mChildren.clear();
+    mRoot.mConfigs.clear();
+    mUnindexed.mConfigs.clear();
+    mConfigNodes.clear();
+}
+
+void FileDiscoveryConfigIndex::FindCandidates(const string& path, vector<FileDiscoveryConfig>& candidates) const {
+    const Node* node = &mRoot;
+    string component;
+    size_t begin = 0;
+    while (true) {
+        for (const auto& item : node->mConfigs) {
+            candidates.push_back(item.second);
+        }
+        if (node->mChildren.empty()) {
+            break;
+        }
+        while (begin < path.size() && path[begin] == PATH_SEPARATOR[0]) {
+            ++begin;
+        }
+        if (begin >= path.size()) {
+            break;
+        }
+        size_t end = path.find(PATH_SEPARATOR[0], begin);
+        if (end == string::npos) {
+            end = path.size();
+        }
+        component.assign(path, begin, end - begin);
+        begin = end;
+        auto it = node->mChildren.find(component);
+        if (it == node->mChildren.end()) {
+            break;
+        }
+        node = it->second.get();
+    }
+    for (const auto& item : mUnindexed.mConfigs) {
+        candidates.push_back(item.second);
+    }
+}
+
+} // namespace logtail
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "file_server/FileDiscoveryOptions.h"
+
+namespace logtail {
+
+// FileDiscoveryConfigIndex narrows down the file discovery configs that may match a path, so that matching a path
+// does not need to go through all configs.
+//
+// Configs are kept in a trie of path components, at the node of the constant prefix of their base path, i.e. the
+// whole base path if it has no wildcard, or the directories before the first wildcard otherwise. A path can only be
+// matched by configs on the nodes along the walk of its components. Configs with container discovery enabled match
+// the paths of containers, which are not known by the base path, so they are always candidates.
+//
+// The index is a filter only, and IsMatch should still be called on each candidate.
+class FileDiscoveryConfigIndex {
+public:
+    FileDiscoveryConfigIndex() = default;
+    FileDiscoveryConfigIndex(const FileDiscoveryConfigIndex&) = delete;
+    FileDiscoveryConfigIndex& operator=(const FileDiscoveryConfigIndex&) = delete;
+
+    // The config with the same name is replaced. The base path of the config should not change after it is added.
+    void Add(const std::string& name, const FileDiscoveryConfig& config);
+    void Remove(const std::string& name);
+    void Clear();
+
+    // Candidates are appended to @candidates, ordered from the shortest indexed prefix to the longest one, followed by
+    // the ones not indexed.
+    void FindCandidates(const std::string& path, std::vector<FileDiscoveryConfig>& candidates) const;
+
+    size_t Size() const { return mConfigNodes.size(); }
+
+private:
+    struct Node {
+        Node* mParent = nullptr;
+        std::string mComponent;
+        std::unordered_map<std::string, std::unique_ptr<Node>> mChildren;
+        // ordered by name so that the candidates are stable
+        std::map<std::string, FileDiscoveryConfig> mConfigs;
+    };
+
+    // @return false if the config cannot be indexed by path.
+    static bool GetIndexedComponents(const FileDiscoveryOptions& opts, std::vector<std::string>& components);
+
+    Node mRoot;
+    Node mUnindexed;
+    std::unordered_map<std::string, Node*> mConfigNodes;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileDiscoveryConfigIndexUnittest;
+#endif
+};
+
+} // namespace logtail
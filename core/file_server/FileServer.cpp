@@ -140,12 +140,20 @@ void FileServer::AddFileDiscoveryConfig(const string& name,
                                         const CollectionPipelineContext* ctx) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap[name] = make_pair(opts, ctx);
+    mFileDiscoveryConfigIndex.Add(name, make_pair(opts, ctx));
 }
 
 // 移除给定名称的文件发现配置
 void FileServer::RemoveFileDiscoveryConfig(const string& name) {
     WriteLock lock(mReadWriteLock);
     mPipelineNameFileDiscoveryConfigsMap.erase(name);
+    mFileDiscoveryConfigIndex.Remove(name);
+}
+
+// 获取可能匹配给定路径的文件发现配置
+void FileServer::GetCandidateFileDiscoveryConfigs(const string& path, vector<FileDiscoveryConfig>& configs) const {
+    ReadLock lock(mReadWriteLock);
+    mFileDiscoveryConfigIndex.FindCandidates(path, configs);
 }
 
 // 获取给定名称的文件读取器配置
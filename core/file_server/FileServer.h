@@ -19,9 +19,11 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "collection_pipeline/CollectionPipelineContext.h"
 #include "common/Lock.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
 #include "file_server/FileDiscoveryOptions.h"
 #include "file_server/FileTagOptions.h"
 #include "file_server/MultilineOptions.h"
@@ -53,6 +55,8 @@ public:
     void
     AddFileDiscoveryConfig(const std::string& name, FileDiscoveryOptions* opts, const CollectionPipelineContext* ctx);
     void RemoveFileDiscoveryConfig(const std::string& name);
+    // The candidates may match the path, and IsMatch should be called on each of them.
+    void GetCandidateFileDiscoveryConfigs(const std::string& path, std::vector<FileDiscoveryConfig>& configs) const;
 
     FileReaderConfig GetFileReaderConfig(const std::string& name) const;
     const std::unordered_map<std::string, FileReaderConfig>& GetAllFileReaderConfigs() const {
@@ -110,6 +114,7 @@ private:
     mutable ReadWriteLock mReadWriteLock;
 
     std::unordered_map<std::string, FileDiscoveryConfig> mPipelineNameFileDiscoveryConfigsMap;
+    FileDiscoveryConfigIndex mFileDiscoveryConfigIndex;
     std::unordered_map<std::string, FileReaderConfig> mPipelineNameFileReaderConfigsMap;
     std::unordered_map<std::string, MultilineConfig> mPipelineNameMultilineConfigsMap;
     std::unordered_map<std::string, FileTagConfig> mPipelineNameFileTagConfigsMap;
@@ -14,6 +14,7 @@
 
 #include "EventHandler.h"
 
+#include <atomic>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -201,6 +202,22 @@ bool CreateModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void CreateModifyHandler::CollectReadersToPrefetch(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    if (!event.IsModify() || event.IsDir()) {
+        return;
+    }
+    if (!event.GetConfigName().empty()) {
+        auto iter = mModifyHandlerPtrMap.find(event.GetConfigName());
+        if (iter != mModifyHandlerPtrMap.end()) {
+            iter->second->CollectReadersToPrefetch(event, readers);
+        }
+        return;
+    }
+    for (auto& item : mModifyHandlerPtrMap) {
+        item.second->CollectReadersToPrefetch(event, readers);
+    }
+}
+
 ModifyHandler* CreateModifyHandler::GetOrCreateModifyHandler(const std::string& configName,
                                                              const FileDiscoveryConfig& pConfig) {
     ModifyHandlerMap::iterator iter = mModifyHandlerPtrMap.find(configName);
@@ -664,6 +681,13 @@ void ModifyHandler::Handle(const Event& event) {
             LOG_ERROR(sLogger, ("unknow error, reader array size is 0", logPath));
             return;
         }
+        if (LogInput::GetInstance()->IsReadingInParallel() && LogInput::GetInstance()->HasReadTask(readerArrayPtr)) {
+            // the file is to be read for another event of the batch, handle this event in the next batch
+            Event* ev = new Event(event);
+            ev->SetConfigName(mConfigName);
+            LogInput::GetInstance()->PushEventQueue(ev);
+            return;
+        }
         LogFileReaderPtr reader = (*readerArrayPtr)[0];
         // If file modified, it means the file is existed, then we should set fileDeletedFlag to false
         // NOTE: This may override the correct delete flag, which will cause fd close delay!
@@ -763,131 +787,20 @@ void ModifyHandler::Handle(const Event& event) {
             }
         }
 
-        bool hasMoreData;
-        do {
-            if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
-                static int32_t s_lastOutPutTime = 0;
-                int32_t curTime = time(NULL);
-                if (curTime - s_lastOutPutTime > 600) {
-                    s_lastOutPutTime = curTime;
-                    LOG_WARNING(sLogger,
-                                ("logprocess queue is full, put modify event to event queue again",
-                                 reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
-
-                    AlarmManager::GetInstance()->SendAlarm(
-                        PROCESS_QUEUE_BUSY_ALARM,
-                        string("logprocess queue is full, put modify event to event queue again, file:")
-                            + reader->GetHostLogPath(),
-                        reader->GetRegion(),
-                        reader->GetProject(),
-                        reader->GetConfigName(),
-                        reader->GetLogstore());
-                }
-
-                BlockedEventManager::GetInstance()->UpdateBlockEvent(
-                    reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), curTime);
-                return;
-            }
-            auto logBuffer = make_unique<LogBuffer>();
-            hasMoreData = reader->ReadLog(*logBuffer, &event);
-            int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get());
-            if (!hasMoreData) {
-                if (reader->IsFileDeleted()) {
-                    LOG_INFO(sLogger,
-                             ("close the file", "current file has been read, and is marked deleted")(
-                                 "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                 "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                 "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                                 "file size", reader->GetFileSize()));
-                    reader->CloseFilePtr();
-                } else if (reader->IsContainerStopped()) {
-                    // update container info one more time, ensure file is hold by same cotnainer
-                    if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
-                        LOG_INFO(sLogger,
-                                 ("file is reused by a new container", reader->GetContainerID())(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                    } else {
-                        // release fd as quick as possible
-                        LOG_INFO(sLogger,
-                                 ("close the file",
-                                  "current file has been read, and the relative container has been stopped")(
-                                     "project", reader->GetProject())("logstore", reader->GetLogstore())(
-                                     "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
-                                     "file device", reader->GetDevInode().dev)(
-                                     "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
-                        ForceReadLogAndPush(reader);
-                        reader->CloseFilePtr();
-                    }
-                }
-                break;
-            }
-            if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > mReadFileTimeSlice) {
-                LOG_DEBUG(
-                    sLogger,
-                    ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
-                        "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject()));
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-
-            // When loginput thread hold on, we should repush this event back.
-            // If we don't repush and this file has no modify event, this reader will never been read.
-            if (LogInput::GetInstance()->IsInterupt()) {
-                if (hasMoreData) {
-                    LOG_INFO(sLogger,
-                             ("read log interupt but has more data, reason",
-                              "log input thread hold on")("action", "repush modify event to event queue")(
-                                 "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
-                                 "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
-                                 "size", reader->GetFileSize()));
-                } else {
-                    LOG_DEBUG(sLogger,
-                              ("read log breakout, reason",
-                               "log input thread hold on")("action", "repush modify event to event queue")(
-                                  "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
-                                  "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
-                                  "size", reader->GetFileSize()));
-                }
-                Event* ev = new Event(event);
-                ev->SetConfigName(mConfigName);
-                LogInput::GetInstance()->PushEventQueue(ev);
-                break;
-            }
-        } while (true);
-
-        if (!hasMoreData && readerArrayPtr->size() > (size_t)1) {
-            // when a rotated reader finish its reading, it's unlikely that there will be data again
-            // so release file fd as quick as possible (open again if new data coming)
-            LOG_INFO(sLogger,
-                     ("close the file and move the corresponding reader to the rotator reader pool",
-                      "current file has been read and more files are waiting in the log reader queue")(
-                         "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
-                         "log reader queue name", reader->GetHostLogPath())("log reader queue size",
-                                                                            readerArrayPtr->size() - 1)(
-                         "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
-                         "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
-            ForceReadLogAndPush(reader);
-            reader->CloseFilePtr();
-            readerArrayPtr->pop_front();
-            mDevInodeReaderMap.erase(reader->GetDevInode());
-            mRotatorReaderMap[reader->GetDevInode()] = reader;
-            // need to push modify event again, but without dev inode
-            // use head dev + inode
-            Event* ev = new Event(event.GetSource(),
-                                  event.GetEventObject(),
-                                  event.GetType(),
-                                  event.GetWd(),
-                                  event.GetCookie(),
-                                  (*readerArrayPtr)[0]->GetDevInode().dev,
-                                  (*readerArrayPtr)[0]->GetDevInode().inode);
-            ev->SetConfigName(mConfigName);
-            LogInput::GetInstance()->PushEventQueue(ev);
+        if (LogInput::GetInstance()->IsReadingInParallel()) {
+            auto result = make_shared<FileReadResult>();
+            LogInput::GetInstance()->AddReadTask(
+                readerArrayPtr,
+                reader->GetDevInode(),
+                [this, event, reader, result]() { ReadFile(event, reader, GetCurrentTimeInMicroSeconds(), *result); },
+                [this, event, reader, readerArrayPtr, result]() {
+                    OnFileRead(event, reader, readerArrayPtr, *result);
+                });
+            return;
         }
+        FileReadResult result;
+        ReadFile(event, reader, beginTime, result);
+        OnFileRead(event, reader, readerArrayPtr, result);
     }
     // if a file is created, and dev inode cannot found(this means it's a new file), create reader for this file, then
     // insert reader into mDevInodeReaderMap
@@ -913,6 +826,157 @@ void ModifyHandler::Handle(const Event& event) {
     }
 }
 
+void ModifyHandler::ReadFile(const Event& event,
+                             const LogFileReaderPtr& reader,
+                             uint64_t beginTime,
+                             FileReadResult& result) {
+    bool& hasMoreData = result.mHasMoreData;
+    do {
+        if (!ProcessQueueManager::GetInstance()->IsValidToPush(reader->GetQueueKey())) {
+            static atomic_int s_lastOutPutTime{0};
+            int32_t curTime = time(NULL);
+            int32_t lastOutPutTime = s_lastOutPutTime.load();
+            if (curTime - lastOutPutTime > 600 && s_lastOutPutTime.compare_exchange_strong(lastOutPutTime, curTime)) {
+                LOG_WARNING(sLogger,
+                            ("logprocess queue is full, put modify event to event queue again",
+                             reader->GetHostLogPath())(reader->GetProject(), reader->GetLogstore()));
+
+                AlarmManager::GetInstance()->SendAlarm(
+                    PROCESS_QUEUE_BUSY_ALARM,
+                    string("logprocess queue is full, put modify event to event queue again, file:")
+                        + reader->GetHostLogPath(),
+                    reader->GetRegion(),
+                    reader->GetProject(),
+                    reader->GetConfigName(),
+                    reader->GetLogstore());
+            }
+
+            result.mBlocked = true;
+            return;
+        }
+        auto logBuffer = make_unique<LogBuffer>();
+        hasMoreData = reader->ReadLog(*logBuffer, &event);
+        int32_t pushRetry = PushLogToProcessor(reader, logBuffer.get(), &result.mUnpushedGroup);
+        if (result.mUnpushedGroup) {
+            result.mRepushEvent = true;
+            break;
+        }
+        if (!hasMoreData) {
+            if (reader->IsFileDeleted()) {
+                LOG_INFO(sLogger,
+                         ("close the file", "current file has been read, and is marked deleted")(
+                             "project", reader->GetProject())("logstore", reader->GetLogstore())(
+                             "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
+                             "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
+                             "file size", reader->GetFileSize()));
+                reader->CloseFilePtr();
+            } else if (reader->IsContainerStopped()) {
+                // update container info one more time, ensure file is hold by same cotnainer
+                if (reader->UpdateContainerInfo() && !reader->IsContainerStopped()) {
+                    LOG_INFO(sLogger,
+                             ("file is reused by a new container", reader->GetContainerID())(
+                                 "project", reader->GetProject())("logstore", reader->GetLogstore())(
+                                 "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
+                                 "file device", reader->GetDevInode().dev)(
+                                 "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+                } else {
+                    // release fd as quick as possible
+                    LOG_INFO(sLogger,
+                             ("close the file",
+                              "current file has been read, and the relative container has been stopped")(
+                                 "project", reader->GetProject())("logstore", reader->GetLogstore())(
+                                 "config", mConfigName)("log reader queue name", reader->GetHostLogPath())(
+                                 "file device", reader->GetDevInode().dev)(
+                                 "file inode", reader->GetDevInode().inode)("file size", reader->GetFileSize()));
+                    ForceReadLogAndPush(reader, &result.mUnpushedGroup);
+                    reader->CloseFilePtr();
+                }
+            }
+            break;
+        }
+        if (pushRetry >= 5 || GetCurrentTimeInMicroSeconds() - beginTime > mReadFileTimeSlice) {
+            LOG_DEBUG(
+                sLogger,
+                ("read log breakout", "file io cost 1 time slice (50ms) or push blocked")("pushRetry", pushRetry)(
+                    "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject()));
+            result.mRepushEvent = true;
+            break;
+        }
+
+        // When loginput thread hold on, we should repush this event back.
+        // If we don't repush and this file has no modify event, this reader will never been read.
+        if (LogInput::GetInstance()->IsInterupt()) {
+            if (hasMoreData) {
+                LOG_INFO(sLogger,
+                         ("read log interupt but has more data, reason",
+                          "log input thread hold on")("action", "repush modify event to event queue")(
+                             "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
+                             "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
+                             "size", reader->GetFileSize()));
+            } else {
+                LOG_DEBUG(sLogger,
+                          ("read log breakout, reason",
+                           "log input thread hold on")("action", "repush modify event to event queue")(
+                              "begin time", beginTime)("path", event.GetSource())("file", event.GetEventObject())(
+                              "inode", reader->GetDevInode().inode)("offset", reader->GetLastFilePos())(
+                              "size", reader->GetFileSize()));
+            }
+            result.mRepushEvent = true;
+            break;
+        }
+    } while (true);
+}
+
+void ModifyHandler::OnFileRead(const Event& event,
+                               const LogFileReaderPtr& reader,
+                               LogFileReaderPtrArray* readerArrayPtr,
+                               FileReadResult& result) {
+    if (result.mUnpushedGroup) {
+        PushGroupToProcessor(reader, std::move(*result.mUnpushedGroup), nullptr);
+        result.mUnpushedGroup.reset();
+    }
+    if (result.mBlocked) {
+        BlockedEventManager::GetInstance()->UpdateBlockEvent(
+            reader->GetQueueKey(), mConfigName, event, reader->GetDevInode(), time(NULL));
+        return;
+    }
+    if (result.mRepushEvent) {
+        Event* ev = new Event(event);
+        ev->SetConfigName(mConfigName);
+        LogInput::GetInstance()->PushEventQueue(ev);
+        return;
+    }
+    // the reader array may have been changed by other events of the batch when files are read in parallel
+    if (!result.mHasMoreData && readerArrayPtr->size() > (size_t)1 && (*readerArrayPtr)[0] == reader) {
+        // when a rotated reader finish its reading, it's unlikely that there will be data again
+        // so release file fd as quick as possible (open again if new data coming)
+        LOG_INFO(sLogger,
+                 ("close the file and move the corresponding reader to the rotator reader pool",
+                  "current file has been read and more files are waiting in the log reader queue")(
+                     "project", reader->GetProject())("logstore", reader->GetLogstore())("config", mConfigName)(
+                     "log reader queue name", reader->GetHostLogPath())("log reader queue size",
+                                                                        readerArrayPtr->size() - 1)(
+                     "file device", reader->GetDevInode().dev)("file inode", reader->GetDevInode().inode)(
+                     "file size", reader->GetFileSize())("rotator reader pool size", mRotatorReaderMap.size() + 1));
+        ForceReadLogAndPush(reader);
+        reader->CloseFilePtr();
+        readerArrayPtr->pop_front();
+        mDevInodeReaderMap.erase(reader->GetDevInode());
+        mRotatorReaderMap[reader->GetDevInode()] = reader;
+        // need to push modify event again, but without dev inode
+        // use head dev + inode
+        Event* ev = new Event(event.GetSource(),
+                              event.GetEventObject(),
+                              event.GetType(),
+                              event.GetWd(),
+                              event.GetCookie(),
+                              (*readerArrayPtr)[0]->GetDevInode().dev,
+                              (*readerArrayPtr)[0]->GetDevInode().inode);
+        ev->SetConfigName(mConfigName);
+        LogInput::GetInstance()->PushEventQueue(ev);
+    }
+}
+
 void ModifyHandler::HandleTimeOut() {
     MakeSpaceForNewReader();
     DeleteTimeoutReader();
@@ -1021,6 +1085,21 @@ bool ModifyHandler::IsAllFileRead() {
     return true;
 }
 
+void ModifyHandler::CollectReadersToPrefetch(const Event& event, std::vector<LogFileReaderPtr>& readers) {
+    if (!event.IsModify()) {
+        return;
+    }
+    // same as Handle, the head of the reader array is the one to be read
+    auto iter = mNameReaderMap.find(event.GetEventObject());
+    if (iter == mNameReaderMap.end() || iter->second.empty()) {
+        return;
+    }
+    const auto& reader = iter->second[0];
+    if (reader->IsFileOpened()) {
+        readers.emplace_back(reader);
+    }
+}
+
 void ModifyHandler::DeleteTimeoutReader() {
     if ((int32_t)mDevInodeReaderMap.size() > INT32_FLAG(logreader_count_maxlimit))
         DeleteTimeoutReader(86400);
@@ -1091,24 +1170,36 @@ void ModifyHandler::DeleteRollbackReader() {
         mRotatorReaderMap.erase(*keyIter);
 }
 
-void ModifyHandler::ForceReadLogAndPush(LogFileReaderPtr reader) {
+void ModifyHandler::ForceReadLogAndPush(LogFileReaderPtr reader, unique_ptr<PipelineEventGroup>* unpushedGroup) {
     auto logBuffer = make_unique<LogBuffer>();
     auto pEvent = reader->CreateFlushTimeoutEvent();
     reader->ReadLog(*logBuffer, pEvent.get());
-    PushLogToProcessor(reader, logBuffer.get());
+    PushLogToProcessor(reader, logBuffer.get(), unpushedGroup);
 }
 
-int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer) {
+int32_t ModifyHandler::PushLogToProcessor(LogFileReaderPtr reader,
+                                          LogBuffer* logBuffer,
+                                          unique_ptr<PipelineEventGroup>* unpushedGroup) {
+    if (logBuffer->rawBuffer.empty()) {
+        return 0;
+    }
+    reader->ReportMetrics(logBuffer->readLength);
+    return PushGroupToProcessor(reader, LogFileReader::GenerateEventGroup(reader, logBuffer), unpushedGroup);
+}
+
+int32_t ModifyHandler::PushGroupToProcessor(const LogFileReaderPtr& reader,
+                                            PipelineEventGroup&& group,
+                                            unique_ptr<PipelineEventGroup>* unpushedGroup) {
     int32_t pushRetry = 0;
-    if (!logBuffer->rawBuffer.empty()) {
-        reader->ReportMetrics(logBuffer->readLength);
-        PipelineEventGroup group = LogFileReader::GenerateEventGroup(reader, logBuffer);
-
-        while (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), 0, std::move(group))) // 10ms
-        {
-            ++pushRetry;
-            if (pushRetry % 10 == 0)
-                LogInput::GetInstance()->TryReadEvents(false);
+    while (!ProcessorRunner::GetInstance()->PushQueue(reader->GetQueueKey(), 0, std::move(group))) // 10ms
+    {
+        ++pushRetry;
+        if (pushRetry % 10 == 0) {
+            if (unpushedGroup != nullptr) {
+                *unpushedGroup = make_unique<PipelineEventGroup>(std::move(group));
+                break;
+            }
+            LogInput::GetInstance()->TryReadEvents(false);
         }
     }
     return pushRetry;
@@ -19,6 +19,7 @@
 
 #include <deque>
 #include <map>
+#include <memory>
 #include <unordered_map>
 
 #include "file_server/reader/LogFileReader.h"
@@ -40,6 +41,8 @@ public:
     virtual void HandleTimeOut() = 0;
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag) = 0;
     virtual bool IsAllFileRead() { return true; }
+    // collect readers which will be read when the event is handled, used for batched read
+    virtual void CollectReadersToPrefetch(const Event& event, std::vector<LogFileReaderPtr>& readers) {}
     virtual ~EventHandler() {}
 };
 
@@ -98,9 +101,33 @@ private:
                                             uint32_t exactlyonceConcurrency = 0,
                                             bool forceBeginingFlag = false);
 
-    int32_t PushLogToProcessor(LogFileReaderPtr reader, LogBuffer* logBuffer);
-
-    void ForceReadLogAndPush(LogFileReaderPtr reader);
+    struct FileReadResult {
+        bool mHasMoreData = false;
+        bool mBlocked = false;
+        bool mRepushEvent = false;
+        // log read but not pushed to the process queue by a reader thread, pushed later by the input thread
+        std::unique_ptr<PipelineEventGroup> mUnpushedGroup;
+    };
+
+    // Reads the file until there is no more data, the time slice is used up or the process queue is blocked. Only the
+    // reader itself is changed, so it can be called by reader threads of LogInput.
+    void ReadFile(const Event& event, const LogFileReaderPtr& reader, uint64_t beginTime, FileReadResult& result);
+    // Applies the result of ReadFile to the event queue and reader maps, which is only allowed in the input thread.
+    void OnFileRead(const Event& event,
+                    const LogFileReaderPtr& reader,
+                    LogFileReaderPtrArray* readerArrayPtr,
+                    FileReadResult& result);
+
+    // If unpushedGroup is given, pushing gives up after a few retries and the group is left in it, since the event
+    // queue can only be drained by the input thread when the process queue is full.
+    int32_t PushLogToProcessor(LogFileReaderPtr reader,
+                               LogBuffer* logBuffer,
+                               std::unique_ptr<PipelineEventGroup>* unpushedGroup = nullptr);
+    int32_t PushGroupToProcessor(const LogFileReaderPtr& reader,
+                                 PipelineEventGroup&& group,
+                                 std::unique_ptr<PipelineEventGroup>* unpushedGroup);
+
+    void ForceReadLogAndPush(LogFileReaderPtr reader, std::unique_ptr<PipelineEventGroup>* unpushedGroup = nullptr);
 
     // no copy
     ModifyHandler(const ModifyHandler&);
@@ -113,6 +140,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void CollectReadersToPrefetch(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
     const std::string& GetConfigName() const { return mConfigName; }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -170,6 +198,7 @@ public:
     virtual void HandleTimeOut();
     virtual bool DumpReaderMeta(bool isRotatorReader, bool checkConfigFlag);
     bool IsAllFileRead() override;
+    void CollectReadersToPrefetch(const Event& event, std::vector<LogFileReaderPtr>& readers) override;
 
     ModifyHandler* GetOrCreateModifyHandler(const std::string& configName, const FileDiscoveryConfig& pConfig);
 
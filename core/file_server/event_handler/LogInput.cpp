@@ -35,6 +35,7 @@
 #include "file_server/polling/PollingDirFile.h"
 #include "file_server/polling/PollingEventQueue.h"
 #include "file_server/polling/PollingModify.h"
+#include "file_server/reader/FileReadEngine.h"
 #include "file_server/reader/GloablFileDescriptorManager.h"
 #include "file_server/reader/LogFileReader.h"
 #include "logger/Logger.h"
@@ -53,12 +54,21 @@ DEFINE_FLAG_INT32(dump_inotify_watcher_interval, "seconds", 180);
 DEFINE_FLAG_INT32(clear_config_match_interval, "seconds", 600);
 DEFINE_FLAG_INT32(check_block_event_interval, "seconds", 1);
 DEFINE_FLAG_INT32(read_local_event_interval, "seconds", 60);
+DEFINE_FLAG_BOOL(enable_batched_file_read,
+                 "read the files of a batch of modify events at once before handling them, with io_uring if possible",
+                 false);
+DEFINE_FLAG_INT32(batched_file_read_max_events, "max number of events handled in one batch", 128);
+DEFINE_FLAG_INT32(log_input_reader_thread_count,
+                  "number of threads reading files for modify events, 1 means reading in the input thread",
+                  1);
 DEFINE_FLAG_BOOL(force_close_file_on_container_stopped,
                  "whether close file handler immediately when associate container stopped",
                  false);
 
 
 namespace logtail {
+thread_local bool LogInput::sIsReaderThread = false;
+
 LogInput::LogInput() : mAccessMainThreadRWL(ReadWriteLock::PREFER_WRITER) {
     mCheckBaseDirInterval = INT32_FLAG(check_base_dir_interval);
     mCheckSymbolicLinkInterval = INT32_FLAG(check_symbolic_link_interval);
@@ -90,7 +100,14 @@ void LogInput::Start() {
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_ACTIVE_READERS_TOTAL);
     mEnableFileIncludedByMultiConfigs = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
         METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG);
-
+    mBatchedReadSubmittedTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+        METRIC_RUNNER_FILE_BATCHED_READ_SUBMITTED_TOTAL);
+    mBatchedReadCompletedTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+        METRIC_RUNNER_FILE_BATCHED_READ_COMPLETED_TOTAL);
+    mParallelReadTasksTotal = FileServer::GetInstance()->GetMetricsRecordRef().CreateCounter(
+        METRIC_RUNNER_FILE_PARALLEL_READ_TASKS_TOTAL);
+
+    StartReaderThreads();
     mThreadRes = async(launch::async, &LogInput::ProcessLoop, this);
 }
 
@@ -119,7 +136,8 @@ void LogInput::HoldOn() {
 }
 
 void LogInput::TryReadEvents(bool forceRead) {
-    if (mInteruptFlag)
+    // events can only be read by the input thread, while reader threads may also be blocked by process queue
+    if (mInteruptFlag || sIsReaderThread)
         return;
 
     int64_t curMicroSeconds = GetCurrentTimeInMicroSeconds();
@@ -374,16 +392,43 @@ void LogInput::ProcessLoop() {
     mEventProcessCount = 0;
     BlockedEventManager* pBlockedEventManager = BlockedEventManager::GetInstance();
     string path;
+    vector<Event*> events;
     while (true) {
         ReadLock lock(mAccessMainThreadRWL);
         TryReadEvents(false);
-        Event* ev = PopEventQueue();
-        if (ev != NULL) {
-            ++mEventProcessCount;
-            if (mIdleFlag) {
-                delete ev;
-            } else
-                ProcessEvent(dispatcher, ev);
+        if (BOOL_FLAG(enable_batched_file_read) || mReaderThreadCnt > 1) {
+            PopEventQueue(events, INT32_FLAG(batched_file_read_max_events));
+        } else if (Event* ev = PopEventQueue()) {
+            events.push_back(ev);
+        }
+        if (!events.empty()) {
+            if (BOOL_FLAG(enable_batched_file_read) && events.size() > 1 && !mIdleFlag) {
+                PrefetchEvents(dispatcher, events);
+            }
+            mIsCollectingReadTasks = mReaderThreadCnt > 1;
+            for (size_t i = 0; i < events.size(); ++i) {
+                if (i > 0 && mInteruptFlag && !mIdleFlag) {
+                    // do not block HoldOn with the rest of the batch, which must still go before the events
+                    // queued meanwhile
+                    RequeueEventsToFront(vector<Event*>(events.begin() + i, events.end()));
+                    break;
+                }
+                Event* ev = events[i];
+                ++mEventProcessCount;
+                if (mIdleFlag) {
+                    delete ev;
+                } else {
+                    if (!ev->IsModify() || ev->IsDir()) {
+                        // other events may change the readers or delete the handlers used by the read tasks
+                        FlushReadTasks();
+                    }
+                    ProcessEvent(dispatcher, ev);
+                }
+            }
+            FlushReadTasks();
+            mIsCollectingReadTasks = false;
+            events.clear();
+            ReleasePrefetchedData();
         } else {
             unique_lock<mutex> lock(mFeedbackMux);
             mFeedbackCV.wait_for(lock, chrono::microseconds(INT32_FLAG(log_input_thread_wait_interval)));
@@ -460,6 +505,7 @@ void LogInput::ProcessLoop() {
         }
     }
 
+    StopReaderThreads();
     mInteruptFlag = true;
 }
 
@@ -523,6 +569,153 @@ Event* LogInput::PopEventQueue() {
     return NULL;
 }
 
+void LogInput::PopEventQueue(vector<Event*>& events, size_t maxCount) {
+    while (events.size() < maxCount) {
+        Event* ev = PopEventQueue();
+        if (ev == NULL) {
+            break;
+        }
+        events.push_back(ev);
+    }
+}
+
+void LogInput::RequeueEventsToFront(const vector<Event*>& events) {
+    queue<Event*> eventQueue;
+    for (Event* ev : events) {
+        if (ev->GetType() == EVENT_MODIFY) {
+            mModifyEventSet.insert(ev->GetHashKey());
+        }
+        eventQueue.push(ev);
+    }
+    while (!mInotifyEventQueue.empty()) {
+        eventQueue.push(mInotifyEventQueue.front());
+        mInotifyEventQueue.pop();
+    }
+    mInotifyEventQueue.swap(eventQueue);
+}
+
+void LogInput::PrefetchEvents(EventDispatcher* dispatcher, const vector<Event*>& events) {
+    vector<LogFileReaderPtr> readers;
+    for (const Event* ev : events) {
+        if (!ev->IsModify() || ev->IsDir()) {
+            continue;
+        }
+        EventHandler* handler = dispatcher->GetHandler(ev->GetSource().c_str());
+        if (handler) {
+            handler->CollectReadersToPrefetch(*ev, readers);
+        }
+    }
+    if (readers.empty()) {
+        return;
+    }
+
+    unordered_set<LogFileReader*> seen;
+    vector<FileReadRequest> requests;
+    for (auto& reader : readers) {
+        if (!seen.insert(reader.get()).second) {
+            continue;
+        }
+        FileReadRequest request;
+        if (reader->PrepareBatchRead(request)) {
+            requests.emplace_back(std::move(request));
+            mPrefetchedReaders.emplace_back(reader);
+        }
+    }
+    size_t completed = FileReadEngine::GetInstance()->Read(requests);
+    ADD_COUNTER(mBatchedReadSubmittedTotal, requests.size());
+    ADD_COUNTER(mBatchedReadCompletedTotal, completed);
+    for (size_t i = 0; i < requests.size(); ++i) {
+        mPrefetchedReaders[i]->SetPrefetchedData(std::move(requests[i]));
+    }
+}
+
+void LogInput::ReleasePrefetchedData() {
+    // data not consumed by the batch is stale, give the buffers back
+    for (auto& reader : mPrefetchedReaders) {
+        reader->ReleasePrefetchedData();
+    }
+    mPrefetchedReaders.clear();
+}
+
+void LogInput::StartReaderThreads() {
+    mReaderThreadCnt = static_cast<uint32_t>(max(1, INT32_FLAG(log_input_reader_thread_count)));
+    if (mReaderThreadCnt == 1) {
+        return;
+    }
+    mIsReaderThreadStopped = false;
+    for (uint32_t threadNo = 0; threadNo < mReaderThreadCnt; ++threadNo) {
+        mReaderQueues.emplace_back(make_unique<SafeQueue<ReadTask*>>());
+    }
+    for (uint32_t threadNo = 0; threadNo < mReaderThreadCnt; ++threadNo) {
+        mReaderThreadRes.emplace_back(async(launch::async, &LogInput::ReaderThreadLoop, this, threadNo));
+    }
+}
+
+void LogInput::StopReaderThreads() {
+    mIsReaderThreadStopped = true;
+    for (auto& res : mReaderThreadRes) {
+        if (res.valid()) {
+            res.wait();
+        }
+    }
+    mReaderThreadRes.clear();
+    mReaderQueues.clear();
+    mReaderThreadCnt = 1;
+}
+
+void LogInput::ReaderThreadLoop(uint32_t threadNo) {
+    LOG_INFO(sLogger, ("log input reader thread", "started")("thread no", threadNo));
+    sIsReaderThread = true;
+    auto& queue = *mReaderQueues[threadNo];
+    while (!mIsReaderThreadStopped) {
+        ReadTask* task = nullptr;
+        if (!queue.WaitAndPop(task, 100)) {
+            continue;
+        }
+        task->mRead();
+        lock_guard<mutex> lock(mReadTaskMux);
+        if (--mUnfinishedReadTaskCnt == 0) {
+            mReadTaskCV.notify_one();
+        }
+    }
+    LOG_INFO(sLogger, ("log input reader thread", "stopped")("thread no", threadNo));
+}
+
+void LogInput::AddReadTask(const void* key,
+                           const DevInode& devInode,
+                           function<void()>&& read,
+                           function<void()>&& onRead) {
+    auto task = make_unique<ReadTask>();
+    task->mThreadNo = DevInodeHash()(devInode) % mReaderThreadCnt;
+    task->mRead = std::move(read);
+    task->mOnRead = std::move(onRead);
+    mReadTasks.emplace_back(std::move(task));
+    mReadTaskKeys.insert(key);
+}
+
+void LogInput::FlushReadTasks() {
+    if (mReadTasks.empty()) {
+        return;
+    }
+    {
+        lock_guard<mutex> lock(mReadTaskMux);
+        mUnfinishedReadTaskCnt = mReadTasks.size();
+    }
+    for (auto& task : mReadTasks) {
+        mReaderQueues[task->mThreadNo]->Push(task.get());
+    }
+    {
+        unique_lock<mutex> lock(mReadTaskMux);
+        mReadTaskCV.wait(lock, [this]() { return mUnfinishedReadTaskCnt == 0; });
+    }
+    ADD_COUNTER(mParallelReadTasksTotal, mReadTasks.size());
+    for (auto& task : mReadTasks) {
+        task->mOnRead();
+    }
+    mReadTasks.clear();
+    mReadTaskKeys.clear();
+}
+
 #ifdef APSARA_UNIT_TEST_MAIN
 void LogInput::CleanEnviroments() {
     mIdleFlag = true;
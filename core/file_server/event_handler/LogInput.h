@@ -17,20 +17,27 @@
 #ifndef __LOG_ILOGTAIL_LOG_INPUT_H__
 #define __LOG_ILOGTAIL_LOG_INPUT_H__
 
+#include <atomic>
 #include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
 #include <queue>
 #include <string>
 #include <unordered_set>
 #include <vector>
 
+#include "common/DevInode.h"
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
+#include "common/SafeQueue.h"
 #include "monitor/Monitor.h"
 
 namespace logtail {
 
 class Event;
 class EventDispatcher;
+class LogFileReader;
 
 class LogInput : public LogRunnable {
 public:
@@ -62,13 +69,39 @@ public:
 
     void Trigger() { mFeedbackCV.notify_one(); }
 
+    // When there is more than one reader thread, files of the modify events in a batch are read by reader threads.
+    // Each file is read by the thread its dev inode is mapped to, and only one read task is allowed for a reader array
+    // in a batch, so files are still read in order. All tasks of the batch are finished before any other event is
+    // handled, and onRead is called by the input thread after that.
+    bool IsReadingInParallel() const { return mIsCollectingReadTasks; }
+    bool HasReadTask(const void* key) const { return mReadTaskKeys.find(key) != mReadTaskKeys.end(); }
+    void AddReadTask(const void* key,
+                     const DevInode& devInode,
+                     std::function<void()>&& read,
+                     std::function<void()>&& onRead);
+
 private:
+    struct ReadTask {
+        uint32_t mThreadNo = 0;
+        std::function<void()> mRead;
+        std::function<void()> mOnRead;
+    };
+
     LogInput();
     ~LogInput();
     void ProcessLoop();
     void ProcessEvent(EventDispatcher* dispatcher, Event* ev);
     Event* PopEventQueue();
+    void PopEventQueue(std::vector<Event*>& events, size_t maxCount);
+    // Put popped but unprocessed events back to the front of the queue, keeping their order.
+    void RequeueEventsToFront(const std::vector<Event*>& events);
+    void PrefetchEvents(EventDispatcher* dispatcher, const std::vector<Event*>& events);
+    void ReleasePrefetchedData();
     void UpdateCriticalMetric(int32_t curTime);
+    void StartReaderThreads();
+    void StopReaderThreads();
+    void ReaderThreadLoop(uint32_t threadNo);
+    void FlushReadTasks();
 
     std::queue<Event*> mInotifyEventQueue;
     std::unordered_set<int64_t> mModifyEventSet;
@@ -86,6 +119,27 @@ private:
     IntGaugePtr mRegisterdHandlersTotal;
     IntGaugePtr mActiveReadersTotal;
     IntGaugePtr mEnableFileIncludedByMultiConfigs;
+    CounterPtr mBatchedReadSubmittedTotal;
+    CounterPtr mBatchedReadCompletedTotal;
+    CounterPtr mParallelReadTasksTotal;
+
+    // readers holding prefetched data of current batch
+    std::vector<std::shared_ptr<LogFileReader>> mPrefetchedReaders;
+
+    uint32_t mReaderThreadCnt = 1;
+    std::vector<std::future<void>> mReaderThreadRes;
+    std::vector<std::unique_ptr<SafeQueue<ReadTask*>>> mReaderQueues;
+    std::atomic_bool mIsReaderThreadStopped{false};
+    // the following are only accessed by the input thread
+    bool mIsCollectingReadTasks = false;
+    std::vector<std::unique_ptr<ReadTask>> mReadTasks;
+    std::unordered_set<const void*> mReadTaskKeys;
+    // for waiting read tasks of a batch to finish
+    std::mutex mReadTaskMux;
+    std::condition_variable mReadTaskCV;
+    size_t mUnfinishedReadTaskCnt = 0;
+
+    thread_local static bool sIsReaderThread;
 
     std::atomic_int mLastReadEventTime{0};
     std::future<void> mThreadRes;
@@ -104,6 +158,7 @@ private:
     friend class ConfigMatchUnittest;
     friend class FuseFileUnittest;
     friend class PipelineUpdateUnittest;
+    friend class ModifyHandlerUnittest;
 
     void CleanEnviroments();
 #endif
@@ -21,6 +21,9 @@
 #endif
 #include <sys/stat.h>
 
+#include <chrono>
+#include <thread>
+
 #include "app_config/AppConfig.h"
 #include "common/ErrorUtil.h"
 #include "common/FileSystemUtil.h"
@@ -48,6 +51,10 @@ DEFINE_FLAG_INT32(dirfile_check_interval_ms, "dir file check interval, ms", 1000
 #endif
 DEFINE_FLAG_INT32(dirfile_stat_count, "sleep when dir file stat count up to", 100);
 DEFINE_FLAG_INT32(dirfile_stat_sleep, "sleep time when dir file stat up to 1000, ms", 30);
+DEFINE_FLAG_INT32(polling_dir_file_thread_count, "number of threads polling the base directories of configs", 1);
+DEFINE_FLAG_INT32(polling_dir_file_full_stat_round,
+                  "cached files in directories unchanged since last round are stat-ed only every these rounds",
+                  1);
 DEFINE_FLAG_INT32(polling_dir_upperlimit, "try to remove unchanged dir if dir count is up to", 500000);
 DEFINE_FLAG_INT32(polling_file_upperlimit, "try to remove unchanged file if file count is up to", 500000);
 DEFINE_FLAG_INT32(polling_dir_timeout, "remove unchanged dir if modify time is older than time", 12 * 3600);
@@ -67,13 +74,23 @@ namespace logtail {
 
 static const int64_t NANO_CONVERTING = 1000000000;
 
+// Entries checked by current thread, used to count the stats of a config.
+static thread_local int32_t sThreadStatCount = 0;
+
 void PollingDirFile::Start() {
     ClearCache();
     mPollingDirCacheSize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE);
     mPollingFileCacheSize
         = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE);
+    mPollingRoundTimeMs
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_ROUND_TIME_MS);
+    mPollingStatCount
+        = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(METRIC_RUNNER_FILE_POLLING_STAT_COUNT);
+    mPollingSkippedStatCount = FileServer::GetInstance()->GetMetricsRecordRef().CreateIntGauge(
+        METRIC_RUNNER_FILE_POLLING_SKIPPED_STAT_COUNT);
     mRuningFlag = true;
+    StartWorkers();
     mThreadPtr = CreateThread([this]() { Polling(); });
 }
 
@@ -86,6 +103,7 @@ void PollingDirFile::Stop() {
             LOG_ERROR(sLogger, ("stop polling dir file thread failed", ToString((int)mThreadPtr->GetState())));
         }
     }
+    StopWorkers();
     LOG_INFO(sLogger, ("PollingDirFile", "stop"));
 }
 
@@ -106,7 +124,7 @@ void PollingDirFile::Resume() {
 void PollingDirFile::CheckConfigPollingStatCount(const int32_t lastStatCount,
                                                  const FileDiscoveryConfig& config,
                                                  bool isDockerConfig) {
-    auto diffCount = mStatCount - lastStatCount;
+    auto diffCount = sThreadStatCount - lastStatCount;
     if (diffCount <= INT32_FLAG(polling_max_stat_count_per_config))
         return;
 
@@ -116,11 +134,11 @@ void PollingDirFile::CheckConfigPollingStatCount(const int32_t lastStatCount,
     msgBase += "config has exceeded limit";
 
     LOG_WARNING(sLogger,
-                (msgBase, diffCount)(config.first->GetBasePath(), mStatCount)(config.second->GetProjectName(),
-                                                                              config.second->GetLogstoreName()));
+                (msgBase, diffCount)(config.first->GetBasePath(), mStatCount.load())(
+                    config.second->GetProjectName(), config.second->GetLogstoreName()));
     AlarmManager::GetInstance()->SendAlarm(STAT_LIMIT_ALARM,
                                            msgBase + ", current count: " + ToString(diffCount) + " total count:"
-                                               + ToString(mStatCount) + " path: " + config.first->GetBasePath(),
+                                               + ToString(mStatCount.load()) + " path: " + config.first->GetBasePath(),
                                            config.second->GetRegion(),
                                            config.second->GetProjectName(),
                                            config.second->GetConfigName(),
@@ -144,7 +162,10 @@ void PollingDirFile::Polling() {
 void PollingDirFile::PollingIteration() {
     LOG_DEBUG(sLogger, ("start dir file polling, mCurrentRound", mCurrentRound));
     PTScopedLock threadLock(mPollingThreadLock);
+    auto roundBeginTime = chrono::steady_clock::now();
     mStatCount = 0;
+    mRoundStatCount = 0;
+    mRoundSkippedStatCount = 0;
     mNewFileVec.clear();
     ++mCurrentRound;
 
@@ -168,83 +189,22 @@ void PollingDirFile::PollingIteration() {
         SET_GAUGE(mPollingFileCacheSize, mFileCacheMap.size());
     }
 
-    // Iterate all normal configs, make sure stat count will not exceed limit.
-    for (auto itr = sortedConfigs.begin();
-         itr != sortedConfigs.end() && mStatCount <= INT32_FLAG(polling_max_stat_count);
-         ++itr) {
-        if (!mRuningFlag || mHoldOnFlag)
-            break;
-
-        const FileDiscoveryOptions* config = itr->first;
-        const CollectionPipelineContext* ctx = itr->second;
-        if (!config->IsContainerDiscoveryEnabled()) {
-            fsutil::PathStat baseDirStat;
-            if (!fsutil::PathStat::stat(config->GetBasePath(), baseDirStat)) {
-                LOG_DEBUG(sLogger,
-                          ("get base dir info error: ", config->GetBasePath())(ctx->GetProjectName(),
-                                                                               ctx->GetLogstoreName()));
-                continue;
-            }
-
-            int32_t lastConfigStatCount = mStatCount;
-            if (!PollingNormalConfigPath(*itr, config->GetBasePath(), string(), baseDirStat, 0)) {
-                LOG_DEBUG(sLogger,
-                          ("logPath in config not exist", config->GetBasePath())(ctx->GetProjectName(),
-                                                                                 ctx->GetLogstoreName()));
-            }
-            CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
-        } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& basePath = (*config->GetContainerInfo())[i].mRealBaseDir;
-                fsutil::PathStat baseDirStat;
-                if (!fsutil::PathStat::stat(basePath, baseDirStat)) {
-                    LOG_DEBUG(
-                        sLogger,
-                        ("get docker base dir info error: ", basePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
-                    continue;
-                }
-                int32_t lastConfigStatCount = mStatCount;
-                if (!PollingNormalConfigPath(*itr, basePath, string(), baseDirStat, 0)) {
-                    LOG_DEBUG(sLogger,
-                              ("docker logPath in config not exist", basePath)(ctx->GetProjectName(),
-                                                                               ctx->GetLogstoreName()));
-                }
-                CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
-            }
-        }
-    }
-
-    // Iterate all wildcard configs, make sure stat count will not exceed limit.
-    for (auto itr = wildcardConfigs.begin();
-         itr != wildcardConfigs.end() && mStatCount <= INT32_FLAG(polling_max_stat_count);
-         ++itr) {
-        if (!mRuningFlag || mHoldOnFlag)
-            break;
-
-        const FileDiscoveryOptions* config = itr->first;
-        const CollectionPipelineContext* ctx = itr->second;
-        if (!config->IsContainerDiscoveryEnabled()) {
-            int32_t lastConfigStatCount = mStatCount;
-            if (!PollingWildcardConfigPath(*itr, config->GetWildcardPaths()[0], 0)) {
-                LOG_DEBUG(sLogger,
-                          ("can not find matched path in config, Wildcard begin logPath",
-                           config->GetBasePath())(ctx->GetProjectName(), ctx->GetLogstoreName()));
-            }
-            CheckConfigPollingStatCount(lastConfigStatCount, *itr, false);
-        } else {
-            for (size_t i = 0; i < config->GetContainerInfo()->size(); ++i) {
-                const string& baseWildcardPath = (*config->GetContainerInfo())[i].mRealBaseDir;
-                int32_t lastConfigStatCount = mStatCount;
-                if (!PollingWildcardConfigPath(*itr, baseWildcardPath, 0)) {
-                    LOG_DEBUG(sLogger,
-                              ("can not find matched path in config, "
-                               "Wildcard begin logPath ",
-                               baseWildcardPath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+    // Normal configs go first, then wildcard configs.
+    vector<PollingTask> tasks;
+    for (const auto* configs : {&sortedConfigs, &wildcardConfigs}) {
+        for (const auto& config : *configs) {
+            if (!config.first->IsContainerDiscoveryEnabled()) {
+                const auto& basePath = config.first->GetWildcardPaths().empty() ? config.first->GetBasePath()
+                                                                                : config.first->GetWildcardPaths()[0];
+                tasks.push_back({config, basePath, false});
+            } else {
+                for (const auto& containerInfo : *config.first->GetContainerInfo()) {
+                    tasks.push_back({config, containerInfo.mRealBaseDir, true});
                 }
-                CheckConfigPollingStatCount(lastConfigStatCount, *itr, true);
             }
         }
     }
+    RunPollingTasks(tasks);
 
     // Add collected new files to PollingModify.
     PollingModify::GetInstance()->AddNewFile(mNewFileVec);
@@ -254,6 +214,127 @@ void PollingDirFile::PollingIteration() {
         ClearUnavailableFileAndDir();
     }
     ClearTimeoutFileAndDir();
+
+    SET_GAUGE(mPollingRoundTimeMs,
+              chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - roundBeginTime).count());
+    SET_GAUGE(mPollingStatCount, mRoundStatCount.load());
+    SET_GAUGE(mPollingSkippedStatCount, mRoundSkippedStatCount.load());
+}
+
+void PollingDirFile::StartWorkers() {
+    // No round is running now, so workers will not miss the next one.
+    uint64_t taskRound = mTaskRound;
+    for (int32_t i = 1; i < INT32_FLAG(polling_dir_file_thread_count); ++i) {
+        mWorkerThreads.push_back(CreateThread([this, taskRound]() { PollingWorker(taskRound); }));
+    }
+}
+
+void PollingDirFile::StopWorkers() {
+    {
+        lock_guard<mutex> lock(mTaskMux);
+        mWorkerStopFlag = true;
+    }
+    mTaskCV.notify_all();
+    for (auto& worker : mWorkerThreads) {
+        worker->Wait(5 * 1000000);
+    }
+    mWorkerThreads.clear();
+    mWorkerStopFlag = false;
+}
+
+void PollingDirFile::PollingWorker(uint64_t lastTaskRound) {
+    unique_lock<mutex> lock(mTaskMux);
+    while (true) {
+        mTaskCV.wait(lock, [this, lastTaskRound]() { return mWorkerStopFlag || mTaskRound != lastTaskRound; });
+        if (mWorkerStopFlag) {
+            break;
+        }
+        lastTaskRound = mTaskRound;
+        const vector<PollingTask>* tasks = mTasks;
+        lock.unlock();
+        RunTasks(*tasks);
+        lock.lock();
+        if (--mBusyWorkerCount == 0) {
+            mTaskDoneCV.notify_one();
+        }
+    }
+    LOG_DEBUG(sLogger, ("dir file polling worker thread done", ""));
+}
+
+void PollingDirFile::RunPollingTasks(const vector<PollingTask>& tasks) {
+    mNextTask = 0;
+    if (!mWorkerThreads.empty()) {
+        {
+            lock_guard<mutex> lock(mTaskMux);
+            mTasks = &tasks;
+            mBusyWorkerCount = mWorkerThreads.size();
+            ++mTaskRound;
+        }
+        mTaskCV.notify_all();
+    }
+    RunTasks(tasks);
+    if (!mWorkerThreads.empty()) {
+        unique_lock<mutex> lock(mTaskMux);
+        mTaskDoneCV.wait(lock, [this]() { return mBusyWorkerCount == 0; });
+        mTasks = nullptr;
+    }
+}
+
+void PollingDirFile::RunTasks(const vector<PollingTask>& tasks) {
+    // Iterate all tasks, make sure stat count will not exceed limit.
+    for (size_t i = mNextTask++; i < tasks.size() && mStatCount <= INT32_FLAG(polling_max_stat_count);
+         i = mNextTask++) {
+        if (!mRuningFlag || mHoldOnFlag)
+            break;
+        PollingBasePath(tasks[i]);
+    }
+}
+
+void PollingDirFile::PollingBasePath(const PollingTask& task) {
+    const FileDiscoveryOptions* config = task.mConfig.first;
+    const CollectionPipelineContext* ctx = task.mConfig.second;
+    int32_t lastConfigStatCount = sThreadStatCount;
+    if (config->GetWildcardPaths().empty()) {
+        fsutil::PathStat baseDirStat;
+        if (!StatPath(task.mBasePath, baseDirStat)) {
+            LOG_DEBUG(sLogger,
+                      (task.mIsContainerPath ? "get docker base dir info error: " : "get base dir info error: ",
+                       task.mBasePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+            return;
+        }
+        if (!PollingNormalConfigPath(task.mConfig, task.mBasePath, string(), baseDirStat, 0)) {
+            LOG_DEBUG(sLogger,
+                      (task.mIsContainerPath ? "docker logPath in config not exist" : "logPath in config not exist",
+                       task.mBasePath)(ctx->GetProjectName(), ctx->GetLogstoreName()));
+        }
+    } else {
+        if (!PollingWildcardConfigPath(task.mConfig, task.mBasePath, 0)) {
+            LOG_DEBUG(sLogger,
+                      ("can not find matched path in config, Wildcard begin logPath",
+                       task.mBasePath)("basePath", config->GetBasePath())(ctx->GetProjectName(),
+                                                                          ctx->GetLogstoreName()));
+        }
+    }
+    CheckConfigPollingStatCount(lastConfigStatCount, task.mConfig, task.mIsContainerPath);
+}
+
+void PollingDirFile::CountEntry() {
+    ++sThreadStatCount;
+    if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
+        auto pauseUntil = chrono::steady_clock::now() + chrono::milliseconds(INT32_FLAG(dirfile_stat_sleep));
+        mStatPauseUntilNs = chrono::duration_cast<chrono::nanoseconds>(pauseUntil.time_since_epoch()).count();
+    }
+    auto pauseUntilNs = mStatPauseUntilNs.load();
+    if (pauseUntilNs > 0) {
+        // All polling threads sleep until the pause ends, no lock is held here.
+        this_thread::sleep_until(chrono::steady_clock::time_point(
+            chrono::duration_cast<chrono::steady_clock::duration>(chrono::nanoseconds(pauseUntilNs))));
+    }
+}
+
+bool PollingDirFile::StatPath(const string& path, fsutil::PathStat& statBuf) {
+    ++mRoundStatCount;
+    return fsutil::PathStat::stat(path, statBuf);
 }
 
 // Last Modified Time (LMD) of directory changes when a file or a subdirectory is added,
@@ -263,7 +344,8 @@ void PollingDirFile::PollingIteration() {
 bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
                                                  const fsutil::PathStat& statBuf,
                                                  bool exceedPreservedDirDepth,
-                                                 bool& newFlag) {
+                                                 bool& newFlag,
+                                                 bool& unchangedFlag) {
     int64_t sec, nsec;
     statBuf.GetLastWriteTime(sec, nsec);
     int64_t modifyTime = NANO_CONVERTING * sec + nsec;
@@ -272,6 +354,7 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
     auto iter = mDirCacheMap.find(dirPath);
 
     // New directory, add a new cache item for it.
+    unchangedFlag = false;
     if (iter == mDirCacheMap.end()) {
         DirFileCache& dirCache = mDirCacheMap[dirPath];
         dirCache.SetConfigMatched(true);
@@ -291,7 +374,10 @@ bool PollingDirFile::CheckAndUpdateDirMatchCache(const string& dirPath,
     }
 
     // Already cached, update last round and modified time.
+    // The directory may have been polled in current round by another config.
     newFlag = false;
+    unchangedFlag
+        = iter->second.GetLastModifyTime() == modifyTime && iter->second.GetLastCheckRound() + 1 >= mCurrentRound;
     iter->second.SetCheckRound(mCurrentRound);
     iter->second.SetLastModifyTime(modifyTime);
     return true; // iter->second.HasMatchedConfig().
@@ -308,49 +394,69 @@ bool PollingDirFile::CheckAndUpdateFileMatchCache(const string& fileDir,
 
     bool newFlag = false;
     string filePath = PathJoin(fileDir, fileName);
-    FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
     int32_t curTime = time(NULL);
-    if (iter == mFileCacheMap.end()) {
-        bool matchFlag = needFindBestMatch
-            ? ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr
-            : true;
-
-        DirFileCache& fileCache = mFileCacheMap[filePath];
-        fileCache.SetConfigMatched(matchFlag);
-        fileCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
-        fileCache.SetCheckRound(mCurrentRound);
-        fileCache.SetLastModifyTime(modifyTime);
-
-        // Files found at round 1 or too old are considered as old data.
-        if (mCurrentRound == 1 || curTime - sec > INT32_FLAG(polling_file_first_watch_timeout)) {
-            newFlag = false;
-        } else {
-            newFlag = true;
-            fileCache.SetLastEventTime(curTime);
-        }
-        fileCache.SetEventFlag(newFlag);
-        return matchFlag && newFlag;
-    }
-
-    // If the file is not overtime, repush it to PollingModify thread regularly (by default, 10s).
-    // Mainly for case that file is deleted and recreated after a while.
-    // In detail, it can avoid data missing when following things happen:
-    // 1. File is created, and PollingDirFile add it to cache and push it to PollingModify.
-    // 2. File is deleted, PollingModify removes it.
-    // 3. File is recreated, because PollingDirFile already caches it, new flag will
-    //    not be set.
-    // 4. Now, PollingModify will not generate MODIFY event for the file because the file
-    //    is not existing in polling file list. **We lose the file**.
-    if ((curTime - sec < INT32_FLAG(polling_file_first_watch_timeout))
-        && (!iter->second.HasEventFlag()
-            || (curTime - iter->second.GetLastEventTime() >= INT32_FLAG(polling_modify_repush_interval)))) {
+    {
+        ScopedSpinLock lock(mCacheLock);
+        FileCheckCacheMap::iterator iter = mFileCacheMap.find(filePath);
+        if (iter != mFileCacheMap.end()) {
+            // If the file is not overtime, repush it to PollingModify thread regularly (by default, 10s).
+            // Mainly for case that file is deleted and recreated after a while.
+            // In detail, it can avoid data missing when following things happen:
+            // 1. File is created, and PollingDirFile add it to cache and push it to PollingModify.
+            // 2. File is deleted, PollingModify removes it.
+            // 3. File is recreated, because PollingDirFile already caches it, new flag will
+            //    not be set.
+            // 4. Now, PollingModify will not generate MODIFY event for the file because the file
+            //    is not existing in polling file list. **We lose the file**.
+            if ((curTime - sec < INT32_FLAG(polling_file_first_watch_timeout))
+                && (!iter->second.HasEventFlag()
+                    || (curTime - iter->second.GetLastEventTime() >= INT32_FLAG(polling_modify_repush_interval)))) {
+                newFlag = true;
+                iter->second.SetEventFlag(newFlag);
+                iter->second.SetLastEventTime(curTime);
+            }
+            iter->second.SetCheckRound(mCurrentRound);
+            iter->second.SetLastModifyTime(modifyTime);
+            return iter->second.HasMatchedConfig() && newFlag;
+        }
+    }
+
+    // Match outside the lock, it might take a while.
+    bool matchFlag
+        = needFindBestMatch ? ConfigManager::GetInstance()->FindBestMatch(fileDir, fileName).first != nullptr : true;
+
+    ScopedSpinLock lock(mCacheLock);
+    auto res = mFileCacheMap.emplace(filePath, DirFileCache());
+    if (!res.second) {
+        // Cached by another polling thread in the meantime.
+        res.first->second.SetCheckRound(mCurrentRound);
+        return false;
+    }
+    DirFileCache& fileCache = res.first->second;
+    fileCache.SetConfigMatched(matchFlag);
+    fileCache.SetExceedPreservedDirDepth(exceedPreservedDirDepth);
+    fileCache.SetCheckRound(mCurrentRound);
+    fileCache.SetLastModifyTime(modifyTime);
+
+    // Files found at round 1 or too old are considered as old data.
+    if (mCurrentRound == 1 || curTime - sec > INT32_FLAG(polling_file_first_watch_timeout)) {
+        newFlag = false;
+    } else {
         newFlag = true;
-        iter->second.SetEventFlag(newFlag);
-        iter->second.SetLastEventTime(curTime);
+        fileCache.SetLastEventTime(curTime);
+    }
+    fileCache.SetEventFlag(newFlag);
+    return matchFlag && newFlag;
+}
+
+bool PollingDirFile::RefreshFileMatchCache(const string& filePath) {
+    ScopedSpinLock lock(mCacheLock);
+    auto iter = mFileCacheMap.find(filePath);
+    if (iter == mFileCacheMap.end()) {
+        return false;
     }
     iter->second.SetCheckRound(mCurrentRound);
-    iter->second.SetLastModifyTime(modifyTime);
-    return iter->second.HasMatchedConfig() && newFlag;
+    return true;
 }
 
 bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
@@ -381,7 +487,8 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         return false;
     }
     bool isNewDirectory = false;
-    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory))
+    bool isUnchangedDirectory = false;
+    if (!CheckAndUpdateDirMatchCache(dirPath, statBuf, exceedPreservedDirDepth, isNewDirectory, isUnchangedDirectory))
         return true;
     if (isNewDirectory) {
         PollingEventQueue::GetInstance()->PushEvent(new Event(srcPath, obj, EVENT_CREATE | EVENT_ISDIR, -1, 0));
@@ -406,24 +513,28 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         }
         return true;
     }
+    // Entries of an unchanged directory are the same as last round, so the cached files in it
+    // can skip stat, except in every polling_dir_file_full_stat_round rounds, so that the
+    // modified time in cache is not too old. Files exceeding preserved dir depth are always
+    // stat-ed, because they are timed out by the modified time.
+    bool skipCachedFileStat = isUnchangedDirectory && !exceedPreservedDirDepth
+        && mCurrentRound % max(1, INT32_FLAG(polling_dir_file_full_stat_round)) != 0;
     int32_t nowStatCount = 0;
     fsutil::Entry ent;
     while ((ent = dir.ReadNext(false))) {
         if (!mRuningFlag || mHoldOnFlag)
             break;
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0) {
-            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
-        }
+        CountEntry();
 
         if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
             LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                        ("total dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount.load())(
                             pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarm(
                 STAT_LIMIT_ALARM,
                 string("total dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
+                    + " total count:" + ToString(mStatCount.load()) + " path: " + dirPath
                     + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
                 pConfig.second->GetRegion(),
                 pConfig.second->GetProjectName(),
@@ -434,12 +545,12 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
 
         if (++nowStatCount > INT32_FLAG(polling_max_stat_count_per_dir)) {
             LOG_WARNING(sLogger,
-                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount)(
+                        ("this dir's polling stat count is exceeded", nowStatCount)(dirPath, mStatCount.load())(
                             pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarm(
                 STAT_LIMIT_ALARM,
                 string("this dir's polling stat count is exceeded, now count:") + ToString(nowStatCount)
-                    + " total count:" + ToString(mStatCount) + " path: " + dirPath
+                    + " total count:" + ToString(mStatCount.load()) + " path: " + dirPath
                     + " project:" + pConfig.second->GetProjectName() + " logstore:" + pConfig.second->GetLogstoreName(),
                 pConfig.second->GetRegion(),
                 pConfig.second->GetProjectName(),
@@ -470,6 +581,10 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
             if (!ConfigManager::GetInstance()->FindBestMatch(dirPath, entName).first) {
                 continue;
             }
+            if (skipCachedFileStat && RefreshFileMatchCache(item)) {
+                ++mRoundSkippedStatCount;
+                continue;
+            }
         } else {
             // Symbolic link should be passed, while other types file should ignore.
             if (!ent.IsSymbolic()) {
@@ -480,7 +595,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
 
         // Mainly for symbolic (Linux), we need to use stat to dig out the real type.
         fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
+        if (!StatPath(item, buf)) {
             LOG_DEBUG(sLogger, ("get file info error", item.c_str())("errno", errno));
             continue;
         }
@@ -495,6 +610,7 @@ bool PollingDirFile::PollingNormalConfigPath(const FileDiscoveryConfig& pConfig,
         } else if (buf.IsRegFile()) {
             if (CheckAndUpdateFileMatchCache(dirPath, entName, buf, needFindBestMatch, exceedPreservedDirDepth)) {
                 LOG_DEBUG(sLogger, ("add to modify event", entName)("round", mCurrentRound));
+                lock_guard<mutex> lock(mNewFileVecMux);
                 mNewFileVec.push_back(SplitedFilePath(dirPath, entName));
             }
         } else {
@@ -539,7 +655,7 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
         // permission to access it, just return true to stop polling.
         string item = PathJoin(dirPath, pConfig.first->GetConstWildcardPaths()[depth]);
         fsutil::PathStat baseDirStat;
-        if (!fsutil::PathStat::stat(item, baseDirStat)) {
+        if (!StatPath(item, baseDirStat)) {
             LOG_DEBUG(sLogger,
                       ("get wildcard dir info error: ", pConfig.first->GetBasePath())("stat path", item)(
                           pConfig.second->GetProjectName(),
@@ -601,16 +717,15 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
-        if (++mStatCount % INT32_FLAG(dirfile_stat_count) == 0)
-            usleep(INT32_FLAG(dirfile_stat_sleep) * 1000);
+        CountEntry();
 
         if (mStatCount > INT32_FLAG(polling_max_stat_count)) {
             LOG_WARNING(sLogger,
-                        ("total dir's polling stat count is exceeded",
-                         "")(dirPath, mStatCount)(pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
+                        ("total dir's polling stat count is exceeded", "")(dirPath, mStatCount.load())(
+                            pConfig.second->GetProjectName(), pConfig.second->GetLogstoreName()));
             AlarmManager::GetInstance()->SendAlarm(
                 STAT_LIMIT_ALARM,
-                string("total dir's polling stat count is exceeded, total count:" + ToString(mStatCount)
+                string("total dir's polling stat count is exceeded, total count:" + ToString(mStatCount.load())
                        + " path: " + dirPath + " project:" + pConfig.second->GetProjectName()
                        + " logstore:" + pConfig.second->GetLogstoreName()),
                 pConfig.second->GetRegion(),
@@ -620,10 +735,15 @@ bool PollingDirFile::PollingWildcardConfigPath(const FileDiscoveryConfig& pConfi
             break;
         }
 
+        // Only directories can match the next part, so regular files need not stat.
+        if (ent.IsRegFile()) {
+            ++mRoundSkippedStatCount;
+            continue;
+        }
         auto entName = ent.Name();
         string item = PathJoin(dirPath, entName);
         fsutil::PathStat buf;
-        if (!fsutil::PathStat::stat(item, buf)) {
+        if (!StatPath(item, buf)) {
             LOG_WARNING(sLogger, ("get file info fail", item.c_str())("errno", GetErrno()));
             continue;
         }
@@ -15,7 +15,11 @@
  */
 
 #pragma once
+#include <atomic>
+#include <condition_variable>
 #include <map>
+#include <mutex>
+#include <vector>
 
 #include "common/Lock.h"
 #include "common/LogRunnable.h"
@@ -57,8 +61,33 @@ private:
     PollingDirFile();
     ~PollingDirFile();
 
+    // PollingTask polls one base directory of a config, i.e. the base path of the config,
+    // or the real base path of one of its containers.
+    struct PollingTask {
+        FileDiscoveryConfig mConfig;
+        std::string mBasePath;
+        bool mIsContainerPath = false;
+    };
+
     void Polling();
     void PollingIteration();
+    // StartWorkers starts polling_dir_file_thread_count - 1 worker threads, which live until
+    // StopWorkers and run the tasks of each round together with the polling thread.
+    void StartWorkers();
+    void StopWorkers();
+    void PollingWorker(uint64_t lastTaskRound);
+    // RunPollingTasks runs @tasks in the polling thread and all worker threads, and returns
+    // after all of them are done. Each task is run entirely in one thread.
+    void RunPollingTasks(const std::vector<PollingTask>& tasks);
+    void RunTasks(const std::vector<PollingTask>& tasks);
+    void PollingBasePath(const PollingTask& task);
+
+    // CountEntry counts a checked directory entry. Every dirfile_stat_count entries checked by
+    // all polling threads, all of them pause for dirfile_stat_sleep ms, so the rate is the same
+    // as that of a single polling thread.
+    void CountEntry();
+    // StatPath calls stat on @path and records it in the stat count of current round.
+    bool StatPath(const std::string& path, fsutil::PathStat& statBuf);
 
     // PollingNormalConfigPath polls config with normal base path recursively.
     // @config: config to poll.
@@ -84,12 +113,15 @@ private:
     // @dirPath: absolute path of the directory.
     // @statBuf: stat of the directory.
     // @newFlag: a boolean to indicate caller that it is a new directory, generate event for it.
+    // @unchangedFlag: a boolean to indicate caller that the entries of the directory have not been
+    //   added, removed or renamed since it was polled last round.
     // @return a boolean to indicate should the directory be continued to poll.
     //   It will returns true always now (might change in future).
     bool CheckAndUpdateDirMatchCache(const std::string& dirPath,
                                      const fsutil::PathStat& statBuf,
                                      bool exceedPreservedDirDepth,
-                                     bool& newFlag);
+                                     bool& newFlag,
+                                     bool& unchangedFlag);
     // CheckAndUpdateFileMatchCache updates file cache (add if not existing).
     // @fileDir+@fileName: absolute path of the file.
     // @needFindBestMatch: false indicates that the file has already found the
@@ -101,6 +133,10 @@ private:
                                       const fsutil::PathStat& statBuf,
                                       bool needFindBestMatch,
                                       bool exceedPreservedDirDepth);
+    // RefreshFileMatchCache marks the cached file as checked in current round without stat.
+    // It is used for files in unchanged directories, see polling_dir_file_full_stat_round.
+    // @return false if the file is not cached.
+    bool RefreshFileMatchCache(const std::string& filePath);
 
     // ClearUnavailableFileAndDir checks cache, remove unavailable items.
     // By default, it will be called every 20 rounds (flag check_not_exist_file_dir_round).
@@ -121,6 +157,17 @@ private:
     volatile bool mHoldOnFlag;
     ThreadPtr mThreadPtr;
 
+    // Worker threads and the tasks of current round shared with them.
+    std::vector<ThreadPtr> mWorkerThreads;
+    std::mutex mTaskMux;
+    std::condition_variable mTaskCV;
+    std::condition_variable mTaskDoneCV;
+    const std::vector<PollingTask>* mTasks = nullptr;
+    std::atomic_size_t mNextTask{0};
+    uint64_t mTaskRound = 0;
+    size_t mBusyWorkerCount = 0;
+    bool mWorkerStopFlag = false;
+
     // Directories and files cache to reduce overhead of polling.
     // When the status of a cache item becomes unavailable or timeout, it might be removed:
     // - Unavailable: cache item becomes unavailable when it was deleted on filesystem
@@ -133,19 +180,31 @@ private:
     DirCheckCacheMap mDirCacheMap;
     FileCheckCacheMap mFileCacheMap;
 
-    // Record how much times stat is called, if it exceeds limit, stop polling.
-    int32_t mStatCount;
+    // Record how much entries are checked, if it exceeds limit, stop polling.
+    std::atomic_int32_t mStatCount;
     // Record new files found in current round, will be pushed to PollingModify.
+    std::mutex mNewFileVecMux;
     std::vector<SplitedFilePath> mNewFileVec;
     // The sequence number of current round, uint64_t is used to avoid overflow.
     uint64_t mCurrentRound;
 
+    // Polling threads pause until this time point (steady clock, ns) when entries checked
+    // reach dirfile_stat_count.
+    std::atomic_int64_t mStatPauseUntilNs{0};
+    // Stats made and skipped in current round.
+    std::atomic_int32_t mRoundStatCount{0};
+    std::atomic_int32_t mRoundSkippedStatCount{0};
+
     IntGaugePtr mPollingDirCacheSize;
     IntGaugePtr mPollingFileCacheSize;
+    IntGaugePtr mPollingRoundTimeMs;
+    IntGaugePtr mPollingStatCount;
+    IntGaugePtr mPollingSkippedStatCount;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PollingUnittest;
     friend class PollingPreservedDirDepthUnittest;
+    friend class PollingDirFileUnittest;
 #endif
 };
 
@@ -0,0 +1,253 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "file_server/reader/FileReadEngine.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup)
+#include <linux/io_uring.h>
+#define LOGTAIL_HAS_IO_URING
+#endif
+#endif
+
+#include "common/Flags.h"
+#include "logger/Logger.h"
+
+DEFINE_FLAG_BOOL(enable_io_uring_file_read, "use io_uring for batched file read when supported by the kernel", true);
+DEFINE_FLAG_INT32(io_uring_queue_depth, "max number of file reads submitted to io_uring at once", 256);
+
+using namespace std;
+
+namespace logtail {
+
+FileReadEngine::FileReadEngine() {
+    if (BOOL_FLAG(enable_io_uring_file_read) && !InitIOUring(static_cast<uint32_t>(INT32_FLAG(io_uring_queue_depth)))) {
+        LOG_INFO(sLogger, ("io_uring is not available", "fall back to pread for batched file read"));
+    }
+}
+
+FileReadEngine::~FileReadEngine() {
+    DestroyIOUring();
+}
+
+size_t FileReadEngine::Read(vector<FileReadRequest>& requests) {
+    if (requests.empty()) {
+        return 0;
+    }
+    if (IsIOUringEnabled()) {
+        return ReadByIOUring(requests);
+    }
+    return ReadByPread(requests);
+}
+
+size_t FileReadEngine::ReadByPread(vector<FileReadRequest>& requests) {
+    size_t completed = 0;
+    for (auto& req : requests) {
+        if (ReadByPread(req)) {
+            ++completed;
+        }
+    }
+    return completed;
+}
+
+bool FileReadEngine::ReadByPread(FileReadRequest& request) {
+#if defined(__linux__)
+    ssize_t n = pread(request.mFd, request.mBuffer, request.mSize, request.mOffset);
+    request.mResult = n < 0 ? -errno : n;
+#else
+    request.mResult = -ENOSYS;
+#endif
+    return request.mResult >= 0;
+}
+
+#ifdef LOGTAIL_HAS_IO_URING
+bool FileReadEngine::InitIOUring(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    int fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+        LOG_INFO(sLogger, ("failed to setup io_uring, errno", errno));
+        return false;
+    }
+    mRingFd = fd;
+    mRingEntries = params.sq_entries;
+    mSqRingSize = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    mCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMmap = params.features & IORING_FEAT_SINGLE_MMAP;
+    if (singleMmap) {
+        mSqRingSize = mCqRingSize = max(mSqRingSize, mCqRingSize);
+    }
+    mSqRing = mmap(nullptr, mSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+    if (mSqRing == MAP_FAILED) {
+        mSqRing = nullptr;
+        DestroyIOUring();
+        return false;
+    }
+    if (singleMmap) {
+        mCqRing = mSqRing;
+    } else {
+        mCqRing = mmap(nullptr, mCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+        if (mCqRing == MAP_FAILED) {
+            mCqRing = nullptr;
+            DestroyIOUring();
+            return false;
+        }
+    }
+    mSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    mSqes = mmap(nullptr, mSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+    if (mSqes == MAP_FAILED) {
+        mSqes = nullptr;
+        DestroyIOUring();
+        return false;
+    }
+
+    char* sq = static_cast<char*>(mSqRing);
+    mSqHead = reinterpret_cast<uint32_t*>(sq + params.sq_off.head);
+    mSqTail = reinterpret_cast<uint32_t*>(sq + params.sq_off.tail);
+    mSqMask = reinterpret_cast<uint32_t*>(sq + params.sq_off.ring_mask);
+    mSqArray = reinterpret_cast<uint32_t*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(mCqRing);
+    mCqHead = reinterpret_cast<uint32_t*>(cq + params.cq_off.head);
+    mCqTail = reinterpret_cast<uint32_t*>(cq + params.cq_off.tail);
+    mCqMask = reinterpret_cast<uint32_t*>(cq + params.cq_off.ring_mask);
+    mCqes = cq + params.cq_off.cqes;
+    LOG_INFO(sLogger, ("io_uring is enabled for batched file read, entries", mRingEntries));
+    return true;
+}
+
+void FileReadEngine::DestroyIOUring() {
+    if (mSqes) {
+        munmap(mSqes, mSqesSize);
+        mSqes = nullptr;
+    }
+    if (mCqRing && mCqRing != mSqRing) {
+        munmap(mCqRing, mCqRingSize);
+    }
+    mCqRing = nullptr;
+    if (mSqRing) {
+        munmap(mSqRing, mSqRingSize);
+        mSqRing = nullptr;
+    }
+    if (mRingFd >= 0) {
+        close(mRingFd);
+        mRingFd = -1;
+    }
+}
+
+size_t FileReadEngine::ReadByIOUring(vector<FileReadRequest>& requests) {
+    auto* sqes = static_cast<io_uring_sqe*>(mSqes);
+    vector<iovec> iovecs(requests.size());
+    vector<bool> done(requests.size(), false);
+    size_t completed = 0;
+    size_t next = 0;
+    while (next < requests.size()) {
+        // submit as many requests as the ring can hold, then wait for all of them
+        uint32_t sqHead = __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE);
+        uint32_t tail = *mSqTail;
+        uint32_t toSubmit = 0;
+        for (; next < requests.size() && toSubmit < mRingEntries; ++next, ++toSubmit, ++tail) {
+            auto& req = requests[next];
+            iovecs[next].iov_base = req.mBuffer;
+            iovecs[next].iov_len = req.mSize;
+            uint32_t idx = tail & *mSqMask;
+            io_uring_sqe* sqe = &sqes[idx];
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_READV;
+            sqe->fd = req.mFd;
+            sqe->off = static_cast<uint64_t>(req.mOffset);
+            sqe->addr = reinterpret_cast<uint64_t>(&iovecs[next]);
+            sqe->len = 1;
+            sqe->user_data = next;
+            mSqArray[idx] = idx;
+        }
+        __atomic_store_n(mSqTail, tail, __ATOMIC_RELEASE);
+
+        uint32_t toComplete = toSubmit;
+        uint32_t pending = toSubmit;
+        while (toComplete > 0) {
+            int ret = static_cast<int>(
+                syscall(__NR_io_uring_enter, mRingFd, pending, toComplete, IORING_ENTER_GETEVENTS, nullptr, 0));
+            if (ret < 0) {
+                if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+                    continue;
+                }
+                // the ring is unusable, stop using io_uring. Reads already consumed by the kernel may still be writing
+                // into their buffers, so wait for them before the buffers are given back, then read the rest with
+                // pread.
+                LOG_WARNING(sLogger, ("io_uring_enter failed, fall back to pread, errno", errno));
+                uint32_t inflight = __atomic_load_n(mSqHead, __ATOMIC_ACQUIRE) - sqHead - (toSubmit - toComplete);
+                while (inflight > 0) {
+                    uint32_t reaped = ReapIOUring(requests, done, completed);
+                    inflight -= min(inflight, reaped);
+                    if (inflight > 0) {
+                        usleep(1000);
+                    }
+                }
+                DestroyIOUring();
+                for (size_t i = 0; i < requests.size(); ++i) {
+                    if (!done[i] && ReadByPread(requests[i])) {
+                        ++completed;
+                    }
+                }
+                return completed;
+            }
+            pending -= min(pending, static_cast<uint32_t>(ret));
+            toComplete -= min(toComplete, ReapIOUring(requests, done, completed));
+        }
+    }
+    return completed;
+}
+
+uint32_t FileReadEngine::ReapIOUring(vector<FileReadRequest>& requests, vector<bool>& done, size_t& completed) {
+    auto* cqes = static_cast<io_uring_cqe*>(mCqes);
+    uint32_t head = *mCqHead;
+    uint32_t cqTail = __atomic_load_n(mCqTail, __ATOMIC_ACQUIRE);
+    uint32_t reaped = 0;
+    for (; head != cqTail; ++head, ++reaped) {
+        const io_uring_cqe& cqe = cqes[head & *mCqMask];
+        auto& req = requests[cqe.user_data];
+        req.mResult = cqe.res;
+        done[cqe.user_data] = true;
+        if (cqe.res >= 0) {
+            ++completed;
+        }
+    }
+    __atomic_store_n(mCqHead, head, __ATOMIC_RELEASE);
+    return reaped;
+}
+#else
+bool FileReadEngine::InitIOUring(uint32_t entries) {
+    return false;
+}
+
+void FileReadEngine::DestroyIOUring() {
+}
+
+size_t FileReadEngine::ReadByIOUring(vector<FileReadRequest>& requests) {
+    return ReadByPread(requests);
+}
+
+uint32_t FileReadEngine::ReapIOUring(vector<FileReadRequest>& requests, vector<bool>& done, size_t& completed) {
+    return 0;
+}
+#endif
+
+} // namespace logtail
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <vector>
+
+namespace logtail {
+
+struct FileReadRequest {
+    int mFd = -1;
+    int64_t mOffset = 0;
+    size_t mSize = 0;
+    char* mBuffer = nullptr; // at least mSize bytes, owned by the caller and must outlive FileReadEngine::Read
+    int64_t mResult = 0; // bytes read, or -errno on failure
+};
+
+// FileReadEngine reads a batch of file ranges at once. With io_uring, all reads of a batch are submitted with a single
+// syscall and served concurrently by the kernel; otherwise, or if io_uring is not permitted (e.g. blocked by seccomp),
+// reads are done one by one with pread.
+class FileReadEngine {
+public:
+    FileReadEngine(const FileReadEngine&) = delete;
+    FileReadEngine& operator=(const FileReadEngine&) = delete;
+
+    static FileReadEngine* GetInstance() {
+        static FileReadEngine instance;
+        return &instance;
+    }
+
+    // return the number of requests completed, i.e. mResult >= 0
+    size_t Read(std::vector<FileReadRequest>& requests);
+
+    bool IsIOUringEnabled() const { return mRingFd >= 0; }
+
+private:
+    FileReadEngine();
+    ~FileReadEngine();
+
+    bool InitIOUring(uint32_t entries);
+    void DestroyIOUring();
+    size_t ReadByIOUring(std::vector<FileReadRequest>& requests);
+    // reap completed reads from the completion queue, return the number of reads reaped
+    uint32_t ReapIOUring(std::vector<FileReadRequest>& requests, std::vector<bool>& done, size_t& completed);
+    size_t ReadByPread(std::vector<FileReadRequest>& requests);
+    static bool ReadByPread(FileReadRequest& request);
+
+    int mRingFd = -1;
+    uint32_t mRingEntries = 0;
+    void* mSqRing = nullptr;
+    size_t mSqRingSize = 0;
+    void* mCqRing = nullptr;
+    size_t mCqRingSize = 0;
+    void* mSqes = nullptr;
+    size_t mSqesSize = 0;
+    uint32_t* mSqHead = nullptr;
+    uint32_t* mSqTail = nullptr;
+    uint32_t* mSqMask = nullptr;
+    uint32_t* mSqArray = nullptr;
+    uint32_t* mCqHead = nullptr;
+    uint32_t* mCqTail = nullptr;
+    uint32_t* mCqMask = nullptr;
+    void* mCqes = nullptr;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class FileReadEngineUnittest;
+#endif
+};
+
+} // namespace logtail
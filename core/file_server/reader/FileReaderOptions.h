@@ -39,6 +39,9 @@ struct FileReaderOptions {
     uint32_t mReadDelayAlertThresholdBytes;
     uint32_t mCloseUnusedReaderIntervalSec;
     uint32_t mRotatorQueueSize;
+    // read file content through a private mmap window instead of pread, so that events reference the page cache
+    // directly. Only suitable for local files which are not truncated in place.
+    bool mEnableMmapRead = false;
 
     FileReaderOptions();
 
@@ -48,6 +48,7 @@
 #include "common/RandomUtil.h"
 #include "common/TimeUtil.h"
 #include "common/UUIDUtil.h"
+#include "common/memory/MappedFileWindow.h"
 #include "constants/Constants.h"
 #include "file_server/ConfigManager.h"
 #include "file_server/FileServer.h"
@@ -1170,6 +1171,7 @@ bool LogFileReader::CloseTimeoutFilePtr(int32_t curTime) {
 }
 
 void LogFileReader::CloseFilePtr() {
+    ReleasePrefetchedData();
     if (mLogFileOp.IsOpen()) {
         mCache.shrink_to_fit();
         LOG_DEBUG(sLogger, ("start close LogFileReader", mHostLogPath));
@@ -1507,6 +1509,10 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
     size_t nbytes = 0;
 
     logBuffer.readOffset = mLastFilePos;
+    if (mLogFileOp.IsOpen() && mReaderConfig.first->mEnableMmapRead && !mReaderConfig.second->RequiringJsonReader()
+        && ReadUTF8ByMmap(logBuffer, end, moreData, tryRollback)) {
+        return;
+    }
     if (!mLogFileOp.IsOpen()) {
         // read flush timeout
         nbytes = mCache.size();
@@ -1537,17 +1543,23 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
         if (READ_BYTE < lastCacheSize) {
             READ_BYTE = lastCacheSize; // this should not happen, just avoid READ_BYTE >= 0 theoratically
         }
-        StringBuffer stringMemory
-            = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE); // allocate modifiable buffer
+        int64_t lastReadPos = GetLastReadPos();
+        char* readBuffer = nullptr;
+        if (mPrefetchedSourceBuffer && mPrefetchedData.mOffset == lastReadPos
+            && mPrefetchedData.mBuffer == mPrefetchedString + lastCacheSize && READ_BYTE <= mPrefetchedStringSize) {
+            // the prefetched data is already in place, take over its source buffer
+            logBuffer.sourcebuffer = std::move(mPrefetchedSourceBuffer);
+            readBuffer = mPrefetchedString;
+        } else {
+            readBuffer = logBuffer.sourcebuffer->AllocateStringBuffer(READ_BYTE).data; // allocate modifiable buffer
+        }
         if (lastCacheSize) {
             READ_BYTE -= lastCacheSize; // reserve space to copy from cache if needed
         }
         TruncateInfo* truncateInfo = nullptr;
-        int64_t lastReadPos = GetLastReadPos();
-        nbytes = READ_BYTE
-            ? ReadFile(mLogFileOp, stringMemory.data + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
-            : (size_t)0;
-        stringBuffer = stringMemory.data;
+        nbytes = READ_BYTE ? ReadFile(mLogFileOp, readBuffer + lastCacheSize, READ_BYTE, lastReadPos, &truncateInfo)
+                           : (size_t)0;
+        stringBuffer = readBuffer;
         bool allowRollback = true;
         // Only when there is no new log and not try rollback, then force read
         if (!tryRollback && nbytes == 0) {
@@ -1635,6 +1647,123 @@ void LogFileReader::ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData,
     LOG_DEBUG(sLogger, ("read size", nbytes)("last file pos", mLastFilePos));
 }
 
+bool LogFileReader::ReadUTF8ByMmap(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
+    bool fromCpt = false;
+    size_t READ_BYTE = getNextReadSize(end, fromCpt);
+    if (!READ_BYTE) {
+        return true;
+    }
+    if (mReaderConfig.first->mInputType == FileReaderOptions::InputType::InputContainerStdio && !mHasReadContainerBom) {
+        checkContainerType(mLogFileOp);
+    }
+    const size_t lastCacheSize = mCache.size();
+    if (READ_BYTE < lastCacheSize) {
+        READ_BYTE = lastCacheSize;
+    }
+    // the mapped range must still be backed by the file. Truncation is left to the pread path, which knows how to deal
+    // with it.
+    int64_t fileSize = mLogFileOp.GetFileSize();
+    if (fileSize < mLastFilePos + static_cast<int64_t>(lastCacheSize)) {
+        return false;
+    }
+    size_t nbytes = std::min(READ_BYTE, static_cast<size_t>(fileSize - mLastFilePos));
+    bool allowRollback = true;
+    // Only when there is no new log and not try rollback, then force read
+    if (!tryRollback && nbytes == lastCacheSize) {
+        allowRollback = false;
+    }
+    if (nbytes == lastCacheSize && (!lastCacheSize || allowRollback)) {
+        return true;
+    }
+
+    auto window = MappedFileWindow::Create(mLogFileOp.GetFd(), mLastFilePos, nbytes);
+    if (!window) {
+        return false;
+    }
+    // Events outlive the window, so the data is copied out before being scanned. The copy stops short if the file is
+    // truncated meanwhile, in which case nothing has been changed and the read is left to the pread path, which handles
+    // truncation and keeps its bookkeeping.
+    StringBuffer stringMemory = logBuffer.sourcebuffer->AllocateStringBuffer(nbytes);
+    if (window->Read(stringMemory.data, nbytes) < nbytes) {
+        LOG_WARNING(sLogger,
+                    ("file is truncated while being read by mmap", "read by pread instead")("file", mHostLogPath)(
+                        "inode", mDevInode.inode)("offset", mLastFilePos)("size", mLogFileOp.GetFileSize()));
+        return false;
+    }
+    window.reset();
+    char* stringBuffer = stringMemory.data;
+    // cache should be exactly the head of the data read, or the file has been rewritten in place
+    if (lastCacheSize && memcmp(stringBuffer, mCache.data(), lastCacheSize) != 0) {
+        return false;
+    }
+
+    // Ignore \n if last is force read
+    bool skipLineFeed = stringBuffer[0] == '\n' && mLastForceRead;
+    if (skipLineFeed) {
+        ++stringBuffer;
+        --nbytes;
+    }
+    const size_t stringBufferLen = nbytes;
+    int64_t lastReadPos = mLastFilePos + (skipLineFeed ? 1 : 0) + nbytes;
+    LOG_DEBUG(sLogger, ("mmap bytes", nbytes)("last read pos", lastReadPos));
+    auto alignedBytes = nbytes;
+    if (allowRollback) {
+        alignedBytes = AlignLastCharacter(stringBuffer, nbytes);
+        int32_t rollbackLineFeedCount = 0;
+        nbytes = RemoveLastIncompleteLog(stringBuffer, alignedBytes, rollbackLineFeedCount, allowRollback);
+    }
+    if (skipLineFeed) {
+        ++mLastFilePos;
+        logBuffer.readOffset = mLastFilePos;
+    }
+    mLastForceRead = !allowRollback;
+    moreData = (stringBufferLen == BUFFER_SIZE);
+
+    if (nbytes == 0) {
+        if (moreData) { // excessively long line without '\n' or multiline begin or valid wchar
+            nbytes = alignedBytes ? alignedBytes : BUFFER_SIZE;
+            LOG_WARNING(sLogger,
+                        ("Log is too long and forced to be split at offset: ",
+                         mLastFilePos + nbytes)("file: ", mHostLogPath)("inode: ", mDevInode.inode)(
+                            "first 1024B log: ", std::string(stringBuffer, std::min(nbytes, (size_t)1024))));
+            std::ostringstream oss;
+            oss << "Log is too long and forced to be split at offset: " << ToString(mLastFilePos + nbytes)
+                << " file: " << mHostLogPath << " inode: " << ToString(mDevInode.inode)
+                << " first 1024B log: " << std::string(stringBuffer, std::min(nbytes, (size_t)1024)) << std::endl;
+            AlarmManager::GetInstance()->SendAlarm(
+                SPLIT_LOG_FAIL_ALARM, oss.str(), GetRegion(), GetProject(), GetConfigName(), GetLogstore());
+        } else {
+            // line is not finished yet nor more data, put all data in cache
+            mCache.assign(stringBuffer, stringBufferLen);
+            return true;
+        }
+    }
+    if (nbytes < stringBufferLen) {
+        // rollback happend, put rollbacked part in cache
+        mCache.assign(stringBuffer + nbytes, stringBufferLen - nbytes);
+    } else {
+        mCache.clear();
+    }
+    if (!moreData && fromCpt && lastReadPos < end) {
+        moreData = true;
+    }
+
+    // cache is sealed, nbytes should no change any more
+    size_t stringLen = nbytes;
+    if (stringLen > 0 && (stringBuffer[stringLen - 1] == '\n' || stringBuffer[stringLen - 1] == '\0')) {
+        --stringLen;
+    }
+    stringBuffer[stringLen] = '\0';
+
+    logBuffer.rawBuffer = StringView(stringBuffer, stringLen); // set readable buffer
+    logBuffer.readLength = nbytes;
+    setExactlyOnceCheckpointAfterRead(nbytes);
+    mLastFilePos += nbytes;
+
+    LOG_DEBUG(sLogger, ("read size", nbytes)("last file pos", mLastFilePos));
+    return true;
+}
+
 void LogFileReader::ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback) {
     std::unique_ptr<char[]> gbkMemory;
     char* gbkBuffer = nullptr;
@@ -1820,20 +1949,82 @@ LogFileReader::ReadFile(LogFileOperator& op, void* buf, size_t size, int64_t& of
         return 0;
     }
 
+    size_t prefetched = 0;
+    if (&op == &mLogFileOp && mPrefetchedData.mBuffer && mPrefetchedData.mOffset == offset) {
+        prefetched = std::min(size, static_cast<size_t>(mPrefetchedData.mResult));
+        if (buf != mPrefetchedData.mBuffer) {
+            memcpy(buf, mPrefetchedData.mBuffer, prefetched);
+        }
+        ReleasePrefetchedData();
+        if (prefetched == size) {
+            *((char*)buf + prefetched) = '\0';
+            return prefetched;
+        }
+    }
+
     int nbytes = 0;
-    nbytes = op.Pread(buf, 1, size, offset);
+    nbytes = op.Pread((char*)buf + prefetched, 1, size - prefetched, offset + prefetched);
     if (nbytes < 0) {
         LOG_ERROR(sLogger,
                   ("Pread fail to read log file", mHostLogPath)("mLastFilePos", mLastFilePos)("size", size)("offset",
                                                                                                             offset));
-        return 0;
+        if (prefetched == 0) {
+            return 0;
+        }
+        nbytes = 0;
     }
     // }
 
+    nbytes += prefetched;
     *((char*)buf + nbytes) = '\0';
     return nbytes;
 }
 
+bool LogFileReader::PrepareBatchRead(FileReadRequest& request) {
+    // GBK content is converted and mmap read does not copy, so only plain UTF8 read benefits from prefetching
+    if (!mLogFileOp.IsOpen() || mPrefetchedSourceBuffer || mEOOption
+        || mReaderConfig.first->mFileEncoding == FileReaderOptions::Encoding::GBK
+        || mReaderConfig.first->mEnableMmapRead) {
+        return false;
+    }
+    const size_t cacheSize = mCache.size();
+    if (cacheSize >= BUFFER_SIZE) {
+        return false;
+    }
+    // size the read by the data really appended, so that no full BUFFER_SIZE buffer is allocated for small appends
+    int64_t lastReadPos = GetLastReadPos();
+    int64_t fileSize = mLogFileOp.GetFileSize();
+    if (fileSize <= lastReadPos) {
+        return false;
+    }
+    size_t readSize
+        = static_cast<size_t>(std::min(fileSize - lastReadPos, static_cast<int64_t>(BUFFER_SIZE - cacheSize)));
+    mPrefetchedSourceBuffer.reset(new SourceBuffer());
+    mPrefetchedStringSize = cacheSize + readSize;
+    mPrefetchedString = mPrefetchedSourceBuffer->AllocateStringBuffer(mPrefetchedStringSize).data;
+    request.mFd = mLogFileOp.GetFd();
+    request.mOffset = lastReadPos;
+    request.mSize = readSize;
+    request.mBuffer = mPrefetchedString + cacheSize;
+    request.mResult = 0;
+    return true;
+}
+
+void LogFileReader::SetPrefetchedData(FileReadRequest&& request) {
+    if (request.mResult <= 0 || request.mFd != mLogFileOp.GetFd()) {
+        ReleasePrefetchedData();
+        return;
+    }
+    mPrefetchedData = std::move(request);
+}
+
+void LogFileReader::ReleasePrefetchedData() {
+    mPrefetchedData = FileReadRequest();
+    mPrefetchedSourceBuffer.reset();
+    mPrefetchedString = nullptr;
+    mPrefetchedStringSize = 0;
+}
+
 LogFileReader::FileCompareResult LogFileReader::CompareToFile(const string& filePath) {
     LogFileOperator logFileOp;
     logFileOp.Open(filePath.c_str());
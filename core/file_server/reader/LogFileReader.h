@@ -18,6 +18,7 @@
 
 #include <atomic>
 #include <deque>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -39,6 +40,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/MultilineOptions.h"
 #include "file_server/event/Event.h"
+#include "file_server/reader/FileReadEngine.h"
 #include "file_server/reader/FileReaderOptions.h"
 #include "logger/Logger.h"
 #include "protobuf/sls/sls_logs.pb.h"
@@ -332,6 +334,13 @@ public:
 
     void CloseFilePtr();
 
+    // Batched read: the next read window of many readers are read at once before their events are handled, and the
+    // prefetched data is consumed by the following ReadLog if the offset still matches. The data is read straight into
+    // a source buffer, which is handed over to the LogBuffer of ReadLog, so no copy is needed.
+    bool PrepareBatchRead(FileReadRequest& request);
+    void SetPrefetchedData(FileReadRequest&& request);
+    void ReleasePrefetchedData();
+
     // void SetLogstoreKey(uint64_t logstoreKey) { mLogstoreKey = logstoreKey; }
 
     // Return the key of queues into which next read data will push.
@@ -457,6 +466,9 @@ public:
 protected:
     bool GetRawData(LogBuffer& logBuffer, int64_t fileSize, bool tryRollback = true);
     void ReadUTF8(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback = true);
+    // read by mapping the file range instead of copying it, return false if nothing has been changed and pread should
+    // be used instead
+    bool ReadUTF8ByMmap(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback);
     void ReadGBK(LogBuffer& logBuffer, int64_t end, bool& moreData, bool tryRollback = true);
 
     size_t
@@ -486,6 +498,11 @@ protected:
     int64_t mLastFileSize = 0;
     time_t mLastMTime = 0;
     std::string mCache;
+    FileReadRequest mPrefetchedData;
+    // the prefetched data is read into mPrefetchedString + mCache.size(), and mCache is copied before it when consumed
+    std::unique_ptr<SourceBuffer> mPrefetchedSourceBuffer;
+    char* mPrefetchedString = nullptr;
+    size_t mPrefetchedStringSize = 0;
     // >= 0: index of reader array, -1: new reader, -2: not in reader array
     int32_t mIdxInReaderArrayFromLastCpt = CHECKPOINT_IDX_OF_NEW_READER_IN_ARRAY;
     // std::string mProjectName;
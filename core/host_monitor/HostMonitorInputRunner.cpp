@@ -69,6 +69,7 @@ void HostMonitorInputRunner::UpdateCollector(const std::vector<std::string>& new
                                              const std::vector<uint32_t>& newCollectorIntervals,
                                              QueueKey processQueueKey,
                                              size_t inputIndex) {
+    std::vector<std::unique_ptr<TimerEvent>> events;
     std::unique_lock<std::shared_mutex> lock(mRegisteredCollectorMapMutex);
     for (size_t i = 0; i < newCollectorNames.size(); ++i) {
         const auto& collectorName = newCollectorNames[i];
@@ -83,10 +84,10 @@ void HostMonitorInputRunner::UpdateCollector(const std::vector<std::string>& new
         HostMonitorTimerEvent::CollectConfig collectConfig(
             collectorName, processQueueKey, inputIndex, std::chrono::seconds(newCollectorIntervals[i]));
         auto now = std::chrono::steady_clock::now();
-        auto event = std::make_unique<HostMonitorTimerEvent>(now, collectConfig);
-        Timer::GetInstance()->PushEvent(std::move(event));
+        events.emplace_back(std::make_unique<HostMonitorTimerEvent>(now, collectConfig));
         LOG_INFO(sLogger, ("host monitor", "add new collector")("collector", collectorName));
     }
+    Timer::GetInstance()->PushEvents(std::move(events));
 }
 
 void HostMonitorInputRunner::RemoveCollector(const std::vector<std::string>& collectorNames) {
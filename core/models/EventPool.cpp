@@ -27,112 +27,60 @@ namespace logtail {
 
 EventPool::~EventPool() {
     if (mEnableLock) {
-        {
-            lock_guard<mutex> lock(mPoolMux);
-            DestroyAllEventPool();
-        }
-        {
-            lock_guard<mutex> lockBak(mPoolBakMux);
-            DestroyAllEventPoolBak();
-        }
+        lock_guard<mutex> lock(mPoolMux);
+        DestroyAllEventPool();
     } else {
         DestroyAllEventPool();
     }
+    DestroyAllReturnedEvents();
 }
 
 LogEvent* EventPool::AcquireLogEvent(PipelineEventGroup* ptr) {
-    if (mEnableLock) {
-        TransferPoolIfEmpty(mLogEventPool, mLogEventPoolBak);
-        lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
-    }
-    return AcquireEventNoLock(ptr, mLogEventPool, mMinUnusedLogEventsCnt);
+    return AcquireEvent(ptr, mLogEventPool, mReturnedLogEvents, mMinUnusedLogEventsCnt);
 }
 
 MetricEvent* EventPool::AcquireMetricEvent(PipelineEventGroup* ptr) {
-    if (mEnableLock) {
-        TransferPoolIfEmpty(mMetricEventPool, mMetricEventPoolBak);
-        lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
-    }
-    return AcquireEventNoLock(ptr, mMetricEventPool, mMinUnusedMetricEventsCnt);
+    return AcquireEvent(ptr, mMetricEventPool, mReturnedMetricEvents, mMinUnusedMetricEventsCnt);
 }
 
 SpanEvent* EventPool::AcquireSpanEvent(PipelineEventGroup* ptr) {
-    if (mEnableLock) {
-        TransferPoolIfEmpty(mSpanEventPool, mSpanEventPoolBak);
-        lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
-    }
-    return AcquireEventNoLock(ptr, mSpanEventPool, mMinUnusedSpanEventsCnt);
+    return AcquireEvent(ptr, mSpanEventPool, mReturnedSpanEvents, mMinUnusedSpanEventsCnt);
 }
 
 RawEvent* EventPool::AcquireRawEvent(PipelineEventGroup* ptr) {
-    if (mEnableLock) {
-        TransferPoolIfEmpty(mRawEventPool, mRawEventPoolBak);
-        lock_guard<mutex> lock(mPoolMux);
-        return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
-    }
-    return AcquireEventNoLock(ptr, mRawEventPool, mMinUnusedRawEventsCnt);
+    return AcquireEvent(ptr, mRawEventPool, mReturnedRawEvents, mMinUnusedRawEventsCnt);
 }
 
 void EventPool::Release(vector<LogEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mLogEventPoolBak.insert(mLogEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mLogEventPool.insert(mLogEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mLogEventPool, mReturnedLogEvents);
 }
 
 void EventPool::Release(vector<MetricEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mMetricEventPoolBak.insert(mMetricEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mMetricEventPool.insert(mMetricEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mMetricEventPool, mReturnedMetricEvents);
 }
 
 void EventPool::Release(vector<SpanEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mSpanEventPoolBak.insert(mSpanEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mSpanEventPool.insert(mSpanEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mSpanEventPool, mReturnedSpanEvents);
 }
 
 void EventPool::Release(vector<RawEvent*>&& obj) {
-    if (mEnableLock) {
-        lock_guard<mutex> lock(mPoolBakMux);
-        mRawEventPoolBak.insert(mRawEventPoolBak.end(), obj.begin(), obj.end());
-    } else {
-        mRawEventPool.insert(mRawEventPool.end(), obj.begin(), obj.end());
-    }
+    ReleaseEvents(std::move(obj), mRawEventPool, mReturnedRawEvents);
 }
 
 template <class T>
-void DoGC(vector<T*>& pool, vector<T*>& poolBak, size_t& minUnusedCnt, mutex* mux, const string& type) {
+void DoGC(vector<T*>& pool, ReturnedEventStack<T>& returned, size_t& minUnusedCnt, const string& type) {
     if (minUnusedCnt <= pool.size() || minUnusedCnt == numeric_limits<size_t>::max()) {
         auto sz = minUnusedCnt == numeric_limits<size_t>::max() ? pool.size() : minUnusedCnt;
         for (size_t i = 0; i < sz; ++i) {
             delete pool.back();
             pool.pop_back();
         }
-        size_t bakSZ = 0;
-        if (mux) {
-            lock_guard<mutex> lock(*mux);
-            bakSZ = poolBak.size();
-            for (auto& item : poolBak) {
-                delete item;
-            }
-            poolBak.clear();
-        }
-        if (sz != 0 || bakSZ != 0) {
-            LOG_INFO(
-                sLogger,
-                ("event pool gc", "done")("event type", type)("gc event cnt", sz + bakSZ)("pool size", pool.size()));
+        // events returned since the last time the pool ran out are not used at all
+        size_t returnedSZ = returned.DeleteAll();
+        if (sz != 0 || returnedSZ != 0) {
+            LOG_INFO(sLogger,
+                     ("event pool gc", "done")("event type", type)("gc event cnt", sz + returnedSZ)(
+                         "pool size", pool.size()));
         }
     } else {
         LOG_ERROR(sLogger,
@@ -143,23 +91,43 @@ void DoGC(vector<T*>& pool, vector<T*>& poolBak, size_t& minUnusedCnt, mutex* mu
 }
 
 void EventPool::CheckGC() {
+    unique_lock<mutex> lock(mPoolMux, defer_lock);
+    if (mEnableLock) {
+        lock.lock();
+    }
+    if (mHitCounter) {
+        mHitCounter->Add(mHitCnt - mReportedHitCnt);
+        mMissCounter->Add(mMissCnt - mReportedMissCnt);
+        auto crossThreadReturnedCnt = mCrossThreadReturnedCnt.load(memory_order_relaxed);
+        mCrossThreadReturnedCounter->Add(crossThreadReturnedCnt - mReportedCrossThreadReturnedCnt);
+        mReportedCrossThreadReturnedCnt = crossThreadReturnedCnt;
+    }
+    mReportedHitCnt = mHitCnt;
+    mReportedMissCnt = mMissCnt;
     if (time(nullptr) - mLastGCTime > INT32_FLAG(event_pool_gc_interval_sec)) {
-        if (mEnableLock) {
-            lock_guard<mutex> lock(mPoolMux);
-            DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, &mPoolBakMux, "log");
-            DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, &mPoolBakMux, "metric");
-            DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, &mPoolBakMux, "span");
-            DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, &mPoolBakMux, "raw");
-        } else {
-            DoGC(mLogEventPool, mLogEventPoolBak, mMinUnusedLogEventsCnt, nullptr, "log");
-            DoGC(mMetricEventPool, mMetricEventPoolBak, mMinUnusedMetricEventsCnt, nullptr, "metric");
-            DoGC(mSpanEventPool, mSpanEventPoolBak, mMinUnusedSpanEventsCnt, nullptr, "span");
-            DoGC(mRawEventPool, mRawEventPoolBak, mMinUnusedRawEventsCnt, nullptr, "raw");
-        }
+        DoGC(mLogEventPool, mReturnedLogEvents, mMinUnusedLogEventsCnt, "log");
+        DoGC(mMetricEventPool, mReturnedMetricEvents, mMinUnusedMetricEventsCnt, "metric");
+        DoGC(mSpanEventPool, mReturnedSpanEvents, mMinUnusedSpanEventsCnt, "span");
+        DoGC(mRawEventPool, mReturnedRawEvents, mMinUnusedRawEventsCnt, "raw");
         mLastGCTime = time(nullptr);
     }
 }
 
+void EventPool::SetMetrics(const CounterPtr& hitCnt,
+                           const CounterPtr& missCnt,
+                           const CounterPtr& crossThreadReturnedCnt) {
+    unique_lock<mutex> lock(mPoolMux, defer_lock);
+    if (mEnableLock) {
+        lock.lock();
+    }
+    mHitCounter = hitCnt;
+    mMissCounter = missCnt;
+    mCrossThreadReturnedCounter = crossThreadReturnedCnt;
+    mReportedHitCnt = mHitCnt;
+    mReportedMissCnt = mMissCnt;
+    mReportedCrossThreadReturnedCnt = mCrossThreadReturnedCnt.load(memory_order_relaxed);
+}
+
 void EventPool::DestroyAllEventPool() {
     for (auto& item : mLogEventPool) {
         delete item;
@@ -175,19 +143,33 @@ void EventPool::DestroyAllEventPool() {
     }
 }
 
-void EventPool::DestroyAllEventPoolBak() {
-    for (auto& item : mLogEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mMetricEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mSpanEventPoolBak) {
-        delete item;
-    }
-    for (auto& item : mRawEventPoolBak) {
-        delete item;
-    }
+void EventPool::DestroyAllReturnedEvents() {
+    mReturnedLogEvents.DeleteAll();
+    mReturnedMetricEvents.DeleteAll();
+    mReturnedSpanEvents.DeleteAll();
+    mReturnedRawEvents.DeleteAll();
+}
+
+void EventPool::OnOwnerThreadStart() {
+    mOwnerThread.store(this_thread::get_id(), memory_order_relaxed);
+    mLastGCTime = 0;
+}
+
+void EventPool::OnOwnerThreadExit() {
+    // from now on, all events released are returned through the lock-free stacks until the pool is leased again
+    mOwnerThread.store(thread::id(), memory_order_relaxed);
+    DestroyAllEventPool();
+    mLogEventPool.clear();
+    mMetricEventPool.clear();
+    mSpanEventPool.clear();
+    mRawEventPool.clear();
+    mMinUnusedLogEventsCnt = numeric_limits<size_t>::max();
+    mMinUnusedMetricEventsCnt = numeric_limits<size_t>::max();
+    mMinUnusedSpanEventsCnt = numeric_limits<size_t>::max();
+    mMinUnusedRawEventsCnt = numeric_limits<size_t>::max();
+    mHitCounter.reset();
+    mMissCounter.reset();
+    mCrossThreadReturnedCounter.reset();
 }
 
 #ifdef APSARA_UNIT_TEST_MAIN
@@ -204,18 +186,53 @@ void EventPool::Clear() {
         mMinUnusedSpanEventsCnt = numeric_limits<size_t>::max();
         mMinUnusedRawEventsCnt = numeric_limits<size_t>::max();
     }
-    {
-        lock_guard<mutex> lock(mPoolBakMux);
-        DestroyAllEventPoolBak();
-        mLogEventPoolBak.clear();
-        mMetricEventPoolBak.clear();
-        mSpanEventPoolBak.clear();
-        mRawEventPoolBak.clear();
-    }
+    DestroyAllReturnedEvents();
     mLastGCTime = 0;
 }
 #endif
 
-thread_local EventPool gThreadedEventPool(false);
+class ThreadedEventPoolHolder {
+public:
+    ThreadedEventPoolHolder() {
+        {
+            lock_guard<mutex> lock(GetIdlePoolsMux());
+            auto& idlePools = GetIdlePools();
+            if (!idlePools.empty()) {
+                mPool = idlePools.back();
+                idlePools.pop_back();
+            }
+        }
+        if (mPool) {
+            mPool->OnOwnerThreadStart();
+        } else {
+            mPool = new EventPool(false);
+        }
+    }
+
+    ~ThreadedEventPoolHolder() {
+        mPool->OnOwnerThreadExit();
+        lock_guard<mutex> lock(GetIdlePoolsMux());
+        GetIdlePools().push_back(mPool);
+    }
+
+    EventPool& GetPool() { return *mPool; }
+
+private:
+    // intentionally leaked, since pools may still be referenced by events after all threads exit
+    static vector<EventPool*>& GetIdlePools() {
+        static auto* sIdlePools = new vector<EventPool*>();
+        return *sIdlePools;
+    }
+
+    static mutex& GetIdlePoolsMux() {
+        static auto* sMux = new mutex();
+        return *sMux;
+    }
+
+    EventPool* mPool = nullptr;
+};
+
+static thread_local ThreadedEventPoolHolder sThreadedEventPoolHolder;
+thread_local EventPool& gThreadedEventPool = sThreadedEventPoolHolder.GetPool();
 
 } // namespace logtail
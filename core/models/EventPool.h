@@ -18,22 +18,91 @@
 
 #include <cstdint>
 
+#include <atomic>
 #include <limits>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 #include "models/LogEvent.h"
 #include "models/MetricEvent.h"
 #include "models/RawEvent.h"
 #include "models/SpanEvent.h"
+#include "monitor/metric_models/MetricTypes.h"
 
 namespace logtail {
 class PipelineEventGroup;
 
+// Events released by threads other than the owner are pushed to a lock-free stack in batches, and are taken back by
+// the owner all at once when its local pool runs out. Only push and pop-all are supported, so there is no ABA problem.
+template <class T>
+class ReturnedEventStack {
+public:
+    struct Batch {
+        std::vector<T*> mEvents;
+        Batch* mNext = nullptr;
+    };
+
+    ~ReturnedEventStack() { DeleteAll(); }
+
+    void Push(std::vector<T*>&& events) {
+        auto batch = new Batch{std::move(events), mHead.load(std::memory_order_relaxed)};
+        while (!mHead.compare_exchange_weak(batch->mNext, batch, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+    // move all returned events to the end of pool, and return the number of events moved
+    size_t PopAllTo(std::vector<T*>& pool) {
+        size_t cnt = 0;
+        auto batch = mHead.exchange(nullptr, std::memory_order_acquire);
+        while (batch) {
+            cnt += batch->mEvents.size();
+            if (pool.empty()) {
+                pool.swap(batch->mEvents);
+            } else {
+                pool.insert(pool.end(), batch->mEvents.begin(), batch->mEvents.end());
+            }
+            auto next = batch->mNext;
+            delete batch;
+            batch = next;
+        }
+        return cnt;
+    }
+
+    bool Empty() const { return mHead.load(std::memory_order_relaxed) == nullptr; }
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    size_t Size() const {
+        size_t cnt = 0;
+        for (auto batch = mHead.load(); batch; batch = batch->mNext) {
+            cnt += batch->mEvents.size();
+        }
+        return cnt;
+    }
+
+    // the last event returned
+    T* Back() const { return mHead.load()->mEvents.back(); }
+#endif
+
+    size_t DeleteAll() {
+        std::vector<T*> events;
+        size_t cnt = PopAllTo(events);
+        for (auto& item : events) {
+            delete item;
+        }
+        return cnt;
+    }
+
+private:
+    std::atomic<Batch*> mHead = nullptr;
+};
+
 class EventPool {
 public:
-    explicit EventPool(bool enableLock = true) : mEnableLock(enableLock) {}
+    // @param enableLock if false, the pool is owned by the constructing thread, and events released by other threads
+    // are returned through the lock-free stacks.
+    explicit EventPool(bool enableLock = true) : mEnableLock(enableLock), mOwnerThread(std::this_thread::get_id()) {}
     ~EventPool();
     EventPool(const EventPool&) = delete;
     EventPool& operator=(const EventPool&) = delete;
@@ -42,11 +111,14 @@ public:
     MetricEvent* AcquireMetricEvent(PipelineEventGroup* ptr);
     SpanEvent* AcquireSpanEvent(PipelineEventGroup* ptr);
     RawEvent* AcquireRawEvent(PipelineEventGroup* ptr);
+    // events should have been reset before release, so that their containers keep the capacity for reuse
     void Release(std::vector<LogEvent*>&& obj);
     void Release(std::vector<MetricEvent*>&& obj);
     void Release(std::vector<SpanEvent*>&& obj);
     void Release(std::vector<RawEvent*>&& obj);
+    // also updates the metrics set by SetMetrics
     void CheckGC();
+    void SetMetrics(const CounterPtr& hitCnt, const CounterPtr& missCnt, const CounterPtr& crossThreadReturnedCnt);
 
 #ifdef APSARA_UNIT_TEST_MAIN
     void Clear();
@@ -54,20 +126,31 @@ public:
 
 private:
     template <class T>
-    void TransferPoolIfEmpty(std::vector<T*>& pool, std::vector<T*>& poolBak) {
-        std::lock_guard<std::mutex> lock(mPoolMux);
-        if (pool.empty()) {
-            std::lock_guard<std::mutex> lk(mPoolBakMux);
-            pool.swap(poolBak);
+    T* AcquireEvent(PipelineEventGroup* ptr,
+                    std::vector<T*>& pool,
+                    ReturnedEventStack<T>& returned,
+                    size_t& minUnusedCnt) {
+        if (mEnableLock) {
+            std::lock_guard<std::mutex> lock(mPoolMux);
+            if (pool.empty()) {
+                returned.PopAllTo(pool);
+            }
+            return AcquireEventNoLock(ptr, pool, minUnusedCnt);
+        }
+        if (pool.empty() && !returned.Empty()) {
+            returned.PopAllTo(pool);
         }
+        return AcquireEventNoLock(ptr, pool, minUnusedCnt);
     }
 
     template <class T>
     T* AcquireEventNoLock(PipelineEventGroup* ptr, std::vector<T*>& pool, size_t& minUnusedCnt) {
         if (pool.empty()) {
+            ++mMissCnt;
             return new T(ptr);
         }
 
+        ++mHitCnt;
         auto obj = pool.back();
         obj->ResetPipelineEventGroup(ptr);
         pool.pop_back();
@@ -75,23 +158,43 @@ private:
         return obj;
     }
 
+    template <class T>
+    void ReleaseEvents(std::vector<T*>&& obj, std::vector<T*>& pool, ReturnedEventStack<T>& returned) {
+        if (obj.empty()) {
+            return;
+        }
+        // events of a shared pool always go through the returned stack, which is not a cross thread return
+        if (!mEnableLock) {
+            if (std::this_thread::get_id() == mOwnerThread.load(std::memory_order_relaxed)) {
+                pool.insert(pool.end(), obj.begin(), obj.end());
+                return;
+            }
+            mCrossThreadReturnedCnt.fetch_add(obj.size(), std::memory_order_relaxed);
+        }
+        returned.Push(std::move(obj));
+    }
+
     void DestroyAllEventPool();
-    void DestroyAllEventPoolBak();
+    void DestroyAllReturnedEvents();
+
+    // called when the thread owning the pool exits, see ThreadedEventPoolHolder
+    void OnOwnerThreadExit();
+    void OnOwnerThreadStart();
 
     bool mEnableLock = true;
+    std::atomic<std::thread::id> mOwnerThread;
 
+    // only meaningful when mEnableLock is true
     std::mutex mPoolMux;
     std::vector<LogEvent*> mLogEventPool;
     std::vector<MetricEvent*> mMetricEventPool;
     std::vector<SpanEvent*> mSpanEventPool;
     std::vector<RawEvent*> mRawEventPool;
 
-    // only meaningful when mEnableLock is true
-    std::mutex mPoolBakMux;
-    std::vector<LogEvent*> mLogEventPoolBak;
-    std::vector<MetricEvent*> mMetricEventPoolBak;
-    std::vector<SpanEvent*> mSpanEventPoolBak;
-    std::vector<RawEvent*> mRawEventPoolBak;
+    ReturnedEventStack<LogEvent> mReturnedLogEvents;
+    ReturnedEventStack<MetricEvent> mReturnedMetricEvents;
+    ReturnedEventStack<SpanEvent> mReturnedSpanEvents;
+    ReturnedEventStack<RawEvent> mReturnedRawEvents;
 
     size_t mMinUnusedLogEventsCnt = std::numeric_limits<size_t>::max();
     size_t mMinUnusedMetricEventsCnt = std::numeric_limits<size_t>::max();
@@ -100,6 +203,18 @@ private:
 
     time_t mLastGCTime = 0;
 
+    // modified only by the acquiring side, which is either the owner thread or protected by mPoolMux
+    uint64_t mHitCnt = 0;
+    uint64_t mMissCnt = 0;
+    std::atomic_uint64_t mCrossThreadReturnedCnt = 0;
+    uint64_t mReportedHitCnt = 0;
+    uint64_t mReportedMissCnt = 0;
+    uint64_t mReportedCrossThreadReturnedCnt = 0;
+    CounterPtr mHitCounter;
+    CounterPtr mMissCounter;
+    CounterPtr mCrossThreadReturnedCounter;
+
+    friend class ThreadedEventPoolHolder;
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class EventPoolUnittest;
     friend class PipelineEventGroupUnittest;
@@ -107,6 +222,9 @@ private:
 #endif
 };
 
-extern thread_local EventPool gThreadedEventPool;
+// Each thread leases an event pool when gThreadedEventPool is first used, and gives it back when the thread exits.
+// Since events acquired from the pool may be released by other threads after the owner thread exits, leased pools are
+// never destroyed but reused by later threads.
+extern thread_local EventPool& gThreadedEventPool;
 
 } // namespace logtail
@@ -30,22 +30,25 @@ unique_ptr<PipelineEvent> LogEvent::Copy() const {
 void LogEvent::Reset() {
     PipelineEvent::Reset();
     mContents.clear();
-    mIndex.clear();
+    mHashIndex.clear();
+    mHashIndexUsed = 0;
+    mHasDuplicateKey = false;
     mAllocatedContentSize = 0;
+    mSize = 0;
     mFileOffset = 0;
     mRawSize = 0;
 }
 
 StringView LogEvent::GetContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return mContents[it->second].first.second;
+    size_t pos = FindContentPos(key);
+    if (pos != mContents.size()) {
+        return mContents[pos].first.second;
     }
     return gEmptyStringView;
 }
 
 bool LogEvent::HasContent(StringView key) const {
-    return mIndex.find(key) != mIndex.end();
+    return FindContentPos(key) != mContents.size();
 }
 
 void LogEvent::SetContent(StringView key, StringView val) {
@@ -65,26 +68,32 @@ void LogEvent::SetContentNoCopy(const StringBuffer& key, const StringBuffer& val
 }
 
 void LogEvent::SetContentNoCopy(StringView key, StringView val) {
-    auto rst = mIndex.insert(make_pair(key, mContents.size()));
-    if (!rst.second) {
-        auto& it = rst.first;
-        auto& field = mContents[it->second].first;
+    size_t pos = FindContentPos(key);
+    if (pos != mContents.size()) {
+        auto& field = mContents[pos].first;
         mAllocatedContentSize += key.size() + val.size() - field.first.size() - field.second.size();
         field = make_pair(key, val);
     } else {
-        mAllocatedContentSize += key.size() + val.size();
-        mContents.emplace_back(make_pair(key, val), true);
+        PushContent(key, val);
+        ++mSize;
     }
 }
 
 void LogEvent::DelContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        auto& field = mContents[it->second].first;
-        mAllocatedContentSize -= field.first.size() + field.second.size();
-        mContents[it->second].second = false;
-        mIndex.erase(it);
+    size_t pos = FindContentPos(key);
+    if (pos == mContents.size()) {
+        return;
     }
+    // contents shadowed by AppendContentNoCopy precede the one found, and are deleted along with it. Otherwise, they
+    // would be found again by linear scan but not by hash index.
+    for (size_t i = mHasDuplicateKey ? 0 : pos; i <= pos; ++i) {
+        auto& content = mContents[i];
+        if (content.second && content.first.first == key) {
+            mAllocatedContentSize -= content.first.first.size() + content.first.second.size();
+            content.second = false;
+        }
+    }
+    --mSize;
 }
 
 void LogEvent::SetLevel(const std::string& level) {
@@ -93,19 +102,11 @@ void LogEvent::SetLevel(const std::string& level) {
 }
 
 LogEvent::ContentIterator LogEvent::FindContent(StringView key) {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ContentIterator(mContents.begin() + it->second, mContents);
-    }
-    return ContentIterator(mContents.end(), mContents);
+    return ContentIterator(mContents.begin() + FindContentPos(key), mContents);
 }
 
 LogEvent::ConstContentIterator LogEvent::FindContent(StringView key) const {
-    auto it = mIndex.find(key);
-    if (it != mIndex.end()) {
-        return ConstContentIterator(mContents.begin() + it->second, mContents);
-    }
-    return ConstContentIterator(mContents.end(), mContents);
+    return ConstContentIterator(mContents.begin() + FindContentPos(key), mContents);
 }
 
 LogEvent::ContentIterator LogEvent::begin() {
@@ -142,9 +143,84 @@ LogEvent::ConstContentIterator LogEvent::cend() const {
 }
 
 void LogEvent::AppendContentNoCopy(StringView key, StringView val) {
+    // the existing content with the same key is kept, but can no longer be found by key
+    if (FindContentPos(key) == mContents.size()) {
+        ++mSize;
+    } else {
+        mHasDuplicateKey = true;
+    }
+    PushContent(key, val);
+}
+
+size_t LogEvent::FindContentPos(StringView key) const {
+    if (mHashIndex.empty()) {
+        // search backward, so that the latest content wins if the same key is appended multiple times
+        for (size_t i = mContents.size(); i > 0; --i) {
+            const auto& content = mContents[i - 1];
+            if (content.second && content.first.first == key) {
+                return i - 1;
+            }
+        }
+        return mContents.size();
+    }
+    size_t mask = mHashIndex.size() - 1;
+    for (size_t slot = StringViewHash()(key) & mask;; slot = (slot + 1) & mask) {
+        uint32_t pos = mHashIndex[slot];
+        if (pos == 0) {
+            return mContents.size();
+        }
+        const auto& content = mContents[pos - 1];
+        if (content.second && content.first.first == key) {
+            return pos - 1;
+        }
+    }
+}
+
+void LogEvent::PushContent(StringView key, StringView val) {
     mAllocatedContentSize += key.size() + val.size();
     mContents.emplace_back(make_pair(key, val), true);
-    mIndex[key] = mContents.size() - 1;
+    if (!mHashIndex.empty()) {
+        // keep the load factor of the index below 1/2
+        if ((mHashIndexUsed + 1) * 2 > mHashIndex.size()) {
+            RebuildHashIndex();
+        } else {
+            InsertHashIndex(mContents.size() - 1);
+        }
+    } else if (mContents.size() >= sHashIndexThreshold) {
+        RebuildHashIndex();
+    }
+}
+
+void LogEvent::InsertHashIndex(size_t pos) {
+    const auto& key = mContents[pos].first.first;
+    size_t mask = mHashIndex.size() - 1;
+    for (size_t slot = StringViewHash()(key) & mask;; slot = (slot + 1) & mask) {
+        uint32_t& cur = mHashIndex[slot];
+        if (cur == 0) {
+            cur = static_cast<uint32_t>(pos + 1);
+            ++mHashIndexUsed;
+            return;
+        }
+        const auto& content = mContents[cur - 1];
+        if (content.second && content.first.first == key) {
+            cur = static_cast<uint32_t>(pos + 1);
+            return;
+        }
+    }
+}
+
+void LogEvent::RebuildHashIndex() {
+    size_t capacity = sHashIndexThreshold * 2;
+    while (capacity < mSize * 4) {
+        capacity *= 2;
+    }
+    mHashIndex.assign(capacity, 0);
+    mHashIndexUsed = 0;
+    for (size_t i = 0; i < mContents.size(); ++i) {
+        if (mContents[i].second) {
+            InsertHashIndex(i);
+        }
+    }
 }
 
 size_t LogEvent::DataSize() const {
@@ -92,8 +92,8 @@ public:
     StringView GetLevel() const { return mLevel; }
     void SetLevel(const std::string& level);
 
-    bool Empty() const { return mIndex.empty(); }
-    size_t Size() const { return mIndex.size(); }
+    bool Empty() const { return mSize == 0; }
+    size_t Size() const { return mSize; }
 
     ContentIterator begin();
     ContentIterator end();
@@ -110,6 +110,8 @@ public:
 #endif
 
 private:
+    static constexpr size_t sHashIndexThreshold = 16;
+
     LogEvent(PipelineEventGroup* ptr);
 
     // this is only used for ProcessorParseApsaraNative for backward compatability, since multiple keys are allowed.
@@ -117,11 +119,26 @@ private:
     friend class ProcessorParseApsaraNative;
     void AppendContentNoCopy(StringView key, StringView val);
 
+    // return the position of key in mContents, or mContents.size() if not found
+    size_t FindContentPos(StringView key) const;
+    void PushContent(StringView key, StringView val);
+    void InsertHashIndex(size_t pos);
+    void RebuildHashIndex();
+
     // since log reduce in SLS server requires the original order of log contents, we have to maintain this sequential
     // information for backward compatability.
+    // Deleted contents are only marked invalid (second == false) instead of being erased.
     ContentsContainer mContents;
     size_t mAllocatedContentSize = 0;
-    std::map<StringView, size_t> mIndex;
+    // number of distinct keys, contents shadowed by AppendContentNoCopy are not counted
+    size_t mSize = 0;
+    // Most events have only a few contents, which are looked up by linear scan. Once the number of contents reaches
+    // sHashIndexThreshold, an open addressing hash index is built, where each slot holds the position in mContents
+    // plus 1, and 0 means empty. Slots of deleted contents are left as tombstones until the index is rebuilt.
+    std::vector<uint32_t> mHashIndex;
+    size_t mHashIndexUsed = 0;
+    // whether any key has been appended more than once by AppendContentNoCopy
+    bool mHasDuplicateKey = false;
     uint64_t mFileOffset = 0;
     uint64_t mRawSize = 0;
     StringView mLevel;
@@ -16,6 +16,7 @@
 
 #include "models/PipelineEventGroup.h"
 
+#include <algorithm>
 #ifdef APSARA_UNIT_TEST_MAIN
 #include <sstream>
 #endif
@@ -33,28 +34,25 @@ namespace logtail {
 
 template <class T>
 void DestroyEvents(vector<PipelineEventPtr>&& events) {
-    unordered_map<EventPool*, vector<T*>> eventsPoolMap;
-    // for most cases, all events have the same origin. So we cache the pool pointer and iterator for efficiency
-    EventPool* cachedPoolPtr = nullptr;
-    typename unordered_map<EventPool*, vector<T*>>::iterator cachedIt;
-    bool firstEvent = true;
+    // for most cases, all events have the same origin, so the whole group is released to the pool in one batch
+    vector<pair<EventPool*, vector<T*>>> eventsPoolList;
     for (auto& item : events) {
         if (item && item.IsFromEventPool()) {
             item->Reset();
-            if (firstEvent || item.GetEventPool() != cachedPoolPtr) {
-                cachedPoolPtr = item.GetEventPool();
-                cachedIt = eventsPoolMap.find(cachedPoolPtr);
-                if (cachedIt == eventsPoolMap.end()) {
-                    eventsPoolMap.emplace(cachedPoolPtr, vector<T*>());
-                    cachedIt = eventsPoolMap.find(cachedPoolPtr);
-                    cachedIt->second.reserve(events.size());
-                }
-                firstEvent = false;
+            EventPool* pool = item.GetEventPool();
+            auto it = eventsPoolList.begin();
+            while (it != eventsPoolList.end() && it->first != pool) {
+                ++it;
             }
-            cachedIt->second.emplace_back(static_cast<T*>(item.Release()));
+            if (it == eventsPoolList.end()) {
+                eventsPoolList.emplace_back(pool, vector<T*>());
+                it = prev(eventsPoolList.end());
+                it->second.reserve(events.size());
+            }
+            it->second.emplace_back(static_cast<T*>(item.Release()));
         }
     }
-    for (auto& item : eventsPoolMap) {
+    for (auto& item : eventsPoolList) {
         if (item.first) {
             item.first->Release(std::move(item.second));
         } else {
@@ -120,6 +118,57 @@ PipelineEventGroup PipelineEventGroup::Copy() const {
     return res;
 }
 
+vector<PipelineEventGroup> PipelineEventGroup::SplitIntoChunks(size_t chunkCnt) {
+    vector<PipelineEventGroup> chunks;
+    chunkCnt = min(chunkCnt, mEvents.size());
+    if (chunkCnt == 0) {
+        return chunks;
+    }
+    chunks.reserve(chunkCnt);
+    size_t begin = 0;
+    for (size_t i = 0; i < chunkCnt; ++i) {
+        size_t end = begin + mEvents.size() / chunkCnt + (i < mEvents.size() % chunkCnt ? 1 : 0);
+        chunks.emplace_back(make_shared<SourceBuffer>());
+        auto& chunk = chunks.back();
+        chunk.mMetadata = mMetadata;
+        chunk.mTags = mTags;
+        chunk.mExactlyOnceCheckpoint = mExactlyOnceCheckpoint;
+        chunk.mEvents.reserve(end - begin);
+        for (size_t j = begin; j < end; ++j) {
+            mEvents[j]->ResetPipelineEventGroup(&chunk);
+            chunk.mEvents.emplace_back(std::move(mEvents[j]));
+        }
+        begin = end;
+    }
+    mEvents.clear();
+    return chunks;
+}
+
+void PipelineEventGroup::MergeChunks(vector<PipelineEventGroup>&& chunks) {
+    if (chunks.empty()) {
+        return;
+    }
+    mMetadata = std::move(chunks[0].mMetadata);
+    mTags = std::move(chunks[0].mTags);
+    size_t cnt = mEvents.size();
+    for (const auto& chunk : chunks) {
+        cnt += chunk.mEvents.size();
+    }
+    mEvents.reserve(cnt);
+    for (auto& chunk : chunks) {
+        for (auto& e : chunk.mEvents) {
+            e->ResetPipelineEventGroup(this);
+            mEvents.emplace_back(std::move(e));
+        }
+        chunk.mEvents.clear();
+        // data allocated while processing the chunk should live as long as this group
+        if (chunk.mSourceBuffer && chunk.mSourceBuffer != mSourceBuffer) {
+            mSourceBuffer->AddExternalBuffer(std::move(chunk.mSourceBuffer));
+        }
+    }
+    chunks.clear();
+}
+
 unique_ptr<LogEvent> PipelineEventGroup::CreateLogEvent(bool fromPool, EventPool* pool) {
     LogEvent* e = nullptr;
     if (fromPool) {
@@ -179,11 +228,11 @@ unique_ptr<RawEvent> PipelineEventGroup::CreateRawEvent(bool fromPool, EventPool
 LogEvent* PipelineEventGroup::AddLogEvent(bool fromPool, EventPool* pool) {
     LogEvent* e = nullptr;
     if (fromPool) {
-        if (pool) {
-            e = pool->AcquireLogEvent(this);
-        } else {
-            e = gThreadedEventPool.AcquireLogEvent(this);
+        // record the thread local pool as well, so that the event can be returned to it from other threads
+        if (!pool) {
+            pool = &gThreadedEventPool;
         }
+        e = pool->AcquireLogEvent(this);
     } else {
         e = new LogEvent(this);
     }
@@ -194,11 +243,10 @@ LogEvent* PipelineEventGroup::AddLogEvent(bool fromPool, EventPool* pool) {
 MetricEvent* PipelineEventGroup::AddMetricEvent(bool fromPool, EventPool* pool) {
     MetricEvent* e = nullptr;
     if (fromPool) {
-        if (pool) {
-            e = pool->AcquireMetricEvent(this);
-        } else {
-            e = gThreadedEventPool.AcquireMetricEvent(this);
+        if (!pool) {
+            pool = &gThreadedEventPool;
         }
+        e = pool->AcquireMetricEvent(this);
     } else {
         e = new MetricEvent(this);
     }
@@ -209,11 +257,10 @@ MetricEvent* PipelineEventGroup::AddMetricEvent(bool fromPool, EventPool* pool)
 SpanEvent* PipelineEventGroup::AddSpanEvent(bool fromPool, EventPool* pool) {
     SpanEvent* e = nullptr;
     if (fromPool) {
-        if (pool) {
-            e = pool->AcquireSpanEvent(this);
-        } else {
-            e = gThreadedEventPool.AcquireSpanEvent(this);
+        if (!pool) {
+            pool = &gThreadedEventPool;
         }
+        e = pool->AcquireSpanEvent(this);
     } else {
         e = new SpanEvent(this);
     }
@@ -224,11 +271,10 @@ SpanEvent* PipelineEventGroup::AddSpanEvent(bool fromPool, EventPool* pool) {
 RawEvent* PipelineEventGroup::AddRawEvent(bool fromPool, EventPool* pool) {
     RawEvent* e = nullptr;
     if (fromPool) {
-        if (pool) {
-            e = pool->AcquireRawEvent(this);
-        } else {
-            e = gThreadedEventPool.AcquireRawEvent(this);
+        if (!pool) {
+            pool = &gThreadedEventPool;
         }
+        e = pool->AcquireRawEvent(this);
     } else {
         e = new RawEvent(this);
     }
@@ -314,11 +360,15 @@ size_t PipelineEventGroup::GetTagsHash() const {
 }
 
 size_t PipelineEventGroup::DataSize() const {
-    size_t eventsSize = sizeof(decltype(mEvents));
+    return sizeof(decltype(mEvents)) + EventsDataSize() + mTags.DataSize();
+}
+
+size_t PipelineEventGroup::EventsDataSize() const {
+    size_t eventsSize = 0;
     for (const auto& item : mEvents) {
         eventsSize += item->DataSize();
     }
-    return eventsSize + mTags.DataSize();
+    return eventsSize;
 }
 
 bool PipelineEventGroup::IsReplay() const {
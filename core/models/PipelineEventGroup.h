@@ -83,6 +83,14 @@ public:
 
     PipelineEventGroup Copy() const;
 
+    // Move events into at most chunkCnt groups of nearly equal size, in the original order. Each chunk has the same
+    // metadata, tags and checkpoint, and its own source buffer, so that chunks can be processed by different threads.
+    // Chunk data may refer to the source buffer of this group, so this group must outlive the chunks unless they are
+    // merged back by MergeChunks.
+    std::vector<PipelineEventGroup> SplitIntoChunks(size_t chunkCnt);
+    // Move events of all chunks back into this group in order. Metadata and tags are taken from the first chunk.
+    void MergeChunks(std::vector<PipelineEventGroup>&& chunks);
+
     std::unique_ptr<LogEvent> CreateLogEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<MetricEvent> CreateMetricEvent(bool fromPool = false, EventPool* pool = nullptr);
     std::unique_ptr<SpanEvent> CreateSpanEvent(bool fromPool = false, EventPool* pool = nullptr);
@@ -127,6 +135,8 @@ public:
     bool IsReplay() const;
 
     size_t DataSize() const;
+    // data size of the events only, without group level data such as tags
+    size_t EventsDataSize() const;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     // for debug and test
@@ -108,6 +108,8 @@ extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL;
 extern const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS;
 extern const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL;
+extern const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_HITS_TOTAL;
+extern const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_MISSES_TOTAL;
 
 /**********************************************************
  *   input_ebpf
@@ -188,6 +190,13 @@ extern const std::string METRIC_PLUGIN_FLUSHER_OTHER_ERROR_TOTAL;
  **********************************************************/
 extern const std::string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL;
 
+/**********************************************************
+ *   processor_parse_regex_native
+ *   processor_filter_regex_native
+ **********************************************************/
+extern const std::string METRIC_PLUGIN_BOOST_REGEX_MATCH_TIME_MS;
+extern const std::string METRIC_PLUGIN_RE2_REGEX_MATCH_TIME_MS;
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
@@ -225,10 +234,12 @@ extern const std::string METRIC_LABEL_KEY_FLUSHER_PLUGIN_ID;
 extern const std::string METRIC_LABEL_KEY_EXACTLY_ONCE_ENABLED;
 extern const std::string METRIC_LABEL_KEY_QUEUE_TYPE;
 extern const std::string METRIC_LABEL_KEY_GROUP_BATCH_ENABLED;
+extern const std::string METRIC_LABEL_KEY_LIMITER_NAME;
 
 // label values
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_BATCHER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_COMPRESSOR;
+extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_CONCURRENCY_LIMITER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_PROCESS_QUEUE;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_ROUTER;
 extern const std::string METRIC_LABEL_VALUE_COMPONENT_NAME_SENDER_QUEUE;
@@ -273,6 +284,12 @@ extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_PROJECT_LIMITE
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_LOGSTORE_LIMITER_TIMES_TOTAL;
 extern const std::string METRIC_COMPONENT_QUEUE_FETCH_REJECTED_BY_RATE_LIMITER_TIMES_TOTAL;
 
+/**********************************************************
+ *   concurrency limiter
+ **********************************************************/
+extern const std::string METRIC_COMPONENT_LIMITER_CONCURRENCY_LIMIT;
+extern const std::string METRIC_COMPONENT_LIMITER_RTT_MS;
+
 //////////////////////////////////////////////////////////////////////////
 // runner
 //////////////////////////////////////////////////////////////////////////
@@ -285,6 +302,7 @@ extern const std::string METRIC_LABEL_KEY_THREAD_NO;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK;
+extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_ASYN_CURL;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS;
 extern const std::string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER;
@@ -309,14 +327,27 @@ extern const std::string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS;
+extern const std::string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_FIRST_BYTE_TIME_MS;
 extern const std::string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL;
 extern const std::string METRIC_RUNNER_SINK_SEND_CONCURRENCY;
 
+/**********************************************************
+ *   processor runner
+ **********************************************************/
+extern const std::string METRIC_RUNNER_PROCESSOR_POP_TOTAL_TIME_MS;
+extern const std::string METRIC_RUNNER_PROCESSOR_STOLEN_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_PROCESSOR_PARALLEL_TASKS_TOTAL;
+extern const std::string METRIC_RUNNER_PROCESSOR_PUSH_QUEUE_BLOCKED_TIME_MS;
+extern const std::string METRIC_RUNNER_PROCESSOR_EVENT_POOL_HIT_TOTAL;
+extern const std::string METRIC_RUNNER_PROCESSOR_EVENT_POOL_MISS_TOTAL;
+extern const std::string METRIC_RUNNER_PROCESSOR_EVENT_POOL_CROSS_THREAD_RETURNED_TOTAL;
+
 /**********************************************************
  *   flusher runner
  **********************************************************/
 extern const std::string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES;
 extern const std::string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL;
+extern const std::string METRIC_RUNNER_FLUSHER_SEND_BLOCKED_TIME_MS;
 
 /**********************************************************
  *   file server
@@ -327,6 +358,12 @@ extern const std::string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIG
 extern const std::string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE;
 extern const std::string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE;
+extern const std::string METRIC_RUNNER_FILE_POLLING_ROUND_TIME_MS;
+extern const std::string METRIC_RUNNER_FILE_POLLING_STAT_COUNT;
+extern const std::string METRIC_RUNNER_FILE_POLLING_SKIPPED_STAT_COUNT;
+extern const std::string METRIC_RUNNER_FILE_BATCHED_READ_SUBMITTED_TOTAL;
+extern const std::string METRIC_RUNNER_FILE_BATCHED_READ_COMPLETED_TOTAL;
+extern const std::string METRIC_RUNNER_FILE_PARALLEL_READ_TASKS_TOTAL;
 
 /**********************************************************
  *   ebpf server
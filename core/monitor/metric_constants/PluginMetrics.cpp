@@ -60,6 +60,8 @@ const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TOTAL = "prom_subscribe_total";
 const std::string METRIC_PLUGIN_PROM_SUBSCRIBE_TIME_MS = "prom_subscribe_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_TIME_MS = "prom_scrape_time_ms";
 const std::string METRIC_PLUGIN_PROM_SCRAPE_DELAY_TOTAL = "prom_scrape_delay_total";
+const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_HITS_TOTAL = "prom_relabel_cache_hits_total";
+const std::string METRIC_PLUGIN_PROM_RELABEL_CACHE_MISSES_TOTAL = "prom_relabel_cache_misses_total";
 
 /**********************************************************
  *   input_ebpf
@@ -126,6 +128,13 @@ const string METRIC_PLUGIN_OUT_SUCCESSFUL_EVENTS_TOTAL = "out_successful_events_
  **********************************************************/
 const string METRIC_PLUGIN_HISTORY_FAILURE_TOTAL = "history_failure_total";
 
+/**********************************************************
+ *   processor_parse_regex_native
+ *   processor_filter_regex_native
+ **********************************************************/
+const string METRIC_PLUGIN_BOOST_REGEX_MATCH_TIME_MS = "boost_regex_match_time_ms";
+const string METRIC_PLUGIN_RE2_REGEX_MATCH_TIME_MS = "re2_regex_match_time_ms";
+
 /**********************************************************
  *   processor_split_multiline_log_string_native
  **********************************************************/
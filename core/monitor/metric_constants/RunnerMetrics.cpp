@@ -27,6 +27,7 @@ const string METRIC_LABEL_KEY_THREAD_NO = "thread_no";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FILE_SERVER = "file_server";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_FLUSHER = "flusher_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_HTTP_SINK = "http_sink";
+const string METRIC_LABEL_VALUE_RUNNER_NAME_ASYN_CURL = "asyn_curl_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR = "processor_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_PROMETHEUS = "prometheus_runner";
 const string METRIC_LABEL_VALUE_RUNNER_NAME_EBPF_SERVER = "ebpf_runner";
@@ -51,14 +52,27 @@ const string METRIC_RUNNER_SINK_OUT_SUCCESSFUL_ITEMS_TOTAL = "out_successful_ite
 const string METRIC_RUNNER_SINK_OUT_FAILED_ITEMS_TOTAL = "out_failed_items_total";
 const string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS = "successful_response_time_ms";
 const string METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS = "failed_response_time_ms";
+const string METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_FIRST_BYTE_TIME_MS = "successful_first_byte_time_ms";
 const string METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL = "sending_items_total";
 const string METRIC_RUNNER_SINK_SEND_CONCURRENCY = "send_concurrency";
 
+/**********************************************************
+ *   processor runner
+ **********************************************************/
+const string METRIC_RUNNER_PROCESSOR_POP_TOTAL_TIME_MS = "pop_total_time_ms";
+const string METRIC_RUNNER_PROCESSOR_STOLEN_ITEMS_TOTAL = "stolen_items_total";
+const string METRIC_RUNNER_PROCESSOR_PARALLEL_TASKS_TOTAL = "parallel_tasks_total";
+const string METRIC_RUNNER_PROCESSOR_PUSH_QUEUE_BLOCKED_TIME_MS = "push_queue_blocked_time_ms";
+const string METRIC_RUNNER_PROCESSOR_EVENT_POOL_HIT_TOTAL = "event_pool_hit_total";
+const string METRIC_RUNNER_PROCESSOR_EVENT_POOL_MISS_TOTAL = "event_pool_miss_total";
+const string METRIC_RUNNER_PROCESSOR_EVENT_POOL_CROSS_THREAD_RETURNED_TOTAL = "event_pool_cross_thread_returned_total";
+
 /**********************************************************
  *   flusher runner
  **********************************************************/
 const string METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES = "in_raw_size_bytes";
 const string METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL = "waiting_items_total";
+const string METRIC_RUNNER_FLUSHER_SEND_BLOCKED_TIME_MS = "send_blocked_time_ms";
 
 /**********************************************************
  *   file server
@@ -69,6 +83,12 @@ const string METRIC_RUNNER_FILE_ENABLE_FILE_INCLUDED_BY_MULTI_CONFIGS_FLAG = "en
 const string METRIC_RUNNER_FILE_POLLING_MODIFY_CACHE_SIZE = "polling_modify_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_DIR_CACHE_SIZE = "polling_dir_cache_size";
 const string METRIC_RUNNER_FILE_POLLING_FILE_CACHE_SIZE = "polling_file_cache_size";
+const string METRIC_RUNNER_FILE_POLLING_ROUND_TIME_MS = "polling_round_time_ms";
+const string METRIC_RUNNER_FILE_POLLING_STAT_COUNT = "polling_stat_count";
+const string METRIC_RUNNER_FILE_POLLING_SKIPPED_STAT_COUNT = "polling_skipped_stat_count";
+const string METRIC_RUNNER_FILE_BATCHED_READ_SUBMITTED_TOTAL = "batched_read_submitted_total";
+const string METRIC_RUNNER_FILE_BATCHED_READ_COMPLETED_TOTAL = "batched_read_completed_total";
+const string METRIC_RUNNER_FILE_PARALLEL_READ_TASKS_TOTAL = "parallel_read_tasks_total";
 
 /**********************************************************
  *   ebpf server
@@ -61,6 +61,9 @@ DEFINE_FLAG_BOOL(enable_metricstore_channel, "only works for metrics data for en
 DEFINE_FLAG_INT32(max_send_log_group_size, "bytes", 10 * 1024 * 1024);
 DEFINE_FLAG_DOUBLE(sls_serialize_size_expansion_ratio, "", 1.2);
 DEFINE_FLAG_INT32(sls_request_dscp, "set dscp for sls request, from 0 to 63", -1);
+DEFINE_FLAG_BOOL(enable_sls_serialize_and_compress,
+                 "serialize and compress event groups in one pass without keeping the whole serialized data",
+                 true);
 
 DECLARE_FLAG_BOOL(send_prefer_real_ip);
 
@@ -721,9 +724,9 @@ void FlusherSLS::OnSendDone(const HttpResponse& response, SenderQueueItem* item)
                 ToString(chrono::duration_cast<chrono::milliseconds>(curSystemTime - item->mFirstEnqueTime).count())
                     + "ms")("try cnt", data->mTryCnt)("endpoint", data->mCurrentHost)("is profile data",
                                                                                       isProfileData));
-        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime);
-        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime);
-        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime);
+        GetRegionConcurrencyLimiter(mRegion)->OnSuccess(curSystemTime, response.GetResponseTime());
+        GetProjectConcurrencyLimiter(mProject)->OnSuccess(curSystemTime, response.GetResponseTime());
+        GetLogstoreConcurrencyLimiter(mProject, mLogstore)->OnSuccess(curSystemTime, response.GetResponseTime());
         SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
         ADD_COUNTER(mSuccessCnt, 1);
         DealSenderQueueItemAfterSend(item, false);
@@ -967,51 +970,22 @@ void FlusherSLS::GenerateGoPlugin(const Json::Value& config, Json::Value& res) c
 }
 
 bool FlusherSLS::SerializeAndPush(PipelineEventGroup&& group) {
-    string serializedData, compressedData;
+    string compressedData;
+    size_t rawSize = 0;
     BatchedEvents g(std::move(group.MutableEvents()),
                     std::move(group.GetSizedTags()),
                     std::move(group.GetSourceBuffer()),
                     group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
                     std::move(group.GetExactlyOnceCheckpoint()));
     AddPackId(g);
-    string errorMsg;
-    if (!mGroupSerializer->DoSerialize(std::move(g), serializedData, errorMsg)) {
-        LOG_WARNING(mContext->GetLogger(),
-                    ("failed to serialize event group",
-                     errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-        mContext->GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
-                                       "failed to serialize event group: " + errorMsg
-                                           + "\taction: discard data\tplugin: " + sName
-                                           + "\tconfig: " + mContext->GetConfigName(),
-                                       mContext->GetRegion(),
-                                       mContext->GetProjectName(),
-                                       mContext->GetConfigName(),
-                                       mContext->GetLogstoreName());
+    if (!SerializeAndCompress(std::move(g), compressedData, rawSize)) {
         return false;
     }
-    if (mCompressor) {
-        if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
-            LOG_WARNING(mContext->GetLogger(),
-                        ("failed to compress event group",
-                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-            mContext->GetAlarm().SendAlarm(COMPRESS_FAIL_ALARM,
-                                           "failed to compress event group: " + errorMsg
-                                               + "\taction: discard data\tplugin: " + sName
-                                               + "\tconfig: " + mContext->GetConfigName(),
-                                           mContext->GetRegion(),
-                                           mContext->GetProjectName(),
-                                           mContext->GetConfigName(),
-                                           mContext->GetLogstoreName());
-            return false;
-        }
-    } else {
-        compressedData = serializedData;
-    }
     // must create a tmp, because eoo checkpoint is moved in second param
     auto fbKey = g.mExactlyOnceCheckpoint->fbKey;
     return PushToQueue(fbKey,
                        make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                       serializedData.size(),
+                                                       rawSize,
                                                        this,
                                                        fbKey,
                                                        mLogstore,
@@ -1036,44 +1010,14 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
             shardHashKey = GetShardHashKey(group);
         }
         AddPackId(group);
-        string errorMsg;
-        if (!mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
-            LOG_WARNING(mContext->GetLogger(),
-                        ("failed to serialize event group",
-                         errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-            mContext->GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
-                                           "failed to serialize event group: " + errorMsg
-                                               + "\taction: discard data\tplugin: " + sName
-                                               + "\tconfig: " + mContext->GetConfigName(),
-                                           mContext->GetRegion(),
-                                           mContext->GetProjectName(),
-                                           mContext->GetConfigName(),
-                                           mContext->GetLogstoreName());
+        size_t rawSize = 0;
+        if (!SerializeAndCompress(std::move(group), compressedData, rawSize)) {
             allSucceeded = false;
             continue;
         }
-        if (mCompressor) {
-            if (!mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
-                LOG_WARNING(mContext->GetLogger(),
-                            ("failed to compress event group",
-                             errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
-                mContext->GetAlarm().SendAlarm(COMPRESS_FAIL_ALARM,
-                                               "failed to compress event group: " + errorMsg
-                                                   + "\taction: discard data\tplugin: " + sName
-                                                   + "\tconfig: " + mContext->GetConfigName(),
-                                               mContext->GetRegion(),
-                                               mContext->GetProjectName(),
-                                               mContext->GetConfigName(),
-                                               mContext->GetLogstoreName());
-                allSucceeded = false;
-                continue;
-            }
-        } else {
-            compressedData = serializedData;
-        }
         if (enablePackageList) {
-            packageSize += serializedData.size();
-            compressedLogGroups.emplace_back(std::move(compressedData), serializedData.size());
+            packageSize += rawSize;
+            compressedLogGroups.emplace_back(std::move(compressedData), rawSize);
         } else {
             if (group.mExactlyOnceCheckpoint) {
                 // must create a tmp, because eoo checkpoint is moved in second param
@@ -1081,7 +1025,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                 allSucceeded
                     = PushToQueue(fbKey,
                                   make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                  serializedData.size(),
+                                                                  rawSize,
                                                                   this,
                                                                   fbKey,
                                                                   mLogstore,
@@ -1092,7 +1036,7 @@ bool FlusherSLS::SerializeAndPush(BatchedEventsList&& groupList) {
                     && allSucceeded;
             } else {
                 allSucceeded = Flusher::PushToQueue(make_unique<SLSSenderQueueItem>(std::move(compressedData),
-                                                                                    serializedData.size(),
+                                                                                    rawSize,
                                                                                     this,
                                                                                     mQueueKey,
                                                                                     mLogstore,
@@ -1121,6 +1065,56 @@ bool FlusherSLS::SerializeAndPush(vector<BatchedEventsList>&& groupLists) {
     return allSucceeded;
 }
 
+bool FlusherSLS::SerializeAndCompress(BatchedEvents&& group, string& compressedData, size_t& rawSize) {
+    string errorMsg;
+    bool compressFailed = false;
+    if (mCompressor && BOOL_FLAG(enable_sls_serialize_and_compress)) {
+        if (mGroupSerializer->DoSerializeAndCompress(
+                std::move(group), *mCompressor, compressedData, rawSize, errorMsg, compressFailed)) {
+            return true;
+        }
+    } else {
+        string serializedData;
+        if (mGroupSerializer->DoSerialize(std::move(group), serializedData, errorMsg)) {
+            rawSize = serializedData.size();
+            if (!mCompressor) {
+                compressedData = std::move(serializedData);
+                return true;
+            }
+            if (mCompressor->DoCompress(serializedData, compressedData, errorMsg)) {
+                return true;
+            }
+            compressFailed = true;
+        }
+    }
+    if (compressFailed) {
+        LOG_WARNING(mContext->GetLogger(),
+                    ("failed to compress event group",
+                     errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
+        mContext->GetAlarm().SendAlarm(COMPRESS_FAIL_ALARM,
+                                       "failed to compress event group: " + errorMsg
+                                           + "\taction: discard data\tplugin: " + sName
+                                           + "\tconfig: " + mContext->GetConfigName(),
+                                       mContext->GetRegion(),
+                                       mContext->GetProjectName(),
+                                       mContext->GetConfigName(),
+                                       mContext->GetLogstoreName());
+    } else {
+        LOG_WARNING(mContext->GetLogger(),
+                    ("failed to serialize event group",
+                     errorMsg)("action", "discard data")("plugin", sName)("config", mContext->GetConfigName()));
+        mContext->GetAlarm().SendAlarm(SERIALIZE_FAIL_ALARM,
+                                       "failed to serialize event group: " + errorMsg
+                                           + "\taction: discard data\tplugin: " + sName
+                                           + "\tconfig: " + mContext->GetConfigName(),
+                                       mContext->GetRegion(),
+                                       mContext->GetProjectName(),
+                                       mContext->GetConfigName(),
+                                       mContext->GetLogstoreName());
+    }
+    return false;
+}
+
 bool FlusherSLS::PushToQueue(QueueKey key, unique_ptr<SenderQueueItem>&& item, uint32_t retryTimes) {
     const string& str = QueueKeyManager::GetInstance()->GetName(key);
     for (size_t i = 0; i < retryTimes; ++i) {
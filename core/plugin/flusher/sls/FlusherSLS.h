@@ -120,6 +120,8 @@ private:
     bool SerializeAndPush(std::vector<BatchedEventsList>&& groupLists);
     bool SerializeAndPush(BatchedEventsList&& groupList);
     bool SerializeAndPush(PipelineEventGroup&& g); // for exactly once only
+    // discarded data is alarmed inside
+    bool SerializeAndCompress(BatchedEvents&& group, std::string& compressedData, size_t& rawSize);
     bool PushToQueue(QueueKey key, std::unique_ptr<SenderQueueItem>&& item, uint32_t retryTimes = 500);
     std::string GetShardHashKey(const BatchedEvents& g) const;
     void AddPackId(BatchedEvents& g) const;
@@ -147,7 +149,7 @@ private:
     std::string mSubpath;
 
     Batcher<SLSEventBatchStatus> mBatcher;
-    std::unique_ptr<EventGroupSerializer> mGroupSerializer;
+    std::unique_ptr<SLSEventGroupSerializer> mGroupSerializer;
     std::unique_ptr<Serializer<std::vector<CompressedLogGroup>>> mGroupListSerializer;
 #ifdef __ENTERPRISE__
     // This may not be cached. However, this provides a simple way to control the lifetime of a CandidateHostsInfo.
@@ -16,6 +16,7 @@
 
 #include "plugin/processor/ProcessorFilterNative.h"
 
+#include <algorithm>
 #include <vector>
 
 #include "common/ParamExtractor.h"
@@ -30,6 +31,12 @@ const std::string ProcessorFilterNative::sName = "processor_filter_regex_native"
 bool ProcessorFilterNative::Init(const Json::Value& config) {
     std::string errorMsg;
 
+    mBoostRegexMatchTimeMs = GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_BOOST_REGEX_MATCH_TIME_MS);
+    mRE2RegexMatchTimeMs = GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_RE2_REGEX_MATCH_TIME_MS);
+
+    // RegexEngine
+    GetRegexEngineParam(config, *mContext, sName, mRegexEngine);
+
     // for backward compatibility, ConditionExp prioritize over FilterKey and FilterRegex
     // ConditionExp
     const char* key = "ConditionExp";
@@ -45,7 +52,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         }
-        BaseFilterNodePtr root = ParseExpressionFromJSON(*itr);
+        BaseFilterNodePtr root = ParseExpressionFromJSON(*itr, mRegexEngine);
         if (!root) {
             PARAM_ERROR_RETURN(mContext->GetLogger(),
                                mContext->GetAlarm(),
@@ -56,6 +63,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         }
+        root->SetMatchTimeCounters(mBoostRegexMatchTimeMs, mRE2RegexMatchTimeMs);
         mConditionExp.swap(root);
         mFilterMode = Mode::EXPRESSION_MODE;
     }
@@ -83,7 +91,6 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!filterKeys.empty()) {
-            std::vector<boost::regex> regs;
             for (const auto& reg : filterRegs) {
                 if (!IsRegexValid(reg)) {
                     PARAM_ERROR_RETURN(mContext->GetLogger(),
@@ -95,11 +102,18 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetLogstoreName(),
                                        mContext->GetRegion());
                 }
-                regs.emplace_back(reg);
             }
-            mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = filterKeys;
-            mFilterRule->FilterRegs = regs;
+            mFilterRule = CreateFilterRule(filterKeys, filterRegs);
+            if (!mFilterRule) {
+                PARAM_ERROR_RETURN(mContext->GetLogger(),
+                                   mContext->GetAlarm(),
+                                   "value in list param FilterRegex is not a valid regex",
+                                   sName,
+                                   mContext->GetConfigName(),
+                                   mContext->GetProjectName(),
+                                   mContext->GetLogstoreName(),
+                                   mContext->GetRegion());
+            }
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -117,8 +131,7 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                mContext->GetLogstoreName(),
                                mContext->GetRegion());
         } else if (!mInclude.empty()) {
-            std::vector<std::string> keys;
-            std::vector<boost::regex> regs;
+            std::vector<std::string> keys, regs;
             for (auto& include : mInclude) {
                 if (!IsRegexValid(include.second)) {
                     PARAM_ERROR_RETURN(mContext->GetLogger(),
@@ -131,11 +144,19 @@ bool ProcessorFilterNative::Init(const Json::Value& config) {
                                        mContext->GetRegion());
                 }
                 keys.emplace_back(include.first);
-                regs.emplace_back(boost::regex(include.second));
+                regs.emplace_back(include.second);
+            }
+            mFilterRule = CreateFilterRule(keys, regs);
+            if (!mFilterRule) {
+                PARAM_ERROR_RETURN(mContext->GetLogger(),
+                                   mContext->GetAlarm(),
+                                   "value in map param Include is not a valid regex",
+                                   sName,
+                                   mContext->GetConfigName(),
+                                   mContext->GetProjectName(),
+                                   mContext->GetLogstoreName(),
+                                   mContext->GetRegion());
             }
-            mFilterRule = std::make_shared<LogFilterRule>();
-            mFilterRule->FilterKeys = keys;
-            mFilterRule->FilterRegs = regs;
             mFilterMode = Mode::RULE_MODE;
         }
     }
@@ -215,6 +236,32 @@ bool ProcessorFilterNative::ProcessEvent(PipelineEventPtr& e) {
     return res;
 }
 
+std::shared_ptr<ProcessorFilterNative::LogFilterRule>
+ProcessorFilterNative::CreateFilterRule(const std::vector<std::string>& keys, const std::vector<std::string>& regs) {
+    auto rule = std::make_shared<LogFilterRule>();
+    rule->FilterKeys = keys;
+    rule->FilterRegs = regs;
+
+    std::vector<std::pair<std::string, std::vector<std::string>>> groups;
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto it = std::find_if(groups.begin(), groups.end(), [&](const auto& group) { return group.first == keys[i]; });
+        if (it == groups.end()) {
+            groups.emplace_back(keys[i], std::vector<std::string>{regs[i]});
+        } else {
+            it->second.emplace_back(regs[i]);
+        }
+    }
+    rule->Matchers.resize(groups.size());
+    for (size_t i = 0; i < groups.size(); ++i) {
+        rule->Matchers[i].first = groups[i].first;
+        if (!rule->Matchers[i].second.Init(groups[i].second, mRegexEngine)) {
+            return nullptr;
+        }
+        rule->Matchers[i].second.SetMatchTimeCounters(mBoostRegexMatchTimeMs, mRE2RegexMatchTimeMs);
+    }
+    return rule;
+}
+
 bool ProcessorFilterNative::IsSupportedEvent(const PipelineEventPtr& e) const {
     return e.Is<LogEvent>();
 }
@@ -256,15 +303,13 @@ bool ProcessorFilterNative::FilterFilterRule(LogEvent& sourceEvent, const LogFil
 }
 
 bool ProcessorFilterNative::IsMatched(const LogEvent& contents, const LogFilterRule& rule) {
-    const std::vector<std::string>& keys = rule.FilterKeys;
-    const std::vector<boost::regex> regs = rule.FilterRegs;
     std::string exception;
-    for (uint32_t i = 0; i < keys.size(); ++i) {
-        const auto& content = contents.FindContent(keys[i]);
+    for (const auto& matcher : rule.Matchers) {
+        const auto& content = contents.FindContent(matcher.first);
         if (content == contents.end()) {
             return false;
         }
-        if (!BoostRegexMatch(content->second.data(), content->second.size(), regs[i], exception)) {
+        if (!matcher.second.MatchAll(content->second.data(), content->second.size(), exception)) {
             if (!exception.empty()) {
                 LOG_ERROR(GetContext().GetLogger(), ("regex_match in Filter fail", exception));
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -375,7 +420,7 @@ bool ProcessorFilterNative::noneUtf8(StringView& str, bool modify) {
     return false;
 }
 
-BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value) {
+BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value, RegexEngineType engine) {
     BaseFilterNodePtr node;
     if (!value.isObject()) {
         return node;
@@ -394,13 +439,13 @@ BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value) {
         // invalid json
         const Json::Value& operandsValue = value["operands"];
         if (filterOperator == NOT_OPERATOR && operandsValue.size() == 1) {
-            BaseFilterNodePtr childNode = ParseExpressionFromJSON(operandsValue[0]);
+            BaseFilterNodePtr childNode = ParseExpressionFromJSON(operandsValue[0], engine);
             if (childNode) {
                 node.reset(new UnaryFilterOperatorNode(childNode));
             }
         } else if ((filterOperator == AND_OPERATOR || filterOperator == OR_OPERATOR) && operandsValue.size() == 2) {
-            BaseFilterNodePtr leftNode = ParseExpressionFromJSON(operandsValue[0]);
-            BaseFilterNodePtr rightNode = ParseExpressionFromJSON(operandsValue[1]);
+            BaseFilterNodePtr leftNode = ParseExpressionFromJSON(operandsValue[0], engine);
+            BaseFilterNodePtr rightNode = ParseExpressionFromJSON(operandsValue[1], engine);
             if (leftNode && rightNode) {
                 node.reset(new BinaryFilterOperatorNode(filterOperator, leftNode, rightNode));
             }
@@ -415,7 +460,12 @@ BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value) {
             return node;
         }
         if (func == REGEX_FUNCTION) {
-            node.reset(new RegexFilterValueNode(key, exp));
+            RegexMatcher reg;
+            if (!reg.Init(exp, engine)) {
+                LOG_ERROR(sLogger, ("invalid regex", exp));
+                return node;
+            }
+            node.reset(new RegexFilterValueNode(key, reg));
         }
     }
     return node;
@@ -456,6 +506,16 @@ bool BinaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionP
     return false;
 }
 
+void BinaryFilterOperatorNode::SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs,
+                                                    const TimeCounterPtr& re2MatchTimeMs) {
+    if (left) {
+        left->SetMatchTimeCounters(boostMatchTimeMs, re2MatchTimeMs);
+    }
+    if (right) {
+        right->SetMatchTimeCounters(boostMatchTimeMs, re2MatchTimeMs);
+    }
+}
+
 bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipelineContext& mContext) {
     const auto& content = contents.FindContent(key);
     if (content == contents.end()) {
@@ -463,7 +523,7 @@ bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipel
     }
 
     std::string exception;
-    bool result = BoostRegexMatch(content->second.data(), content->second.size(), reg, exception);
+    bool result = reg.Match(content->second.data(), content->second.size(), exception);
     if (!result && !exception.empty() && AppConfig::GetInstance()->IsLogParseAlarmValid()) {
         LOG_ERROR(mContext.GetLogger(), ("regex_match in Filter fail", exception));
         if (mContext.GetAlarm().IsLowLevelAlarmValid()) {
@@ -478,6 +538,11 @@ bool RegexFilterValueNode::Match(const LogEvent& contents, const CollectionPipel
     return result;
 }
 
+void RegexFilterValueNode::SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs,
+                                                const TimeCounterPtr& re2MatchTimeMs) {
+    reg.SetMatchTimeCounters(boostMatchTimeMs, re2MatchTimeMs);
+}
+
 bool UnaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionPipelineContext& mContext) {
     if (BOOST_LIKELY(child.get() != NULL)) {
         return !child->Match(contents, mContext);
@@ -485,4 +550,11 @@ bool UnaryFilterOperatorNode::Match(const LogEvent& contents, const CollectionPi
     return false;
 }
 
+void UnaryFilterOperatorNode::SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs,
+                                                   const TimeCounterPtr& re2MatchTimeMs) {
+    if (child) {
+        child->SetMatchTimeCounters(boostMatchTimeMs, re2MatchTimeMs);
+    }
+}
+
 } // namespace logtail
@@ -16,11 +16,10 @@
 
 #pragma once
 
-#include "boost/regex.hpp"
-
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
+#include "plugin/processor/RegexEngine.h"
 
 namespace logtail {
 
@@ -38,6 +37,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext) { return true; }
+    virtual void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs) {}
 
 public:
     FilterNodeType GetNodeType() const { return nodeType; }
@@ -57,6 +57,7 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs);
 
 private:
     FilterOperator op;
@@ -67,17 +68,18 @@ private:
 // RegexFilterValueNode
 class RegexFilterValueNode : public BaseFilterNode {
 public:
-    RegexFilterValueNode(const std::string& key, const std::string& exp)
-        : BaseFilterNode(VALUE_NODE), key(key), reg(exp) {}
+    RegexFilterValueNode(const std::string& key, const RegexMatcher& reg)
+        : BaseFilterNode(VALUE_NODE), key(key), reg(reg) {}
 
     virtual ~RegexFilterValueNode() {}
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs);
 
 private:
     std::string key;
-    boost::regex reg;
+    RegexMatcher reg;
 };
 
 // UnaryFilterOperatorNode
@@ -89,12 +91,13 @@ public:
 
 public:
     virtual bool Match(const LogEvent& contents, const CollectionPipelineContext& mContext);
+    virtual void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs);
 
 private:
     BaseFilterNodePtr child;
 };
 
-BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value);
+BaseFilterNodePtr ParseExpressionFromJSON(const Json::Value& value, RegexEngineType engine = RegexEngineType::BOOST);
 bool GetOperatorType(const std::string& type, FilterOperator& op);
 bool GetNodeFuncType(const std::string& type, FilterNodeFunctionType& func);
 
@@ -105,12 +108,15 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportFusedProcessing() const override { return true; }
 
     // Log field whitelist. The relationship between multiple conditions is "and". Only when all conditions are met, the
     // log will be collected.
     std::unordered_map<std::string, std::string> mInclude;
     BaseFilterNodePtr mConditionExp = nullptr;
     bool mDiscardingNonUTF8 = false;
+    // Preferred regex engine, patterns not supported by RE2 are always matched by boost.
+    RegexEngineType mRegexEngine = RegexEngineType::BOOST;
 
 protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
@@ -120,10 +126,14 @@ private:
 
     struct LogFilterRule {
         std::vector<std::string> FilterKeys;
-        std::vector<boost::regex> FilterRegs;
+        std::vector<std::string> FilterRegs;
+        // regexes on the same key are grouped, so that all of them are checked in one pass over the content
+        std::vector<std::pair<std::string, RegexSetMatcher>> Matchers;
     };
 
     bool ProcessEvent(PipelineEventPtr& e);
+    std::shared_ptr<LogFilterRule> CreateFilterRule(const std::vector<std::string>& keys,
+                                                    const std::vector<std::string>& regs);
 
     // Filter logs through ConditionExp
     bool FilterExpressionRoot(LogEvent& sourceEvent, const BaseFilterNodePtr& node);
@@ -140,6 +150,9 @@ private:
 
     std::shared_ptr<LogFilterRule> mFilterRule;
 
+    TimeCounterPtr mBoostRegexMatchTimeMs;
+    TimeCounterPtr mRE2RegexMatchTimeMs;
+
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorFilterNativeUnittest;
 #endif
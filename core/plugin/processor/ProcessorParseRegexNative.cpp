@@ -59,7 +59,18 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
                            mContext->GetLogstoreName(),
                            mContext->GetRegion());
     }
-    mReg = boost::regex(mRegex);
+    // RegexEngine
+    GetRegexEngineParam(config, *mContext, sName, mRegexEngine);
+    if (!mReg.Init(mRegex, mRegexEngine)) {
+        PARAM_ERROR_RETURN(mContext->GetLogger(),
+                           mContext->GetAlarm(),
+                           "mandatory string param Regex is not a valid regex",
+                           sName,
+                           mContext->GetConfigName(),
+                           mContext->GetProjectName(),
+                           mContext->GetLogstoreName(),
+                           mContext->GetRegion());
+    }
     mIsWholeLineMode = mRegex == "(.*)";
 
     // Keys
@@ -96,6 +107,9 @@ bool ProcessorParseRegexNative::Init(const Json::Value& config) {
     mOutFailedEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_FAILED_EVENTS_TOTAL);
     mOutKeyNotFoundEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_KEY_NOT_FOUND_EVENTS_TOTAL);
     mOutSuccessfulEventsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_OUT_SUCCESSFUL_EVENTS_TOTAL);
+    mBoostRegexMatchTimeMs = GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_BOOST_REGEX_MATCH_TIME_MS);
+    mRE2RegexMatchTimeMs = GetMetricsRecordRef().CreateTimeCounter(METRIC_PLUGIN_RE2_REGEX_MATCH_TIME_MS);
+    mReg.SetMatchTimeCounters(mBoostRegexMatchTimeMs, mRE2RegexMatchTimeMs);
 
     return true;
 }
@@ -179,14 +193,14 @@ void ProcessorParseRegexNative::AddLog(const StringView& key,
 }
 
 bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
-                                                   const boost::regex& reg,
+                                                   const RegexMatcher& reg,
                                                    const std::vector<std::string>& keys,
                                                    const StringView& logPath) {
-    boost::match_results<const char*> what;
+    thread_local std::vector<StringView> what;
     std::string exception;
     StringView buffer = sourceEvent.GetContent(mSourceKey);
     bool parseSuccess = true;
-    if (!BoostRegexMatch(buffer.data(), buffer.size(), reg, exception, what, boost::match_default)) {
+    if (!reg.Match(buffer.data(), buffer.size(), what, exception)) {
         if (!exception.empty()) {
             if (AppConfig::GetInstance()->IsLogParseAlarmValid()) {
                 if (GetContext().GetAlarm().IsLowLevelAlarmValid()) {
@@ -242,7 +256,7 @@ bool ProcessorParseRegexNative::RegexLogLineParser(LogEvent& sourceEvent,
     }
 
     for (uint32_t i = 0; i < keys.size(); i++) {
-        AddLog(keys[i], StringView(what[i + 1].begin(), what[i + 1].length()), sourceEvent);
+        AddLog(keys[i], what[i + 1], sourceEvent);
     }
     return true;
 }
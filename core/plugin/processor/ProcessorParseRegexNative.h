@@ -18,11 +18,10 @@
 
 #include <vector>
 
-#include "boost/regex.hpp"
-
 #include "collection_pipeline/plugin/interface/Processor.h"
 #include "models/LogEvent.h"
 #include "plugin/processor/CommonParserOptions.h"
+#include "plugin/processor/RegexEngine.h"
 
 namespace logtail {
 
@@ -33,6 +32,7 @@ public:
     const std::string& Name() const override { return sName; }
     bool Init(const Json::Value& config) override;
     void Process(PipelineEventGroup& logGroup) override;
+    bool SupportFusedProcessing() const override { return true; }
 
     // Source field name.
     std::string mSourceKey;
@@ -40,6 +40,8 @@ public:
     std::string mRegex;
     // Extracted field list.
     std::vector<std::string> mKeys;
+    // Preferred regex engine, patterns not supported by RE2 are always matched by boost.
+    RegexEngineType mRegexEngine = RegexEngineType::BOOST;
     CommonParserOptions mCommonParserOptions;
 
 protected:
@@ -50,19 +52,21 @@ private:
     bool ProcessEvent(const StringView& logPath, PipelineEventPtr& e, const GroupMetadata& metadata);
     bool WholeLineModeParser(LogEvent& sourceEvent, const std::string& key);
     bool RegexLogLineParser(LogEvent& sourceEvent,
-                            const boost::regex& reg,
+                            const RegexMatcher& reg,
                             const std::vector<std::string>& keys,
                             const StringView& logPath);
     void AddLog(const StringView& key, const StringView& value, LogEvent& targetEvent, bool overwritten = true);
 
     bool mSourceKeyOverwritten = false;
     bool mIsWholeLineMode = false;
-    boost::regex mReg;
+    RegexMatcher mReg;
 
     CounterPtr mDiscardedEventsTotal;
     CounterPtr mOutFailedEventsTotal;
     CounterPtr mOutKeyNotFoundEventsTotal;
     CounterPtr mOutSuccessfulEventsTotal;
+    TimeCounterPtr mBoostRegexMatchTimeMs;
+    TimeCounterPtr mRE2RegexMatchTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorParseRegexNativeUnittest;
@@ -0,0 +1,207 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "plugin/processor/RegexEngine.h"
+
+#include <chrono>
+
+#include "common/ParamExtractor.h"
+#include "common/StringTools.h"
+
+using namespace std;
+
+namespace logtail {
+
+static const string sBoostEngineName = "boost";
+static const string sRE2EngineName = "re2";
+
+bool ParseRegexEngineType(const string& name, RegexEngineType& type) {
+    string lowerName = ToLowerCaseString(name);
+    if (lowerName == sBoostEngineName) {
+        type = RegexEngineType::BOOST;
+    } else if (lowerName == sRE2EngineName) {
+        type = RegexEngineType::RE2;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+const string& RegexEngineTypeToString(RegexEngineType type) {
+    return type == RegexEngineType::RE2 ? sRE2EngineName : sBoostEngineName;
+}
+
+void GetRegexEngineParam(const Json::Value& config,
+                         const CollectionPipelineContext& ctx,
+                         const string& pluginType,
+                         RegexEngineType& engine) {
+    string errorMsg, engineName;
+    engine = RegexEngineType::BOOST;
+    if (!GetOptionalStringParam(config, "RegexEngine", engineName, errorMsg)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              errorMsg,
+                              sBoostEngineName,
+                              pluginType,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    } else if (!engineName.empty() && !ParseRegexEngineType(engineName, engine)) {
+        PARAM_WARNING_DEFAULT(ctx.GetLogger(),
+                              ctx.GetAlarm(),
+                              "string param RegexEngine is not valid",
+                              sBoostEngineName,
+                              pluginType,
+                              ctx.GetConfigName(),
+                              ctx.GetProjectName(),
+                              ctx.GetLogstoreName(),
+                              ctx.GetRegion());
+    }
+}
+
+// Make RE2 behave as boost::regex with default perl syntax:
+// 1. patterns and inputs are treated as bytes;
+// 2. '.' matches newline;
+// 3. '^' and '$' match at the beginning and end of each line.
+static RE2::Options GetRE2Options() {
+    RE2::Options options;
+    options.set_encoding(RE2::Options::EncodingLatin1);
+    options.set_dot_nl(true);
+    options.set_log_errors(false);
+    return options;
+}
+
+static string ToRE2Pattern(const string& pattern) {
+    return "(?m)" + pattern;
+}
+
+bool RegexMatcher::Init(const string& pattern, RegexEngineType engine) {
+    mPattern = pattern;
+    mRE2.reset();
+    if (engine == RegexEngineType::RE2) {
+        auto re2 = make_shared<re2::RE2>(ToRE2Pattern(pattern), GetRE2Options());
+        if (re2->ok()) {
+            mRE2 = std::move(re2);
+            mEngineType = RegexEngineType::RE2;
+            return true;
+        }
+    }
+    if (!IsRegexValid(pattern)) {
+        return false;
+    }
+    mBoostReg = boost::regex(pattern);
+    mEngineType = RegexEngineType::BOOST;
+    return true;
+}
+
+void RegexMatcher::SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs) {
+    mMatchTimeMs = mEngineType == RegexEngineType::RE2 ? re2MatchTimeMs : boostMatchTimeMs;
+}
+
+bool RegexMatcher::Match(const char* data, size_t size, string& exception) const {
+    auto before = mMatchTimeMs ? chrono::system_clock::now() : chrono::system_clock::time_point();
+    bool res = false;
+    if (mRE2) {
+        res = mRE2->Match(re2::StringPiece(data, size), 0, size, RE2::ANCHOR_BOTH, nullptr, 0);
+    } else {
+        res = BoostRegexMatch(data, size, mBoostReg, exception);
+    }
+    ADD_COUNTER(mMatchTimeMs, chrono::system_clock::now() - before);
+    return res;
+}
+
+bool RegexMatcher::Match(const char* data, size_t size, vector<StringView>& groups, string& exception) const {
+    auto before = mMatchTimeMs ? chrono::system_clock::now() : chrono::system_clock::time_point();
+    bool res = false;
+    groups.clear();
+    if (mRE2) {
+        thread_local vector<re2::StringPiece> sSubmatches;
+        sSubmatches.resize(GetCaptureGroupCount() + 1);
+        res = mRE2->Match(
+            re2::StringPiece(data, size), 0, size, RE2::ANCHOR_BOTH, sSubmatches.data(), sSubmatches.size());
+        if (res) {
+            for (const auto& submatch : sSubmatches) {
+                groups.emplace_back(submatch.data(), submatch.size());
+            }
+        }
+    } else {
+        boost::match_results<const char*> what;
+        res = BoostRegexMatch(data, size, mBoostReg, exception, what, boost::match_default);
+        if (res) {
+            for (size_t i = 0; i < what.size(); ++i) {
+                groups.emplace_back(what[i].first, what[i].length());
+            }
+        }
+    }
+    ADD_COUNTER(mMatchTimeMs, chrono::system_clock::now() - before);
+    return res;
+}
+
+size_t RegexMatcher::GetCaptureGroupCount() const {
+    return mRE2 ? mRE2->NumberOfCapturingGroups() : mBoostReg.mark_count();
+}
+
+bool RegexSetMatcher::Init(const vector<string>& patterns, RegexEngineType engine) {
+    mMatchers.clear();
+    mRE2Set.reset();
+    mMatchers.resize(patterns.size());
+    bool allRE2 = true;
+    for (size_t i = 0; i < patterns.size(); ++i) {
+        if (!mMatchers[i].Init(patterns[i], engine)) {
+            return false;
+        }
+        allRE2 = allRE2 && mMatchers[i].GetEngineType() == RegexEngineType::RE2;
+    }
+    // a single regex is matched faster by itself
+    if (!allRE2 || patterns.size() <= 1) {
+        return true;
+    }
+    auto set = make_shared<re2::RE2::Set>(GetRE2Options(), RE2::ANCHOR_BOTH);
+    for (const auto& pattern : patterns) {
+        if (set->Add(ToRE2Pattern(pattern), nullptr) < 0) {
+            return true;
+        }
+    }
+    if (set->Compile()) {
+        mRE2Set = std::move(set);
+    }
+    return true;
+}
+
+void RegexSetMatcher::SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs,
+                                           const TimeCounterPtr& re2MatchTimeMs) {
+    for (auto& matcher : mMatchers) {
+        matcher.SetMatchTimeCounters(boostMatchTimeMs, re2MatchTimeMs);
+    }
+    mSetMatchTimeMs = re2MatchTimeMs;
+}
+
+bool RegexSetMatcher::MatchAll(const char* data, size_t size, string& exception) const {
+    if (mRE2Set) {
+        auto before = mSetMatchTimeMs ? chrono::system_clock::now() : chrono::system_clock::time_point();
+        thread_local vector<int> sMatched;
+        bool res = mRE2Set->Match(re2::StringPiece(data, size), &sMatched) && sMatched.size() == mMatchers.size();
+        ADD_COUNTER(mSetMatchTimeMs, chrono::system_clock::now() - before);
+        return res;
+    }
+    for (const auto& matcher : mMatchers) {
+        if (!matcher.Match(data, size, exception)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace logtail
@@ -0,0 +1,95 @@
+/*
+ * Copyright 2025 iLogtail Authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "boost/regex.hpp"
+#include "json/json.h"
+#include "re2/re2.h"
+#include "re2/set.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/StringView.h"
+#include "monitor/metric_models/MetricTypes.h"
+
+namespace logtail {
+
+enum class RegexEngineType { BOOST, RE2 };
+
+bool ParseRegexEngineType(const std::string& name, RegexEngineType& type);
+const std::string& RegexEngineTypeToString(RegexEngineType type);
+// Parse the optional param RegexEngine, boost is used if the param is not set or invalid.
+void GetRegexEngineParam(const Json::Value& config,
+                         const CollectionPipelineContext& ctx,
+                         const std::string& pluginType,
+                         RegexEngineType& engine);
+
+// RegexMatcher checks whether the whole input is matched by a regex, which is the semantics of boost::regex_match.
+// With RE2, matching is done by automata in time linear to the input size. Patterns that RE2 does not support (e.g.
+// backreferences and lookarounds) are matched by boost instead.
+class RegexMatcher {
+public:
+    // @return false if the pattern is not a valid regex for boost
+    bool Init(const std::string& pattern, RegexEngineType engine = RegexEngineType::BOOST);
+    void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs);
+
+    bool Match(const char* data, size_t size, std::string& exception) const;
+    // @param groups the whole match followed by all capture groups, the same as boost::match_results
+    bool Match(const char* data, size_t size, std::vector<StringView>& groups, std::string& exception) const;
+
+    size_t GetCaptureGroupCount() const;
+    RegexEngineType GetEngineType() const { return mEngineType; }
+    const std::string& GetPattern() const { return mPattern; }
+
+private:
+    std::string mPattern;
+    RegexEngineType mEngineType = RegexEngineType::BOOST;
+    boost::regex mBoostReg;
+    std::shared_ptr<re2::RE2> mRE2;
+    TimeCounterPtr mMatchTimeMs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RegexEngineUnittest;
+#endif
+};
+
+// RegexSetMatcher checks whether the whole input is matched by all of the given regexes. With RE2, all regexes are
+// compiled into one RE2::Set so that the input is scanned only once, no matter how many regexes there are.
+class RegexSetMatcher {
+public:
+    // @return false if any pattern is not a valid regex for boost
+    bool Init(const std::vector<std::string>& patterns, RegexEngineType engine = RegexEngineType::BOOST);
+    void SetMatchTimeCounters(const TimeCounterPtr& boostMatchTimeMs, const TimeCounterPtr& re2MatchTimeMs);
+
+    bool MatchAll(const char* data, size_t size, std::string& exception) const;
+
+    size_t Size() const { return mMatchers.size(); }
+
+private:
+    std::vector<RegexMatcher> mMatchers;
+    std::shared_ptr<re2::RE2::Set> mRE2Set;
+    TimeCounterPtr mSetMatchTimeMs;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class RegexEngineUnittest;
+#endif
+};
+
+} // namespace logtail
@@ -4,6 +4,7 @@
 
 #include "common/StringTools.h"
 #include "logger/Logger.h"
+#include "models/EventPool.h"
 #include "models/MetricEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
@@ -59,8 +60,9 @@ bool ProcessorPromParseMetricNative::ProcessEvent(PipelineEventPtr& e,
     auto& sourceEvent = e.Cast<RawEvent>();
     std::unique_ptr<MetricEvent> metricEvent = eGroup.CreateMetricEvent(true);
     if (parser.ParseLine(sourceEvent.GetContent(), *metricEvent)) {
-        metricEvent->SetTag(string(prometheus::NAME), metricEvent->GetName());
-        newEvents.emplace_back(std::move(metricEvent), true, nullptr);
+        // both the key and the name live longer than the event, no need to copy
+        metricEvent->SetTagNoCopy(StringView(prometheus::NAME), metricEvent->GetName());
+        newEvents.emplace_back(std::move(metricEvent), true, &gThreadedEventPool);
     }
     return true;
 }
@@ -27,10 +27,15 @@
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
 #include "models/SizedContainer.h"
+#include "monitor/metric_constants/MetricConstants.h"
 #include "prometheus/Constants.h"
 
 using namespace std;
 
+DEFINE_FLAG_INT32(prom_relabel_cache_size,
+                  "max number of series whose metric relabel results are cached for each config, 0 to disable",
+                  50000);
+
 DECLARE_FLAG_STRING(_pod_name_);
 
 namespace logtail {
@@ -47,6 +52,13 @@ bool ProcessorPromRelabelMetricNative::Init(const Json::Value& config) {
 
     mLoongCollectorScraper = STRING_FLAG(_pod_name_);
 
+    if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty() && INT32_FLAG(prom_relabel_cache_size) > 0) {
+        mRelabelCache = make_unique<RelabelCache>(INT32_FLAG(prom_relabel_cache_size),
+                                                  INT32_FLAG(prom_relabel_cache_size) / 10);
+    }
+    mRelabelCacheHitsTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PROM_RELABEL_CACHE_HITS_TOTAL);
+    mRelabelCacheMissesTotal = GetMetricsRecordRef().CreateCounter(METRIC_PLUGIN_PROM_RELABEL_CACHE_MISSES_TOTAL);
+
     return true;
 }
 
@@ -113,8 +125,7 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e, const G
         appendLabels(k, v, mScrapeConfigPtr->mHonorLabels);
     }
 
-    if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty()
-        && !mScrapeConfigPtr->mMetricRelabelConfigs.Process(sourceEvent)) {
+    if (!mScrapeConfigPtr->mMetricRelabelConfigs.Empty() && !ProcessMetricRelabel(sourceEvent)) {
         return false;
     }
 
@@ -142,6 +153,63 @@ bool ProcessorPromRelabelMetricNative::ProcessEvent(PipelineEventPtr& e, const G
     return true;
 }
 
+bool ProcessorPromRelabelMetricNative::ProcessMetricRelabel(MetricEvent& e) {
+    if (!mRelabelCache) {
+        return mScrapeConfigPtr->mMetricRelabelConfigs.Process(e);
+    }
+
+    // name and labels are length prefixed, so that different label sets never share the same key
+    thread_local string sKey;
+    sKey.clear();
+    auto appendToKey = [](StringView s) {
+        auto size = static_cast<uint32_t>(s.size());
+        sKey.append(reinterpret_cast<const char*>(&size), sizeof(size));
+        sKey.append(s.data(), s.size());
+    };
+    appendToKey(e.GetName());
+    for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+        appendToKey(it->first);
+        appendToKey(it->second);
+    }
+
+    shared_ptr<const RelabelResult> cached;
+    if (mRelabelCache->tryGet(sKey, cached)) {
+        ADD_COUNTER(mRelabelCacheHitsTotal, 1);
+        if (!cached->mKeep) {
+            return false;
+        }
+        // labels not changed by relabeling still refer to the original data, others are copied
+        auto& tags = e.mTags.mInner;
+        thread_local vector<pair<StringView, StringView>> sLabels;
+        sLabels.clear();
+        for (const auto& [k, v] : cached->mLabels) {
+            auto it = find_if(tags.begin(), tags.end(), [&k = k](const auto& item) { return item.first == k; });
+            if (it != tags.end() && it->second == v) {
+                sLabels.emplace_back(*it);
+            } else {
+                auto key = e.GetSourceBuffer()->CopyString(k);
+                auto value = e.GetSourceBuffer()->CopyString(v);
+                sLabels.emplace_back(StringView(key.data, key.size), StringView(value.data, value.size));
+            }
+        }
+        tags.swap(sLabels);
+        return true;
+    }
+
+    ADD_COUNTER(mRelabelCacheMissesTotal, 1);
+    bool keep = mScrapeConfigPtr->mMetricRelabelConfigs.Process(e);
+    auto result = make_shared<RelabelResult>();
+    result->mKeep = keep;
+    if (keep) {
+        result->mLabels.reserve(e.TagsSize());
+        for (auto it = e.TagsBegin(); it != e.TagsEnd(); ++it) {
+            result->mLabels.emplace_back(it->first.to_string(), it->second.to_string());
+        }
+    }
+    mRelabelCache->insert(sKey, std::move(result));
+    return keep;
+}
+
 void ProcessorPromRelabelMetricNative::UpdateAutoMetrics(const PipelineEventGroup& eGroup,
                                                          prom::AutoMetric& autoMetric) const {
     if (eGroup.HasMetadata(EventGroupMetaKey::PROMETHEUS_SCRAPE_DURATION)) {
@@ -16,9 +16,14 @@
 
 #pragma once
 
+#include <memory>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "collection_pipeline/plugin/interface/Processor.h"
+#include "common/LRUCache.h"
 #include "models/PipelineEventGroup.h"
 #include "models/PipelineEventPtr.h"
 #include "prometheus/schedulers/ScrapeConfig.h"
@@ -50,7 +55,15 @@ protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override;
 
 private:
+    // result of metric relabeling for a given label set
+    struct RelabelResult {
+        bool mKeep = false;
+        std::vector<std::pair<std::string, std::string>> mLabels;
+    };
+    using RelabelCache = lru11::Cache<std::string, std::shared_ptr<const RelabelResult>, std::mutex>;
+
     bool ProcessEvent(PipelineEventPtr& e, const GroupTags& targetTags);
+    bool ProcessMetricRelabel(MetricEvent& e);
 
     void AddAutoMetrics(PipelineEventGroup& eGroup, const prom::AutoMetric& autoMetric) const;
     void UpdateAutoMetrics(const PipelineEventGroup& eGroup, prom::AutoMetric& autoMetric) const;
@@ -63,6 +76,12 @@ private:
 
     std::unique_ptr<ScrapeConfig> mScrapeConfigPtr;
     std::string mLoongCollectorScraper;
+    // Relabeling is a pure function of the label set, and most series do not change between scrapes, so results are
+    // cached by the whole input label set. The cache is dropped with the processor whenever the config changes.
+    std::unique_ptr<RelabelCache> mRelabelCache;
+
+    CounterPtr mRelabelCacheHitsTotal;
+    CounterPtr mRelabelCacheMissesTotal;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorPromRelabelMetricNativeUnittest;
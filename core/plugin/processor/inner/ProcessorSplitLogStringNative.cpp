@@ -16,7 +16,9 @@
 
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 
+#include "common/CharFinder.h"
 #include "common/ParamExtractor.h"
+#include "models/EventPool.h"
 #include "models/LogEvent.h"
 
 namespace logtail {
@@ -130,14 +132,23 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
     StringView sourceVal = sourceEvent.GetContent(mSourceKey);
     StringBuffer sourceKey = logGroup.GetSourceBuffer()->CopyString(mSourceKey);
 
+    // locate all line ends at once, the end of the source is the end of the last line
+    static thread_local std::vector<size_t> sLineEnds;
+    sLineEnds.clear();
+    FindAllChars(sourceVal.data(), sourceVal.size(), mSplitChar, sLineEnds);
+    sLineEnds.push_back(sourceVal.size());
+
     size_t begin = 0;
-    while (begin < sourceVal.size()) {
-        StringView content = GetNextLine(sourceVal, begin);
+    for (size_t end : sLineEnds) {
+        if (begin >= sourceVal.size()) {
+            break;
+        }
+        StringView content(sourceVal.data() + begin, end - begin);
         if (mEnableRawContent) {
             std::unique_ptr<RawEvent> targetEvent = logGroup.CreateRawEvent(true);
             targetEvent->SetContentNoCopy(content);
             targetEvent->SetTimestamp(sourceEvent.GetTimestamp(), sourceEvent.GetTimestampNanosecond());
-            newEvents.emplace_back(std::move(targetEvent), true, nullptr);
+            newEvents.emplace_back(std::move(targetEvent), true, &gThreadedEventPool);
         } else {
             std::unique_ptr<LogEvent> targetEvent = logGroup.CreateLogEvent(true);
             targetEvent->SetContentNoCopy(StringView(sourceKey.data, sourceKey.size), content);
@@ -154,23 +165,10 @@ void ProcessorSplitLogStringNative::ProcessEvent(PipelineEventGroup& logGroup,
                 targetEvent->SetContentNoCopy(logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY),
                                               StringView(offsetStr.data, offsetStr.size));
             }
-            newEvents.emplace_back(std::move(targetEvent), true, nullptr);
+            newEvents.emplace_back(std::move(targetEvent), true, &gThreadedEventPool);
         }
         begin += content.size() + 1;
     }
 }
 
-StringView ProcessorSplitLogStringNative::GetNextLine(StringView log, size_t begin) {
-    if (begin >= log.size()) {
-        return StringView();
-    }
-
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == mSplitChar) {
-            return StringView(log.data() + begin, end - begin);
-        }
-    }
-    return StringView(log.data() + begin, log.size() - begin);
-}
-
 } // namespace logtail
@@ -42,7 +42,6 @@ protected:
 
 private:
     void ProcessEvent(PipelineEventGroup& logGroup, PipelineEventPtr&& e, EventsContainer& newEvents);
-    StringView GetNextLine(StringView log, size_t begin);
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class ProcessorRegexStringNativeUnittest;
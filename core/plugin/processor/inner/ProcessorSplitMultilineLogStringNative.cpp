@@ -16,16 +16,19 @@
 
 #include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
 
+#include <cstring>
 #include <string>
 
 #include "boost/regex.hpp"
 
 #include "app_config/AppConfig.h"
 #include "collection_pipeline/plugin/instance/ProcessorInstance.h"
+#include "common/CharFinder.h"
 #include "common/ParamExtractor.h"
 #include "constants/Constants.h"
 #include "constants/TagConstants.h"
 #include "logger/Logger.h"
+#include "models/EventPool.h"
 #include "models/LogEvent.h"
 #include "models/PipelineEventGroup.h"
 #include "monitor/metric_constants/MetricConstants.h"
@@ -68,6 +71,9 @@ bool ProcessorSplitMultilineLogStringNative::Init(const Json::Value& config) {
                               mContext->GetRegion());
     }
 
+    mStartPatternPrefix = GetRegexLiteralPrefix(mMultiline.mStartPattern);
+    mContinuePatternPrefix = GetRegexLiteralPrefix(mMultiline.mContinuePattern);
+    mEndPatternPrefix = GetRegexLiteralPrefix(mMultiline.mEndPattern);
     for (int i = 0; i < AppConfig::GetInstance()->GetProcessThreadCount(); ++i) {
         if (!mMultiline.mStartPattern.empty()) {
             mStartPatternReg.emplace_back(mMultiline.mStartPattern);
@@ -169,24 +175,27 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         multiStartIndex = sourceVal.data();
     }
 
+    // locate all line ends at once, the end of the source is the end of the last line
+    static thread_local std::vector<size_t> sLineEnds;
+    sLineEnds.clear();
+    FindAllChars(sourceVal.data(), sourceVal.size(), '\n', sLineEnds);
+    sLineEnds.push_back(sourceVal.size());
+
     size_t begin = 0;
-    while (begin < sourceVal.size()) {
-        StringView content = GetNextLine(sourceVal, begin);
+    for (size_t end : sLineEnds) {
+        if (begin >= sourceVal.size()) {
+            break;
+        }
+        StringView content(sourceVal.data() + begin, end - begin);
         bool isLastLog = begin + content.size() == sourceVal.size();
         ++(*inputLines);
         if (!isPartialLog) {
             // it is impossible to enter this state if only end pattern is given
-            boost::regex regex;
-            if (HasStartPattern()) {
-                regex = GetStartPatternReg();
-            } else {
-                regex = GetContinuePatternReg();
-            }
-            if (BoostRegexSearch(content.data(), content.size(), regex, exception)) {
+            if (HasStartPattern() ? MatchStartPattern(content, exception) : MatchContinuePattern(content, exception)) {
                 multiStartIndex = content.data();
                 isPartialLog = true;
             } else if (HasEndPattern() && !HasStartPattern() && HasContinuePattern()
-                       && BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                       && MatchEndPattern(content, exception)) {
                 // case: continue + end
                 CreateNewEvent(content, isLastLog, sourceKey, sourceEvent, logGroup, newEvents);
                 multiStartIndex = content.data() + content.size() + 1;
@@ -198,7 +207,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
         } else {
             // case: start + continue or continue + end
             if (HasContinuePattern()
-                && BoostRegexSearch(content.data(), content.size(), GetContinuePatternReg(), exception)) {
+                && MatchContinuePattern(content, exception)) {
                 begin += content.size() + 1;
                 continue;
             }
@@ -207,7 +216,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                 if (HasContinuePattern()) {
                     // current line is not matched against the continue pattern, so the end pattern will decide
                     // if the current log is a match or not
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (MatchEndPattern(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -229,7 +238,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                     isPartialLog = false;
                 } else {
                     // case: start + end or end
-                    if (BoostRegexSearch(content.data(), content.size(), GetEndPatternReg(), exception)) {
+                    if (MatchEndPattern(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() + content.size() - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -250,7 +259,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
             } else {
                 if (!HasContinuePattern()) {
                     // case: start
-                    if (BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (MatchStartPattern(content, exception)) {
                         CreateNewEvent(StringView(multiStartIndex, content.data() - 1 - multiStartIndex),
                                        isLastLog,
                                        sourceKey,
@@ -270,7 +279,7 @@ void ProcessorSplitMultilineLogStringNative::ProcessEvent(PipelineEventGroup& lo
                                    logGroup,
                                    newEvents);
                     ADD_COUNTER(mMatchedEventsTotal, 1);
-                    if (!BoostRegexSearch(content.data(), content.size(), GetStartPatternReg(), exception)) {
+                    if (!MatchStartPattern(content, exception)) {
                         // when no end pattern is given, the only chance to enter unmatched state is when both
                         // start and continue pattern are given, and the current line is not matched against the
                         // start pattern
@@ -319,7 +328,7 @@ void ProcessorSplitMultilineLogStringNative::CreateNewEvent(const StringView& co
         std::unique_ptr<RawEvent> targetEvent = logGroup.CreateRawEvent(true);
         targetEvent->SetContentNoCopy(content);
         targetEvent->SetTimestamp(sourceEvent.GetTimestamp(), sourceEvent.GetTimestampNanosecond());
-        newEvents.emplace_back(std::move(targetEvent), true, nullptr);
+        newEvents.emplace_back(std::move(targetEvent), true, &gThreadedEventPool);
     } else {
         StringView sourceVal = sourceEvent.GetContent(mSourceKey);
         std::unique_ptr<LogEvent> targetEvent = logGroup.CreateLogEvent(true);
@@ -336,7 +345,7 @@ void ProcessorSplitMultilineLogStringNative::CreateNewEvent(const StringView& co
             targetEvent->SetContentNoCopy(logGroup.GetMetadata(EventGroupMetaKey::LOG_FILE_OFFSET_KEY),
                                           StringView(offsetStr.data, offsetStr.size));
         }
-        newEvents.emplace_back(std::move(targetEvent), true, nullptr);
+        newEvents.emplace_back(std::move(targetEvent), true, &gThreadedEventPool);
     }
 }
 
@@ -385,14 +394,25 @@ StringView ProcessorSplitMultilineLogStringNative::GetNextLine(StringView log, s
         return StringView();
     }
 
-    for (size_t end = begin; end < log.size(); ++end) {
-        if (log[end] == '\n') {
-            return StringView(log.data() + begin, end - begin);
-        }
+    const char* end = static_cast<const char*>(memchr(log.data() + begin, '\n', log.size() - begin));
+    if (end != nullptr) {
+        return StringView(log.data() + begin, end - log.data() - begin);
     }
     return StringView(log.data() + begin, log.size() - begin);
 }
 
+bool ProcessorSplitMultilineLogStringNative::MatchPattern(StringView line,
+                                                          const std::string& prefix,
+                                                          const boost::regex& reg,
+                                                          std::string& exception) {
+    // the pattern is matched from the beginning of the line, so a line not starting with the literal prefix of the
+    // pattern can never match
+    if (line.size() < prefix.size() || memcmp(line.data(), prefix.data(), prefix.size()) != 0) {
+        return false;
+    }
+    return BoostRegexSearch(line.data(), line.size(), reg, exception);
+}
+
 const boost::regex& ProcessorSplitMultilineLogStringNative::GetStartPatternReg() const {
     return mStartPatternReg[ProcessorRunner::GetThreadNo()];
 }
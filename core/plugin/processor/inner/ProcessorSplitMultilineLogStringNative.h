@@ -71,12 +71,27 @@ private:
     const boost::regex& GetStartPatternReg() const;
     const boost::regex& GetContinuePatternReg() const;
     const boost::regex& GetEndPatternReg() const;
+    bool MatchStartPattern(StringView line, std::string& exception) const {
+        return MatchPattern(line, mStartPatternPrefix, GetStartPatternReg(), exception);
+    }
+    bool MatchContinuePattern(StringView line, std::string& exception) const {
+        return MatchPattern(line, mContinuePatternPrefix, GetContinuePatternReg(), exception);
+    }
+    bool MatchEndPattern(StringView line, std::string& exception) const {
+        return MatchPattern(line, mEndPatternPrefix, GetEndPatternReg(), exception);
+    }
+    static bool
+    MatchPattern(StringView line, const std::string& prefix, const boost::regex& reg, std::string& exception);
 
     // boost::regex object shared by multi-thread leads to performance degradation. Therefore, each thread should be
     // allocated a different copy.
     std::vector<boost::regex> mStartPatternReg;
     std::vector<boost::regex> mContinuePatternReg;
     std::vector<boost::regex> mEndPatternReg;
+    // literal prefix of each pattern, used to skip lines which cannot match before running the regex
+    std::string mStartPatternPrefix;
+    std::string mContinuePatternPrefix;
+    std::string mEndPatternPrefix;
 
     CounterPtr mMatchedEventsTotal;
     CounterPtr mMatchedLinesTotal;
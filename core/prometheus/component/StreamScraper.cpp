@@ -1,6 +1,7 @@
 #include "prometheus/component/StreamScraper.h"
 
 #include <cstddef>
+#include <cstring>
 
 #include <memory>
 #include <string>
@@ -54,22 +55,29 @@ size_t StreamScraper::MetricWriteCallback(char* buffer, size_t size, size_t nmem
 
     auto* body = static_cast<StreamScraper*>(data);
 
-    size_t begin = 0;
-    for (size_t end = begin; end < sizes; ++end) {
-        if (buffer[end] == '\n') {
-            if (begin == 0 && !body->mCache.empty()) {
-                body->mCache.append(buffer, end);
-                body->AddEvent(body->mCache.data(), body->mCache.size());
-                body->mCache.clear();
-            } else if (begin != end) {
-                body->AddEvent(buffer + begin, end - begin);
-            }
-            begin = end + 1;
+    const char* begin = buffer;
+    const char* end = buffer + sizes;
+    const auto* firstLineEnd = static_cast<const char*>(memchr(begin, '\n', sizes));
+    if (firstLineEnd != nullptr) {
+        // complete the line split across the previous chunk and this one
+        if (!body->mCache.empty()) {
+            body->mCache.append(begin, firstLineEnd - begin);
+            body->AddEvent(body->mCache.data(), body->mCache.size());
+            body->mCache.clear();
+            begin = firstLineEnd + 1;
+        }
+        const char* lastLineEnd = end - 1;
+        while (*lastLineEnd != '\n') {
+            --lastLineEnd;
         }
+        if (begin < lastLineEnd) {
+            body->AddEvents(begin, lastLineEnd);
+        }
+        begin = lastLineEnd + 1;
     }
 
-    if (begin < sizes) {
-        body->mCache.append(buffer + begin, sizes - begin);
+    if (begin < end) {
+        body->mCache.append(begin, end - begin);
         // limit the last line cache size to prom_max_sample_length bytes
         if (body->mCache.size() > mMaxSampleLength) {
             LOG_WARNING(sLogger, ("stream scraper", "cache is too large, drop it."));
@@ -89,9 +97,52 @@ size_t StreamScraper::MetricWriteCallback(char* buffer, size_t size, size_t nmem
 
 void StreamScraper::AddEvent(const char* line, size_t len) {
     if (IsValidMetric(StringView(line, len))) {
-        auto* e = mEventGroup.AddRawEvent(true, mEventPool);
         auto sb = mEventGroup.GetSourceBuffer()->CopyString(line, len);
-        e->SetContentNoCopy(sb);
+        AddEvent(StringView(sb.data, sb.size));
+    }
+}
+
+void StreamScraper::AddEvents(const char* begin, const char* end) {
+    // each run of valid lines is copied into the source buffer at once, so that events are views without per line copy,
+    // while comments and empty lines are not copied
+    auto addRun = [this](const char* runBegin, const char* runEnd) {
+        auto sb = mEventGroup.GetSourceBuffer()->CopyString(runBegin, runEnd - runBegin);
+        const char* pos = sb.data;
+        const char* posEnd = sb.data + sb.size;
+        while (pos < posEnd) {
+            const auto* lineEnd = static_cast<const char*>(memchr(pos, '\n', posEnd - pos));
+            if (lineEnd == nullptr) {
+                lineEnd = posEnd;
+            }
+            AddEvent(StringView(pos, lineEnd - pos));
+            pos = lineEnd + 1;
+        }
+    };
+    const char* runBegin = nullptr;
+    const char* pos = begin;
+    while (pos <= end) {
+        const auto* lineEnd = static_cast<const char*>(memchr(pos, '\n', end - pos));
+        if (lineEnd == nullptr) {
+            lineEnd = end;
+        }
+        bool valid = IsValidMetric(StringView(pos, lineEnd - pos));
+        if (valid && runBegin == nullptr) {
+            runBegin = pos;
+        } else if (!valid && runBegin != nullptr) {
+            addRun(runBegin, pos - 1);
+            runBegin = nullptr;
+        }
+        pos = lineEnd + 1;
+    }
+    if (runBegin != nullptr) {
+        addRun(runBegin, end);
+    }
+}
+
+void StreamScraper::AddEvent(StringView line) {
+    if (IsValidMetric(line)) {
+        auto* e = mEventGroup.AddRawEvent(true, mEventPool);
+        e->SetContentNoCopy(line);
         mScrapeSamplesScraped++;
     }
 }
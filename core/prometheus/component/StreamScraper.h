@@ -34,7 +34,12 @@ public:
     uint64_t mStreamIndex = 0;
 
 private:
+    // copy the line into the source buffer
     void AddEvent(const char* line, size_t len);
+    // the line must be already in the source buffer
+    void AddEvent(StringView line);
+    // copy the valid lines in [begin, end), which are separated by '\n', into the source buffer
+    void AddEvents(const char* begin, const char* end);
     void PushEventGroup(PipelineEventGroup&&) const;
     void SetTargetLabels(PipelineEventGroup& eGroup) const;
     std::string GetId();
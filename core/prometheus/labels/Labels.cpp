@@ -72,7 +72,10 @@ std::string Labels::Get(const string& name) {
 
 void Labels::Reset(MetricEvent* metricEvent) {
     mMetricEventPtr = metricEvent;
-    Set(prometheus::NAME, metricEvent->GetName().to_string());
+    // __name__ is usually set by the parser already
+    if (metricEvent->GetTag(prometheus::NAME) != metricEvent->GetName()) {
+        Set(prometheus::NAME, metricEvent->GetName().to_string());
+    }
 }
 
 void Labels::Set(const string& k, const string& v) {
@@ -32,11 +32,35 @@ using namespace std;
 namespace logtail {
 
 bool IsValidNumberChar(char c) {
-    static const unordered_set<char> sValidChars
-        = {'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '.', '-', '+', 'e', 'E', 'I',
-           'N', 'F', 'T', 'Y', 'i', 'n', 'f', 't', 'y', 'X', 'x', 'N', 'n', 'A', 'a'};
-    return sValidChars.count(c);
-};
+    // called for every char of values and timestamps, so avoid hash lookups
+    if (c >= '0' && c <= '9') {
+        return true;
+    }
+    switch (c) {
+        case '.':
+        case '-':
+        case '+':
+        case 'e':
+        case 'E':
+        case 'I':
+        case 'i':
+        case 'N':
+        case 'n':
+        case 'F':
+        case 'f':
+        case 'T':
+        case 't':
+        case 'Y':
+        case 'y':
+        case 'X':
+        case 'x':
+        case 'A':
+        case 'a':
+            return true;
+        default:
+            return false;
+    }
+}
 
 TextParser::TextParser(bool honorTimestamps) : mHonorTimestamps(honorTimestamps) {
 }
@@ -102,7 +102,32 @@ void LogGroupSerializer::Prepare(size_t size) {
     mRes.reserve(size);
 }
 
+void LogGroupSerializer::PrepareChunks(size_t chunkSize, ChunkHandler&& handler) {
+    mChunkHandler = std::move(handler);
+    mChunkSize = chunkSize;
+    mChunkFailed = false;
+    mRes.clear();
+    // a chunk is handed over only at log boundaries, so leave some room for the log crossing the boundary
+    mRes.reserve(chunkSize * 2);
+}
+
+bool LogGroupSerializer::FinishChunks() {
+    HandleChunk();
+    mChunkHandler = nullptr;
+    return !mChunkFailed;
+}
+
+void LogGroupSerializer::HandleChunk() {
+    if (!mChunkFailed && !mRes.empty() && !mChunkHandler(StringView(mRes.data(), mRes.size()))) {
+        mChunkFailed = true;
+    }
+    mRes.clear();
+}
+
 void LogGroupSerializer::StartToAddLog(size_t size) {
+    if (mChunkHandler && mRes.size() >= mChunkSize) {
+        HandleChunk();
+    }
     // field = 1, wire_type = 2
     mRes.push_back(0x0A);
     uint32_pack(size, mRes);
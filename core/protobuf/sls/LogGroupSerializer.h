@@ -18,6 +18,7 @@
 
 #include <cstdint>
 
+#include <functional>
 #include <string>
 
 #include "common/StringView.h"
@@ -36,7 +37,14 @@ extern const std::string METRIC_LABELS_KEY_VALUE_SEPARATOR;
 // see for detail: https://protobuf.dev/programming-guides/encoding/
 class LogGroupSerializer {
 public:
+    using ChunkHandler = std::function<bool(StringView)>;
+
     void Prepare(size_t size);
+    // Instead of keeping the whole log group in the result, serialized data is handed over to the handler each time
+    // about chunkSize bytes are accumulated. FinishChunks must be called after all fields are added.
+    void PrepareChunks(size_t chunkSize, ChunkHandler&& handler);
+    // @return false if any call to the handler fails
+    bool FinishChunks();
     void StartToAddLog(size_t size);
     void AddLogTime(uint32_t logTime);
     void AddLogContent(StringView key, StringView value);
@@ -52,8 +60,12 @@ public:
 
 private:
     void AddString(StringView value);
+    void HandleChunk();
 
     std::string mRes;
+    ChunkHandler mChunkHandler;
+    size_t mChunkSize = 0;
+    bool mChunkFailed = false;
 };
 
 size_t GetLogContentSize(size_t keySZ, size_t valueSZ);
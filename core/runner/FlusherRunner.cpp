@@ -29,6 +29,9 @@
 #include "runner/sink/http/HttpSink.h"
 
 DEFINE_FLAG_INT32(flusher_runner_exit_timeout_sec, "", 60);
+DEFINE_FLAG_INT32(flusher_runner_dispatch_thread_count,
+                  "number of threads dispatching items to http sink, 1 means dispatching in flusher runner thread",
+                  1);
 
 DECLARE_FLAG_INT32(discard_send_fail_interval);
 
@@ -52,7 +55,20 @@ bool FlusherRunner::Init() {
     mLastRunTime = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
     mInItemRawDataSizeBytes = mMetricsRecordRef.CreateCounter(METRIC_RUNNER_FLUSHER_IN_RAW_SIZE_BYTES);
     mWaitingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_FLUSHER_WAITING_ITEMS_TOTAL);
+    mSendBlockedTimeMs = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_FLUSHER_SEND_BLOCKED_TIME_MS);
 
+    mDispatchThreadCnt = static_cast<uint32_t>(max(1, INT32_FLAG(flusher_runner_dispatch_thread_count)));
+    if (mDispatchThreadCnt > 1) {
+        mIsDispatchStopped = false;
+        mDispatchQueues.clear();
+        mDispatchThreadRes.clear();
+        for (uint32_t threadNo = 0; threadNo < mDispatchThreadCnt; ++threadNo) {
+            mDispatchQueues.emplace_back(make_unique<SafeQueue<DispatchItem>>());
+        }
+        for (uint32_t threadNo = 0; threadNo < mDispatchThreadCnt; ++threadNo) {
+            mDispatchThreadRes.emplace_back(async(launch::async, &FlusherRunner::RunDispatchThread, this, threadNo));
+        }
+    }
     mThreadRes = async(launch::async, &FlusherRunner::Run, this);
     mLastCheckSendClientTime = time(nullptr);
     mIsFlush = false;
@@ -93,6 +109,7 @@ void FlusherRunner::UpdateSendFlowControl() {
 void FlusherRunner::Stop() {
     mIsFlush = true;
     SenderQueueManager::GetInstance()->Trigger();
+    mHttpSendingCntCV.notify_all();
     if (!mThreadRes.valid()) {
         return;
     }
@@ -102,18 +119,40 @@ void FlusherRunner::Stop() {
     } else {
         LOG_WARNING(sLogger, ("flusher runner", "forced to stopped"));
     }
+
+    // all items have been sent if the runner thread stopped successfully, so the dispatch threads are idle now
+    mIsDispatchStopped = true;
+    for (auto& res : mDispatchThreadRes) {
+        if (res.valid() && res.wait_for(chrono::seconds(1)) != future_status::ready) {
+            LOG_WARNING(sLogger, ("flusher runner dispatch thread", "forced to stopped"));
+        }
+    }
 }
 
 void FlusherRunner::DecreaseHttpSendingCnt() {
-    --mHttpSendingCnt;
+    {
+        // the waiter may be between checking the count and waiting, lock to avoid missing the notification
+        lock_guard<mutex> lock(mHttpSendingCntMux);
+        --mHttpSendingCnt;
+    }
+    mHttpSendingCntCV.notify_one();
     SenderQueueManager::GetInstance()->Trigger();
 }
 
 void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
-    // TODO: use semaphore instead
-    while (withLimit && !Application::GetInstance()->IsExiting()
-           && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
-        this_thread::sleep_for(chrono::milliseconds(10));
+    {
+        unique_lock<mutex> lock(mHttpSendingCntMux);
+        if (withLimit && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
+            auto before = chrono::steady_clock::now();
+            while (!Application::GetInstance()->IsExiting()
+                   && GetSendingBufferCount() >= AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()) {
+                // exiting is not notified, so wake up periodically to check it
+                mHttpSendingCntCV.wait_for(lock, chrono::milliseconds(100));
+            }
+            ADD_COUNTER(mSendBlockedTimeMs, chrono::steady_clock::now() - before);
+        }
+        // the slot is taken before the request is built, so that dispatch threads cannot exceed the limit together
+        ++mHttpSendingCnt;
     }
 
     unique_ptr<HttpSinkRequest> req;
@@ -135,6 +174,7 @@ void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
             SenderQueueManager::GetInstance()->DecreaseConcurrencyLimiterInSendingCnt(item->mQueueKey);
             SenderQueueManager::GetInstance()->RemoveItem(item->mQueueKey, item);
         }
+        DecreaseHttpSendingCnt();
         return;
     }
 
@@ -142,9 +182,8 @@ void FlusherRunner::PushToHttpSink(SenderQueueItem* item, bool withLimit) {
     LOG_TRACE(sLogger,
               ("send item to http sink, item address", item)("config-flusher-dst",
                                                              QueueKeyManager::GetInstance()->GetName(item->mQueueKey))(
-                  "sending cnt", ToString(mHttpSendingCnt.load() + 1)));
+                  "sending cnt", ToString(mHttpSendingCnt.load())));
     HttpSink::GetInstance()->AddRequest(std::move(req));
-    ++mHttpSendingCnt;
 }
 
 void FlusherRunner::Run() {
@@ -157,7 +196,10 @@ void FlusherRunner::Run() {
         int32_t limit = Application::GetInstance()->IsExiting()
             ? -1
             : AppConfig::GetInstance()->GetSendRequestGlobalConcurrency();
-        SenderQueueManager::GetInstance()->GetAvailableItems(items, limit);
+        // items waiting in dispatch threads cannot be sent before the in-flight requests finish, so stop fetching more
+        if (limit == -1 || mDispatchingCnt.load() < limit) {
+            SenderQueueManager::GetInstance()->GetAvailableItems(items, limit);
+        }
         if (items.empty()) {
             SenderQueueManager::GetInstance()->Wait(1000);
         } else {
@@ -184,10 +226,15 @@ void FlusherRunner::Run() {
                 RateLimiter::FlowControl((*itr)->mRawSize, mSendLastTime, mSendLastByte, true);
             }
 
+            // items of other sinks are handled at once, so that they are never blocked by http sink
+            if (mDispatchThreadCnt > 1 && (*itr)->mFlusher->GetSinkType() == SinkType::HTTP) {
+                ++mDispatchingCnt;
+                mDispatchQueues[static_cast<uint64_t>((*itr)->mQueueKey) % mDispatchThreadCnt]->Push(
+                    DispatchItem{*itr, curTime});
+                continue;
+            }
             Dispatch(*itr);
-            SUB_GAUGE(mWaitingItemsTotal, 1);
-            ADD_COUNTER(mOutItemsTotal, 1);
-            ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - curTime);
+            OnItemDispatched(curTime);
         }
 
         if (mIsFlush && SenderQueueManager::GetInstance()->IsAllQueueEmpty()) {
@@ -196,6 +243,29 @@ void FlusherRunner::Run() {
     }
 }
 
+void FlusherRunner::RunDispatchThread(uint32_t threadNo) {
+    LOG_INFO(sLogger, ("flusher runner dispatch thread", "started")("thread no", threadNo));
+    auto& queue = *mDispatchQueues[threadNo];
+    while (!mIsDispatchStopped) {
+        DispatchItem item;
+        if (!queue.WaitAndPop(item, 100)) {
+            continue;
+        }
+        Dispatch(item.mItem);
+        OnItemDispatched(item.mFetchTime);
+        --mDispatchingCnt;
+        // the runner thread may be waiting for dispatch threads to fetch more items
+        SenderQueueManager::GetInstance()->Trigger();
+    }
+    LOG_INFO(sLogger, ("flusher runner dispatch thread", "stopped")("thread no", threadNo));
+}
+
+void FlusherRunner::OnItemDispatched(const chrono::system_clock::time_point& fetchTime) {
+    SUB_GAUGE(mWaitingItemsTotal, 1);
+    ADD_COUNTER(mOutItemsTotal, 1);
+    ADD_COUNTER(mTotalDelayMs, chrono::system_clock::now() - fetchTime);
+}
+
 void FlusherRunner::Dispatch(SenderQueueItem* item) {
     switch (item->mFlusher->GetSinkType()) {
         case SinkType::HTTP:
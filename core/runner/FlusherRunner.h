@@ -19,10 +19,16 @@
 #include <cstdint>
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <future>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 #include "collection_pipeline/plugin/interface/Flusher.h"
 #include "collection_pipeline/queue/SenderQueueItem.h"
+#include "common/SafeQueue.h"
 #include "monitor/MetricManager.h"
 #include "runner/sink/SinkType.h"
 
@@ -49,11 +55,18 @@ public:
     int32_t GetSendingBufferCount() { return mHttpSendingCnt.load(); }
 
 private:
+    struct DispatchItem {
+        SenderQueueItem* mItem = nullptr;
+        std::chrono::system_clock::time_point mFetchTime;
+    };
+
     FlusherRunner() = default;
     ~FlusherRunner() = default;
 
     void Run();
+    void RunDispatchThread(uint32_t threadNo);
     void Dispatch(SenderQueueItem* item);
+    void OnItemDispatched(const std::chrono::system_clock::time_point& fetchTime);
     bool LoadModuleConfig(bool isInit);
     void UpdateSendFlowControl();
 
@@ -62,7 +75,19 @@ private:
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
+    // When there is more than one dispatch thread, items of http sink are built and sent by these threads instead of
+    // the runner thread. Each sender queue is mapped to one thread by its key, so that items from the same queue are
+    // still dispatched in order.
+    uint32_t mDispatchThreadCnt = 1;
+    std::vector<std::future<void>> mDispatchThreadRes;
+    std::vector<std::unique_ptr<SafeQueue<DispatchItem>>> mDispatchQueues;
+    std::atomic_int32_t mDispatchingCnt{0};
+    std::atomic_bool mIsDispatchStopped = false;
+
     std::atomic_int32_t mHttpSendingCnt{0};
+    // notified when a request sent to http sink is done, so that PushToHttpSink can send the next one at once
+    std::mutex mHttpSendingCntMux;
+    std::condition_variable mHttpSendingCntCV;
 
     // TODO: temporarily here
     int32_t mLastCheckSendClientTime = 0;
@@ -79,6 +104,7 @@ private:
     TimeCounterPtr mTotalDelayMs;
     IntGaugePtr mWaitingItemsTotal;
     IntGaugePtr mLastRunTime;
+    TimeCounterPtr mSendBlockedTimeMs;
 
 #ifdef APSARA_UNIT_TEST_MAIN
     friend class PluginRegistryUnittest;
@@ -40,12 +40,23 @@ thread_local CounterPtr ProcessorRunner::sInGroupsCnt;
 thread_local CounterPtr ProcessorRunner::sInEventsCnt;
 thread_local CounterPtr ProcessorRunner::sInGroupDataSizeBytes;
 thread_local IntGaugePtr ProcessorRunner::sLastRunTime;
+thread_local TimeCounterPtr ProcessorRunner::sPopTotalTimeMs;
+thread_local CounterPtr ProcessorRunner::sStolenItemsCnt;
+thread_local CounterPtr ProcessorRunner::sParallelTasksCnt;
 
 ProcessorRunner::ProcessorRunner()
     : mThreadCount(AppConfig::GetInstance()->GetProcessThreadCount()), mThreadRes(mThreadCount) {
 }
 
 void ProcessorRunner::Init() {
+    if (!mPushQueueBlockedTimeMs) {
+        WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
+            mMetricsRecordRef,
+            MetricCategory::METRIC_CATEGORY_RUNNER,
+            {{METRIC_LABEL_KEY_RUNNER_NAME, METRIC_LABEL_VALUE_RUNNER_NAME_PROCESSOR}});
+        mPushQueueBlockedTimeMs
+            = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_PROCESSOR_PUSH_QUEUE_BLOCKED_TIME_MS);
+    }
     for (uint32_t threadNo = 0; threadNo < mThreadCount; ++threadNo) {
         mThreadRes[threadNo] = async(launch::async, &ProcessorRunner::Run, this, threadNo);
     }
@@ -69,19 +80,35 @@ void ProcessorRunner::Stop() {
 }
 
 bool ProcessorRunner::PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes) {
+    static ProcessQueueManager* manager = ProcessQueueManager::GetInstance();
+
     unique_ptr<ProcessQueueItem> item = make_unique<ProcessQueueItem>(std::move(group), inputIndex);
-    for (size_t i = 0; i < retryTimes; ++i) {
-        if (ProcessQueueManager::GetInstance()->PushQueue(key, std::move(item)) == QueueStatus::OK) {
+    // the queue is retried as soon as any item is popped, instead of every 10ms, within the same total time
+    auto start = chrono::steady_clock::now();
+    auto deadline = start + chrono::milliseconds(10) * retryTimes;
+    auto lastWarningTime = start - chrono::seconds(1);
+    for (bool blocked = false;; blocked = true) {
+        auto version = manager->GetPopVersion();
+        if (manager->PushQueue(key, std::move(item)) == QueueStatus::OK) {
+            if (blocked) {
+                ADD_COUNTER(mPushQueueBlockedTimeMs, chrono::steady_clock::now() - start);
+            }
             return true;
         }
-        if (i % 100 == 0) {
+        auto now = chrono::steady_clock::now();
+        if (now >= deadline) {
+            break;
+        }
+        if (now - lastWarningTime >= chrono::seconds(1)) {
             LOG_WARNING(sLogger,
                         ("push attempts to process queue continuously failed for the past second",
                          "retry again")("config", QueueKeyManager::GetInstance()->GetName(key))("input index",
                                                                                                 ToString(inputIndex)));
+            lastWarningTime = now;
         }
-        this_thread::sleep_for(chrono::milliseconds(10));
+        manager->WaitForPop(version, chrono::ceil<chrono::milliseconds>(deadline - now).count());
     }
+    ADD_COUNTER(mPushQueueBlockedTimeMs, chrono::steady_clock::now() - start);
     group = std::move(item->mEventGroup);
     return false;
 }
@@ -100,7 +127,16 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     sInEventsCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_EVENTS_TOTAL);
     sInGroupDataSizeBytes = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_IN_SIZE_BYTES);
     sLastRunTime = sMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_LAST_RUN_TIME);
+    sPopTotalTimeMs = sMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_PROCESSOR_POP_TOTAL_TIME_MS);
+    sStolenItemsCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESSOR_STOLEN_ITEMS_TOTAL);
+    sParallelTasksCnt = sMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESSOR_PARALLEL_TASKS_TOTAL);
+    gThreadedEventPool.SetMetrics(
+        sMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESSOR_EVENT_POOL_HIT_TOTAL),
+        sMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESSOR_EVENT_POOL_MISS_TOTAL),
+        sMetricsRecordRef.CreateCounter(METRIC_RUNNER_PROCESSOR_EVENT_POOL_CROSS_THREAD_RETURNED_TOTAL));
 
+    const CollectionPipeline::ParallelExecutor executor
+        = [this](vector<function<void()>>& tasks) { RunInParallel(tasks); };
     static int32_t lastFlushBatchTime = 0;
     while (true) {
         int32_t curTime = time(nullptr);
@@ -110,15 +146,27 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         }
 
         SET_GAUGE(sLastRunTime, curTime);
+        // chunks of groups being processed by other threads go first, since those threads are waiting for them
+        if (RunOneParallelTask()) {
+            continue;
+        }
+
         unique_ptr<ProcessQueueItem> item;
         string configName;
-        if (!ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName)) {
+        bool isStolen = false;
+        auto popStartTime = chrono::steady_clock::now();
+        bool hasItem = ProcessQueueManager::GetInstance()->PopItem(threadNo, item, configName, &isStolen);
+        ADD_COUNTER(sPopTotalTimeMs, chrono::steady_clock::now() - popStartTime);
+        if (!hasItem) {
             if (mIsFlush && ProcessQueueManager::GetInstance()->IsAllQueueEmpty()) {
                 break;
             }
             ProcessQueueManager::GetInstance()->Wait(100);
             continue;
         }
+        if (isStolen) {
+            ADD_COUNTER(sStolenItemsCnt, 1);
+        }
 
         ADD_COUNTER(sInEventsCnt, item->mEventGroup.GetEvents().size());
         ADD_COUNTER(sInGroupsCnt, 1);
@@ -139,7 +187,7 @@ void ProcessorRunner::Run(uint32_t threadNo) {
         eventGroupList.emplace_back(std::move(item->mEventGroup));
         // TODO: use old pipeline input index to find inner processor in new pipeline, maybe cause some issues when
         // there are multiple inputs
-        pipeline->Process(eventGroupList, item->mInputIndex);
+        pipeline->Process(eventGroupList, item->mInputIndex, executor);
 
         if (pipeline->IsFlushingThroughGoPipeline()) {
             // TODO:
@@ -181,6 +229,54 @@ void ProcessorRunner::Run(uint32_t threadNo) {
     }
 }
 
+void ProcessorRunner::RunInParallel(vector<function<void()>>& tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+    auto group = make_shared<ParallelTaskGroup>();
+    group->mPending.store(tasks.size());
+    {
+        lock_guard<mutex> lock(mParallelTaskMux);
+        for (size_t i = 1; i < tasks.size(); ++i) {
+            mParallelTasks.push_back({&tasks[i], group});
+        }
+    }
+    for (size_t i = 1; i < tasks.size(); ++i) {
+        ProcessQueueManager::GetInstance()->Trigger();
+    }
+
+    ParallelTask first{&tasks[0], group};
+    RunParallelTask(first);
+    while (group->mPending.load() > 0 && RunOneParallelTask()) {
+    }
+    // the remaining tasks are being run by other threads
+    unique_lock<mutex> lock(group->mMux);
+    group->mCond.wait(lock, [&group]() { return group->mPending.load() == 0; });
+}
+
+bool ProcessorRunner::RunOneParallelTask() {
+    ParallelTask task;
+    {
+        lock_guard<mutex> lock(mParallelTaskMux);
+        if (mParallelTasks.empty()) {
+            return false;
+        }
+        task = std::move(mParallelTasks.front());
+        mParallelTasks.pop_front();
+    }
+    RunParallelTask(task);
+    return true;
+}
+
+void ProcessorRunner::RunParallelTask(ParallelTask& task) {
+    (*task.mTask)();
+    ADD_COUNTER(sParallelTasksCnt, 1);
+    if (task.mGroup->mPending.fetch_sub(1) == 1) {
+        lock_guard<mutex> lock(task.mGroup->mMux);
+        task.mGroup->mCond.notify_all();
+    }
+}
+
 bool ProcessorRunner::Serialize(
     const PipelineEventGroup& group, bool enableNanosecond, const string& logstore, string& res, string& errorMsg) {
     sls_logs::LogGroup logGroup;
@@ -19,7 +19,12 @@
 #include <cstdint>
 
 #include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
 #include <future>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -46,11 +51,29 @@ public:
     bool PushQueue(QueueKey key, size_t inputIndex, PipelineEventGroup&& group, uint32_t retryTimes = 1);
 
 private:
+    // tasks of one RunInParallel call
+    struct ParallelTaskGroup {
+        std::atomic_size_t mPending{0};
+        std::mutex mMux;
+        std::condition_variable mCond;
+    };
+
+    struct ParallelTask {
+        std::function<void()>* mTask = nullptr;
+        std::shared_ptr<ParallelTaskGroup> mGroup;
+    };
+
     ProcessorRunner();
     ~ProcessorRunner() = default;
 
     void Run(uint32_t threadNo);
 
+    // Run all tasks with the help of other runner threads, and return after all of them are finished. The caller
+    // runs tasks itself as well, so all tasks are finished even if all other threads are busy.
+    void RunInParallel(std::vector<std::function<void()>>& tasks);
+    bool RunOneParallelTask();
+    void RunParallelTask(ParallelTask& task);
+
     bool Serialize(const PipelineEventGroup& group,
                    bool enableNanosecond,
                    const std::string& logstore,
@@ -61,6 +84,13 @@ private:
     std::vector<std::future<void>> mThreadRes;
     std::atomic_bool mIsFlush = false;
 
+    std::mutex mParallelTaskMux;
+    std::deque<ParallelTask> mParallelTasks;
+
+    // for PushQueue, which is called by input threads
+    MetricsRecordRef mMetricsRecordRef;
+    TimeCounterPtr mPushQueueBlockedTimeMs;
+
     thread_local static uint32_t sThreadNo;
 
     thread_local static MetricsRecordRef sMetricsRecordRef;
@@ -68,6 +98,13 @@ private:
     thread_local static CounterPtr sInEventsCnt;
     thread_local static CounterPtr sInGroupDataSizeBytes;
     thread_local static IntGaugePtr sLastRunTime;
+    thread_local static TimeCounterPtr sPopTotalTimeMs;
+    thread_local static CounterPtr sStolenItemsCnt;
+    thread_local static CounterPtr sParallelTasksCnt;
+
+#ifdef APSARA_UNIT_TEST_MAIN
+    friend class PipelineUnittest;
+#endif
 };
 
 } // namespace logtail
@@ -31,6 +31,8 @@
 #endif
 
 DEFINE_FLAG_INT32(http_sink_exit_timeout_sec, "", 5);
+DEFINE_FLAG_INT32(http_sink_max_idle_handlers_per_host, "", 16);
+DEFINE_FLAG_BOOL(enable_http_sink_http2, "multiplex requests to the same https host over http/2", false);
 
 using namespace std;
 
@@ -46,11 +48,18 @@ HttpSink* HttpSink::GetInstance() {
 }
 
 bool HttpSink::Init() {
-    mClient = curl_multi_init();
-    if (mClient == nullptr) {
+    if (!mEventLoop.Init()) {
         LOG_ERROR(sLogger, ("failed to init http sink", "failed to init curl multi client"));
         return false;
     }
+    mHandlerPool = make_unique<CurlHandlerPool>(INT32_FLAG(http_sink_max_idle_handlers_per_host));
+    // keep idle connections of all concurrent requests, so that they can be reused by the following requests
+    curl_multi_setopt(mEventLoop.GetClient(),
+                      CURLMOPT_MAXCONNECTS,
+                      static_cast<long>(AppConfig::GetInstance()->GetSendRequestGlobalConcurrency()));
+    if (BOOL_FLAG(enable_http_sink_http2)) {
+        curl_multi_setopt(mEventLoop.GetClient(), CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+    }
 
     WriteMetrics::GetInstance()->PrepareMetricsRecordRef(
         mMetricsRecordRef,
@@ -64,6 +73,8 @@ bool HttpSink::Init() {
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_RESPONSE_TIME_MS);
     mFailedItemTotalResponseTimeMs
         = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_FAILED_ITEM_TOTAL_RESPONSE_TIME_MS);
+    mSuccessfulItemTotalFirstByteTimeMs
+        = mMetricsRecordRef.CreateTimeCounter(METRIC_RUNNER_SINK_SUCCESSFUL_ITEM_TOTAL_FIRST_BYTE_TIME_MS);
     mSendingItemsTotal = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SENDING_ITEMS_TOTAL);
     mSendConcurrency = mMetricsRecordRef.CreateIntGauge(METRIC_RUNNER_SINK_SEND_CONCURRENCY);
 
@@ -76,6 +87,7 @@ bool HttpSink::Init() {
 
 void HttpSink::Stop() {
     mIsFlush = true;
+    mEventLoop.Wakeup();
     if (!mThreadRes.valid()) {
         return;
     }
@@ -87,13 +99,43 @@ void HttpSink::Stop() {
     }
 }
 
+bool HttpSink::AddRequest(unique_ptr<HttpSinkRequest>&& request) {
+    mQueue.Push(std::move(request));
+    // send it at once if the sink is waiting for running requests
+    mEventLoop.Wakeup();
+    return true;
+}
+
 void HttpSink::Run() {
     LOG_INFO(sLogger, ("http sink", "started"));
+    int runningHandlers = 0;
     while (true) {
         SET_GAUGE(mLastRunTime,
                   chrono::duration_cast<chrono::seconds>(chrono::system_clock::now().time_since_epoch()).count());
         unique_ptr<HttpSinkRequest> request;
-        if (mQueue.WaitAndPop(request, 500)) {
+        if (runningHandlers == 0) {
+            // nothing to wait for in curl, so wait for new requests
+            if (mQueue.WaitAndPop(request, 500)) {
+                ADD_COUNTER(mInItemsTotal, 1);
+                LOG_TRACE(sLogger,
+                          ("got item from flusher runner, item address", request->mItem)(
+                              "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(request->mItem->mQueueKey))(
+                              "wait time",
+                              ToString(chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now()
+                                                                                   - request->mEnqueTime)
+                                           .count()))("try cnt", ToString(request->mTryCnt)));
+                if (AddRequestToClient(std::move(request))) {
+                    ++runningHandlers;
+                    ADD_GAUGE(mSendingItemsTotal, 1);
+                }
+            } else if (mIsFlush && mQueue.Empty()) {
+                break;
+            }
+            if (runningHandlers == 0) {
+                continue;
+            }
+        }
+        while (mQueue.TryPop(request)) {
             ADD_COUNTER(mInItemsTotal, 1);
             LOG_TRACE(sLogger,
                       ("got item from flusher runner, item address", request->mItem)(
@@ -102,25 +144,24 @@ void HttpSink::Run() {
                           ToString(chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now()
                                                                                - request->mEnqueTime)
                                        .count()))("try cnt", ToString(request->mTryCnt)));
-            if (!AddRequestToClient(std::move(request))) {
-                continue;
+            if (AddRequestToClient(std::move(request))) {
+                ++runningHandlers;
+                ADD_GAUGE(mSendingItemsTotal, 1);
             }
-            ADD_GAUGE(mSendingItemsTotal, 1);
-        } else if (mIsFlush && mQueue.Empty()) {
-            break;
-        } else {
-            continue;
         }
-        DoRun();
-    }
-    auto mc = curl_multi_cleanup(mClient);
-    if (mc != CURLM_OK) {
-        LOG_ERROR(sLogger, ("failed to cleanup curl multi handle", "exit anyway")("errMsg", curl_multi_strerror(mc)));
+
+        // only sockets with events are handled, and new requests wake it up at once
+        mEventLoop.Wait(1000);
+        runningHandlers = mEventLoop.GetRunningHandles();
+        HandleCompletedRequests(runningHandlers);
     }
+    mEventLoop.Cleanup();
+    mHandlerPool->Clear();
 }
 
 bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
     curl_slist* headers = nullptr;
+    auto hostKey = CurlHandlerPool::GetHostKey(request->mHTTPSFlag, request->mHost, request->mPort);
     CURL* curl = CreateCurlHandler(request->mMethod,
                                    request->mHTTPSFlag,
                                    request->mHost,
@@ -136,7 +177,8 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
                                    AppConfig::GetInstance()->GetBindInterface(),
                                    false,
                                    std::nullopt,
-                                   std::move(request->mSocket));
+                                   std::move(request->mSocket),
+                                   mHandlerPool->Acquire(hostKey));
     if (curl == nullptr) {
         request->mItem->mStatus = SendingStatus::IDLE;
         request->mResponse.SetNetworkStatus(NetworkCode::Other, "failed to init curl handler");
@@ -150,16 +192,21 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
         return false;
     }
 
+    if (request->mHTTPSFlag && BOOL_FLAG(enable_http_sink_http2)) {
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+        // wait for the connection being established to the same host, so that the request can be multiplexed on it
+        curl_easy_setopt(curl, CURLOPT_PIPEWAIT, 1L);
+    }
     request->mPrivateData = headers;
     curl_easy_setopt(curl, CURLOPT_PRIVATE, request.get());
     request->mLastSendTime = chrono::system_clock::now();
 
-    auto res = curl_multi_add_handle(mClient, curl);
+    auto res = curl_multi_add_handle(mEventLoop.GetClient(), curl);
     if (res != CURLM_OK) {
         request->mItem->mStatus = SendingStatus::IDLE;
         request->mResponse.SetNetworkStatus(NetworkCode::Other, "failed to add the easy curl handle to multi_handle");
         FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
-        curl_easy_cleanup(curl);
+        mHandlerPool->Release(hostKey, curl);
         ADD_COUNTER(mOutFailedItemsTotal, 1);
         LOG_ERROR(sLogger,
                   ("failed to send request",
@@ -174,83 +221,9 @@ bool HttpSink::AddRequestToClient(unique_ptr<HttpSinkRequest>&& request) {
     return true;
 }
 
-void HttpSink::DoRun() {
-    CURLMcode mc;
-    int runningHandlers = 1;
-    while (runningHandlers) {
-        auto curTime = chrono::system_clock::now();
-        SET_GAUGE(mLastRunTime, chrono::duration_cast<chrono::seconds>(curTime.time_since_epoch()).count());
-        if ((mc = curl_multi_perform(mClient, &runningHandlers)) != CURLM_OK) {
-            LOG_ERROR(
-                sLogger,
-                ("failed to call curl_multi_perform", "sleep 100ms and retry")("errMsg", curl_multi_strerror(mc)));
-            this_thread::sleep_for(chrono::milliseconds(100));
-            continue;
-        }
-        HandleCompletedRequests(runningHandlers);
-
-        unique_ptr<HttpSinkRequest> request;
-        bool hasRequest = false;
-        while (mQueue.TryPop(request)) {
-            ADD_COUNTER(mInItemsTotal, 1);
-            LOG_TRACE(sLogger,
-                      ("got item from flusher runner, item address", request->mItem)(
-                          "config-flusher-dst", QueueKeyManager::GetInstance()->GetName(request->mItem->mQueueKey))(
-                          "wait time",
-                          ToString(chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now()
-                                                                               - request->mEnqueTime)
-                                       .count()))("try cnt", ToString(request->mTryCnt)));
-            if (AddRequestToClient(std::move(request))) {
-                ++runningHandlers;
-                ADD_GAUGE(mSendingItemsTotal, 1);
-                hasRequest = true;
-            }
-        }
-        if (hasRequest) {
-            continue;
-        }
-
-        struct timeval timeout {
-            1, 0
-        };
-        long curlTimeout = -1;
-        if ((mc = curl_multi_timeout(mClient, &curlTimeout)) != CURLM_OK) {
-            LOG_WARNING(
-                sLogger,
-                ("failed to call curl_multi_timeout", "use default timeout 1s")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (curlTimeout >= 0) {
-            auto sec = curlTimeout / 1000;
-            // to avoid waiting too long so that adding new request is delayed
-            if (sec <= 1) {
-                timeout.tv_sec = sec;
-                timeout.tv_usec = (curlTimeout % 1000) * 1000;
-            }
-        }
-
-        int maxfd = -1;
-        fd_set fdread;
-        fd_set fdwrite;
-        fd_set fdexcep;
-        FD_ZERO(&fdread);
-        FD_ZERO(&fdwrite);
-        FD_ZERO(&fdexcep);
-        if ((mc = curl_multi_fdset(mClient, &fdread, &fdwrite, &fdexcep, &maxfd)) != CURLM_OK) {
-            LOG_ERROR(sLogger, ("failed to call curl_multi_fdset", "sleep 100ms")("errMsg", curl_multi_strerror(mc)));
-        }
-        if (maxfd == -1) {
-            // sleep min(timeout, 100ms) according to libcurl
-            int64_t sleepMs = (curlTimeout >= 0 && curlTimeout < 100) ? curlTimeout : 100;
-            this_thread::sleep_for(chrono::milliseconds(sleepMs));
-        } else {
-            select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
-        }
-    }
-}
-
 void HttpSink::HandleCompletedRequests(int& runningHandlers) {
     int msgsLeft = 0;
-    CURLMsg* msg = curl_multi_info_read(mClient, &msgsLeft);
+    CURLMsg* msg = curl_multi_info_read(mEventLoop.GetClient(), &msgsLeft);
     while (msg) {
         if (msg->msg == CURLMSG_DONE) {
             bool requestReused = false;
@@ -278,6 +251,9 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     FlusherRunner::GetInstance()->DecreaseHttpSendingCnt();
                     ADD_COUNTER(mOutSuccessfulItemsTotal, 1);
                     ADD_COUNTER(mSuccessfulItemTotalResponseTimeMs, responseTime);
+                    curl_off_t firstByteTime = 0;
+                    curl_easy_getinfo(handler, CURLINFO_STARTTRANSFER_TIME_T, &firstByteTime);
+                    ADD_COUNTER(mSuccessfulItemTotalFirstByteTimeMs, chrono::microseconds(firstByteTime));
                     SUB_GAUGE(mSendingItemsTotal, 1);
                     break;
                 }
@@ -318,8 +294,10 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                     SUB_GAUGE(mSendingItemsTotal, 1);
                     break;
             }
-            curl_multi_remove_handle(mClient, handler);
-            curl_easy_cleanup(handler);
+            curl_multi_remove_handle(mEventLoop.GetClient(), handler);
+            // the connection is kept by the multi handle, and the handler is reused by the following requests
+            mHandlerPool->Release(CurlHandlerPool::GetHostKey(request->mHTTPSFlag, request->mHost, request->mPort),
+                                  handler);
             if (!requestReused) {
                 if (request->mPrivateData) {
                     curl_slist_free_all((curl_slist*)request->mPrivateData);
@@ -327,7 +305,7 @@ void HttpSink::HandleCompletedRequests(int& runningHandlers) {
                 delete request;
             }
         }
-        msg = curl_multi_info_read(mClient, &msgsLeft);
+        msg = curl_multi_info_read(mEventLoop.GetClient(), &msgsLeft);
     }
 }
 
@@ -19,10 +19,11 @@
 #include <atomic>
 #include <condition_variable>
 #include <future>
+#include <memory>
 #include <mutex>
 
-#include "curl/multi.h"
-
+#include "common/http/CurlEventLoop.h"
+#include "common/http/CurlHandlerPool.h"
 #include "monitor/MetricManager.h"
 #include "runner/sink/Sink.h"
 #include "runner/sink/http/HttpSinkRequest.h"
@@ -38,6 +39,7 @@ public:
 
     bool Init() override;
     void Stop() override;
+    bool AddRequest(std::unique_ptr<HttpSinkRequest>&& request) override;
 
 private:
     HttpSink() = default;
@@ -45,10 +47,10 @@ private:
 
     void Run();
     bool AddRequestToClient(std::unique_ptr<HttpSinkRequest>&& request);
-    void DoRun();
     void HandleCompletedRequests(int& runningHandlers);
 
-    CURLM* mClient = nullptr;
+    CurlEventLoop mEventLoop;
+    std::unique_ptr<CurlHandlerPool> mHandlerPool;
 
     std::future<void> mThreadRes;
     std::atomic_bool mIsFlush = false;
@@ -59,6 +61,7 @@ private:
     CounterPtr mOutFailedItemsTotal;
     TimeCounterPtr mSuccessfulItemTotalResponseTimeMs;
     TimeCounterPtr mFailedItemTotalResponseTimeMs;
+    TimeCounterPtr mSuccessfulItemTotalFirstByteTimeMs;
     IntGaugePtr mSendingItemsTotal;
     IntGaugePtr mSendConcurrency;
     IntGaugePtr mLastRunTime;
@@ -69,24 +69,24 @@ void BatchedEventsUnittest::TestDestructor() {
         log = g.AddLogEvent(true, &mPool);
         log->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mLogEventPoolBak.size());
-    APSARA_TEST_EQUAL(log, mPool.mLogEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedLogEvents.Size());
+    APSARA_TEST_EQUAL(log, mPool.mReturnedLogEvents.Back());
     APSARA_TEST_EQUAL(0, log->GetTimestamp());
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         metric = g.AddMetricEvent(true, &mPool);
         metric->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mMetricEventPoolBak.size());
-    APSARA_TEST_EQUAL(metric, mPool.mMetricEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedMetricEvents.Size());
+    APSARA_TEST_EQUAL(metric, mPool.mReturnedMetricEvents.Back());
     APSARA_TEST_EQUAL(0, metric->GetTimestamp());
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         span = g.AddSpanEvent(true, &mPool);
         span->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mSpanEventPoolBak.size());
-    APSARA_TEST_EQUAL(span, mPool.mSpanEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedSpanEvents.Size());
+    APSARA_TEST_EQUAL(span, mPool.mReturnedSpanEvents.Back());
     APSARA_TEST_EQUAL(0, span->GetTimestamp());
 }
 
@@ -0,0 +1,293 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "checkpoint/CheckPointJournal.h"
+#include "checkpoint/CheckPointManager.h"
+#include "common/FileSystemUtil.h"
+#include "common/Flags.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(check_point_journal_compact_ratio);
+DECLARE_FLAG_BOOL(enable_check_point_journal);
+
+using namespace std;
+
+namespace logtail {
+
+class CheckPointJournalUnittest : public ::testing::Test {
+public:
+    void TestDumpAndLoad();
+    void TestIncrementalDump();
+    void TestDiscardUncommittedRecords();
+    void TestCompaction();
+    void TestMigrateFromJson();
+
+protected:
+    static void SetUpTestCase() {
+        sRootDir = (bfs::path(GetProcessExecutionDir()) / "CheckPointJournalUnittest").string();
+        bfs::remove_all(sRootDir);
+        bfs::create_directories(sRootDir);
+        sJournalPath = (bfs::path(sRootDir) / "checkpoint.journal").string();
+    }
+
+    static void TearDownTestCase() { bfs::remove_all(sRootDir); }
+
+    void SetUp() override {
+        bfs::remove(sJournalPath);
+        mFileCheckPoints.clear();
+        mDirCheckPoints.clear();
+        for (int i = 0; i < 10; ++i) {
+            auto checkPoint = make_unique<CheckPoint>("/var/log/" + to_string(i) + ".log",
+                                                      i * 100,
+                                                      1024,
+                                                      i + 1,
+                                                      DevInode(1, i + 1),
+                                                      "config",
+                                                      "/var/log/real_" + to_string(i) + ".log",
+                                                      i % 2 == 0,
+                                                      i % 3 == 0,
+                                                      "container",
+                                                      i % 5 == 0);
+            checkPoint->mLastUpdateTime = 1000 + i;
+            checkPoint->mIdxInReaderArray = i;
+            mFileCheckPoints.emplace_back(std::move(checkPoint));
+        }
+        auto dir = make_unique<DirCheckPoint>("/var/log");
+        dir->mSubDir.insert("/var/log/a");
+        dir->mSubDir.insert("/var/log/b");
+        mDirCheckPoints.emplace_back(std::move(dir));
+    }
+
+    void Dump(CheckPointJournal& journal) {
+        vector<const CheckPoint*> files;
+        for (const auto& item : mFileCheckPoints) {
+            files.push_back(item.get());
+        }
+        vector<const DirCheckPoint*> dirs;
+        for (const auto& item : mDirCheckPoints) {
+            dirs.push_back(item.get());
+        }
+        APSARA_TEST_TRUE(journal.Dump(sJournalPath, 200, files, dirs));
+    }
+
+    map<string, CheckPointPtr> Load(CheckPointJournal& journal, vector<DirCheckPointPtr>* dirs = nullptr) {
+        int32_t version = 0;
+        vector<CheckPointPtr> files;
+        vector<DirCheckPointPtr> loadedDirs;
+        APSARA_TEST_TRUE(journal.Load(sJournalPath, version, files, loadedDirs));
+        APSARA_TEST_EQUAL(200, version);
+        map<string, CheckPointPtr> res;
+        for (auto& item : files) {
+            res[item->mFileName] = item;
+        }
+        if (dirs != nullptr) {
+            *dirs = loadedDirs;
+        }
+        return res;
+    }
+
+    static size_t GetJournalSize() { return bfs::file_size(sJournalPath); }
+
+    static string sRootDir;
+    static string sJournalPath;
+
+    vector<unique_ptr<CheckPoint>> mFileCheckPoints;
+    vector<unique_ptr<DirCheckPoint>> mDirCheckPoints;
+};
+
+string CheckPointJournalUnittest::sRootDir;
+string CheckPointJournalUnittest::sJournalPath;
+
+void CheckPointJournalUnittest::TestDumpAndLoad() {
+    CheckPointJournal journal;
+    Dump(journal);
+
+    CheckPointJournal loadJournal;
+    vector<DirCheckPointPtr> dirs;
+    auto files = Load(loadJournal, &dirs);
+    APSARA_TEST_EQUAL(mFileCheckPoints.size(), files.size());
+    for (const auto& expected : mFileCheckPoints) {
+        APSARA_TEST_EQUAL_FATAL(1U, files.count(expected->mFileName));
+        const auto& checkPoint = files[expected->mFileName];
+        APSARA_TEST_EQUAL(expected->mDevInode, checkPoint->mDevInode);
+        APSARA_TEST_EQUAL(expected->mOffset, checkPoint->mOffset);
+        APSARA_TEST_EQUAL(expected->mSignatureHash, checkPoint->mSignatureHash);
+        APSARA_TEST_EQUAL(expected->mSignatureSize, checkPoint->mSignatureSize);
+        APSARA_TEST_EQUAL(expected->mLastUpdateTime, checkPoint->mLastUpdateTime);
+        APSARA_TEST_EQUAL(expected->mIdxInReaderArray, checkPoint->mIdxInReaderArray);
+        APSARA_TEST_EQUAL(expected->mFileOpenFlag, checkPoint->mFileOpenFlag);
+        APSARA_TEST_EQUAL(expected->mContainerStopped, checkPoint->mContainerStopped);
+        APSARA_TEST_EQUAL(expected->mLastForceRead, checkPoint->mLastForceRead);
+        APSARA_TEST_EQUAL(expected->mRealFileName, checkPoint->mRealFileName);
+        APSARA_TEST_EQUAL(expected->mConfigName, checkPoint->mConfigName);
+        APSARA_TEST_EQUAL(expected->mContainerID, checkPoint->mContainerID);
+    }
+    APSARA_TEST_EQUAL_FATAL(1U, dirs.size());
+    APSARA_TEST_EQUAL("/var/log", dirs[0]->mParentName);
+    APSARA_TEST_EQUAL(mDirCheckPoints[0]->mUpdateTime, dirs[0]->mUpdateTime);
+    APSARA_TEST_TRUE(mDirCheckPoints[0]->mSubDir == dirs[0]->mSubDir);
+
+    // invalid journals
+    int32_t version = 0;
+    vector<CheckPointPtr> fileCheckPoints;
+    vector<DirCheckPointPtr> dirCheckPoints;
+    APSARA_TEST_FALSE(loadJournal.Load(sJournalPath + ".unknown", version, fileCheckPoints, dirCheckPoints));
+    ofstream(sJournalPath, ios::trunc) << "{\"check_point\":{}}";
+    APSARA_TEST_FALSE(loadJournal.Load(sJournalPath, version, fileCheckPoints, dirCheckPoints));
+    APSARA_TEST_TRUE(fileCheckPoints.empty());
+}
+
+void CheckPointJournalUnittest::TestIncrementalDump() {
+    CheckPointJournal journal;
+    Dump(journal);
+    size_t size = GetJournalSize();
+
+    // nothing is written if nothing changes
+    Dump(journal);
+    APSARA_TEST_EQUAL(size, GetJournalSize());
+
+    // only the changed checkpoint is appended
+    mFileCheckPoints[3]->mOffset += 10;
+    Dump(journal);
+    size_t appendedSize = GetJournalSize() - size;
+    APSARA_TEST_TRUE(appendedSize > 0);
+    APSARA_TEST_TRUE(appendedSize < size / mFileCheckPoints.size() * 2);
+
+    // removed checkpoints are removed on load
+    mFileCheckPoints.erase(mFileCheckPoints.begin());
+    mDirCheckPoints.clear();
+    Dump(journal);
+
+    CheckPointJournal loadJournal;
+    vector<DirCheckPointPtr> dirs;
+    auto files = Load(loadJournal, &dirs);
+    APSARA_TEST_EQUAL(mFileCheckPoints.size(), files.size());
+    APSARA_TEST_EQUAL(0U, files.count("/var/log/0.log"));
+    APSARA_TEST_EQUAL(310, files["/var/log/3.log"]->mOffset);
+    APSARA_TEST_TRUE(dirs.empty());
+
+    // the loaded journal keeps appending
+    size = GetJournalSize();
+    mFileCheckPoints[0]->mOffset += 10;
+    Dump(loadJournal);
+    APSARA_TEST_TRUE(GetJournalSize() > size);
+    APSARA_TEST_TRUE(GetJournalSize() - size < size / mFileCheckPoints.size() * 2);
+    APSARA_TEST_EQUAL(110, Load(journal)["/var/log/1.log"]->mOffset);
+}
+
+void CheckPointJournalUnittest::TestDiscardUncommittedRecords() {
+    CheckPointJournal journal;
+    Dump(journal);
+    size_t size = GetJournalSize();
+    mFileCheckPoints[0]->mOffset = 12345;
+    Dump(journal);
+    size_t appendedSize = GetJournalSize() - size;
+
+    // a dump torn by crash
+    bfs::resize_file(sJournalPath, size + appendedSize - 1);
+    CheckPointJournal loadJournal;
+    auto files = Load(loadJournal);
+    APSARA_TEST_EQUAL(mFileCheckPoints.size(), files.size());
+    APSARA_TEST_EQUAL(0, files["/var/log/0.log"]->mOffset);
+    // the next dump rewrites the journal instead of appending to the torn one
+    APSARA_TEST_TRUE(loadJournal.mPath.empty());
+    Dump(loadJournal);
+    APSARA_TEST_EQUAL(12345, Load(journal)["/var/log/0.log"]->mOffset);
+
+    // garbage at the tail
+    ofstream(sJournalPath, ios::binary | ios::app) << "garbage";
+    APSARA_TEST_EQUAL(12345, Load(journal)["/var/log/0.log"]->mOffset);
+}
+
+void CheckPointJournalUnittest::TestCompaction() {
+    auto bakRatio = INT32_FLAG(check_point_journal_compact_ratio);
+    INT32_FLAG(check_point_journal_compact_ratio) = 1;
+    CheckPointJournal journal;
+    Dump(journal);
+    size_t size = GetJournalSize();
+    size_t maxRecordCount = 0;
+    for (int i = 0; i < 2000; ++i) {
+        ++mFileCheckPoints[0]->mOffset;
+        Dump(journal);
+        maxRecordCount = max(maxRecordCount, journal.mRecordCount);
+    }
+    // records of the live checkpoints and a commit
+    APSARA_TEST_TRUE(maxRecordCount <= 1024 + mFileCheckPoints.size() + mDirCheckPoints.size());
+    APSARA_TEST_TRUE(journal.mRecordCount < maxRecordCount);
+    APSARA_TEST_TRUE(GetJournalSize() < size * 100);
+    APSARA_TEST_EQUAL(2000, Load(journal)["/var/log/0.log"]->mOffset);
+    INT32_FLAG(check_point_journal_compact_ratio) = bakRatio;
+}
+
+void CheckPointJournalUnittest::TestMigrateFromJson() {
+    auto bakJournal = BOOL_FLAG(enable_check_point_journal);
+    auto bakPath = AppConfig::GetInstance()->mCheckPointFilePath;
+    AppConfig::GetInstance()->mCheckPointFilePath = (bfs::path(sRootDir) / "checkpoint").string();
+    const auto& jsonPath = AppConfig::GetInstance()->GetCheckPointFilePath();
+    auto journalPath = CheckPointManager::GetCheckPointJournalPath();
+    auto manager = CheckPointManager::Instance();
+    manager->RemoveAllCheckPoint();
+
+    // checkpoint dumped by previous versions
+    BOOL_FLAG(enable_check_point_journal) = false;
+    manager->AddCheckPoint(new CheckPoint("/var/log/a.log", 100, 1024, 1, DevInode(1, 1), "config", "", false, false,
+                                          "", false));
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(CheckExistance(jsonPath));
+    APSARA_TEST_FALSE(CheckExistance(journalPath));
+    manager->RemoveAllCheckPoint();
+
+    BOOL_FLAG(enable_check_point_journal) = true;
+    manager->LoadCheckPoint();
+    CheckPointPtr checkPoint;
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", checkPoint));
+    APSARA_TEST_EQUAL(100, checkPoint->mOffset);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_FALSE(CheckExistance(jsonPath));
+    APSARA_TEST_TRUE(CheckExistance(journalPath));
+    manager->RemoveAllCheckPoint();
+
+    manager->LoadCheckPoint();
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", checkPoint));
+    APSARA_TEST_EQUAL(100, checkPoint->mOffset);
+
+    // switching back to json loads the journal when there is no json, and then drops it
+    BOOL_FLAG(enable_check_point_journal) = false;
+    manager->RemoveAllCheckPoint();
+    manager->LoadCheckPoint();
+    APSARA_TEST_TRUE_FATAL(manager->GetCheckPoint(DevInode(1, 1), "config", checkPoint));
+    APSARA_TEST_EQUAL(100, checkPoint->mOffset);
+    APSARA_TEST_TRUE(manager->DumpCheckPointToLocal());
+    APSARA_TEST_TRUE(CheckExistance(jsonPath));
+    APSARA_TEST_FALSE(CheckExistance(journalPath));
+    manager->RemoveAllCheckPoint();
+
+    BOOL_FLAG(enable_check_point_journal) = bakJournal;
+    AppConfig::GetInstance()->mCheckPointFilePath = bakPath;
+}
+
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestDumpAndLoad)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestIncrementalDump)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestDiscardUncommittedRecords)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestCompaction)
+UNIT_TEST_CASE(CheckPointJournalUnittest, TestMigrateFromJson)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
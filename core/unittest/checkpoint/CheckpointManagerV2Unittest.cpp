@@ -14,6 +14,7 @@
 
 #include "app_config/AppConfig.h"
 #include "checkpoint/CheckpointManagerV2.h"
+#include "common/DevInode.h"
 #include "common/Flags.h"
 #include "protobuf/sls/sls_logs.pb.h"
 #include "unittest/Unittest.h"
@@ -21,12 +22,14 @@
 DECLARE_FLAG_INT32(logtail_checkpoint_check_gc_interval_sec);
 DECLARE_FLAG_INT32(logtail_checkpoint_expired_threshold_sec);
 DECLARE_FLAG_INT32(logtail_checkpoint_gc_threshold_sec);
+DECLARE_FLAG_INT32(logtail_checkpoint_batch_write_interval_ms);
+DECLARE_FLAG_INT32(logtail_checkpoint_config_gc_interval_sec);
 
 namespace logtail {
 
 std::string kTestRootDir;
 const uint32_t kConcurrency = 3;
-const std::string kPrimaryKey = "primary";
+const std::string kPrimaryKey = "config-/var/log/test.log-100-1000";
 const std::string kConfigName = "config";
 const std::string kLogPath = "/var/log/test.log";
 const auto kDevInode = DevInode(100, 1000);
@@ -41,6 +44,8 @@ public:
         bfs::create_directories(kTestRootDir);
         AppConfig::GetInstance()->SetLoongcollectorConfDir(kTestRootDir);
         INT32_FLAG(logtail_checkpoint_check_gc_interval_sec) = 1;
+        // Writes are only flushed explicitly, unless the test says otherwise.
+        INT32_FLAG(logtail_checkpoint_batch_write_interval_ms) = 3600 * 1000;
     }
 
     static void TearDownTestCase() { bfs::remove_all(kTestRootDir); }
@@ -49,6 +54,14 @@ public:
 
     void TestProtobufMethod();
 
+    void TestGroupCommit();
+
+    void TestFlushRetry();
+
+    void TestBatchWriteThread();
+
+    void TestConfigIndexGC();
+
     void TestScanCheckpoints();
 
     void TestExtractPrimaryKeyFromRangeKey();
@@ -58,6 +71,10 @@ public:
 
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestBaseMethod);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestProtobufMethod);
+UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestGroupCommit);
+UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestFlushRetry);
+UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestBatchWriteThread);
+UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestConfigIndexGC);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestScanCheckpoints);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestExtractPrimaryKeyFromRangeKey);
 UNIT_TEST_CASE(CheckpointManagerV2Unittest, TestMarkGC);
@@ -100,6 +117,186 @@ void CheckpointManagerV2Unittest::TestProtobufMethod() {
     }
 }
 
+void CheckpointManagerV2Unittest::TestGroupCommit() {
+    CheckpointManagerV2 m;
+    m.rebuild();
+
+    const std::string key = "test";
+    const std::string otherKey = "test_other";
+    std::string rValue;
+    const auto startSeq = m.GetLastWriteSeq();
+    EXPECT_TRUE(m.write(key, "value1"));
+    EXPECT_TRUE(m.write(key, "value2"));
+    EXPECT_TRUE(m.write(otherKey, "value"));
+    const auto seq = m.GetLastWriteSeq();
+    EXPECT_EQ(startSeq + 3, seq);
+    // Pending writes are coalesced by key and visible to read.
+    EXPECT_EQ(2U, m.mPendingWrites.size());
+    EXPECT_TRUE(m.read(key, rValue));
+    EXPECT_EQ("value2", rValue);
+    EXPECT_FALSE(m.readDatabase(key, rValue));
+
+    m.FlushPendingWrites(seq);
+    EXPECT_TRUE(m.mPendingWrites.empty());
+    EXPECT_EQ(seq, m.mFlushedSeq.load());
+    EXPECT_TRUE(m.readDatabase(key, rValue));
+    EXPECT_EQ("value2", rValue);
+    EXPECT_TRUE(m.readDatabase(otherKey, rValue));
+
+    // Writes which have been flushed are not flushed again.
+    EXPECT_TRUE(m.write(key, "value3"));
+    m.FlushPendingWrites(seq);
+    EXPECT_EQ(1U, m.mPendingWrites.size());
+
+    // Deletion drops pending writes of the key.
+    m.DeleteCheckpoints(std::vector<std::string>{key});
+    EXPECT_TRUE(m.mPendingWrites.empty());
+    EXPECT_FALSE(m.read(key, rValue));
+    m.FlushPendingWrites(m.GetLastWriteSeq());
+    EXPECT_FALSE(m.readDatabase(key, rValue));
+
+    // So does batch update of primary checkpoints.
+    PrimaryCheckpointPB cpt;
+    cpt.set_concurrency(kConcurrency);
+    cpt.set_config_name(kConfigName);
+    cpt.set_sig_hash(0);
+    cpt.set_sig_size(0);
+    cpt.set_log_path("pending");
+    EXPECT_TRUE(m.SetPB(kPrimaryKey, cpt));
+    std::pair<std::string, PrimaryCheckpointPB> updated{kPrimaryKey, cpt};
+    updated.second.set_log_path(kLogPath);
+    m.UpdatePrimaryCheckpoints({&updated});
+    m.FlushPendingWrites(m.GetLastWriteSeq());
+    PrimaryCheckpointPB rCpt;
+    EXPECT_TRUE(m.GetPB(kPrimaryKey, rCpt));
+    EXPECT_EQ(kLogPath, rCpt.log_path());
+}
+
+void CheckpointManagerV2Unittest::TestFlushRetry() {
+    CheckpointManagerV2 m;
+    m.rebuild();
+
+    const std::string key = "test";
+    std::string rValue;
+    EXPECT_TRUE(m.write(key, "value"));
+    const auto seq = m.GetLastWriteSeq();
+
+    // Writes failed to flush are kept and still visible.
+    m.close();
+    m.FlushPendingWrites(seq);
+    EXPECT_LT(m.mFlushedSeq.load(), seq);
+    EXPECT_EQ(1U, m.mPendingWrites.size());
+    EXPECT_TRUE(m.readPendingWrites(key, rValue));
+
+    EXPECT_TRUE(m.open());
+    m.FlushPendingWrites(seq);
+    EXPECT_EQ(seq, m.mFlushedSeq.load());
+    EXPECT_TRUE(m.mPendingWrites.empty());
+    EXPECT_TRUE(m.readDatabase(key, rValue));
+    EXPECT_EQ("value", rValue);
+}
+
+void CheckpointManagerV2Unittest::TestBatchWriteThread() {
+    auto bakInterval = INT32_FLAG(logtail_checkpoint_batch_write_interval_ms);
+    INT32_FLAG(logtail_checkpoint_batch_write_interval_ms) = 10;
+    {
+        CheckpointManagerV2 m;
+        m.rebuild();
+
+        const std::string key = "test";
+        std::string rValue;
+        EXPECT_TRUE(m.write(key, "value"));
+        for (int i = 0; i < 100 && !m.readDatabase(key, rValue); ++i) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        EXPECT_TRUE(m.readDatabase(key, rValue));
+        EXPECT_EQ("value", rValue);
+    }
+    {
+        // Interval 0 writes the database directly.
+        INT32_FLAG(logtail_checkpoint_batch_write_interval_ms) = 0;
+        CheckpointManagerV2 m;
+        m.rebuild();
+
+        const std::string key = "test_direct";
+        std::string rValue;
+        EXPECT_TRUE(m.write(key, "value"));
+        EXPECT_TRUE(m.readDatabase(key, rValue));
+        EXPECT_EQ(0U, m.GetLastWriteSeq());
+    }
+    INT32_FLAG(logtail_checkpoint_batch_write_interval_ms) = bakInterval;
+}
+
+// Test GC of checkpoints by config index, with a config name being the prefix of the other.
+void CheckpointManagerV2Unittest::TestConfigIndexGC() {
+    const std::string kOtherConfigName = kConfigName + "-a";
+    const std::string kOtherPrimaryKey = kOtherConfigName + "-/var/log/other.log-100-1001";
+    std::vector<std::string> configs{kConfigName, kOtherConfigName};
+
+    CheckpointManagerV2 m;
+    m.rebuild();
+
+    auto writeCheckpoints = [&](const std::string& configName, const std::string& primaryKey, time_t updateTime) {
+        PrimaryCheckpointPB cpt;
+        cpt.set_concurrency(kConcurrency);
+        cpt.set_config_name(configName);
+        cpt.set_sig_hash(0);
+        cpt.set_sig_size(0);
+        cpt.set_log_path(kLogPath);
+        cpt.set_update_time(updateTime);
+        EXPECT_TRUE(m.SetPB(primaryKey, cpt));
+        for (uint32_t idx = 0; idx < kConcurrency; ++idx) {
+            RangeCheckpointPB rgCpt;
+            rgCpt.set_hash_key(primaryKey + std::to_string(idx));
+            rgCpt.set_sequence_id(0);
+            rgCpt.set_read_offset(0);
+            rgCpt.set_read_length(0);
+            rgCpt.set_update_time(updateTime);
+            rgCpt.set_committed(false);
+            EXPECT_TRUE(m.SetPB(m.MakeRangeKey(primaryKey, idx), rgCpt));
+        }
+    };
+    writeCheckpoints(kConfigName, kPrimaryKey, time(NULL));
+    writeCheckpoints(kOtherConfigName, kOtherPrimaryKey, time(NULL));
+
+    // The first scan goes through the whole database and builds the index.
+    EXPECT_FALSE(m.mConfigIndexBuilt);
+    auto checkpoints = m.ScanCheckpoints(configs);
+    EXPECT_EQ(2U, checkpoints.size());
+    EXPECT_TRUE(m.mConfigIndexBuilt);
+    EXPECT_EQ(2U, m.mConfigIndex.size());
+    // Later scans go through the key range of each config, and keys of the other config sharing the prefix are not
+    //  taken as the config's.
+    checkpoints = m.ScanCheckpoints(configs);
+    EXPECT_EQ(2U, checkpoints.size());
+
+    // Checkpoints of configs whose last GC is not long ago are not scanned.
+    const auto expiredTime = time(NULL) - 100 - INT32_FLAG(logtail_checkpoint_expired_threshold_sec);
+    writeCheckpoints(kConfigName, kPrimaryKey, expiredTime);
+    m.FlushPendingWrites(m.GetLastWriteSeq());
+    m.gcConfigCheckpoints(1000);
+    std::string ignoreValue;
+    EXPECT_TRUE(m.read(kPrimaryKey, ignoreValue));
+
+    auto bakGCInterval = INT32_FLAG(logtail_checkpoint_config_gc_interval_sec);
+    INT32_FLAG(logtail_checkpoint_config_gc_interval_sec) = 0;
+    m.gcConfigCheckpoints(1000);
+    INT32_FLAG(logtail_checkpoint_config_gc_interval_sec) = bakGCInterval;
+
+    EXPECT_FALSE(m.read(kPrimaryKey, ignoreValue));
+    for (uint32_t idx = 0; idx < kConcurrency; ++idx) {
+        EXPECT_FALSE(m.read(m.MakeRangeKey(kPrimaryKey, idx), ignoreValue));
+    }
+    EXPECT_TRUE(m.read(kOtherPrimaryKey, ignoreValue));
+    for (uint32_t idx = 0; idx < kConcurrency; ++idx) {
+        EXPECT_TRUE(m.read(m.MakeRangeKey(kOtherPrimaryKey, idx), ignoreValue));
+    }
+    // The config having no checkpoint is removed from the index.
+    EXPECT_EQ(1U, m.mConfigIndex.size());
+    EXPECT_EQ(1U, m.mConfigIndex.count(kOtherConfigName));
+    EXPECT_TRUE(m.mConfigIndex[kOtherConfigName].mLastScannedKey.empty());
+}
+
 // Test checkpoints returned by ScanCheckpoints.
 void CheckpointManagerV2Unittest::TestScanCheckpoints() {
     std::vector<std::string> configs{kConfigName};
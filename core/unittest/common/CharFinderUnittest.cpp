@@ -0,0 +1,100 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common/CharFinder.h"
+#include "unittest/Unittest.h"
+
+namespace logtail {
+
+class CharFinderUnittest : public ::testing::Test {
+public:
+    void TestFindAllChars();
+    void TestImplementationsConsistent();
+
+private:
+    static std::vector<size_t> Expected(const std::string& s, size_t begin, char c) {
+        std::vector<size_t> res;
+        for (size_t i = begin; i < s.size(); ++i) {
+            if (s[i] == c) {
+                res.push_back(i - begin);
+            }
+        }
+        return res;
+    }
+};
+
+void CharFinderUnittest::TestFindAllChars() {
+    std::vector<size_t> offsets;
+    FindAllChars("", 0, '\n', offsets);
+    APSARA_TEST_TRUE(offsets.empty());
+
+    std::string s = "line1\nline2\n\nline4";
+    FindAllChars(s.data(), s.size(), '\n', offsets);
+    APSARA_TEST_EQUAL(std::vector<size_t>({5, 11, 12}), offsets);
+
+    // offsets are appended
+    FindAllChars(s.data(), s.size(), '4', offsets);
+    APSARA_TEST_EQUAL(std::vector<size_t>({5, 11, 12, 17}), offsets);
+
+    // chars with the high bit set
+    s = std::string(100, 'a') + "\xff" + std::string(50, 'b') + "\xff";
+    offsets.clear();
+    FindAllChars(s.data(), s.size(), '\xff', offsets);
+    APSARA_TEST_EQUAL(std::vector<size_t>({100, 151}), offsets);
+}
+
+void CharFinderUnittest::TestImplementationsConsistent() {
+    std::mt19937 rng(0);
+    for (size_t round = 0; round < 500; ++round) {
+        std::string s(rng() % 300, 'a');
+        for (auto& ch : s) {
+            if (rng() % 8 == 0) {
+                ch = '\n';
+            }
+        }
+        // unaligned begin
+        for (size_t begin = 0; begin < 4 && begin <= s.size(); ++begin) {
+            const char* data = s.data() + begin;
+            size_t size = s.size() - begin;
+            auto expected = Expected(s, begin, '\n');
+            std::vector<size_t> offsets;
+            FindAllChars(data, size, '\n', offsets);
+            APSARA_TEST_EQUAL(expected, offsets);
+            offsets.clear();
+            FindAllCharsScalar(data, size, '\n', offsets);
+            APSARA_TEST_EQUAL(expected, offsets);
+#ifdef LOGTAIL_CHAR_FINDER_X86
+            offsets.clear();
+            FindAllCharsSSE2(data, size, '\n', offsets);
+            APSARA_TEST_EQUAL(expected, offsets);
+            if (__builtin_cpu_supports("avx2")) {
+                offsets.clear();
+                FindAllCharsAVX2(data, size, '\n', offsets);
+                APSARA_TEST_EQUAL(expected, offsets);
+            }
+#endif
+        }
+    }
+}
+
+UNIT_TEST_CASE(CharFinderUnittest, TestFindAllChars)
+UNIT_TEST_CASE(CharFinderUnittest, TestImplementationsConsistent)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
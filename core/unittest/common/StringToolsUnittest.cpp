@@ -206,6 +206,42 @@ TEST_F(StringToolsUnittest, TestBoostRegexSearch) {
     }
 }
 
+TEST_F(StringToolsUnittest, TestGetRegexLiteralPrefix) {
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix(""));
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix(R"(\d+-\d+)"));
+    APSARA_TEST_EQUAL("[", GetRegexLiteralPrefix(R"(\[\d+-\d+-\d+\].*)"));
+    APSARA_TEST_EQUAL("[", GetRegexLiteralPrefix(R"(^\[\d+)"));
+    APSARA_TEST_EQUAL("INFO ", GetRegexLiteralPrefix("INFO .*"));
+    APSARA_TEST_EQUAL("2024-", GetRegexLiteralPrefix(R"(2024-\d{2})"));
+    APSARA_TEST_EQUAL("a.b", GetRegexLiteralPrefix(R"(a\.b(cd)?)"));
+    APSARA_TEST_EQUAL("abc", GetRegexLiteralPrefix("abc$"));
+    // quantified char
+    APSARA_TEST_EQUAL("ab", GetRegexLiteralPrefix("abc?d"));
+    APSARA_TEST_EQUAL("ab", GetRegexLiteralPrefix("abc*d"));
+    APSARA_TEST_EQUAL("ab", GetRegexLiteralPrefix("abc{0,2}d"));
+    APSARA_TEST_EQUAL("abc", GetRegexLiteralPrefix("abc+d"));
+    // alternation, inline modifier and special escapes
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix(R"(^(\[\d+-\d+-\d+\].*)|(\[\d+\].*))"));
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix("abc|def"));
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix("(?i)abc"));
+    APSARA_TEST_EQUAL("ab", GetRegexLiteralPrefix(R"(ab\<c)"));
+    APSARA_TEST_EQUAL("", GetRegexLiteralPrefix(R"(\Qabc\E)"));
+
+    // every line matched must start with the prefix
+    std::vector<std::string> patterns = {R"(\[\d+\].*)", "INFO .*", "abc+d", R"(2024-\d{2})"};
+    std::vector<std::string> lines = {"[123] x", "INFO x", "abccd", "2024-01", "[x] y", "INF", "abd", "2024-x"};
+    for (const auto& pattern : patterns) {
+        boost::regex reg(pattern);
+        std::string prefix = GetRegexLiteralPrefix(pattern);
+        for (const auto& line : lines) {
+            std::string exception;
+            if (BoostRegexSearch(line.data(), line.size(), reg, exception)) {
+                APSARA_TEST_TRUE(StartWith(line, prefix));
+            }
+        }
+    }
+}
+
 TEST_F(StringToolsUnittest, TestNormalizeTopicRegFormat) {
     { // Perl flavor
         std::string topicFormat(R"(/stdlog/(?<container_name>.*?)/(?<log_name>.*?))");
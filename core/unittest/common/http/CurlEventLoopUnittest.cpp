@@ -0,0 +1,136 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "curl/curl.h"
+
+#include "common/http/CurlEventLoop.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CurlEventLoopUnittest : public ::testing::Test {
+public:
+    void TestWaitTimeout();
+    void TestWakeup();
+    void TestTransfer();
+
+protected:
+    void SetUp() override { APSARA_TEST_TRUE_FATAL(mLoop.Init()); }
+    void TearDown() override { mLoop.Cleanup(); }
+
+    CurlEventLoop mLoop;
+};
+
+void CurlEventLoopUnittest::TestWaitTimeout() {
+    auto before = chrono::steady_clock::now();
+    mLoop.Wait(50);
+    auto elapsed = chrono::steady_clock::now() - before;
+    APSARA_TEST_TRUE(elapsed >= chrono::milliseconds(40));
+    APSARA_TEST_TRUE(elapsed < chrono::milliseconds(1000));
+    APSARA_TEST_EQUAL(0, mLoop.GetRunningHandles());
+}
+
+void CurlEventLoopUnittest::TestWakeup() {
+    thread t([this]() {
+        this_thread::sleep_for(chrono::milliseconds(50));
+        mLoop.Wakeup();
+    });
+    auto before = chrono::steady_clock::now();
+    mLoop.Wait(10000);
+    auto elapsed = chrono::steady_clock::now() - before;
+    t.join();
+    APSARA_TEST_TRUE(elapsed < chrono::seconds(5));
+}
+
+void CurlEventLoopUnittest::TestTransfer() {
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    APSARA_TEST_TRUE_FATAL(listenFd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    APSARA_TEST_EQUAL_FATAL(0, ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    APSARA_TEST_EQUAL_FATAL(0, listen(listenFd, 16));
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    int port = ntohs(addr.sin_port);
+
+    const size_t requestCnt = 8;
+    thread server([listenFd]() {
+        for (size_t i = 0; i < requestCnt; ++i) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            char buf[4096];
+            auto n = read(fd, buf, sizeof(buf));
+            (void)n;
+            string resp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+            n = write(fd, resp.data(), resp.size());
+            close(fd);
+        }
+    });
+
+    for (size_t i = 0; i < requestCnt; ++i) {
+        CURL* curl = curl_easy_init();
+        curl_easy_setopt(curl, CURLOPT_URL, ("http://127.0.0.1:" + to_string(port) + "/").c_str());
+        curl_easy_setopt(curl, CURLOPT_FORBID_REUSE, 1L);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char*, size_t size, size_t nmemb, void*) -> size_t {
+            return size * nmemb;
+        });
+        curl_multi_add_handle(mLoop.GetClient(), curl);
+    }
+
+    size_t completed = 0;
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (completed < requestCnt && chrono::steady_clock::now() < deadline) {
+        mLoop.Wait(1000);
+        int msgsLeft = 0;
+        while (CURLMsg* msg = curl_multi_info_read(mLoop.GetClient(), &msgsLeft)) {
+            if (msg->msg == CURLMSG_DONE) {
+                APSARA_TEST_EQUAL(CURLE_OK, msg->data.result);
+                long statusCode = 0;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &statusCode);
+                APSARA_TEST_EQUAL(200, statusCode);
+                curl_multi_remove_handle(mLoop.GetClient(), msg->easy_handle);
+                curl_easy_cleanup(msg->easy_handle);
+                ++completed;
+            }
+        }
+    }
+    APSARA_TEST_EQUAL(requestCnt, completed);
+    APSARA_TEST_EQUAL(0, mLoop.GetRunningHandles());
+
+    server.join();
+    close(listenFd);
+}
+
+UNIT_TEST_CASE(CurlEventLoopUnittest, TestWaitTimeout)
+UNIT_TEST_CASE(CurlEventLoopUnittest, TestWakeup)
+UNIT_TEST_CASE(CurlEventLoopUnittest, TestTransfer)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,312 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include "curl/curl.h"
+#include "openssl/evp.h"
+#include "openssl/ssl.h"
+#include "openssl/x509.h"
+
+#include "common/http/CurlEventLoop.h"
+#include "common/http/CurlHandlerPool.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class CurlHandlerPoolUnittest : public ::testing::Test {
+public:
+    void TestAcquireAndRelease();
+    void TestConnectionReuse();
+    void TestTlsSessionReuse();
+
+private:
+    // @return true if the request succeeds, and the number of new connections made for it is stored in connects.
+    bool Request(CurlEventLoop& loop, CURL* curl, const string& url, long& connects);
+};
+
+namespace {
+
+// A self-signed certificate for 127.0.0.1 generated on the fly, so that no key material is kept in the repo.
+bool InitTlsServerCtx(SSL_CTX* ctx) {
+    EVP_PKEY* pkey = nullptr;
+    EVP_PKEY_CTX* pctx = EVP_PKEY_CTX_new_id(EVP_PKEY_EC, nullptr);
+    if (pctx == nullptr || EVP_PKEY_keygen_init(pctx) <= 0
+        || EVP_PKEY_CTX_set_ec_paramgen_curve_nid(pctx, NID_X9_62_prime256v1) <= 0
+        || EVP_PKEY_keygen(pctx, &pkey) <= 0) {
+        EVP_PKEY_CTX_free(pctx);
+        return false;
+    }
+    EVP_PKEY_CTX_free(pctx);
+
+    X509* cert = X509_new();
+    X509_set_version(cert, 2);
+    ASN1_INTEGER_set(X509_get_serialNumber(cert), 1);
+    X509_gmtime_adj(X509_getm_notBefore(cert), -3600);
+    X509_gmtime_adj(X509_getm_notAfter(cert), 3600);
+    X509_set_pubkey(cert, pkey);
+    X509_NAME* name = X509_get_subject_name(cert);
+    X509_NAME_add_entry_by_txt(
+        name, "CN", MBSTRING_ASC, reinterpret_cast<const unsigned char*>("127.0.0.1"), -1, -1, 0);
+    X509_set_issuer_name(cert, name);
+    bool res = X509_sign(cert, pkey, EVP_sha256()) > 0 && SSL_CTX_use_certificate(ctx, cert) == 1
+        && SSL_CTX_use_PrivateKey(ctx, pkey) == 1;
+    X509_free(cert);
+    EVP_PKEY_free(pkey);
+    return res;
+}
+
+size_t DiscardBody(char*, size_t size, size_t nmemb, void*) {
+    return size * nmemb;
+}
+
+} // namespace
+
+void CurlHandlerPoolUnittest::TestAcquireAndRelease() {
+    CurlHandlerPool pool(2);
+    auto key1 = CurlHandlerPool::GetHostKey(true, "a.com", 443);
+    auto key2 = CurlHandlerPool::GetHostKey(false, "a.com", 443);
+    APSARA_TEST_NOT_EQUAL(key1, key2);
+
+    CURL* c1 = pool.Acquire(key1);
+    CURL* c2 = pool.Acquire(key1);
+    CURL* c3 = pool.Acquire(key1);
+    APSARA_TEST_TRUE(c1 != nullptr && c2 != nullptr && c3 != nullptr);
+    pool.Release(key1, c1);
+    pool.Release(key1, c2);
+    // the pool of the host is full, so c3 is destroyed
+    pool.Release(key1, c3);
+    APSARA_TEST_EQUAL(2U, pool.GetIdleHandlerCnt(key1));
+    APSARA_TEST_EQUAL(0U, pool.GetIdleHandlerCnt(key2));
+
+    // handlers are not shared between hosts
+    CURL* c4 = pool.Acquire(key2);
+    APSARA_TEST_TRUE(c4 != c1 && c4 != c2);
+    pool.Release(key2, c4);
+    CURL* c5 = pool.Acquire(key1);
+    APSARA_TEST_TRUE(c5 == c1 || c5 == c2);
+    APSARA_TEST_EQUAL(1U, pool.GetIdleHandlerCnt(key1));
+    pool.Release(key1, c5);
+
+    pool.Clear();
+    APSARA_TEST_EQUAL(0U, pool.GetIdleHandlerCnt(key1));
+    APSARA_TEST_EQUAL(0U, pool.GetIdleHandlerCnt(key2));
+}
+
+void CurlHandlerPoolUnittest::TestConnectionReuse() {
+    // a keep-alive http server standing in for the backend
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    APSARA_TEST_TRUE_FATAL(listenFd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    APSARA_TEST_EQUAL_FATAL(0, ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    APSARA_TEST_EQUAL_FATAL(0, listen(listenFd, 16));
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    int port = ntohs(addr.sin_port);
+
+    atomic_int acceptedCnt{0};
+    thread server([listenFd, &acceptedCnt]() {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) {
+            return;
+        }
+        ++acceptedCnt;
+        char buf[4096];
+        string resp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+        while (read(fd, buf, sizeof(buf)) > 0) {
+            if (write(fd, resp.data(), resp.size()) < 0) {
+                break;
+            }
+        }
+        close(fd);
+    });
+
+    CurlEventLoop loop;
+    APSARA_TEST_TRUE_FATAL(loop.Init());
+    CurlHandlerPool pool(4);
+    auto key = CurlHandlerPool::GetHostKey(false, "127.0.0.1", port);
+    const int requestCnt = 5;
+    for (int i = 0; i < requestCnt; ++i) {
+        CURL* curl = pool.Acquire(key);
+        curl_easy_setopt(curl, CURLOPT_URL, ("http://127.0.0.1:" + to_string(port) + "/").c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, +[](char*, size_t size, size_t nmemb, void*) -> size_t {
+            return size * nmemb;
+        });
+        curl_multi_add_handle(loop.GetClient(), curl);
+
+        bool done = false;
+        auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+        while (!done && chrono::steady_clock::now() < deadline) {
+            loop.Wait(1000);
+            int msgsLeft = 0;
+            while (CURLMsg* msg = curl_multi_info_read(loop.GetClient(), &msgsLeft)) {
+                if (msg->msg != CURLMSG_DONE) {
+                    continue;
+                }
+                APSARA_TEST_EQUAL(CURLE_OK, msg->data.result);
+                long connects = -1;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_NUM_CONNECTS, &connects);
+                // only the first request needs a new connection
+                APSARA_TEST_EQUAL(i == 0 ? 1 : 0, connects);
+                curl_multi_remove_handle(loop.GetClient(), msg->easy_handle);
+                pool.Release(key, msg->easy_handle);
+                done = true;
+            }
+        }
+        APSARA_TEST_TRUE(done);
+        APSARA_TEST_EQUAL(1U, pool.GetIdleHandlerCnt(key));
+    }
+    APSARA_TEST_EQUAL(1, acceptedCnt.load());
+
+    // closing the connection lets the server exit
+    loop.Cleanup();
+    pool.Clear();
+    server.join();
+    close(listenFd);
+}
+
+bool CurlHandlerPoolUnittest::Request(CurlEventLoop& loop, CURL* curl, const string& url, long& connects) {
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, DiscardBody);
+    // the certificate of the test server is self-signed
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYPEER, 0L);
+    curl_easy_setopt(curl, CURLOPT_SSL_VERIFYHOST, 0L);
+    curl_multi_add_handle(loop.GetClient(), curl);
+
+    bool res = false;
+    bool done = false;
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(10);
+    while (!done && chrono::steady_clock::now() < deadline) {
+        loop.Wait(1000);
+        int msgsLeft = 0;
+        while (CURLMsg* msg = curl_multi_info_read(loop.GetClient(), &msgsLeft)) {
+            if (msg->msg != CURLMSG_DONE) {
+                continue;
+            }
+            res = msg->data.result == CURLE_OK;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_NUM_CONNECTS, &connects);
+            curl_multi_remove_handle(loop.GetClient(), msg->easy_handle);
+            done = true;
+        }
+    }
+    return res;
+}
+
+void CurlHandlerPoolUnittest::TestTlsSessionReuse() {
+    SSL_CTX* ctx = SSL_CTX_new(TLS_server_method());
+    APSARA_TEST_TRUE_FATAL(ctx != nullptr);
+    APSARA_TEST_TRUE_FATAL(InitTlsServerCtx(ctx));
+
+    int listenFd = socket(AF_INET, SOCK_STREAM, 0);
+    APSARA_TEST_TRUE_FATAL(listenFd >= 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port = 0;
+    APSARA_TEST_EQUAL_FATAL(0, ::bind(listenFd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)));
+    APSARA_TEST_EQUAL_FATAL(0, listen(listenFd, 16));
+    socklen_t len = sizeof(addr);
+    getsockname(listenFd, reinterpret_cast<sockaddr*>(&addr), &len);
+    int port = ntohs(addr.sin_port);
+
+    // The first connection is kept alive for 2 requests and the second one serves 1 request, so that the last request
+    // has to make a new connection.
+    const int connCnt = 2;
+    atomic_int handshakeCnt{0};
+    atomic_int resumedCnt{0};
+    thread server([listenFd, ctx, &handshakeCnt, &resumedCnt]() {
+        for (int i = 0; i < connCnt; ++i) {
+            int fd = accept(listenFd, nullptr, nullptr);
+            if (fd < 0) {
+                return;
+            }
+            SSL* ssl = SSL_new(ctx);
+            SSL_set_fd(ssl, fd);
+            if (SSL_accept(ssl) == 1) {
+                ++handshakeCnt;
+                if (SSL_session_reused(ssl)) {
+                    ++resumedCnt;
+                }
+                const string keepAliveResp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+                const string closeResp = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\nConnection: close\r\n\r\nok";
+                char buf[4096];
+                const int requestCnt = i == 0 ? 2 : 1;
+                for (int served = 0; served < requestCnt; ++served) {
+                    const string& resp = served + 1 == requestCnt ? closeResp : keepAliveResp;
+                    if (SSL_read(ssl, buf, sizeof(buf)) <= 0
+                        || SSL_write(ssl, resp.data(), static_cast<int>(resp.size())) <= 0) {
+                        break;
+                    }
+                }
+                SSL_shutdown(ssl);
+            }
+            SSL_free(ssl);
+            close(fd);
+        }
+    });
+
+    CurlEventLoop loop;
+    APSARA_TEST_TRUE_FATAL(loop.Init());
+    CurlHandlerPool pool(4);
+    auto key = CurlHandlerPool::GetHostKey(true, "127.0.0.1", port);
+    const string url = "https://127.0.0.1:" + to_string(port) + "/";
+    long connects = -1;
+
+    // the connection of the first request is cached by the multi handle and reused by the second one
+    CURL* c1 = pool.Acquire(key);
+    APSARA_TEST_TRUE(Request(loop, c1, url, connects));
+    APSARA_TEST_EQUAL(1, connects);
+    pool.Release(key, c1);
+    c1 = pool.Acquire(key);
+    APSARA_TEST_TRUE(Request(loop, c1, url, connects));
+    APSARA_TEST_EQUAL(0, connects);
+
+    // A different handler has to connect again once the server closes the connection, and it resumes the tls session
+    // of the first handler through the share handle.
+    CURL* c2 = pool.Acquire(key);
+    APSARA_TEST_TRUE(c1 != c2);
+    APSARA_TEST_TRUE(Request(loop, c2, url, connects));
+    APSARA_TEST_EQUAL(1, connects);
+    pool.Release(key, c1);
+    pool.Release(key, c2);
+
+    loop.Cleanup();
+    pool.Clear();
+    server.join();
+    close(listenFd);
+    SSL_CTX_free(ctx);
+    APSARA_TEST_EQUAL(connCnt, handshakeCnt.load());
+    APSARA_TEST_EQUAL(1, resumedCnt.load());
+}
+
+UNIT_TEST_CASE(CurlHandlerPoolUnittest, TestAcquireAndRelease)
+UNIT_TEST_CASE(CurlHandlerPoolUnittest, TestConnectionReuse)
+UNIT_TEST_CASE(CurlHandlerPoolUnittest, TestTlsSessionReuse)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "common/timer/Timer.h"
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+struct BenchmarkTimerEvent : public TimerEvent {
+    BenchmarkTimerEvent(const chrono::steady_clock::time_point& execTime, atomic<size_t>* cnt)
+        : TimerEvent(execTime), mCnt(cnt) {}
+
+    bool IsValid() const override { return true; }
+    bool Execute() override {
+        if (mCnt) {
+            mCnt->fetch_add(1, memory_order_relaxed);
+        }
+        return true;
+    }
+
+    atomic<size_t>* mCnt = nullptr;
+};
+
+class TimerBenchmark : public testing::Test {
+public:
+    void TestPushAndPop();
+    void TestTimerThroughput();
+
+protected:
+    static constexpr size_t kEventCnt = 200000;
+
+    static vector<chrono::steady_clock::time_point> MakeExecTimes(chrono::steady_clock::time_point start) {
+        // scrape schedulers with intervals from 1s to 60s, spread by the hash of the target
+        mt19937 gen(0);
+        uniform_int_distribution<int64_t> dist(0, 60 * 1000);
+        vector<chrono::steady_clock::time_point> res;
+        res.reserve(kEventCnt);
+        for (size_t i = 0; i < kEventCnt; ++i) {
+            res.push_back(start + chrono::milliseconds(dist(gen)));
+        }
+        return res;
+    }
+};
+
+/*
+[ RUN      ] TimerBenchmark.TestPushAndPop
+push 200000 events: 0.00368859 seconds
+pop 200000 events: 0.0123265 seconds
+*/
+void TimerBenchmark::TestPushAndPop() {
+    auto start = chrono::steady_clock::now();
+    auto execTimes = MakeExecTimes(start);
+    vector<unique_ptr<TimerEvent>> events;
+    events.reserve(kEventCnt);
+    for (const auto& t : execTimes) {
+        events.emplace_back(make_unique<BenchmarkTimerEvent>(t, nullptr));
+    }
+
+    TimingWheel wheel(start);
+    auto before = chrono::high_resolution_clock::now();
+    for (auto& e : events) {
+        wheel.Push(std::move(e));
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - before;
+    cout << "push " << kEventCnt << " events: " << elapsed.count() << " seconds" << endl;
+    APSARA_TEST_EQUAL(kEventCnt, wheel.Size());
+
+    // turn the wheel as the timer thread does
+    events.clear();
+    before = chrono::high_resolution_clock::now();
+    auto now = start;
+    while (!wheel.Empty()) {
+        now = wheel.GetNextTurnTime();
+        wheel.PopExpired(now, events);
+    }
+    elapsed = chrono::high_resolution_clock::now() - before;
+    cout << "pop " << kEventCnt << " events: " << elapsed.count() << " seconds" << endl;
+    APSARA_TEST_EQUAL(kEventCnt, events.size());
+}
+
+/*
+[ RUN      ] TimerBenchmark.TestTimerThroughput
+push 200000 events from 4 threads: 0.0262457 seconds
+execute 200000 events: 1.01581 seconds
+*/
+void TimerBenchmark::TestTimerThroughput() {
+    atomic<size_t> cnt{0};
+    Timer timer;
+    timer.Init();
+
+    // all events expire within 1 second
+    auto start = chrono::steady_clock::now() + chrono::milliseconds(10);
+    size_t threadCnt = 4;
+    vector<thread> threads;
+    auto before = chrono::high_resolution_clock::now();
+    for (size_t i = 0; i < threadCnt; ++i) {
+        threads.emplace_back([&, i]() {
+            mt19937 gen(i);
+            uniform_int_distribution<int64_t> dist(0, 1000);
+            for (size_t j = 0; j < kEventCnt / threadCnt; ++j) {
+                timer.PushEvent(make_unique<BenchmarkTimerEvent>(start + chrono::milliseconds(dist(gen)), &cnt));
+            }
+        });
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    chrono::duration<double> elapsed = chrono::high_resolution_clock::now() - before;
+    cout << "push " << kEventCnt << " events from " << threadCnt << " threads: " << elapsed.count() << " seconds"
+         << endl;
+
+    while (cnt.load() < kEventCnt && chrono::high_resolution_clock::now() - before < chrono::seconds(10)) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    elapsed = chrono::high_resolution_clock::now() - before;
+    cout << "execute " << kEventCnt << " events: " << elapsed.count() << " seconds" << endl;
+    timer.Stop();
+    APSARA_TEST_EQUAL(kEventCnt, cnt.load());
+}
+
+UNIT_TEST_CASE(TimerBenchmark, TestPushAndPop)
+UNIT_TEST_CASE(TimerBenchmark, TestTimerThroughput)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <mutex>
+#include <thread>
 #include <vector>
 
 #include "common/timer/Timer.h"
@@ -30,9 +32,27 @@ struct TimerEventMock : public TimerEvent {
     bool mIsValid = false;
 };
 
+struct RecordTimerEventMock : public TimerEvent {
+    RecordTimerEventMock(const chrono::steady_clock::time_point& execTime, int id, mutex& mux, vector<int>& record)
+        : TimerEvent(execTime), mId(id), mMux(mux), mRecord(record) {}
+
+    bool IsValid() const override { return mId >= 0; }
+    bool Execute() {
+        lock_guard<mutex> lock(mMux);
+        mRecord.push_back(mId);
+        return true;
+    }
+
+    int mId;
+    mutex& mMux;
+    vector<int>& mRecord;
+};
+
 class TimerUnittest : public ::testing::Test {
 public:
     void TestPushEvent();
+    void TestPushEvents();
+    void TestRun();
     void TestPeriodicEvent();
 
 private:
@@ -47,16 +67,56 @@ void TimerUnittest::TestPushEvent() {
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(1)));
     timer.PushEvent(make_unique<TimerEventMock>(now + chrono::seconds(3)));
 
-    APSARA_TEST_EQUAL(3U, timer.mQueue.size());
-    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
-    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mQueue.top()->GetExecTime());
-    timer.mQueue.pop();
+    APSARA_TEST_EQUAL(3U, timer.mWheel.Size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mWheel.Top()->GetExecTime());
+    timer.mWheel.Pop();
+    APSARA_TEST_EQUAL(now + chrono::seconds(2), timer.mWheel.Top()->GetExecTime());
+    timer.mWheel.Pop();
+    APSARA_TEST_EQUAL(now + chrono::seconds(3), timer.mWheel.Top()->GetExecTime());
+    timer.mWheel.Pop();
+    APSARA_TEST_TRUE(timer.mWheel.Empty());
+}
+
+void TimerUnittest::TestPushEvents() {
+    auto now = chrono::steady_clock::now();
+    Timer timer;
+    vector<unique_ptr<TimerEvent>> events;
+    for (int i = 0; i < 10; ++i) {
+        events.emplace_back(make_unique<TimerEventMock>(now + chrono::seconds(10 - i)));
+    }
+    timer.PushEvents(std::move(events));
+    APSARA_TEST_TRUE(events.empty());
+    APSARA_TEST_EQUAL(10U, timer.mWheel.Size());
+    APSARA_TEST_EQUAL(now + chrono::seconds(1), timer.mWheel.Top()->GetExecTime());
+}
+
+void TimerUnittest::TestRun() {
+    auto now = chrono::steady_clock::now();
+    mutex mux;
+    vector<int> record;
+    Timer timer;
+    timer.Init();
+    timer.PushEvent(make_unique<RecordTimerEventMock>(now + chrono::milliseconds(300), 3, mux, record));
+    timer.PushEvent(make_unique<RecordTimerEventMock>(now + chrono::milliseconds(100), 1, mux, record));
+    // cancelled
+    timer.PushEvent(make_unique<RecordTimerEventMock>(now + chrono::milliseconds(150), -1, mux, record));
+    timer.PushEvent(make_unique<RecordTimerEventMock>(now + chrono::milliseconds(200), 2, mux, record));
+    // already expired
+    timer.PushEvent(make_unique<RecordTimerEventMock>(now - chrono::seconds(1), 0, mux, record));
+    this_thread::sleep_for(chrono::milliseconds(50));
+    {
+        lock_guard<mutex> lock(mux);
+        APSARA_TEST_EQUAL(vector<int>({0}), record);
+    }
+    this_thread::sleep_for(chrono::milliseconds(500));
+    timer.Stop();
+    lock_guard<mutex> lock(mux);
+    APSARA_TEST_EQUAL(vector<int>({0, 1, 2, 3}), record);
 }
 
 UNIT_TEST_CASE(TimerUnittest, TestPushEvent)
+UNIT_TEST_CASE(TimerUnittest, TestPushEvents)
+UNIT_TEST_CASE(TimerUnittest, TestRun)
 
 
 } // namespace logtail
@@ -0,0 +1,172 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "common/timer/TimingWheel.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+struct TimingWheelEventMock : public TimerEvent {
+    TimingWheelEventMock(const chrono::steady_clock::time_point& execTime, int id) : TimerEvent(execTime), mId(id) {}
+
+    bool IsValid() const override { return true; }
+    bool Execute() override { return true; }
+
+    int mId;
+};
+
+class TimingWheelUnittest : public ::testing::Test {
+public:
+    void TestPopExpired();
+    void TestSubMillisecond();
+    void TestFarFuture();
+    void TestGetNextTurnTime();
+    void TestRandomEvents();
+
+protected:
+    void SetUp() override { mStart = chrono::steady_clock::now(); }
+
+    vector<int> PopIds(TimingWheel& wheel, chrono::steady_clock::time_point now) {
+        vector<unique_ptr<TimerEvent>> res;
+        wheel.PopExpired(now, res);
+        vector<int> ids;
+        for (const auto& e : res) {
+            ids.push_back(static_cast<const TimingWheelEventMock*>(e.get())->mId);
+        }
+        return ids;
+    }
+
+    chrono::steady_clock::time_point mStart;
+};
+
+void TimingWheelUnittest::TestPopExpired() {
+    TimingWheel wheel(mStart);
+    vector<int64_t> offsetsMs = {5000, 1, 63, 64, 65, 4095, 4096, 4097, 0, 300000};
+    for (size_t i = 0; i < offsetsMs.size(); ++i) {
+        wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::milliseconds(offsetsMs[i]), i));
+    }
+    APSARA_TEST_EQUAL(offsetsMs.size(), wheel.Size());
+
+    APSARA_TEST_EQUAL(vector<int>({8}), PopIds(wheel, mStart));
+    APSARA_TEST_EQUAL(vector<int>({1}), PopIds(wheel, mStart + chrono::milliseconds(62)));
+    APSARA_TEST_EQUAL(vector<int>({2, 3}), PopIds(wheel, mStart + chrono::milliseconds(64)));
+    APSARA_TEST_EQUAL(vector<int>({4}), PopIds(wheel, mStart + chrono::milliseconds(4094)));
+    APSARA_TEST_EQUAL(vector<int>({5, 6, 7}), PopIds(wheel, mStart + chrono::milliseconds(4097)));
+    APSARA_TEST_EQUAL(vector<int>(), PopIds(wheel, mStart + chrono::milliseconds(4999)));
+    APSARA_TEST_EQUAL(vector<int>({0}), PopIds(wheel, mStart + chrono::milliseconds(5000)));
+    APSARA_TEST_EQUAL(1U, wheel.Size());
+    APSARA_TEST_EQUAL(vector<int>({9}), PopIds(wheel, mStart + chrono::hours(1)));
+    APSARA_TEST_TRUE(wheel.Empty());
+
+    // pushed after expired
+    wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::seconds(1), 10));
+    APSARA_TEST_EQUAL(mStart + chrono::hours(1), wheel.GetNextTurnTime());
+    APSARA_TEST_EQUAL(vector<int>({10}), PopIds(wheel, mStart + chrono::hours(1)));
+}
+
+void TimingWheelUnittest::TestSubMillisecond() {
+    TimingWheel wheel(mStart);
+    wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::microseconds(1500), 0));
+    APSARA_TEST_EQUAL(vector<int>(), PopIds(wheel, mStart + chrono::microseconds(1999)));
+    APSARA_TEST_EQUAL(vector<int>({0}), PopIds(wheel, mStart + chrono::milliseconds(2)));
+}
+
+void TimingWheelUnittest::TestFarFuture() {
+    TimingWheel wheel(mStart);
+    // longer than the range of the wheel
+    auto execTime = mStart + chrono::hours(24 * 30);
+    wheel.Push(make_unique<TimingWheelEventMock>(execTime, 0));
+    auto now = mStart;
+    while (now < execTime - chrono::hours(1)) {
+        now += chrono::hours(1);
+        APSARA_TEST_EQUAL(vector<int>(), PopIds(wheel, now));
+    }
+    APSARA_TEST_EQUAL(vector<int>(), PopIds(wheel, execTime - chrono::milliseconds(1)));
+    APSARA_TEST_EQUAL(vector<int>({0}), PopIds(wheel, execTime));
+}
+
+void TimingWheelUnittest::TestGetNextTurnTime() {
+    TimingWheel wheel(mStart);
+    APSARA_TEST_EQUAL(chrono::steady_clock::time_point::max(), wheel.GetNextTurnTime());
+    wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::milliseconds(5), 0));
+    APSARA_TEST_EQUAL(mStart + chrono::milliseconds(5), wheel.GetNextTurnTime());
+    // in level 1, turned at the beginning of its slot
+    wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::milliseconds(100), 1));
+    APSARA_TEST_EQUAL(vector<int>({0}), PopIds(wheel, wheel.GetNextTurnTime()));
+    APSARA_TEST_EQUAL(mStart + chrono::milliseconds(64), wheel.GetNextTurnTime());
+    APSARA_TEST_EQUAL(vector<int>(), PopIds(wheel, wheel.GetNextTurnTime()));
+    APSARA_TEST_EQUAL(mStart + chrono::milliseconds(100), wheel.GetNextTurnTime());
+    APSARA_TEST_EQUAL(vector<int>({1}), PopIds(wheel, wheel.GetNextTurnTime()));
+    APSARA_TEST_EQUAL(chrono::steady_clock::time_point::max(), wheel.GetNextTurnTime());
+
+    wheel.Clear();
+    wheel.Push(make_unique<TimingWheelEventMock>(mStart, 2));
+    APSARA_TEST_TRUE(wheel.GetNextTurnTime() <= mStart + chrono::milliseconds(100));
+}
+
+void TimingWheelUnittest::TestRandomEvents() {
+    TimingWheel wheel(mStart);
+    mt19937 gen(0);
+    uniform_int_distribution<int64_t> execDist(0, 3600 * 1000);
+    vector<int64_t> execTimesMs;
+    for (int i = 0; i < 10000; ++i) {
+        execTimesMs.push_back(execDist(gen));
+        wheel.Push(make_unique<TimingWheelEventMock>(mStart + chrono::milliseconds(execTimesMs.back()), i));
+    }
+
+    uniform_int_distribution<int64_t> stepDist(0, 10 * 1000);
+    vector<bool> popped(execTimesMs.size(), false);
+    size_t poppedCnt = 0;
+    int64_t nowMs = 0;
+    while (poppedCnt < execTimesMs.size()) {
+        int64_t nextTurnMs
+            = chrono::duration_cast<chrono::milliseconds>(wheel.GetNextTurnTime() - mStart).count();
+        // the wheel must be turned before any event expires
+        for (size_t i = 0; i < execTimesMs.size(); ++i) {
+            if (!popped[i]) {
+                APSARA_TEST_TRUE_FATAL(nextTurnMs <= execTimesMs[i]);
+            }
+        }
+        nowMs = gen() % 2 ? nextTurnMs : nowMs + stepDist(gen);
+        int64_t lastExecTimeMs = 0;
+        for (auto id : PopIds(wheel, mStart + chrono::milliseconds(nowMs))) {
+            APSARA_TEST_FALSE_FATAL(popped[id]);
+            APSARA_TEST_TRUE_FATAL(execTimesMs[id] <= nowMs);
+            APSARA_TEST_TRUE_FATAL(lastExecTimeMs <= execTimesMs[id]);
+            lastExecTimeMs = execTimesMs[id];
+            popped[id] = true;
+            ++poppedCnt;
+        }
+        for (size_t i = 0; i < execTimesMs.size(); ++i) {
+            APSARA_TEST_TRUE_FATAL(popped[i] || execTimesMs[i] > nowMs);
+        }
+        APSARA_TEST_EQUAL_FATAL(execTimesMs.size() - poppedCnt, wheel.Size());
+    }
+}
+
+UNIT_TEST_CASE(TimingWheelUnittest, TestPopExpired)
+UNIT_TEST_CASE(TimingWheelUnittest, TestSubMillisecond)
+UNIT_TEST_CASE(TimingWheelUnittest, TestFarFuture)
+UNIT_TEST_CASE(TimingWheelUnittest, TestGetNextTurnTime)
+UNIT_TEST_CASE(TimingWheelUnittest, TestRandomEvents)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
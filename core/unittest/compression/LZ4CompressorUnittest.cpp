@@ -22,6 +22,7 @@ namespace logtail {
 class LZ4CompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestStreamCompress();
 };
 
 void LZ4CompressorUnittest::TestCompress() {
@@ -36,7 +37,18 @@ void LZ4CompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void LZ4CompressorUnittest::TestStreamCompress() {
+    // lz4 block format can only be produced in one shot
+    LZ4Compressor compressor(CompressType::LZ4);
+    APSARA_TEST_FALSE(compressor.IsStreamSupported());
+    string output, errorMsg;
+    APSARA_TEST_FALSE(compressor.DoStartStream(100, output, errorMsg));
+    APSARA_TEST_FALSE(compressor.DoAppendStream(StringView("hello"), output, errorMsg));
+    APSARA_TEST_FALSE(compressor.DoFinishStream(output, errorMsg));
+}
+
 UNIT_TEST_CASE(LZ4CompressorUnittest, TestCompress)
+UNIT_TEST_CASE(LZ4CompressorUnittest, TestStreamCompress)
 
 } // namespace logtail
 
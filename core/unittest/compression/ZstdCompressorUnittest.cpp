@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "zstd/zstd.h"
+
 #include "common/compression/ZstdCompressor.h"
 #include "unittest/Unittest.h"
 
@@ -22,6 +24,7 @@ namespace logtail {
 class ZstdCompressorUnittest : public ::testing::Test {
 public:
     void TestCompress();
+    void TestStreamCompress();
 };
 
 void ZstdCompressorUnittest::TestCompress() {
@@ -36,7 +39,36 @@ void ZstdCompressorUnittest::TestCompress() {
     APSARA_TEST_EQUAL(input, decompressed);
 }
 
+void ZstdCompressorUnittest::TestStreamCompress() {
+    ZstdCompressor compressor(CompressType::ZSTD);
+    string input;
+    for (size_t i = 0; i < 10000; ++i) {
+        input += "hello world " + to_string(i) + "\n";
+    }
+    APSARA_TEST_TRUE(compressor.IsStreamSupported());
+    string output;
+    string errorMsg;
+    APSARA_TEST_TRUE(compressor.DoStartStream(input.size(), output, errorMsg));
+    for (size_t pos = 0; pos < input.size(); pos += 1000) {
+        APSARA_TEST_TRUE(compressor.DoAppendStream(
+            StringView(input.data() + pos, min<size_t>(1000, input.size() - pos)), output, errorMsg));
+    }
+    APSARA_TEST_TRUE(compressor.DoFinishStream(output, errorMsg));
+    // a single frame with content size known in advance
+    APSARA_TEST_EQUAL(input.size(), ZSTD_getFrameContentSize(output.data(), output.size()));
+    string decompressed;
+    decompressed.resize(input.size());
+    APSARA_TEST_TRUE(compressor.UnCompress(output, decompressed, errorMsg));
+    APSARA_TEST_EQUAL(input, decompressed);
+
+    // input size mismatch
+    APSARA_TEST_TRUE(compressor.DoStartStream(input.size() + 1, output, errorMsg));
+    APSARA_TEST_TRUE(compressor.DoAppendStream(input, output, errorMsg));
+    APSARA_TEST_FALSE(compressor.DoFinishStream(output, errorMsg));
+}
+
 UNIT_TEST_CASE(ZstdCompressorUnittest, TestCompress)
+UNIT_TEST_CASE(ZstdCompressorUnittest, TestStreamCompress)
 
 } // namespace logtail
 
@@ -18,6 +18,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "common/FileSystemUtil.h"
 #include "common/Flags.h"
@@ -64,10 +65,37 @@ public:
         Event* ev = LogInput::GetInstance()->PopEventQueue();
         delete ev;
     }
+
+    void TestRequeueEventsToFront() {
+        LOG_INFO(sLogger, ("TestRequeueEventsToFront() begin", time(NULL)));
+        LogInput* logInput = LogInput::GetInstance();
+        Event* event0 = new Event("/source", "object0", EVENT_MODIFY, 0);
+        Event* event1 = new Event("/source", "object1", EVENT_DELETE, 0);
+        logInput->PushEventQueue(event0);
+        logInput->PushEventQueue(event1);
+        vector<Event*> events;
+        logInput->PopEventQueue(events, 2);
+        APSARA_TEST_EQUAL_FATAL(2U, events.size());
+
+        // events queued while the batch is interrupted must go after the unprocessed rest of the batch
+        Event* event2 = new Event("/source", "object1", EVENT_CREATE, 0);
+        logInput->PushEventQueue(event2);
+        logInput->RequeueEventsToFront(events);
+        APSARA_TEST_EQUAL_FATAL(logInput->mInotifyEventQueue.size(), 3L);
+        // the requeued modify event still deduplicates later ones
+        logInput->PushEventQueue(new Event("/source", "object0", EVENT_MODIFY, 0));
+        APSARA_TEST_EQUAL_FATAL(logInput->mInotifyEventQueue.size(), 3L);
+        for (Event* expected : {event0, event1, event2}) {
+            Event* ev = logInput->PopEventQueue();
+            APSARA_TEST_EQUAL_FATAL(ev, expected);
+            delete ev;
+        }
+    }
 };
 
 APSARA_UNIT_TEST_CASE(LogInputUnittest, TestTryReadEventsPollingEvents, 0);
 APSARA_UNIT_TEST_CASE(LogInputUnittest, TestTryReadEventsDuplicatedEvents, 0);
+APSARA_UNIT_TEST_CASE(LogInputUnittest, TestRequeueEventsToFront, 0);
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
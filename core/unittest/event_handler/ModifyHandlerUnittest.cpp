@@ -29,6 +29,7 @@
 #include "file_server/FileServer.h"
 #include "file_server/event/Event.h"
 #include "file_server/event_handler/EventHandler.h"
+#include "file_server/event_handler/LogInput.h"
 #include "file_server/reader/LogFileReader.h"
 #include "unittest/Unittest.h"
 #include "unittest/UnittestHelper.h"
@@ -37,6 +38,7 @@ using namespace std;
 
 DECLARE_FLAG_STRING(ilogtail_config);
 DECLARE_FLAG_INT32(default_tail_limit_kb);
+DECLARE_FLAG_INT32(log_input_reader_thread_count);
 
 namespace logtail {
 class ModifyHandlerUnittest : public ::testing::Test {
@@ -52,6 +54,8 @@ public:
     void TestHandleModifyEventWhenContainerRestartCase5();
     void TestHandleModifyEventWhenContainerRestartCase6();
     void TestHandleModifyEvnetWhenContainerStopTwice();
+    void TestHandleModifyEventWithReaderThreads();
+    void TestPushGroupWithLimitedRetries();
 
 protected:
     static void SetUpTestCase() {
@@ -232,6 +236,8 @@ UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartC
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartCase5);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWhenContainerRestartCase6);
 UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEvnetWhenContainerStopTwice);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestHandleModifyEventWithReaderThreads);
+UNIT_TEST_CASE(ModifyHandlerUnittest, TestPushGroupWithLimitedRetries);
 
 void ModifyHandlerUnittest::TestHandleContainerStoppedEventWhenReadToEnd() {
     LOG_INFO(sLogger, ("TestHandleContainerStoppedEventWhenReadToEnd() begin", time(NULL)));
@@ -535,6 +541,49 @@ void ModifyHandlerUnittest::TestHandleModifyEvnetWhenContainerStopTwice() {
     APSARA_TEST_EQUAL_FATAL(mReaderPtr->mContainerID, "2");
 }
 
+void ModifyHandlerUnittest::TestHandleModifyEventWithReaderThreads() {
+    LOG_INFO(sLogger, ("TestHandleModifyEventWithReaderThreads() begin", time(NULL)));
+    INT32_FLAG(log_input_reader_thread_count) = 2;
+    auto logInput = LogInput::GetInstance();
+    logInput->StartReaderThreads();
+    logInput->mIsCollectingReadTasks = true;
+    mReaderPtr->SetContainerStopped();
+
+    Event event(gRootDir, gLogName, EVENT_MODIFY, 0, 0, mReaderPtr->mDevInode.dev, mReaderPtr->mDevInode.inode);
+    event.SetContainerID("1");
+    mHandlerPtr->Handle(event);
+    // the file is not read until the batch is flushed
+    APSARA_TEST_EQUAL(1U, logInput->mReadTasks.size());
+    APSARA_TEST_TRUE(mReaderPtr->mLogFileOp.IsOpen());
+    // the same file is not read twice in a batch, the event is handled in the next batch
+    mHandlerPtr->Handle(event);
+    APSARA_TEST_EQUAL(1U, logInput->mReadTasks.size());
+    APSARA_TEST_EQUAL(1U, logInput->mInotifyEventQueue.size());
+
+    logInput->FlushReadTasks();
+    APSARA_TEST_TRUE(logInput->mReadTasks.empty());
+    APSARA_TEST_TRUE(logInput->mReadTaskKeys.empty());
+    APSARA_TEST_TRUE(mReaderPtr->IsReadToEnd());
+    APSARA_TEST_TRUE(!mReaderPtr->mLogFileOp.IsOpen());
+
+    logInput->mIsCollectingReadTasks = false;
+    logInput->StopReaderThreads();
+    delete logInput->PopEventQueue();
+    INT32_FLAG(log_input_reader_thread_count) = 1;
+}
+
+void ModifyHandlerUnittest::TestPushGroupWithLimitedRetries() {
+    LOG_INFO(sLogger, ("TestPushGroupWithLimitedRetries() begin", time(NULL)));
+    // no process queue, so pushing always fails
+    ProcessQueueManager::GetInstance()->Clear();
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.AddLogEvent();
+    unique_ptr<PipelineEventGroup> unpushedGroup;
+    APSARA_TEST_EQUAL(10, mHandlerPtr->PushGroupToProcessor(mReaderPtr, std::move(group), &unpushedGroup));
+    APSARA_TEST_TRUE_FATAL(unpushedGroup != nullptr);
+    APSARA_TEST_EQUAL(1U, unpushedGroup->GetEvents().size());
+}
+
 } // end of namespace logtail
 
 int main(int argc, char** argv) {
@@ -0,0 +1,119 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryConfigIndexBenchmark : public testing::Test {
+public:
+    void TestMatch_10000();
+
+protected:
+    void SetUp() override {
+        for (size_t i = 0; i < kConfigCnt; ++i) {
+            Json::Value configJson;
+            // one tenth of the configs have wildcard in the base path
+            string filePath = i % 10 == 0 ? "/data/app" + to_string(i) + "/*/logs/**/*.log"
+                                          : "/data/app" + to_string(i) + "/logs/**/*.log";
+            configJson["FilePaths"].append(Json::Value(filePath));
+            configJson["MaxDirSearchDepth"] = Json::Value(2);
+            mOpts.emplace_back(new FileDiscoveryOptions());
+            mOpts.back()->Init(configJson, mCtx, "test");
+            mConfigs.emplace_back(mOpts.back().get(), &mCtx);
+        }
+        for (size_t i = 0; i < kConfigCnt; ++i) {
+            mPaths.push_back(i % 10 == 0 ? "/data/app" + to_string(i) + "/pod/logs/sub"
+                                         : "/data/app" + to_string(i) + "/logs/sub");
+        }
+    }
+
+    static const size_t kConfigCnt = 10000;
+
+    CollectionPipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOpts;
+    vector<FileDiscoveryConfig> mConfigs;
+    vector<string> mPaths;
+};
+
+/*
+[ RUN      ] FileDiscoveryConfigIndexBenchmark.TestMatch_10000
+index build elapsed: 0.00987466 seconds
+linear scan elapsed: 5.03939 seconds, matched: 10000
+index elapsed: 0.004742 seconds, matched: 10000
+*/
+void FileDiscoveryConfigIndexBenchmark::TestMatch_10000() {
+    FileDiscoveryConfigIndex index;
+    {
+        auto start = chrono::high_resolution_clock::now();
+        for (size_t i = 0; i < mConfigs.size(); ++i) {
+            index.Add(to_string(i), mConfigs[i]);
+        }
+        auto end = chrono::high_resolution_clock::now();
+        chrono::duration<double> elapsed = end - start;
+        cout << "index build elapsed: " << elapsed.count() << " seconds" << endl;
+    }
+    {
+        size_t matched = 0;
+        auto start = chrono::high_resolution_clock::now();
+        for (const auto& path : mPaths) {
+            for (const auto& config : mConfigs) {
+                if (config.first->IsMatch(path, "a.log")) {
+                    ++matched;
+                }
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        chrono::duration<double> elapsed = end - start;
+        cout << "linear scan elapsed: " << elapsed.count() << " seconds, matched: " << matched << endl;
+        APSARA_TEST_EQUAL(mPaths.size(), matched);
+    }
+    {
+        size_t matched = 0;
+        vector<FileDiscoveryConfig> candidates;
+        auto start = chrono::high_resolution_clock::now();
+        for (const auto& path : mPaths) {
+            candidates.clear();
+            index.FindCandidates(path, candidates);
+            for (const auto& config : candidates) {
+                if (config.first->IsMatch(path, "a.log")) {
+                    ++matched;
+                }
+            }
+        }
+        auto end = chrono::high_resolution_clock::now();
+        chrono::duration<double> elapsed = end - start;
+        cout << "index elapsed: " << elapsed.count() << " seconds, matched: " << matched << endl;
+        APSARA_TEST_EQUAL(mPaths.size(), matched);
+    }
+}
+
+UNIT_TEST_CASE(FileDiscoveryConfigIndexBenchmark, TestMatch_10000)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -0,0 +1,177 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "file_server/FileDiscoveryConfigIndex.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class FileDiscoveryConfigIndexUnittest : public testing::Test {
+public:
+    void TestFindCandidates();
+    void TestConsistentWithIsMatch();
+    void TestAddAndRemove();
+
+protected:
+    using OptsList = vector<const FileDiscoveryOptions*>;
+
+    void TearDown() override { mOpts.clear(); }
+
+    FileDiscoveryConfig MakeConfig(const string& filePath, int32_t maxDirSearchDepth = 0) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(maxDirSearchDepth);
+        mOpts.emplace_back(new FileDiscoveryOptions());
+        APSARA_TEST_TRUE(mOpts.back()->Init(configJson, mCtx, "test"));
+        return make_pair(mOpts.back().get(), &mCtx);
+    }
+
+    static OptsList FindCandidates(const FileDiscoveryConfigIndex& index, const string& path) {
+        vector<FileDiscoveryConfig> candidates;
+        index.FindCandidates(path, candidates);
+        OptsList res;
+        for (const auto& item : candidates) {
+            res.push_back(item.first);
+        }
+        return res;
+    }
+
+    CollectionPipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOpts;
+};
+
+void FileDiscoveryConfigIndexUnittest::TestFindCandidates() {
+    FileDiscoveryConfigIndex index;
+    auto varLog = MakeConfig("/var/log/*.log");
+    auto varLogApp = MakeConfig("/var/log/app/**/*.log", 2);
+    auto wildcard = MakeConfig("/var/log/*/inner/*.log");
+    auto bracket = MakeConfig("/var/[ab]/*/*.log");
+    auto home = MakeConfig("/home/admin/*.log");
+    auto container = MakeConfig("/app/*.log");
+    container.first->SetEnableContainerDiscoveryFlag(true);
+    index.Add("var_log", varLog);
+    index.Add("var_log_app", varLogApp);
+    index.Add("wildcard", wildcard);
+    index.Add("bracket", bracket);
+    index.Add("home", home);
+    index.Add("container", container);
+    APSARA_TEST_EQUAL(6U, index.Size());
+
+    // from the shortest prefix to the longest one, and then the unindexed ones
+    APSARA_TEST_TRUE(OptsList({bracket.first, varLog.first, wildcard.first, container.first})
+                     == FindCandidates(index, "/var/log"));
+    APSARA_TEST_TRUE(OptsList({bracket.first, varLog.first, wildcard.first, varLogApp.first, container.first})
+                     == FindCandidates(index, "/var/log/app/sub"));
+    // components are not matched by prefix
+    APSARA_TEST_TRUE(OptsList({bracket.first, varLog.first, wildcard.first, container.first})
+                     == FindCandidates(index, "/var/log/apps"));
+    APSARA_TEST_TRUE(OptsList({bracket.first, container.first}) == FindCandidates(index, "/var/b/x"));
+    APSARA_TEST_TRUE(OptsList({home.first, container.first}) == FindCandidates(index, "/home//admin/"));
+    APSARA_TEST_TRUE(OptsList({container.first}) == FindCandidates(index, "/opt"));
+    APSARA_TEST_TRUE(OptsList({container.first}) == FindCandidates(index, ""));
+}
+
+void FileDiscoveryConfigIndexUnittest::TestConsistentWithIsMatch() {
+    FileDiscoveryConfigIndex index;
+    vector<FileDiscoveryConfig> configs = {MakeConfig("/var/log/*.log"),
+                                           MakeConfig("/var/log/app/**/*.log", 2),
+                                           MakeConfig("/var/log/app/**/*.log", -1),
+                                           MakeConfig("/var/log/*/inner/*.log"),
+                                           MakeConfig("/var/lo?/app/*.log"),
+                                           MakeConfig("/*/log/*.log"),
+                                           MakeConfig("/**/*.log", 1),
+                                           MakeConfig("/home/admin/*.log")};
+    for (size_t i = 0; i < configs.size(); ++i) {
+        index.Add(to_string(i), configs[i]);
+    }
+    vector<string> paths = {"/",
+                            "/var",
+                            "/var/log",
+                            "/var/logs",
+                            "/var/log/app",
+                            "/var/log/app/a/b",
+                            "/var/log/app/a/b/c",
+                            "/var/log/x/inner",
+                            "/var/lop/app",
+                            "/home/log",
+                            "/home/admin",
+                            "/home/admin/sub",
+                            "/opt/log"};
+    for (const auto& path : paths) {
+        for (const auto& name : {string(""), string("a.log"), string("a.txt")}) {
+            OptsList expected;
+            for (const auto& config : configs) {
+                if (config.first->IsMatch(path, name)) {
+                    expected.push_back(config.first);
+                }
+            }
+            OptsList res;
+            for (const auto* opts : FindCandidates(index, path)) {
+                if (opts->IsMatch(path, name)) {
+                    res.push_back(opts);
+                }
+            }
+            sort(expected.begin(), expected.end());
+            sort(res.begin(), res.end());
+            APSARA_TEST_TRUE_DESC(expected == res, path + "/" + name);
+        }
+    }
+}
+
+void FileDiscoveryConfigIndexUnittest::TestAddAndRemove() {
+    FileDiscoveryConfigIndex index;
+    auto config1 = MakeConfig("/var/log/app/*.log");
+    auto config2 = MakeConfig("/var/log/*.log");
+    index.Add("config", config1);
+    APSARA_TEST_TRUE(OptsList({config1.first}) == FindCandidates(index, "/var/log/app"));
+
+    // the config with the same name is replaced
+    index.Add("config", config2);
+    APSARA_TEST_EQUAL(1U, index.Size());
+    APSARA_TEST_TRUE(OptsList({config2.first}) == FindCandidates(index, "/var/log/app"));
+    // the nodes only leading to the replaced config are released
+    APSARA_TEST_EQUAL(1U, index.mRoot.mChildren.size());
+    APSARA_TEST_TRUE(index.mRoot.mChildren["var"]->mChildren["log"]->mChildren.empty());
+
+    index.Remove("config");
+    index.Remove("unknown");
+    APSARA_TEST_EQUAL(0U, index.Size());
+    APSARA_TEST_TRUE(index.mRoot.mChildren.empty());
+    APSARA_TEST_TRUE(FindCandidates(index, "/var/log/app").empty());
+
+    index.Add("config1", config1);
+    index.Add("config2", config2);
+    index.Clear();
+    APSARA_TEST_EQUAL(0U, index.Size());
+    APSARA_TEST_TRUE(FindCandidates(index, "/var/log/app").empty());
+}
+
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestFindCandidates)
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestConsistentWithIsMatch)
+UNIT_TEST_CASE(FileDiscoveryConfigIndexUnittest, TestAddAndRemove)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
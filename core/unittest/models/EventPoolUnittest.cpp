@@ -12,6 +12,8 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <thread>
+
 #include "models/EventPool.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
@@ -25,6 +27,9 @@ public:
     void TestNoLock();
     void TestLock();
     void TestGC();
+    void TestCrossThreadReturn();
+    void TestThreadedEventPoolReuse();
+    void TestMetrics();
 
 protected:
     void SetUp() override { mGroup.reset(new PipelineEventGroup(make_shared<SourceBuffer>())); }
@@ -102,18 +107,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireLogEvent(mGroup.get());
         auto e1 = pool.AcquireLogEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mLogEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mLogEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedLogEvents.Size());
+        APSARA_TEST_EQUAL(e, pool.mReturnedLogEvents.Back());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         e = pool.AcquireLogEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<LogEvent*>{e, e1});
         auto e2 = pool.AcquireLogEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mLogEventPool.size());
         delete e2;
     }
@@ -121,18 +126,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireMetricEvent(mGroup.get());
         auto e1 = pool.AcquireMetricEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mMetricEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mMetricEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedMetricEvents.Size());
+        APSARA_TEST_EQUAL(e, pool.mReturnedMetricEvents.Back());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         e = pool.AcquireMetricEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mMetricEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedMetricEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mMetricEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<MetricEvent*>{e, e1});
         auto e2 = pool.AcquireMetricEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mMetricEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedMetricEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mMetricEventPool.size());
         delete e2;
     }
@@ -140,18 +145,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireSpanEvent(mGroup.get());
         auto e1 = pool.AcquireSpanEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mSpanEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mSpanEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedSpanEvents.Size());
+        APSARA_TEST_EQUAL(e, pool.mReturnedSpanEvents.Back());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         e = pool.AcquireSpanEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mSpanEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedSpanEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mSpanEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<SpanEvent*>{e, e1});
         auto e2 = pool.AcquireSpanEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mSpanEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedSpanEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mSpanEventPool.size());
         delete e2;
     }
@@ -159,18 +164,18 @@ void EventPoolUnittest::TestLock() {
         auto e = pool.AcquireRawEvent(mGroup.get());
         auto e1 = pool.AcquireRawEvent(mGroup.get());
         pool.Release({e});
-        APSARA_TEST_EQUAL(1U, pool.mRawEventPoolBak.size());
-        APSARA_TEST_EQUAL(e, pool.mRawEventPoolBak[0]);
+        APSARA_TEST_EQUAL(1U, pool.mReturnedRawEvents.Size());
+        APSARA_TEST_EQUAL(e, pool.mReturnedRawEvents.Back());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         e = pool.AcquireRawEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mRawEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedRawEvents.Size());
         APSARA_TEST_EQUAL(0U, pool.mRawEventPool.size());
         APSARA_TEST_EQUAL(mGroup.get(), e->GetPipelineEventGroupPtr());
 
         pool.Release(vector<RawEvent*>{e, e1});
         auto e2 = pool.AcquireRawEvent(mGroup.get());
-        APSARA_TEST_EQUAL(0U, pool.mRawEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedRawEvents.Size());
         APSARA_TEST_EQUAL(1U, pool.mRawEventPool.size());
         delete e2;
     }
@@ -217,7 +222,7 @@ void EventPoolUnittest::TestGC() {
         pool.Release(std::move(events));
         pool.CheckGC();
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
     }
     {
@@ -233,14 +238,104 @@ void EventPoolUnittest::TestGC() {
         pool.Release({e});
         pool.CheckGC();
         APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
-        APSARA_TEST_EQUAL(0U, pool.mLogEventPoolBak.size());
+        APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
         APSARA_TEST_EQUAL(numeric_limits<size_t>::max(), pool.mMinUnusedLogEventsCnt);
     }
 }
 
+void EventPoolUnittest::TestCrossThreadReturn() {
+    EventPool pool(false);
+    auto e1 = pool.AcquireLogEvent(mGroup.get());
+    auto e2 = pool.AcquireLogEvent(mGroup.get());
+    thread t([&]() {
+        pool.Release({e1});
+        pool.Release({e2});
+    });
+    t.join();
+    APSARA_TEST_EQUAL(0U, pool.mLogEventPool.size());
+    APSARA_TEST_EQUAL(2U, pool.mReturnedLogEvents.Size());
+    APSARA_TEST_EQUAL(e2, pool.mReturnedLogEvents.Back());
+    APSARA_TEST_EQUAL(2U, pool.mCrossThreadReturnedCnt.load());
+
+    // returned events are taken back all at once when the local pool runs out
+    auto e = pool.AcquireLogEvent(mGroup.get());
+    APSARA_TEST_TRUE(e == e1 || e == e2);
+    APSARA_TEST_EQUAL(1U, pool.mLogEventPool.size());
+    APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
+
+    // released by the owner
+    pool.Release({e});
+    APSARA_TEST_EQUAL(2U, pool.mLogEventPool.size());
+    APSARA_TEST_EQUAL(0U, pool.mReturnedLogEvents.Size());
+    APSARA_TEST_EQUAL(2U, pool.mCrossThreadReturnedCnt.load());
+    pool.Clear();
+
+    // events returned to a shared pool are not counted
+    EventPool sharedPool(true);
+    auto e3 = sharedPool.AcquireLogEvent(mGroup.get());
+    thread t2([&]() { sharedPool.Release({e3}); });
+    t2.join();
+    APSARA_TEST_EQUAL(0U, sharedPool.mCrossThreadReturnedCnt.load());
+    sharedPool.Clear();
+}
+
+void EventPoolUnittest::TestThreadedEventPoolReuse() {
+    EventPool* mainPool = &gThreadedEventPool;
+    EventPool* threadPool = nullptr;
+    PipelineEventGroup* group = nullptr;
+    thread t1([&]() {
+        threadPool = &gThreadedEventPool;
+        group = new PipelineEventGroup(make_shared<SourceBuffer>());
+        group->AddLogEvent(true);
+        group->AddLogEvent(true);
+        APSARA_TEST_EQUAL(threadPool, group->GetEvents()[0].GetEventPool());
+    });
+    t1.join();
+    APSARA_TEST_NOT_EQUAL(mainPool, threadPool);
+
+    // events are returned to the pool even if its owner thread has exited
+    delete group;
+    APSARA_TEST_EQUAL(2U, threadPool->mReturnedLogEvents.Size());
+
+    thread t2([&]() {
+        APSARA_TEST_EQUAL(threadPool, &gThreadedEventPool);
+        delete gThreadedEventPool.AcquireLogEvent(mGroup.get());
+        APSARA_TEST_EQUAL(1U, gThreadedEventPool.mLogEventPool.size());
+        APSARA_TEST_EQUAL(0U, gThreadedEventPool.mReturnedLogEvents.Size());
+        gThreadedEventPool.Clear();
+    });
+    t2.join();
+}
+
+void EventPoolUnittest::TestMetrics() {
+    EventPool pool;
+    auto hitCnt = make_shared<Counter>("hit");
+    auto missCnt = make_shared<Counter>("miss");
+    auto crossThreadReturnedCnt = make_shared<Counter>("returned");
+    pool.SetMetrics(hitCnt, missCnt, crossThreadReturnedCnt);
+
+    auto e1 = pool.AcquireLogEvent(mGroup.get());
+    auto e2 = pool.AcquireLogEvent(mGroup.get());
+    pool.Release(vector<LogEvent*>{e1, e2});
+    delete pool.AcquireLogEvent(mGroup.get());
+    pool.CheckGC();
+    APSARA_TEST_EQUAL(1U, hitCnt->GetValue());
+    APSARA_TEST_EQUAL(2U, missCnt->GetValue());
+    APSARA_TEST_EQUAL(2U, crossThreadReturnedCnt->GetValue());
+
+    pool.CheckGC();
+    APSARA_TEST_EQUAL(1U, hitCnt->GetValue());
+    APSARA_TEST_EQUAL(2U, missCnt->GetValue());
+    APSARA_TEST_EQUAL(2U, crossThreadReturnedCnt->GetValue());
+    pool.Clear();
+}
+
 UNIT_TEST_CASE(EventPoolUnittest, TestNoLock)
 UNIT_TEST_CASE(EventPoolUnittest, TestLock)
 UNIT_TEST_CASE(EventPoolUnittest, TestGC)
+UNIT_TEST_CASE(EventPoolUnittest, TestCrossThreadReturn)
+UNIT_TEST_CASE(EventPoolUnittest, TestThreadedEventPoolReuse)
+UNIT_TEST_CASE(EventPoolUnittest, TestMetrics)
 
 } // namespace logtail
 
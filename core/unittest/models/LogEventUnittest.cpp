@@ -33,6 +33,8 @@ public:
     void TestReset();
     void TestFromJsonToJson();
     void TestLevel();
+    void TestManyContents();
+    void TestDelDuplicateContent();
 
 protected:
     void SetUp() override {
@@ -222,6 +224,80 @@ void LogEventUnittest::TestLevel() {
     APSARA_TEST_EQUAL("level", mLogEvent->GetLevel().to_string());
 }
 
+void LogEventUnittest::TestManyContents() {
+    const size_t count = 200;
+    for (size_t i = 0; i < count; ++i) {
+        mLogEvent->SetContent("key" + to_string(i), "value" + to_string(i));
+        // contents are looked up by hash index once there are many of them
+        APSARA_TEST_EQUAL(i + 1 >= LogEvent::sHashIndexThreshold, !mLogEvent->mHashIndex.empty());
+    }
+    APSARA_TEST_EQUAL(count, mLogEvent->Size());
+    for (size_t i = 0; i < count; ++i) {
+        APSARA_TEST_EQUAL("value" + to_string(i), mLogEvent->GetContent("key" + to_string(i)).to_string());
+    }
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key" + to_string(count)));
+
+    // overwrite and delete
+    for (size_t i = 0; i < count; i += 2) {
+        mLogEvent->SetContent("key" + to_string(i), "new" + to_string(i));
+        mLogEvent->DelContent("key" + to_string(i + 1));
+    }
+    APSARA_TEST_EQUAL(count / 2, mLogEvent->Size());
+    // add deleted keys back, which are appended to the end
+    for (size_t i = 1; i < count; i += 2) {
+        mLogEvent->SetContent("key" + to_string(i), "again" + to_string(i));
+    }
+    APSARA_TEST_EQUAL(count, mLogEvent->Size());
+    size_t idx = 0;
+    for (const auto& content : *mLogEvent) {
+        if (idx < count / 2) {
+            APSARA_TEST_EQUAL("key" + to_string(idx * 2), content.first.to_string());
+            APSARA_TEST_EQUAL("new" + to_string(idx * 2), content.second.to_string());
+        } else {
+            size_t i = (idx - count / 2) * 2 + 1;
+            APSARA_TEST_EQUAL("key" + to_string(i), content.first.to_string());
+            APSARA_TEST_EQUAL("again" + to_string(i), content.second.to_string());
+            APSARA_TEST_TRUE(mLogEvent->FindContent(content.first) != mLogEvent->end());
+        }
+        ++idx;
+    }
+    APSARA_TEST_EQUAL(count, idx);
+
+    mLogEvent->Reset();
+    APSARA_TEST_TRUE(mLogEvent->Empty());
+    APSARA_TEST_TRUE(mLogEvent->mHashIndex.empty());
+    APSARA_TEST_FALSE(mLogEvent->HasContent("key0"));
+}
+
+void LogEventUnittest::TestDelDuplicateContent() {
+    // both with linear scan and with hash index
+    for (size_t fieldCnt : {size_t(1), LogEvent::sHashIndexThreshold}) {
+        mLogEvent->Reset();
+        for (size_t i = 1; i < fieldCnt; ++i) {
+            mLogEvent->SetContent("key" + to_string(i), "value" + to_string(i));
+        }
+        mLogEvent->AppendContentNoCopy(StringView("dup"), StringView("old"));
+        mLogEvent->AppendContentNoCopy(StringView("dup"), StringView("new"));
+        APSARA_TEST_EQUAL(fieldCnt >= LogEvent::sHashIndexThreshold, !mLogEvent->mHashIndex.empty());
+        APSARA_TEST_EQUAL(fieldCnt, mLogEvent->Size());
+        APSARA_TEST_EQUAL("new", mLogEvent->GetContent("dup").to_string());
+
+        mLogEvent->DelContent("dup");
+        APSARA_TEST_FALSE(mLogEvent->HasContent("dup"));
+        APSARA_TEST_EQUAL(fieldCnt - 1, mLogEvent->Size());
+        size_t cnt = 0;
+        for (const auto& content : *mLogEvent) {
+            APSARA_TEST_NOT_EQUAL("dup", content.first.to_string());
+            ++cnt;
+        }
+        APSARA_TEST_EQUAL(mLogEvent->Size(), cnt);
+
+        mLogEvent->SetContent(string("dup"), string("again"));
+        APSARA_TEST_EQUAL(fieldCnt, mLogEvent->Size());
+        APSARA_TEST_EQUAL("again", mLogEvent->GetContent("dup").to_string());
+    }
+}
+
 UNIT_TEST_CASE(LogEventUnittest, TestTimestampOp)
 UNIT_TEST_CASE(LogEventUnittest, TestSetContent)
 UNIT_TEST_CASE(LogEventUnittest, TestDelContent)
@@ -232,6 +308,8 @@ UNIT_TEST_CASE(LogEventUnittest, TestSize)
 UNIT_TEST_CASE(LogEventUnittest, TestReset)
 UNIT_TEST_CASE(LogEventUnittest, TestFromJsonToJson)
 UNIT_TEST_CASE(LogEventUnittest, TestLevel)
+UNIT_TEST_CASE(LogEventUnittest, TestManyContents)
+UNIT_TEST_CASE(LogEventUnittest, TestDelDuplicateContent)
 
 } // namespace logtail
 
@@ -31,6 +31,7 @@ public:
     void TestSwapEvents();
     void TestReserveEvents();
     void TestCopy();
+    void TestSplitAndMergeChunks();
     void TestDestructor();
     void TestSetMetadata();
     void TestDelMetadata();
@@ -173,32 +174,32 @@ void PipelineEventGroupUnittest::TestDestructor() {
         log = g.AddLogEvent(true, &mPool);
         log->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mLogEventPoolBak.size());
-    APSARA_TEST_EQUAL(log, mPool.mLogEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedLogEvents.Size());
+    APSARA_TEST_EQUAL(log, mPool.mReturnedLogEvents.Back());
     APSARA_TEST_EQUAL(0, log->GetTimestamp());
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         metric = g.AddMetricEvent(true, &mPool);
         metric->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mMetricEventPoolBak.size());
-    APSARA_TEST_EQUAL(metric, mPool.mMetricEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedMetricEvents.Size());
+    APSARA_TEST_EQUAL(metric, mPool.mReturnedMetricEvents.Back());
     APSARA_TEST_EQUAL(0, metric->GetTimestamp());
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         span = g.AddSpanEvent(true, &mPool);
         span->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mSpanEventPoolBak.size());
-    APSARA_TEST_EQUAL(span, mPool.mSpanEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedSpanEvents.Size());
+    APSARA_TEST_EQUAL(span, mPool.mReturnedSpanEvents.Back());
     APSARA_TEST_EQUAL(0, span->GetTimestamp());
     {
         PipelineEventGroup g(make_shared<SourceBuffer>());
         raw = g.AddRawEvent(true, &mPool);
         raw->SetTimestamp(1234567890);
     }
-    APSARA_TEST_EQUAL(1U, mPool.mRawEventPoolBak.size());
-    APSARA_TEST_EQUAL(raw, mPool.mRawEventPoolBak.back());
+    APSARA_TEST_EQUAL(1U, mPool.mReturnedRawEvents.Size());
+    APSARA_TEST_EQUAL(raw, mPool.mReturnedRawEvents.Back());
     APSARA_TEST_EQUAL(0, raw->GetTimestamp());
 }
 
@@ -215,6 +216,53 @@ void PipelineEventGroupUnittest::TestCopy() {
     APSARA_TEST_EQUAL(3U, res.GetSourceBuffer().use_count());
 }
 
+void PipelineEventGroupUnittest::TestSplitAndMergeChunks() {
+    mEventGroup->SetTag(std::string("key"), std::string("value"));
+    mEventGroup->SetMetadata(EventGroupMetaKey::SOURCE_ID, std::string("source"));
+    for (size_t i = 0; i < 10; ++i) {
+        mEventGroup->AddLogEvent()->SetContent(std::string("idx"), std::to_string(i));
+    }
+    {
+        // more chunks than events
+        PipelineEventGroup group(std::make_shared<SourceBuffer>());
+        group.AddLogEvent();
+        APSARA_TEST_EQUAL(1U, group.SplitIntoChunks(4).size());
+    }
+
+    auto chunks = mEventGroup->SplitIntoChunks(3);
+    APSARA_TEST_EQUAL(3U, chunks.size());
+    APSARA_TEST_TRUE(mEventGroup->GetEvents().empty());
+    std::vector<size_t> expectedSizes = {4, 3, 3};
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        auto& chunk = chunks[i];
+        APSARA_TEST_EQUAL(expectedSizes[i], chunk.GetEvents().size());
+        APSARA_TEST_NOT_EQUAL(mSourceBuffer.get(), chunk.GetSourceBuffer().get());
+        APSARA_TEST_EQUAL("value", chunk.GetTag("key").to_string());
+        APSARA_TEST_EQUAL("source", chunk.GetMetadata(EventGroupMetaKey::SOURCE_ID).to_string());
+        for (const auto& e : chunk.GetEvents()) {
+            APSARA_TEST_EQUAL(&chunk, e->mPipelineEventGroupPtr);
+        }
+        // data allocated by each chunk
+        chunk.SetTag(std::string("chunk"), std::to_string(i));
+        for (auto& e : chunk.MutableEvents()) {
+            e.Cast<LogEvent>().SetContent(std::string("chunk"), std::to_string(i));
+        }
+    }
+
+    mEventGroup->MergeChunks(std::move(chunks));
+    APSARA_TEST_TRUE(chunks.empty());
+    APSARA_TEST_EQUAL(10U, mEventGroup->GetEvents().size());
+    APSARA_TEST_EQUAL("0", mEventGroup->GetTag("chunk").to_string());
+    APSARA_TEST_EQUAL(3U, mSourceBuffer->mExternalBuffers.size());
+    for (size_t i = 0; i < mEventGroup->GetEvents().size(); ++i) {
+        const auto& e = mEventGroup->GetEvents()[i];
+        APSARA_TEST_EQUAL(mEventGroup.get(), e->mPipelineEventGroupPtr);
+        APSARA_TEST_EQUAL(std::to_string(i), e.Cast<LogEvent>().GetContent("idx").to_string());
+        APSARA_TEST_EQUAL(std::to_string(i < 4 ? 0 : (i < 7 ? 1 : 2)),
+                          e.Cast<LogEvent>().GetContent("chunk").to_string());
+    }
+}
+
 void PipelineEventGroupUnittest::TestSetMetadata() {
     { // string copy, let kv out of scope
         mEventGroup->SetMetadata(EventGroupMetaKey::LOG_FORMAT, std::string("value1"));
@@ -299,6 +347,7 @@ UNIT_TEST_CASE(PipelineEventGroupUnittest, TestAddEvent)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSwapEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestReserveEvents)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestCopy)
+UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSplitAndMergeChunks)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDestructor)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestSetMetadata)
 UNIT_TEST_CASE(PipelineEventGroupUnittest, TestDelMetadata)
@@ -13,8 +13,11 @@
 // limitations under the License.
 
 #include "collection_pipeline/limiter/ConcurrencyLimiter.h"
+#include "common/Flags.h"
 #include "unittest/Unittest.h"
 
+DECLARE_FLAG_BOOL(enable_adaptive_concurrency_limiter);
+
 using namespace std;
 
 namespace logtail {
@@ -22,6 +25,23 @@ namespace logtail {
 class ConcurrencyLimiterUnittest : public testing::Test {
 public:
     void TestLimiter() const;
+    void TestAdaptiveLimiter() const;
+
+protected:
+    void TearDown() override { BOOL_FLAG(enable_adaptive_concurrency_limiter) = false; }
+
+private:
+    static void SendWindow(ConcurrencyLimiter& limiter, chrono::milliseconds rtt, uint32_t failCnt = 0) {
+        for (uint32_t i = 0; i < limiter.GetStatisticThreshold(); ++i) {
+            limiter.PostPop();
+            if (i < failCnt) {
+                limiter.OnFail(chrono::system_clock::now());
+            } else {
+                limiter.OnSuccess(chrono::system_clock::now(), rtt);
+            }
+            limiter.OnSendDone();
+        }
+    }
 };
 
 void ConcurrencyLimiterUnittest::TestLimiter() const {
@@ -140,7 +160,53 @@ void ConcurrencyLimiterUnittest::TestLimiter() const {
     APSARA_TEST_EQUAL(expect, sConcurrencyLimiter->GetCurrentLimit());
 }
 
+void ConcurrencyLimiterUnittest::TestAdaptiveLimiter() const {
+    {
+        // response time is ignored by default
+        ConcurrencyLimiter limiter("", 80, 1);
+        limiter.SetCurrentLimit(40);
+        SendWindow(limiter, chrono::milliseconds(1000));
+        APSARA_TEST_EQUAL(41U, limiter.GetCurrentLimit());
+        APSARA_TEST_EQUAL(0.0, limiter.GetLongRttMs());
+    }
+
+    BOOL_FLAG(enable_adaptive_concurrency_limiter) = true;
+    ConcurrencyLimiter limiter("", 80, 1);
+    // stable response time, the limit stays at maximum
+    for (int i = 0; i < 5; ++i) {
+        SendWindow(limiter, chrono::milliseconds(100));
+    }
+    APSARA_TEST_EQUAL(80U, limiter.GetCurrentLimit());
+    APSARA_TEST_EQUAL(100.0, limiter.GetLongRttMs());
+
+    // requests begin to queue at the destination, the limit shrinks
+    uint32_t last = limiter.GetCurrentLimit();
+    for (int i = 0; i < 3; ++i) {
+        SendWindow(limiter, chrono::milliseconds(400));
+        APSARA_TEST_TRUE(limiter.GetCurrentLimit() < last);
+        last = limiter.GetCurrentLimit();
+    }
+    // slightly slower is tolerated
+    limiter.SetCurrentLimit(40);
+    SendWindow(limiter, chrono::milliseconds(static_cast<int64_t>(limiter.GetLongRttMs() * 1.2)));
+    APSARA_TEST_TRUE(limiter.GetCurrentLimit() >= 40U);
+
+    // the destination recovers, the limit grows back
+    for (int i = 0; i < 50; ++i) {
+        SendWindow(limiter, chrono::milliseconds(100));
+    }
+    APSARA_TEST_EQUAL(80U, limiter.GetCurrentLimit());
+
+    // failures still cut the limit
+    SendWindow(limiter, chrono::milliseconds(100), limiter.GetStatisticThreshold());
+    APSARA_TEST_EQUAL(40U, limiter.GetCurrentLimit());
+    // and requests without response time fall back to the additive increase
+    SendWindow(limiter, chrono::milliseconds::zero());
+    APSARA_TEST_EQUAL(41U, limiter.GetCurrentLimit());
+}
+
 UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestLimiter)
+UNIT_TEST_CASE(ConcurrencyLimiterUnittest, TestAdaptiveLimiter)
 
 } // namespace logtail
 
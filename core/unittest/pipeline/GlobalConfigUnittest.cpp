@@ -51,6 +51,8 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
+    APSARA_TEST_FALSE(config->mEnableParallelProcessing);
+    APSARA_TEST_FALSE(config->mEnableFusedProcessing);
 
     // valid optional param
     configStr = R"(
@@ -59,7 +61,9 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicFormat": "test_topic",
             "Priority": 1,
             "EnableTimestampNanosecond": true,
-            "UsingOldContentTag": true
+            "UsingOldContentTag": true,
+            "EnableParallelProcessing": true,
+            "EnableFusedProcessing": true
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -71,6 +75,8 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_TRUE(config->mEnableTimestampNanosecond);
     APSARA_TEST_TRUE(config->mUsingOldContentTag);
+    APSARA_TEST_TRUE(config->mEnableParallelProcessing);
+    APSARA_TEST_TRUE(config->mEnableFusedProcessing);
 
     // invalid optional param
     configStr = R"(
@@ -79,7 +85,9 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
             "TopicFormat": true,
             "Priority": "1",
             "EnableTimestampNanosecond": "true",
-            "UsingOldContentTag": "true"
+            "UsingOldContentTag": "true",
+            "EnableParallelProcessing": "true",
+            "EnableFusedProcessing": "true"
         }
     )";
     APSARA_TEST_TRUE(ParseJsonTable(configStr, configJson, errorMsg));
@@ -91,6 +99,8 @@ void GlobalConfigUnittest::OnSuccessfulInit() const {
     APSARA_TEST_EQUAL(1U, config->mPriority);
     APSARA_TEST_FALSE(config->mEnableTimestampNanosecond);
     APSARA_TEST_FALSE(config->mUsingOldContentTag);
+    APSARA_TEST_FALSE(config->mEnableParallelProcessing);
+    APSARA_TEST_FALSE(config->mEnableFusedProcessing);
 
     // topicFormat
     configStr = R"(
@@ -0,0 +1,457 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// End to end benchmark of the native pipeline hot path:
+// split -> parse (regex/json/delimiter/apsara) -> timestamp -> filter -> batch -> serialize -> compress.
+// Synthetic corpora are written to files and read back in chunks as the file reader does, and all output goes to a
+// blackhole flusher. For each stage, events/s, bytes/s, allocations per event and latency percentiles are reported,
+// and the results are also written as json so that they can be compared between releases.
+//
+// Usage: pipeline_benchmark [--pipeline_benchmark_corpus_size_mb=64] [--pipeline_benchmark_output=xxx.json] ...
+
+#include <cstdio>
+#include <cstdlib>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "collection_pipeline/batch/Batcher.h"
+#include "collection_pipeline/plugin/interface/Flusher.h"
+#include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/Flags.h"
+#include "common/compression/CompressorFactory.h"
+#include "logger/Logger.h"
+#include "models/LogEvent.h"
+#include "models/PipelineEventGroup.h"
+#include "plugin/processor/ProcessorFilterNative.h"
+#include "plugin/processor/ProcessorParseApsaraNative.h"
+#include "plugin/processor/ProcessorParseDelimiterNative.h"
+#include "plugin/processor/ProcessorParseJsonNative.h"
+#include "plugin/processor/ProcessorParseRegexNative.h"
+#include "plugin/processor/ProcessorParseTimestampNative.h"
+#include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
+
+DEFINE_FLAG_INT32(pipeline_benchmark_corpus_size_mb, "size of each synthetic corpus", 64);
+DEFINE_FLAG_INT32(pipeline_benchmark_read_chunk_kb, "size of each file read, the same as the default reader buffer", 512);
+DEFINE_FLAG_INT32(pipeline_benchmark_rounds, "number of rounds to run for each corpus", 3);
+DEFINE_FLAG_STRING(pipeline_benchmark_corpora, "corpora to run, separated by comma", "regex,json,delimiter,apsara");
+DEFINE_FLAG_STRING(pipeline_benchmark_compress_type, "lz4 or zstd", "lz4");
+DEFINE_FLAG_STRING(pipeline_benchmark_regex_engine, "regex engine for the regex corpus, boost or re2", "boost");
+DEFINE_FLAG_STRING(pipeline_benchmark_output, "path of the machine-readable result", "pipeline_benchmark.json");
+
+using namespace std;
+
+// count allocations of the whole process, only the delta within a stage matters
+static atomic<uint64_t> sAllocCnt{0};
+
+void* operator new(size_t size) {
+    sAllocCnt.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size == 0 ? 1 : size)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void* operator new[](size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept {
+    free(p);
+}
+
+namespace logtail {
+
+class FlusherBlackhole : public Flusher {
+public:
+    static const string sName;
+
+    const string& Name() const override { return sName; }
+    bool Init(const Json::Value& config, Json::Value& optionalGoPipeline) override { return true; }
+    bool Send(PipelineEventGroup&& g) override { return true; }
+    bool Flush(size_t key) override { return true; }
+    bool FlushAll() override { return true; }
+};
+
+const string FlusherBlackhole::sName = "flusher_blackhole";
+
+struct StageStats {
+    string mName;
+    uint64_t mInEvents = 0;
+    uint64_t mInBytes = 0;
+    uint64_t mAllocs = 0;
+    uint64_t mTotalNs = 0;
+    // latency of each call, i.e., each event group or batch
+    vector<uint64_t> mLatencyNs;
+
+    explicit StageStats(const string& name) : mName(name) {}
+
+    template <typename F>
+    void Run(uint64_t events, uint64_t bytes, F&& f) {
+        uint64_t allocs = sAllocCnt.load(memory_order_relaxed);
+        auto before = chrono::steady_clock::now();
+        f();
+        uint64_t ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - before).count();
+        mAllocs += sAllocCnt.load(memory_order_relaxed) - allocs;
+        mTotalNs += ns;
+        mInEvents += events;
+        mInBytes += bytes;
+        mLatencyNs.push_back(ns);
+    }
+
+    uint64_t Percentile(double p) const {
+        if (mLatencyNs.empty()) {
+            return 0;
+        }
+        vector<uint64_t> sorted(mLatencyNs);
+        sort(sorted.begin(), sorted.end());
+        size_t idx = static_cast<size_t>(p * sorted.size());
+        return sorted[min(idx, sorted.size() - 1)];
+    }
+
+    Json::Value ToJson() const {
+        double secs = mTotalNs / 1e9;
+        Json::Value res;
+        res["in_events"] = static_cast<Json::UInt64>(mInEvents);
+        res["in_bytes"] = static_cast<Json::UInt64>(mInBytes);
+        res["total_time_ms"] = mTotalNs / 1e6;
+        res["events_per_sec"] = secs > 0 ? mInEvents / secs : 0.0;
+        res["bytes_per_sec"] = secs > 0 ? mInBytes / secs : 0.0;
+        res["allocs_per_event"] = mInEvents > 0 ? static_cast<double>(mAllocs) / mInEvents : 0.0;
+        res["latency_p50_us"] = Percentile(0.5) / 1e3;
+        res["latency_p99_us"] = Percentile(0.99) / 1e3;
+        res["latency_max_us"] = Percentile(1.0) / 1e3;
+        return res;
+    }
+};
+
+struct Corpus {
+    string mName;
+    // generate the i-th line, without line feed
+    string (*mLineGenerator)(size_t);
+    // the processor for parsing and its config
+    unique_ptr<Processor> mParser;
+    Json::Value mParserConfig;
+    // empty if time is parsed by the parser itself
+    string mTimeKey;
+    string mLevelKey;
+};
+
+static const char* const sLevels[] = {"INFO", "WARNING", "ERROR", "DEBUG"};
+static const char* const sClasses[] = {"com.example.order.OrderService",
+                                       "com.example.user.UserController",
+                                       "com.example.pay.PaymentGateway"};
+
+static string FormatTime(size_t i) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "2024-04-07 08:%02zu:%02zu", (i / 60) % 60, i % 60);
+    return buf;
+}
+
+static string RegexLine(size_t i) {
+    return FormatTime(i) + " " + sLevels[i % 4] + " [thread-" + to_string(i % 16) + "] " + sClasses[i % 3]
+        + " - request " + to_string(i) + " handled in " + to_string(i % 1000) + " ms from 10.0.0." + to_string(i % 256);
+}
+
+static string JsonLine(size_t i) {
+    return R"({"time":")" + FormatTime(i) + R"(","level":")" + sLevels[i % 4] + R"(","thread":"thread-)"
+        + to_string(i % 16) + R"(","class":")" + sClasses[i % 3] + R"(","msg":"request )" + to_string(i)
+        + " handled in " + to_string(i % 1000) + R"( ms","ip":"10.0.0.)" + to_string(i % 256) + R"("})";
+}
+
+static string DelimiterLine(size_t i) {
+    return FormatTime(i) + "|" + sLevels[i % 4] + "|thread-" + to_string(i % 16) + "|" + sClasses[i % 3] + "|request "
+        + to_string(i) + " handled in " + to_string(i % 1000) + " ms|10.0.0." + to_string(i % 256);
+}
+
+static string ApsaraLine(size_t i) {
+    return "[" + FormatTime(i) + "." + to_string(100000 + i % 900000) + "]\t[" + sLevels[i % 4] + "]\t["
+        + to_string(1000 + i % 16) + "]\t/build/core/OrderService.cpp:" + to_string(i % 500) + "\t\trequest:"
+        + to_string(i) + "\tcost_ms:" + to_string(i % 1000) + "\tip:10.0.0." + to_string(i % 256);
+}
+
+static vector<Corpus> CreateCorpora() {
+    vector<Corpus> corpora(4);
+    Json::Value keys;
+    for (const auto& key : {"time", "level", "thread", "class", "msg", "ip"}) {
+        keys.append(key);
+    }
+
+    corpora[0].mName = "regex";
+    corpora[0].mLineGenerator = RegexLine;
+    corpora[0].mParser = make_unique<ProcessorParseRegexNative>();
+    corpora[0].mParserConfig["SourceKey"] = DEFAULT_CONTENT_KEY;
+    corpora[0].mParserConfig["Regex"] = R"((\S+ \S+) (\S+) \[([^\]]+)\] (\S+) - (.* ms) from (\S+))";
+    corpora[0].mParserConfig["Keys"] = keys;
+    corpora[0].mParserConfig["RegexEngine"] = STRING_FLAG(pipeline_benchmark_regex_engine);
+    corpora[0].mTimeKey = "time";
+    corpora[0].mLevelKey = "level";
+
+    corpora[1].mName = "json";
+    corpora[1].mLineGenerator = JsonLine;
+    corpora[1].mParser = make_unique<ProcessorParseJsonNative>();
+    corpora[1].mParserConfig["SourceKey"] = DEFAULT_CONTENT_KEY;
+    corpora[1].mTimeKey = "time";
+    corpora[1].mLevelKey = "level";
+
+    corpora[2].mName = "delimiter";
+    corpora[2].mLineGenerator = DelimiterLine;
+    corpora[2].mParser = make_unique<ProcessorParseDelimiterNative>();
+    corpora[2].mParserConfig["SourceKey"] = DEFAULT_CONTENT_KEY;
+    corpora[2].mParserConfig["Separator"] = "|";
+    corpora[2].mParserConfig["Keys"] = keys;
+    corpora[2].mTimeKey = "time";
+    corpora[2].mLevelKey = "level";
+
+    corpora[3].mName = "apsara";
+    corpora[3].mLineGenerator = ApsaraLine;
+    corpora[3].mParser = make_unique<ProcessorParseApsaraNative>();
+    corpora[3].mParserConfig["SourceKey"] = DEFAULT_CONTENT_KEY;
+    corpora[3].mLevelKey = "__LEVEL__";
+    return corpora;
+}
+
+// write the corpus to a file and read it back in chunks ending at line feed, as the file reader does
+static vector<string> PrepareCorpusChunks(const Corpus& corpus, size_t& lineCnt) {
+    const string path = "pipeline_benchmark_" + corpus.mName + ".log";
+    const size_t totalSize = static_cast<size_t>(INT32_FLAG(pipeline_benchmark_corpus_size_mb)) * 1024 * 1024;
+    {
+        ofstream out(path, ios::binary | ios::trunc);
+        size_t size = 0;
+        for (lineCnt = 0; size < totalSize; ++lineCnt) {
+            string line = corpus.mLineGenerator(lineCnt);
+            line.push_back('\n');
+            out << line;
+            size += line.size();
+        }
+    }
+
+    vector<string> chunks;
+    ifstream in(path, ios::binary);
+    const size_t chunkSize = static_cast<size_t>(INT32_FLAG(pipeline_benchmark_read_chunk_kb)) * 1024;
+    string buffer(chunkSize, '\0');
+    string remaining;
+    while (in) {
+        in.read(&buffer[0], chunkSize);
+        size_t n = static_cast<size_t>(in.gcount());
+        if (n == 0) {
+            break;
+        }
+        remaining.append(buffer.data(), n);
+        size_t end = remaining.rfind('\n');
+        if (end == string::npos) {
+            continue;
+        }
+        // the trailing line feed is removed as the reader does
+        chunks.emplace_back(remaining.substr(0, end));
+        remaining.erase(0, end + 1);
+    }
+    remove(path.c_str());
+    return chunks;
+}
+
+static bool InitProcessor(Processor& processor, const Json::Value& config, CollectionPipelineContext& ctx) {
+    processor.SetContext(ctx);
+    processor.SetMetricsRecordRef(processor.Name(), "1");
+    if (!processor.Init(config)) {
+        cout << "failed to init processor " << processor.Name() << endl;
+        return false;
+    }
+    return true;
+}
+
+static bool RunCorpus(Corpus& corpus, Compressor& compressor, Json::Value& result) {
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("pipeline_benchmark_" + corpus.mName);
+
+    FlusherBlackhole flusher;
+    flusher.SetContext(ctx);
+    flusher.SetMetricsRecordRef(FlusherBlackhole::sName, "1");
+
+    ProcessorSplitLogStringNative splitter;
+    ProcessorParseTimestampNative timestampParser;
+    ProcessorFilterNative filter;
+    Json::Value splitConfig, timestampConfig, filterConfig;
+    timestampConfig["SourceKey"] = corpus.mTimeKey;
+    timestampConfig["SourceFormat"] = "%Y-%m-%d %H:%M:%S";
+    filterConfig["Include"][corpus.mLevelKey] = "INFO|WARNING|ERROR";
+    if (!InitProcessor(splitter, splitConfig, ctx) || !InitProcessor(*corpus.mParser, corpus.mParserConfig, ctx)
+        || (!corpus.mTimeKey.empty() && !InitProcessor(timestampParser, timestampConfig, ctx))
+        || !InitProcessor(filter, filterConfig, ctx)) {
+        return false;
+    }
+
+    // the same as the default strategy of flusher_sls
+    DefaultFlushStrategyOptions strategy{5 * 1024 * 1024, 256 * 1024, 4096, 3};
+    Batcher<> batcher;
+    batcher.Init(Json::Value(), &flusher, strategy);
+    SLSEventGroupSerializer serializer(&flusher);
+
+    size_t lineCnt = 0;
+    vector<string> chunks = PrepareCorpusChunks(corpus, lineCnt);
+    uint64_t corpusSize = 0;
+    for (const auto& chunk : chunks) {
+        corpusSize += chunk.size() + 1;
+    }
+
+    vector<StageStats> stages{StageStats("split"),
+                              StageStats("parse"),
+                              StageStats("timestamp"),
+                              StageStats("filter"),
+                              StageStats("batch"),
+                              StageStats("serialize"),
+                              StageStats("compress")};
+    auto& split = stages[0];
+    auto& parse = stages[1];
+    auto& timestamp = stages[2];
+    auto& filt = stages[3];
+    auto& batch = stages[4];
+    auto& serialize = stages[5];
+    auto& compress = stages[6];
+
+    uint64_t outBytes = 0;
+    auto sink = [&](vector<BatchedEventsList>& batchedList) {
+        for (auto& list : batchedList) {
+            for (auto& batched : list) {
+                string data, errorMsg;
+                uint64_t events = batched.mEvents.size();
+                serialize.Run(events, batched.mSizeBytes, [&]() {
+                    serializer.DoSerialize(std::move(batched), data, errorMsg);
+                });
+                string compressed;
+                compress.Run(events, data.size(), [&]() { compressor.DoCompress(data, compressed, errorMsg); });
+                // blackhole
+                outBytes += compressed.size();
+            }
+        }
+        batchedList.clear();
+    };
+
+    auto before = chrono::steady_clock::now();
+    for (int32_t round = 0; round < INT32_FLAG(pipeline_benchmark_rounds); ++round) {
+        for (const auto& chunk : chunks) {
+            PipelineEventGroup group(make_shared<SourceBuffer>());
+            StringBuffer b = group.GetSourceBuffer()->CopyString(chunk);
+            LogEvent* e = group.AddLogEvent();
+            e->SetContentNoCopy(DEFAULT_CONTENT_KEY, StringView(b.data, b.size));
+            e->SetTimestamp(1712476960);
+            group.SetTag(LOG_RESERVED_KEY_TOPIC, corpus.mName);
+
+            split.Run(1, group.DataSize(), [&]() { splitter.Process(group); });
+            parse.Run(group.GetEvents().size(), group.DataSize(), [&]() { corpus.mParser->Process(group); });
+            if (!corpus.mTimeKey.empty()) {
+                timestamp.Run(group.GetEvents().size(), group.DataSize(), [&]() { timestampParser.Process(group); });
+            }
+            filt.Run(group.GetEvents().size(), group.DataSize(), [&]() { filter.Process(group); });
+
+            vector<BatchedEventsList> batchedList;
+            batch.Run(group.GetEvents().size(), group.DataSize(), [&]() {
+                batcher.Add(std::move(group), batchedList);
+            });
+            sink(batchedList);
+        }
+        vector<BatchedEventsList> batchedList;
+        batcher.FlushAll(batchedList);
+        sink(batchedList);
+    }
+    double totalSecs = chrono::duration<double>(chrono::steady_clock::now() - before).count();
+
+    uint64_t totalEvents = lineCnt * INT32_FLAG(pipeline_benchmark_rounds);
+    uint64_t totalBytes = corpusSize * INT32_FLAG(pipeline_benchmark_rounds);
+    uint64_t totalAllocs = 0;
+    cout << "corpus: " << corpus.mName << "\tlines: " << lineCnt << "\tsize: " << corpusSize
+         << "\trounds: " << INT32_FLAG(pipeline_benchmark_rounds) << endl;
+    cout << left << setw(12) << "stage" << setw(16) << "events/s" << setw(16) << "MB/s" << setw(16)
+         << "allocs/event" << setw(12) << "p99(us)" << endl;
+    for (const auto& stage : stages) {
+        if (stage.mLatencyNs.empty()) {
+            continue;
+        }
+        Json::Value stageRes = stage.ToJson();
+        cout << left << setw(12) << stage.mName << setw(16) << fixed << setprecision(0)
+             << stageRes["events_per_sec"].asDouble() << setw(16) << setprecision(1)
+             << stageRes["bytes_per_sec"].asDouble() / 1024 / 1024 << setw(16) << setprecision(3)
+             << stageRes["allocs_per_event"].asDouble() << setw(12) << setprecision(1)
+             << stageRes["latency_p99_us"].asDouble() << endl;
+        result["stages"][stage.mName] = std::move(stageRes);
+        totalAllocs += stage.mAllocs;
+    }
+    result["total"]["events"] = static_cast<Json::UInt64>(totalEvents);
+    result["total"]["bytes"] = static_cast<Json::UInt64>(totalBytes);
+    result["total"]["output_bytes"] = static_cast<Json::UInt64>(outBytes);
+    result["total"]["time_ms"] = totalSecs * 1e3;
+    result["total"]["events_per_sec"] = totalEvents / totalSecs;
+    result["total"]["bytes_per_sec"] = totalBytes / totalSecs;
+    result["total"]["allocs_per_event"] = static_cast<double>(totalAllocs) / totalEvents;
+    cout << "total: " << fixed << setprecision(0) << totalEvents / totalSecs << " events/s\t" << setprecision(1)
+         << totalBytes / totalSecs / 1024 / 1024 << " MB/s" << endl
+         << endl;
+    return true;
+}
+
+} // namespace logtail
+
+using namespace logtail;
+
+int main(int argc, char** argv) {
+    google::ParseCommandLineFlags(&argc, &argv, true);
+    Logger::Instance().InitGlobalLoggers();
+
+    auto compressType = STRING_FLAG(pipeline_benchmark_compress_type) == "zstd" ? CompressType::ZSTD : CompressType::LZ4;
+    auto compressor = CompressorFactory::GetInstance()->Create(compressType);
+
+    Json::Value root;
+    root["compress_type"] = CompressTypeToString(compressType);
+    root["corpus_size_mb"] = INT32_FLAG(pipeline_benchmark_corpus_size_mb);
+    root["rounds"] = INT32_FLAG(pipeline_benchmark_rounds);
+    const string corporaToRun = "," + STRING_FLAG(pipeline_benchmark_corpora) + ",";
+    for (auto& corpus : CreateCorpora()) {
+        if (corporaToRun.find("," + corpus.mName + ",") == string::npos) {
+            continue;
+        }
+        if (!RunCorpus(corpus, *compressor, root["corpora"][corpus.mName])) {
+            return 1;
+        }
+    }
+
+    Json::StreamWriterBuilder builder;
+    builder["indentation"] = "  ";
+    ofstream out(STRING_FLAG(pipeline_benchmark_output), ios::trunc);
+    out << Json::writeString(builder, root) << endl;
+    cout << "result is written to " << STRING_FLAG(pipeline_benchmark_output) << endl;
+    return 0;
+}
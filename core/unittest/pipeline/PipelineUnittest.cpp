@@ -29,11 +29,16 @@
 #include "common/JsonUtil.h"
 #include "config/CollectionConfig.h"
 #include "plugin/input/InputFeedbackInterfaceRegistry.h"
+#include "plugin/processor/ProcessorFilterNative.h"
 #include "plugin/processor/inner/ProcessorSplitLogStringNative.h"
 #include "plugin/processor/inner/ProcessorSplitMultilineLogStringNative.h"
+#include "runner/ProcessorRunner.h"
 #include "unittest/Unittest.h"
 #include "unittest/plugin/PluginMock.h"
 
+DECLARE_FLAG_INT32(parallel_processing_min_chunk_events);
+DECLARE_FLAG_INT32(fused_processing_block_events);
+
 using namespace std;
 
 namespace logtail {
@@ -47,6 +52,8 @@ public:
     void OnInputFileWithJsonMultiline() const;
     void OnInputFileWithContainerDiscovery() const;
     void TestProcess() const;
+    void TestProcessInParallel() const;
+    void TestProcessFused() const;
     void TestSend() const;
     void TestFlushBatch() const;
     void TestInProcessingCount() const;
@@ -2847,6 +2854,150 @@ void PipelineUnittest::TestProcess() const {
     APSARA_TEST_EQUAL(size, pipeline.mProcessorsInSizeBytes->GetValue());
 }
 
+void PipelineUnittest::TestProcessInParallel() const {
+    CollectionPipeline pipeline;
+    pipeline.mPluginID.store(0);
+    CollectionPipelineContext ctx;
+    ctx.SetPipeline(pipeline);
+    Json::Value tmp, globalConfig;
+    globalConfig["EnableParallelProcessing"] = true;
+    pipeline.mContext.InitGlobalConfig(globalConfig, tmp);
+
+    auto input = PluginRegistry::GetInstance()->CreateInput(InputMock::sName, pipeline.GenNextPluginMeta(false));
+    input->Init(Json::Value(), ctx, 0, tmp);
+    pipeline.mInputs.emplace_back(std::move(input));
+    auto processor
+        = PluginRegistry::GetInstance()->CreateProcessor(ProcessorMock::sName, pipeline.GenNextPluginMeta(false));
+    processor->Init(Json::Value(), ctx);
+    pipeline.mProcessorLine.emplace_back(std::move(processor));
+    const auto* processorMock = static_cast<const ProcessorMock*>(pipeline.mProcessorLine[0]->mPlugin.get());
+
+    auto threadCnt = AppConfig::GetInstance()->mProcessThreadCount;
+    AppConfig::GetInstance()->mProcessThreadCount = 4;
+    INT32_FLAG(parallel_processing_min_chunk_events) = 2;
+    size_t taskCnt = 0;
+    CollectionPipeline::ParallelExecutor executor = [&taskCnt](vector<function<void()>>& tasks) {
+        taskCnt += tasks.size();
+        ProcessorRunner::GetInstance()->RunInParallel(tasks);
+    };
+    {
+        // large group is split into chunks
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(make_shared<SourceBuffer>());
+        groups.back().SetTag(string("key"), string("value"));
+        for (size_t i = 0; i < 10; ++i) {
+            groups.back().AddLogEvent()->SetContent(string("idx"), ToString(i));
+        }
+        auto inSize = groups.back().DataSize();
+        pipeline.Process(groups, 0, executor);
+        APSARA_TEST_EQUAL(4U, taskCnt);
+        APSARA_TEST_EQUAL(4U, processorMock->mCnt);
+        // group level data is counted once for all chunks
+        APSARA_TEST_EQUAL(inSize, pipeline.mProcessorLine[0]->mInSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(groups[0].DataSize(), pipeline.mProcessorLine[0]->mOutSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(1U, groups.size());
+        APSARA_TEST_EQUAL("value", groups[0].GetTag("key").to_string());
+        APSARA_TEST_EQUAL(10U, groups[0].GetEvents().size());
+        for (size_t i = 0; i < groups[0].GetEvents().size(); ++i) {
+            auto& e = groups[0].MutableEvents()[i].Cast<LogEvent>();
+            APSARA_TEST_EQUAL(&groups[0], e.GetPipelineEventGroupPtr());
+            APSARA_TEST_EQUAL(ToString(i), e.GetContent("idx").to_string());
+            APSARA_TEST_EQUAL(PROCESSOR_MOCK_LOCAL_CONTENT_VALUE,
+                              e.GetContent(PROCESSOR_MOCK_LOCAL_CONTENT_KEY).to_string());
+        }
+    }
+    {
+        // small group is processed as a whole
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(make_shared<SourceBuffer>());
+        groups.back().AddLogEvent();
+        pipeline.Process(groups, 0, executor);
+        APSARA_TEST_EQUAL(4U, taskCnt);
+        APSARA_TEST_EQUAL(5U, processorMock->mCnt);
+        APSARA_TEST_EQUAL(1U, groups[0].GetEvents().size());
+    }
+    {
+        // parallel processing is disabled
+        pipeline.mContext.InitGlobalConfig(Json::Value(Json::objectValue), tmp);
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(make_shared<SourceBuffer>());
+        for (size_t i = 0; i < 10; ++i) {
+            groups.back().AddLogEvent();
+        }
+        pipeline.Process(groups, 0, executor);
+        APSARA_TEST_EQUAL(4U, taskCnt);
+        APSARA_TEST_EQUAL(6U, processorMock->mCnt);
+    }
+    AppConfig::GetInstance()->mProcessThreadCount = threadCnt;
+    INT32_FLAG(parallel_processing_min_chunk_events) = 1024;
+}
+
+void PipelineUnittest::TestProcessFused() const {
+    CollectionPipeline pipeline;
+    pipeline.mPluginID.store(0);
+    CollectionPipelineContext ctx;
+    ctx.SetPipeline(pipeline);
+    Json::Value tmp, globalConfig;
+    globalConfig["EnableFusedProcessing"] = true;
+    pipeline.mContext.InitGlobalConfig(globalConfig, tmp);
+
+    auto input = PluginRegistry::GetInstance()->CreateInput(InputMock::sName, pipeline.GenNextPluginMeta(false));
+    input->Init(Json::Value(), ctx, 0, tmp);
+    pipeline.mInputs.emplace_back(std::move(input));
+    // mock(fused) -> filter(fused) -> mock(fused) -> mock
+    for (size_t i = 0; i < 4; ++i) {
+        unique_ptr<ProcessorInstance> processor;
+        if (i == 1) {
+            Json::Value config;
+            config["Include"]["idx"] = "[02468]";
+            processor = PluginRegistry::GetInstance()->CreateProcessor(ProcessorFilterNative::sName,
+                                                                       pipeline.GenNextPluginMeta(false));
+            processor->Init(config, ctx);
+        } else {
+            processor = PluginRegistry::GetInstance()->CreateProcessor(ProcessorMock::sName,
+                                                                       pipeline.GenNextPluginMeta(false));
+            processor->Init(Json::Value(), ctx);
+            static_cast<ProcessorMock*>(processor->mPlugin.get())->mSupportFusedProcessing = i != 3;
+        }
+        pipeline.mProcessorLine.emplace_back(std::move(processor));
+    }
+    APSARA_TEST_TRUE(pipeline.mProcessorLine[1]->SupportFusedProcessing());
+
+    INT32_FLAG(fused_processing_block_events) = 4;
+    {
+        vector<PipelineEventGroup> groups;
+        groups.emplace_back(make_shared<SourceBuffer>());
+        groups.back().SetTag(string("key"), string("value"));
+        for (size_t i = 0; i < 10; ++i) {
+            groups.back().AddLogEvent()->SetContent(string("idx"), ToString(i));
+        }
+        auto inSize = groups.back().DataSize();
+        pipeline.Process(groups, 0);
+        // fused processors run once per block
+        APSARA_TEST_EQUAL(3U, static_cast<const ProcessorMock*>(pipeline.mProcessorLine[0]->mPlugin.get())->mCnt);
+        APSARA_TEST_EQUAL(3U, static_cast<const ProcessorMock*>(pipeline.mProcessorLine[2]->mPlugin.get())->mCnt);
+        APSARA_TEST_EQUAL(1U, static_cast<const ProcessorMock*>(pipeline.mProcessorLine[3]->mPlugin.get())->mCnt);
+        // metrics of each processor sum up all blocks
+        APSARA_TEST_EQUAL(10U, pipeline.mProcessorLine[0]->mInEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(10U, pipeline.mProcessorLine[1]->mInEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(5U, pipeline.mProcessorLine[1]->mOutEventsTotal->GetValue());
+        APSARA_TEST_EQUAL(5U, pipeline.mProcessorLine[2]->mInEventsTotal->GetValue());
+        // group level data is counted once for all blocks
+        APSARA_TEST_EQUAL(inSize, pipeline.mProcessorLine[0]->mInSizeBytes->GetValue());
+        APSARA_TEST_EQUAL(groups[0].DataSize(), pipeline.mProcessorLine[2]->mOutSizeBytes->GetValue());
+
+        APSARA_TEST_EQUAL(1U, groups.size());
+        APSARA_TEST_EQUAL("value", groups[0].GetTag("key").to_string());
+        APSARA_TEST_EQUAL(5U, groups[0].GetEvents().size());
+        for (size_t i = 0; i < groups[0].GetEvents().size(); ++i) {
+            auto& e = groups[0].MutableEvents()[i].Cast<LogEvent>();
+            APSARA_TEST_EQUAL(&groups[0], e.GetPipelineEventGroupPtr());
+            APSARA_TEST_EQUAL(ToString(i * 2), e.GetContent("idx").to_string());
+        }
+    }
+    INT32_FLAG(fused_processing_block_events) = 256;
+}
+
 void PipelineUnittest::TestSend() const {
     {
         // no route
@@ -3128,6 +3279,8 @@ UNIT_TEST_CASE(PipelineUnittest, OnInitVariousTopology)
 UNIT_TEST_CASE(PipelineUnittest, OnInputFileWithJsonMultiline)
 UNIT_TEST_CASE(PipelineUnittest, OnInputFileWithContainerDiscovery)
 UNIT_TEST_CASE(PipelineUnittest, TestProcess)
+UNIT_TEST_CASE(PipelineUnittest, TestProcessInParallel)
+UNIT_TEST_CASE(PipelineUnittest, TestProcessFused)
 UNIT_TEST_CASE(PipelineUnittest, TestSend)
 UNIT_TEST_CASE(PipelineUnittest, TestFlushBatch)
 UNIT_TEST_CASE(PipelineUnittest, TestInProcessingCount)
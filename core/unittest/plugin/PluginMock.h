@@ -113,11 +113,13 @@ public:
         }
         ++mCnt;
     };
+    bool SupportFusedProcessing() const override { return mSupportFusedProcessing; }
 
     void Block() { mBlockFlag = true; }
     void Unblock() { mBlockFlag = false; }
 
     uint32_t mCnt = 0;
+    bool mSupportFusedProcessing = false;
 
 protected:
     bool IsSupportedEvent(const PipelineEventPtr& e) const override { return true; };
@@ -0,0 +1,212 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "json/json.h"
+
+#include "collection_pipeline/CollectionPipelineContext.h"
+#include "common/Flags.h"
+#include "file_server/ConfigManager.h"
+#include "file_server/FileDiscoveryOptions.h"
+#include "file_server/FileServer.h"
+#include "file_server/polling/PollingDirFile.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(polling_dir_file_thread_count);
+DECLARE_FLAG_INT32(polling_dir_file_full_stat_round);
+
+using namespace std;
+
+namespace logtail {
+
+class PollingDirFileUnittest : public testing::Test {
+public:
+    void TestParallelTasksSameCache();
+    void TestSkipStatInUnchangedDir();
+    void TestWildcardSkipRegularFile();
+
+protected:
+    void SetUp() override {
+        mRootDir = (filesystem::temp_directory_path() / "polling_dir_file_unittest").string();
+        filesystem::remove_all(mRootDir);
+        filesystem::create_directories(mRootDir);
+        auto* polling = PollingDirFile::GetInstance();
+        polling->ClearCache();
+        polling->mRuningFlag = true;
+        polling->mHoldOnFlag = false;
+    }
+
+    void TearDown() override {
+        for (const auto& name : mConfigNames) {
+            FileServer::GetInstance()->RemoveFileDiscoveryConfig(name);
+        }
+        mConfigNames.clear();
+        mOpts.clear();
+        ConfigManager::GetInstance()->ClearFilePipelineMatchCache();
+        auto* polling = PollingDirFile::GetInstance();
+        polling->StopWorkers();
+        polling->ClearCache();
+        polling->mRuningFlag = false;
+        INT32_FLAG(polling_dir_file_thread_count) = 1;
+        INT32_FLAG(polling_dir_file_full_stat_round) = 1;
+        filesystem::remove_all(mRootDir);
+    }
+
+    void AddConfig(const string& name, const string& filePath, int32_t maxDirSearchDepth = 0) {
+        Json::Value configJson;
+        configJson["FilePaths"].append(Json::Value(filePath));
+        configJson["MaxDirSearchDepth"] = Json::Value(maxDirSearchDepth);
+        mOpts.emplace_back(new FileDiscoveryOptions());
+        APSARA_TEST_TRUE_FATAL(mOpts.back()->Init(configJson, mCtx, "test"));
+        FileServer::GetInstance()->AddFileDiscoveryConfig(name, mOpts.back().get(), &mCtx);
+        mConfigNames.push_back(name);
+    }
+
+    static void CreateFile(const filesystem::path& path) {
+        filesystem::create_directories(path.parent_path());
+        ofstream(path) << "0\n";
+    }
+
+    static set<string> DirCacheKeys() {
+        set<string> keys;
+        for (const auto& item : PollingDirFile::GetInstance()->mDirCacheMap) {
+            keys.insert(item.first);
+        }
+        return keys;
+    }
+
+    static set<string> FileCacheKeys() {
+        set<string> keys;
+        for (const auto& item : PollingDirFile::GetInstance()->mFileCacheMap) {
+            keys.insert(item.first);
+        }
+        return keys;
+    }
+
+    string mRootDir;
+    CollectionPipelineContext mCtx;
+    vector<unique_ptr<FileDiscoveryOptions>> mOpts;
+    vector<string> mConfigNames;
+};
+
+void PollingDirFileUnittest::TestParallelTasksSameCache() {
+    for (int i = 0; i < 4; ++i) {
+        auto baseDir = filesystem::path(mRootDir) / ("base" + to_string(i));
+        for (int j = 0; j < 3; ++j) {
+            CreateFile(baseDir / ("sub" + to_string(j)) / "0.log");
+            CreateFile(baseDir / ("sub" + to_string(j)) / "1.log");
+        }
+        CreateFile(baseDir / "ignored.txt");
+        AddConfig("base" + to_string(i), (baseDir / "**" / "*.log").string(), 2);
+    }
+    auto* polling = PollingDirFile::GetInstance();
+
+    polling->PollingIteration();
+    auto dirKeys = DirCacheKeys();
+    auto fileKeys = FileCacheKeys();
+    APSARA_TEST_EQUAL(16U, dirKeys.size());
+    APSARA_TEST_EQUAL(24U, fileKeys.size());
+
+    polling->ClearCache();
+    INT32_FLAG(polling_dir_file_thread_count) = 4;
+    polling->StartWorkers();
+    APSARA_TEST_EQUAL(3U, polling->mWorkerThreads.size());
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(dirKeys, DirCacheKeys());
+    APSARA_TEST_EQUAL(fileKeys, FileCacheKeys());
+
+    // Workers are reused in the following rounds.
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(dirKeys, DirCacheKeys());
+    APSARA_TEST_EQUAL(fileKeys, FileCacheKeys());
+    polling->StopWorkers();
+    APSARA_TEST_TRUE(polling->mWorkerThreads.empty());
+}
+
+void PollingDirFileUnittest::TestSkipStatInUnchangedDir() {
+    auto baseDir = filesystem::path(mRootDir) / "base";
+    for (int i = 0; i < 5; ++i) {
+        CreateFile(baseDir / (to_string(i) + ".log"));
+    }
+    CreateFile(baseDir / "ignored.txt");
+    AddConfig("base", (baseDir / "*.log").string());
+    INT32_FLAG(polling_dir_file_full_stat_round) = 3;
+    auto* polling = PollingDirFile::GetInstance();
+
+    // Round 1: new directory, the base dir and all files are stat-ed.
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(6, polling->mRoundStatCount.load());
+    APSARA_TEST_EQUAL(0, polling->mRoundSkippedStatCount.load());
+    APSARA_TEST_EQUAL(5U, polling->mFileCacheMap.size());
+
+    // Round 2: unchanged directory, cached files skip stat.
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(1, polling->mRoundStatCount.load());
+    APSARA_TEST_EQUAL(5, polling->mRoundSkippedStatCount.load());
+    for (const auto& item : polling->mFileCacheMap) {
+        APSARA_TEST_EQUAL(2U, item.second.GetLastCheckRound());
+    }
+
+    // Round 3: full stat round.
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(6, polling->mRoundStatCount.load());
+    APSARA_TEST_EQUAL(0, polling->mRoundSkippedStatCount.load());
+
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(1, polling->mRoundStatCount.load());
+    APSARA_TEST_EQUAL(5, polling->mRoundSkippedStatCount.load());
+
+    // Round 5: a new file changes the modified time of the directory, all files are stat-ed.
+    this_thread::sleep_for(chrono::milliseconds(20));
+    CreateFile(baseDir / "5.log");
+    polling->PollingIteration();
+    APSARA_TEST_EQUAL(7, polling->mRoundStatCount.load());
+    APSARA_TEST_EQUAL(0, polling->mRoundSkippedStatCount.load());
+    APSARA_TEST_EQUAL(6U, polling->mFileCacheMap.size());
+}
+
+void PollingDirFileUnittest::TestWildcardSkipRegularFile() {
+    auto baseDir = filesystem::path(mRootDir) / "wildcard";
+    CreateFile(baseDir / "a" / "log" / "0.log");
+    CreateFile(baseDir / "b" / "log" / "0.log");
+    for (int i = 0; i < 3; ++i) {
+        CreateFile(baseDir / (to_string(i) + ".txt"));
+    }
+    AddConfig("wildcard", (baseDir / "*" / "log" / "*.log").string());
+    auto* polling = PollingDirFile::GetInstance();
+
+    polling->PollingIteration();
+    // Regular files can not match the wildcard part, so they are not stat-ed.
+    APSARA_TEST_EQUAL(3, polling->mRoundSkippedStatCount.load());
+    auto fileKeys = FileCacheKeys();
+    APSARA_TEST_EQUAL(2U, fileKeys.size());
+    APSARA_TEST_EQUAL(1U, fileKeys.count((baseDir / "a" / "log" / "0.log").string()));
+    APSARA_TEST_EQUAL(1U, fileKeys.count((baseDir / "b" / "log" / "0.log").string()));
+}
+
+UNIT_TEST_CASE(PollingDirFileUnittest, TestParallelTasksSameCache)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestSkipStatInUnchangedDir)
+UNIT_TEST_CASE(PollingDirFileUnittest, TestWildcardSkipRegularFile)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
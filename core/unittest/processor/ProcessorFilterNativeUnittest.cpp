@@ -31,6 +31,7 @@ public:
     void TestLogFilterRule();
     void TestBaseFilter();
     void TestFilterNoneUtf8();
+    void TestRegexEngine();
 
     CollectionPipelineContext mContext;
 };
@@ -40,6 +41,7 @@ UNIT_TEST_CASE(ProcessorFilterNativeUnittest, OnFailedInit)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestLogFilterRule)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestBaseFilter)
 UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestFilterNoneUtf8)
+UNIT_TEST_CASE(ProcessorFilterNativeUnittest, TestRegexEngine)
 
 PluginInstance::PluginMeta getPluginMeta() {
     PluginInstance::PluginMeta pluginMeta{"1"};
@@ -1088,6 +1090,177 @@ void ProcessorFilterNativeUnittest::TestFilterNoneUtf8() {
     }
 } // end of case
 
+void ProcessorFilterNativeUnittest::TestRegexEngine() {
+    // FilterKey + FilterRegex, regexes on the same key are checked together
+    {
+        Json::Value config;
+        config["FilterKey"] = Json::arrayValue;
+        config["FilterKey"].append("key1");
+        config["FilterKey"].append("key2");
+        config["FilterKey"].append("key1");
+        config["FilterRegex"] = Json::arrayValue;
+        config["FilterRegex"].append(".*value1.*");
+        config["FilterRegex"].append("value2.*");
+        config["FilterRegex"].append("abc.*");
+        config["RegexEngine"] = "re2";
+
+        ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+        APSARA_TEST_EQUAL(3U, processor.mFilterRule->FilterRegs.size());
+        APSARA_TEST_EQUAL(2U, processor.mFilterRule->Matchers.size());
+        APSARA_TEST_EQUAL("key1", processor.mFilterRule->Matchers[0].first);
+        APSARA_TEST_NOT_EQUAL(nullptr, processor.mFilterRule->Matchers[0].second.mRE2Set);
+        APSARA_TEST_EQUAL(nullptr, processor.mFilterRule->Matchers[1].second.mRE2Set);
+
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        std::string inJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "key1" : "abcvalue1",
+                        "key2" : "value2xxxxx"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "key1" : "value1xxxxx",
+                        "key2" : "value2xxxxx"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "key1" : "abcvalue1",
+                        "key2" : "xvalue2"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                }
+            ]
+        })";
+        eventGroup.FromJsonString(inJson);
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+
+        std::string expectJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "key1" : "abcvalue1",
+                        "key2" : "value2xxxxx"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                }
+            ]
+        })";
+        APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(eventGroupList[0].ToJsonString()).c_str());
+    }
+    // ConditionExp, patterns not supported by RE2 fall back to boost
+    {
+        Json::Value root;
+        root["operator"] = "or";
+        Json::Value operands1;
+        operands1["key"] = "key1";
+        operands1["exp"] = "(a+)b\\1";
+        operands1["type"] = "regex";
+        Json::Value operands2;
+        operands2["key"] = "key2";
+        operands2["exp"] = "value2.*";
+        operands2["type"] = "regex";
+        root["operands"].append(operands1);
+        root["operands"].append(operands2);
+
+        Json::Value config;
+        config["ConditionExp"] = root;
+        config["RegexEngine"] = "re2";
+
+        ProcessorFilterNative& processor = *(new ProcessorFilterNative);
+        ProcessorInstance processorInstance(&processor, getPluginMeta());
+        APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, mContext));
+
+        auto sourceBuffer = std::make_shared<SourceBuffer>();
+        PipelineEventGroup eventGroup(sourceBuffer);
+        std::string inJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "key1" : "aaba"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "key1" : "aabaa"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "key2" : "value2"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                }
+            ]
+        })";
+        eventGroup.FromJsonString(inJson);
+        std::vector<PipelineEventGroup> eventGroupList;
+        eventGroupList.emplace_back(std::move(eventGroup));
+        processorInstance.Process(eventGroupList);
+
+        std::string expectJson = R"({
+            "events" :
+            [
+                {
+                    "contents" :
+                    {
+                        "key1" : "aabaa"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                },
+                {
+                    "contents" :
+                    {
+                        "key2" : "value2"
+                    },
+                    "timestamp" : 12345678901,
+                    "timestampNanosecond" : 0,
+                    "type" : 1
+                }
+            ]
+        })";
+        APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(eventGroupList[0].ToJsonString()).c_str());
+    }
+}
+
 } // namespace logtail
 
 UNIT_TEST_MAIN
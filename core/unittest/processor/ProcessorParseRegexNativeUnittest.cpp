@@ -35,6 +35,7 @@ public:
     void TestProcessEventKeyCountUnmatch();
     void TestProcessRegexRaw();
     void TestProcessRegexContent();
+    void TestProcessRegexByRE2();
 
 protected:
     void SetUp() override { ctx.SetConfigName("test_config"); }
@@ -651,6 +652,103 @@ void ProcessorParseRegexNativeUnittest::TestProcessEventKeyCountUnmatch() {
     APSARA_TEST_EQUAL_FATAL(0, processor.mOutFailedEventsTotal->GetValue());
 }
 
+void ProcessorParseRegexNativeUnittest::TestProcessRegexByRE2() {
+    // make config
+    Json::Value config;
+    config["SourceKey"] = "content";
+    config["Regex"] = R"((\w+)\t(\w+)?.*)";
+    config["Keys"] = Json::arrayValue;
+    config["Keys"].append("key1");
+    config["Keys"].append("key2");
+    config["KeepingSourceWhenParseFail"] = true;
+    config["RenamedSourceKey"] = "rawLog";
+    config["RegexEngine"] = "re2";
+    // make events
+    auto sourceBuffer = std::make_shared<SourceBuffer>();
+    PipelineEventGroup eventGroup(sourceBuffer);
+    std::string inJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "content" : "value1\tvalue2\nline2"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "content" : "value3\t"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "content" : "value5"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    eventGroup.FromJsonString(inJson);
+    // run function
+    ProcessorParseRegexNative& processor = *(new ProcessorParseRegexNative);
+    ProcessorInstance processorInstance(&processor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(processorInstance.Init(config, ctx));
+    APSARA_TEST_TRUE(RegexEngineType::RE2 == processor.mReg.GetEngineType());
+    std::vector<PipelineEventGroup> eventGroupList;
+    eventGroupList.emplace_back(std::move(eventGroup));
+    processorInstance.Process(eventGroupList);
+
+    // judge result
+    std::string expectJson = R"({
+        "events" :
+        [
+            {
+                "contents" :
+                {
+                    "key1" : "value1",
+                    "key2" : "value2"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "key1" : "value3",
+                    "key2" : ""
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            },
+            {
+                "contents" :
+                {
+                    "rawLog" : "value5"
+                },
+                "timestamp" : 12345678901,
+                "type" : 1
+            }
+        ]
+    })";
+    std::string outJson = eventGroupList[0].ToJsonString();
+    APSARA_TEST_STREQ_FATAL(CompactJson(expectJson).c_str(), CompactJson(outJson).c_str());
+    APSARA_TEST_EQUAL_FATAL(1, processor.mOutFailedEventsTotal->GetValue());
+
+    // patterns not supported by RE2 fall back to boost
+    config["Regex"] = R"((\w+)\t(\1).*)";
+    ProcessorParseRegexNative& fallbackProcessor = *(new ProcessorParseRegexNative);
+    ProcessorInstance fallbackInstance(&fallbackProcessor, getPluginMeta());
+    APSARA_TEST_TRUE_FATAL(fallbackInstance.Init(config, ctx));
+    APSARA_TEST_TRUE(RegexEngineType::BOOST == fallbackProcessor.mReg.GetEngineType());
+}
+
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, OnSuccessfulInit)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessWholeLine)
@@ -661,6 +759,7 @@ UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventDiscardUnmatch
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessEventKeyCountUnmatch)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexRaw)
 UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexContent)
+UNIT_TEST_CASE(ProcessorParseRegexNativeUnittest, TestProcessRegexByRE2)
 
 } // namespace logtail
 
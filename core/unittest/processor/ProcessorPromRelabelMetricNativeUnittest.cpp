@@ -33,6 +33,7 @@ public:
     void TestProcess();
     void TestAddAutoMetrics();
     void TestHonorLabels();
+    void TestRelabelCache();
 
     CollectionPipelineContext mContext;
 };
@@ -41,6 +42,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestInit() {
     Json::Value config;
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     // success config
     string configStr;
@@ -82,6 +84,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestProcess() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -171,6 +174,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestAddAutoMetrics() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -249,6 +253,7 @@ void ProcessorPromRelabelMetricNativeUnittest::TestHonorLabels() {
 
     ProcessorPromRelabelMetricNative processor;
     processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
 
     string configStr;
     string errorMsg;
@@ -297,10 +302,82 @@ test_metric8{k1="v1", k3="v2", } 9.9410452992e+10 1715829785083
     APSARA_TEST_EQUAL("v2", eventGroup.GetEvents().at(7).Cast<MetricEvent>().GetTag(string("exported_k3")).to_string());
 }
 
+void ProcessorPromRelabelMetricNativeUnittest::TestRelabelCache() {
+    Json::Value config;
+    ProcessorPromRelabelMetricNative processor;
+    processor.SetContext(mContext);
+    processor.SetMetricsRecordRef(ProcessorPromRelabelMetricNative::sName, "1");
+
+    string errorMsg;
+    string configStr = R"JSON(
+        {
+            "job_name": "test_job",
+            "metric_relabel_configs": [
+                {
+                    "action": "drop",
+                    "regex": "v.*",
+                    "source_labels": ["k3"]
+                },
+                {
+                    "action": "replace",
+                    "regex": "(.*)",
+                    "replacement": "${1}_new",
+                    "source_labels": ["k1"],
+                    "target_label": "k4"
+                },
+                {
+                    "action": "labeldrop",
+                    "regex": "k2"
+                }
+            ]
+        }
+    )JSON";
+    APSARA_TEST_TRUE(ParseJsonTable(configStr, config, errorMsg));
+    APSARA_TEST_TRUE(processor.Init(config));
+    APSARA_TEST_NOT_EQUAL(nullptr, processor.mRelabelCache);
+
+    string rawData = R"""(
+test_metric1{k1="v1", k2="v2"} 1.0
+test_metric2{k1="v1", k3="v3"} 2.0
+test_metric3{k1="v2", k2="v2"} 3.0
+)""";
+    vector<string> results;
+    for (size_t round = 0; round < 2; ++round) {
+        auto parser = TextParser();
+        auto eventGroup = parser.Parse(rawData, 0, 0);
+        eventGroup.SetTag(string("instance"), string("localhost:8080"));
+        processor.Process(eventGroup);
+
+        APSARA_TEST_EQUAL(2U, eventGroup.GetEvents().size());
+        string result;
+        for (auto& e : eventGroup.MutableEvents()) {
+            auto& metricEvent = e.Cast<MetricEvent>();
+            APSARA_TEST_FALSE(metricEvent.HasTag("k2"));
+            APSARA_TEST_EQUAL("localhost:8080", metricEvent.GetTag("instance").to_string());
+            metricEvent.SortTags();
+            result += metricEvent.GetName().to_string();
+            for (auto it = metricEvent.TagsBegin(); it != metricEvent.TagsEnd(); ++it) {
+                result += "|" + it->first.to_string() + "=" + it->second.to_string();
+            }
+            result += "\n";
+        }
+        results.push_back(result);
+    }
+    // results from cache are the same as those computed
+    APSARA_TEST_EQUAL(results[0], results[1]);
+    APSARA_TEST_EQUAL("test_metric1|instance=localhost:8080|k1=v1|k4=v1_new\n"
+                      "test_metric3|instance=localhost:8080|k1=v2|k4=v2_new\n",
+                      results[0]);
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheMissesTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCacheHitsTotal->GetValue());
+    APSARA_TEST_EQUAL(3U, processor.mRelabelCache->size());
+}
+
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestInit)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestProcess)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestAddAutoMetrics)
 UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestHonorLabels)
+UNIT_TEST_CASE(ProcessorPromRelabelMetricNativeUnittest, TestRelabelCache)
 
 
 } // namespace logtail
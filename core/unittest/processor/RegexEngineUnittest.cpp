@@ -0,0 +1,142 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <string>
+#include <vector>
+
+#include "plugin/processor/RegexEngine.h"
+#include "unittest/Unittest.h"
+
+using namespace std;
+
+namespace logtail {
+
+class RegexEngineUnittest : public ::testing::Test {
+public:
+    void TestParseRegexEngineType();
+    void TestFallback();
+    void TestMatchConsistency();
+    void TestSetMatcher();
+};
+
+void RegexEngineUnittest::TestParseRegexEngineType() {
+    RegexEngineType type = RegexEngineType::BOOST;
+    APSARA_TEST_TRUE(ParseRegexEngineType("RE2", type));
+    APSARA_TEST_TRUE(RegexEngineType::RE2 == type);
+    APSARA_TEST_TRUE(ParseRegexEngineType("boost", type));
+    APSARA_TEST_TRUE(RegexEngineType::BOOST == type);
+    APSARA_TEST_FALSE(ParseRegexEngineType("hyperscan", type));
+    APSARA_TEST_EQUAL("re2", RegexEngineTypeToString(RegexEngineType::RE2));
+}
+
+void RegexEngineUnittest::TestFallback() {
+    RegexMatcher matcher;
+    APSARA_TEST_TRUE(matcher.Init("(\\w+) (\\w+)", RegexEngineType::RE2));
+    APSARA_TEST_TRUE(RegexEngineType::RE2 == matcher.GetEngineType());
+    APSARA_TEST_EQUAL(2U, matcher.GetCaptureGroupCount());
+
+    // backreference
+    APSARA_TEST_TRUE(matcher.Init("(a)\\1", RegexEngineType::RE2));
+    APSARA_TEST_TRUE(RegexEngineType::BOOST == matcher.GetEngineType());
+    // lookbehind
+    APSARA_TEST_TRUE(matcher.Init("(?<=a)b", RegexEngineType::RE2));
+    APSARA_TEST_TRUE(RegexEngineType::BOOST == matcher.GetEngineType());
+    APSARA_TEST_EQUAL(nullptr, matcher.mRE2);
+
+    APSARA_TEST_FALSE(matcher.Init("(a", RegexEngineType::RE2));
+    APSARA_TEST_FALSE(matcher.Init("(a", RegexEngineType::BOOST));
+}
+
+void RegexEngineUnittest::TestMatchConsistency() {
+    const vector<string> patterns = {
+        R"re((\S+)\s+-\s+-\s+\[([^\]]+)]\s+"(\w+)\s+([^"]*)"\s+(\S+).*)re",
+        ".*value1",
+        "a.b",
+        "^abc$\n?.*",
+        "(a+)(b*)?c",
+        "(a|ab)(c|bcd)(d*)",
+        R"(\d+\.\d+)",
+        "中(.)文",
+        "(?i)POST|PUT",
+        "x*",
+    };
+    const vector<string> inputs = {
+        R"re(127.0.0.1 - - [07/Jul/2022:10:43:30 +0800] "POST /PutData?Category=YunOsAccountOpLog" 0.024 18204)re",
+        "xx value1",
+        "a\nb",
+        "abc\nzzz",
+        "aaac",
+        "abcd",
+        "12.5",
+        "中X文",
+        "post",
+        "",
+        "xxxx",
+    };
+    for (const auto& pattern : patterns) {
+        RegexMatcher boostMatcher, re2Matcher;
+        APSARA_TEST_TRUE(boostMatcher.Init(pattern, RegexEngineType::BOOST));
+        APSARA_TEST_TRUE(re2Matcher.Init(pattern, RegexEngineType::RE2));
+        APSARA_TEST_TRUE(RegexEngineType::RE2 == re2Matcher.GetEngineType());
+        APSARA_TEST_EQUAL(boostMatcher.GetCaptureGroupCount(), re2Matcher.GetCaptureGroupCount());
+        for (const auto& input : inputs) {
+            string exception;
+            vector<StringView> boostGroups, re2Groups;
+            bool boostRes = boostMatcher.Match(input.data(), input.size(), boostGroups, exception);
+            bool re2Res = re2Matcher.Match(input.data(), input.size(), re2Groups, exception);
+            APSARA_TEST_EQUAL(boostRes, re2Res);
+            APSARA_TEST_EQUAL(boostRes, re2Matcher.Match(input.data(), input.size(), exception));
+            APSARA_TEST_EQUAL(boostGroups.size(), re2Groups.size());
+            for (size_t i = 0; i < boostGroups.size() && i < re2Groups.size(); ++i) {
+                APSARA_TEST_EQUAL(boostGroups[i], re2Groups[i]);
+            }
+        }
+    }
+}
+
+void RegexEngineUnittest::TestSetMatcher() {
+    string exception;
+    {
+        RegexSetMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Init({".*a.*", ".*b.*", "[a-z]+"}, RegexEngineType::RE2));
+        APSARA_TEST_NOT_EQUAL(nullptr, matcher.mRE2Set);
+        APSARA_TEST_TRUE(matcher.MatchAll("ab", 2, exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("aa", 2, exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("ab1", 3, exception));
+    }
+    {
+        // one regex not supported by RE2, match one by one
+        RegexSetMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Init({".*a.*", "(a)\\1b"}, RegexEngineType::RE2));
+        APSARA_TEST_EQUAL(nullptr, matcher.mRE2Set);
+        APSARA_TEST_TRUE(matcher.MatchAll("aab", 3, exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("ab", 2, exception));
+    }
+    {
+        RegexSetMatcher matcher;
+        APSARA_TEST_TRUE(matcher.Init({".*a.*", ".*b.*"}, RegexEngineType::BOOST));
+        APSARA_TEST_EQUAL(nullptr, matcher.mRE2Set);
+        APSARA_TEST_TRUE(matcher.MatchAll("ab", 2, exception));
+        APSARA_TEST_FALSE(matcher.MatchAll("a", 1, exception));
+    }
+}
+
+UNIT_TEST_CASE(RegexEngineUnittest, TestParseRegexEngineType)
+UNIT_TEST_CASE(RegexEngineUnittest, TestFallback)
+UNIT_TEST_CASE(RegexEngineUnittest, TestMatchConsistency)
+UNIT_TEST_CASE(RegexEngineUnittest, TestSetMatcher)
+
+} // namespace logtail
+
+UNIT_TEST_MAIN
@@ -245,7 +245,7 @@ void ScrapeSchedulerUnittest::TestScheduler() {
     event.SetComponent(&eventPool);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(Timer::GetInstance()->mQueue.size() == 1);
+    APSARA_TEST_TRUE(Timer::GetInstance()->mWheel.Size() == 1);
 
     event.Cancel();
 
@@ -309,15 +309,15 @@ void ScrapeSchedulerUnittest::TestQueueIsFull() {
     event.SetFirstExecTime(now, nowScrape);
     event.ScheduleNext();
 
-    APSARA_TEST_TRUE(Timer::GetInstance()->mQueue.size() == 1);
+    APSARA_TEST_TRUE(Timer::GetInstance()->mWheel.Size() == 1);
 
-    const auto& e = Timer::GetInstance()->mQueue.top();
+    const auto& e = Timer::GetInstance()->mWheel.Top();
     APSARA_TEST_EQUAL(now, e->GetExecTime());
     APSARA_TEST_FALSE(e->IsValid());
-    Timer::GetInstance()->mQueue.pop();
+    Timer::GetInstance()->mWheel.Pop();
     // queue is full, so it should schedule next after 1 second
-    APSARA_TEST_EQUAL(1UL, Timer::GetInstance()->mQueue.size());
-    const auto& next = Timer::GetInstance()->mQueue.top();
+    APSARA_TEST_EQUAL(1UL, Timer::GetInstance()->mWheel.Size());
+    const auto& next = Timer::GetInstance()->mWheel.Top();
     APSARA_TEST_EQUAL(now + std::chrono::seconds(1), next->GetExecTime());
 }
 
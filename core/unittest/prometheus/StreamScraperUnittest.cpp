@@ -17,6 +17,7 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "EventPool.h"
 #include "Flags.h"
@@ -35,6 +36,7 @@ namespace logtail::prom {
 class StreamScraperUnittest : public testing::Test {
 public:
     void TestStreamMetricWriteCallback();
+    void TestStreamMetricWriteCallbackWithSmallChunks();
     void TestStreamSendMetric();
 
 
@@ -112,6 +114,41 @@ void StreamScraperUnittest::TestStreamMetricWriteCallback() {
     APSARA_TEST_EQUAL("go_memstats_alloc_bytes_total 1.5159292e+08", res.GetEvents()[10].Cast<RawEvent>().GetContent());
 }
 
+void StreamScraperUnittest::TestStreamMetricWriteCallbackWithSmallChunks() {
+    EventPool eventPool{true};
+
+    string body = "# HELP go_goroutines Number of goroutines that currently exist.\n"
+                  "# TYPE go_goroutines gauge\n"
+                  "go_goroutines 7\n"
+                  "\n"
+                  "go_info{version=\"go1.22.3\"} 1\n"
+                  "  # comment\n"
+                  "go_memstats_alloc_bytes 6.742688e+06\n"
+                  "go_memstats_alloc_bytes_total 1.5159292e+08";
+    vector<string> expected = {"go_goroutines 7",
+                               "go_info{version=\"go1.22.3\"} 1",
+                               "go_memstats_alloc_bytes 6.742688e+06",
+                               "go_memstats_alloc_bytes_total 1.5159292e+08"};
+
+    for (size_t chunkSize = 1; chunkSize <= body.size(); ++chunkSize) {
+        Labels labels;
+        auto streamScraper = make_shared<StreamScraper>(labels, 0, 0, "id", nullptr, std::chrono::system_clock::now());
+        streamScraper->mEventPool = &eventPool;
+        for (size_t pos = 0; pos < body.size(); pos += chunkSize) {
+            size_t len = min(chunkSize, body.size() - pos);
+            APSARA_TEST_EQUAL(len, StreamScraper::MetricWriteCallback(body.data() + pos, 1, len, streamScraper.get()));
+        }
+        streamScraper->FlushCache();
+        auto& res = streamScraper->mEventGroup;
+        APSARA_TEST_EQUAL(expected.size(), res.GetEvents().size());
+        for (size_t i = 0; i < expected.size() && i < res.GetEvents().size(); ++i) {
+            APSARA_TEST_EQUAL(expected[i], res.GetEvents()[i].Cast<RawEvent>().GetContent().to_string());
+        }
+        APSARA_TEST_EQUAL(body.size(), streamScraper->mRawSize);
+        APSARA_TEST_EQUAL(expected.size(), streamScraper->mScrapeSamplesScraped);
+    }
+}
+
 void StreamScraperUnittest::TestStreamSendMetric() {
     EventPool eventPool{true};
 
@@ -181,6 +218,7 @@ void StreamScraperUnittest::TestStreamSendMetric() {
 
 
 UNIT_TEST_CASE(StreamScraperUnittest, TestStreamMetricWriteCallback)
+UNIT_TEST_CASE(StreamScraperUnittest, TestStreamMetricWriteCallbackWithSmallChunks)
 UNIT_TEST_CASE(StreamScraperUnittest, TestStreamSendMetric)
 
 
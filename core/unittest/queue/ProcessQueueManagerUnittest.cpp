@@ -12,13 +12,18 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <chrono>
+#include <future>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include "collection_pipeline/CollectionPipelineManager.h"
 #include "collection_pipeline/queue/ExactlyOnceQueueManager.h"
 #include "collection_pipeline/queue/ProcessQueueManager.h"
 #include "collection_pipeline/queue/QueueKeyManager.h"
 #include "collection_pipeline/queue/QueueParam.h"
+#include "common/StringTools.h"
 #include "models/PipelineEventGroup.h"
 #include "unittest/Unittest.h"
 
@@ -36,6 +41,10 @@ public:
     void TestPopItem();
     void TestIsAllQueueEmpty();
     void OnPipelineUpdate();
+    void TestShardedPopItem();
+    void TestShardedUpdateAndDeleteQueue();
+    void TestShardedPushQueue();
+    void TestWaitForPop();
 
 protected:
     static void SetUpTestCase() { sProcessQueueManager = ProcessQueueManager::GetInstance(); }
@@ -451,6 +460,180 @@ void ProcessQueueManagerUnittest::OnPipelineUpdate() {
     }
 }
 
+void ProcessQueueManagerUnittest::TestShardedPopItem() {
+    sProcessQueueManager->mShardedScheduling = true;
+    sProcessQueueManager->InitShards(2);
+
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    bool isStolen = false;
+    CollectionPipelineContext ctx;
+    // key 0 and 2 belong to shard 0, key 1 and 3 belong to shard 1
+    for (QueueKey key = 0; key < 4; ++key) {
+        string name = "test_config_" + ToString(key);
+        ctx.SetConfigName(name);
+        QueueKeyManager::GetInstance()->GetKey(name);
+        sProcessQueueManager->CreateOrUpdateBoundedQueue(key, key < 2 ? 1 : 0, ctx);
+        sProcessQueueManager->EnablePop(name);
+    }
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[0]->mQueues[0].size());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[0]->mQueues[1].size());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[1]->mQueues[0].size());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[1]->mQueues[1].size());
+
+    // item from own shard
+    sProcessQueueManager->PushQueue(1, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(1, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_FALSE(isStolen);
+
+    // item stolen from other shard
+    sProcessQueueManager->PushQueue(1, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_1", configName);
+    APSARA_TEST_TRUE(isStolen);
+
+    // higher priority item in other shard goes before lower priority item in own shard
+    sProcessQueueManager->PushQueue(0, GenerateItem());
+    sProcessQueueManager->PushQueue(3, GenerateItem());
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_3", configName);
+    APSARA_TEST_TRUE(isStolen);
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_0", configName);
+    APSARA_TEST_FALSE(isStolen);
+
+    // ready bit is cleared when nothing can be popped
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(0, item, configName, &isStolen));
+    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mShards[0]->mReadyMask.load());
+    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mShards[1]->mReadyMask.load());
+
+    // items blocked by disabled pop become poppable after the queue is enabled
+    sProcessQueueManager->DisablePop("test_config_2", false);
+    sProcessQueueManager->PushQueue(2, GenerateItem());
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(1, item, configName, &isStolen));
+    sProcessQueueManager->EnablePop("test_config_2");
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(1, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_2", configName);
+    APSARA_TEST_TRUE(isStolen);
+
+    // exactly once queue is never stolen
+    ctx.SetConfigName("test_config_5");
+    ExactlyOnceQueueManager::GetInstance()->CreateOrUpdateQueue(5, 0, ctx, vector<RangeCheckpointPtr>(5));
+    ExactlyOnceQueueManager::GetInstance()->EnablePopProcessQueue("test_config_5");
+    sProcessQueueManager->PushQueue(5, GenerateItem());
+    APSARA_TEST_FALSE(sProcessQueueManager->PopItem(1, item, configName, &isStolen));
+    APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName, &isStolen));
+    APSARA_TEST_EQUAL("test_config_5", configName);
+    APSARA_TEST_FALSE(isStolen);
+
+    sProcessQueueManager->mShardedScheduling = false;
+}
+
+void ProcessQueueManagerUnittest::TestShardedUpdateAndDeleteQueue() {
+    sProcessQueueManager->mShardedScheduling = true;
+    sProcessQueueManager->InitShards(2);
+
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx);
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(2, 0, sCtx);
+    auto& shard = *sProcessQueueManager->mShards[0];
+    APSARA_TEST_EQUAL(2U, shard.mQueues[0].size());
+    APSARA_TEST_TRUE(shard.mCurrentQueue[0] == shard.mQueues[0].begin());
+
+    // update priority
+    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 2, sCtx));
+    APSARA_TEST_EQUAL(1U, shard.mQueues[0].size());
+    APSARA_TEST_EQUAL(1U, shard.mQueues[2].size());
+    APSARA_TEST_EQUAL(2, shard.mQueues[0].front()->GetKey());
+    APSARA_TEST_TRUE(shard.mCurrentQueue[0] == shard.mQueues[0].begin());
+
+    // update queue type
+    APSARA_TEST_TRUE(sProcessQueueManager->CreateOrUpdateCircularQueue(0, 2, 100, sCtx));
+    APSARA_TEST_EQUAL(1U, shard.mQueues[2].size());
+    APSARA_TEST_TRUE(shard.mQueues[2].front() == sProcessQueueManager->mQueues[0].first->get());
+
+    // delete queue
+    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(2));
+    APSARA_TEST_TRUE(shard.mQueues[0].empty());
+    APSARA_TEST_TRUE(shard.mCurrentQueue[0] == shard.mQueues[0].end());
+
+    sProcessQueueManager->mShardedScheduling = false;
+}
+
+void ProcessQueueManagerUnittest::TestShardedPushQueue() {
+    sProcessQueueManager->mShardedScheduling = true;
+    sProcessQueueManager->InitShards(2);
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(0, 0, sCtx);
+    sProcessQueueManager->CreateOrUpdateCircularQueue(1, 0, 100, sCtx);
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[0]->mQueueMap.count(0));
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[1]->mQueueMap.count(1));
+
+    {
+        // push only takes the shard lock
+        lock_guard<mutex> lock(sProcessQueueManager->mQueueMux);
+        auto res = async(launch::async, [&]() {
+            return sProcessQueueManager->IsValidToPush(0) && sProcessQueueManager->IsValidToPush(1)
+                && sProcessQueueManager->PushQueue(0, GenerateItem()) == QueueStatus::OK
+                && sProcessQueueManager->PushQueue(1, GenerateItem()) == QueueStatus::OK;
+        });
+        APSARA_TEST_TRUE(res.wait_for(chrono::seconds(5)) == future_status::ready);
+        APSARA_TEST_TRUE(res.get());
+    }
+    APSARA_TEST_EQUAL(1U, (*sProcessQueueManager->mQueues[0].first)->Size());
+    APSARA_TEST_EQUAL(1U, (*sProcessQueueManager->mQueues[1].first)->Size());
+    APSARA_TEST_EQUAL(1U, sProcessQueueManager->mShards[0]->mReadyMask.load());
+
+    // deleted queue can not be found by push
+    APSARA_TEST_TRUE(sProcessQueueManager->DeleteQueue(0));
+    APSARA_TEST_EQUAL(0U, sProcessQueueManager->mShards[0]->mQueueMap.count(0));
+    APSARA_TEST_EQUAL(QueueStatus::QUEUE_NOT_EXIST, sProcessQueueManager->PushQueue(0, GenerateItem()));
+
+    sProcessQueueManager->mShardedScheduling = false;
+}
+
+void ProcessQueueManagerUnittest::TestWaitForPop() {
+    unique_ptr<ProcessQueueItem> item;
+    string configName;
+    CollectionPipelineContext ctx;
+    ctx.SetConfigName("test_config_1");
+    QueueKey key = QueueKeyManager::GetInstance()->GetKey("test_config_1");
+    sProcessQueueManager->CreateOrUpdateBoundedQueue(key, 0, ctx);
+    sProcessQueueManager->EnablePop("test_config_1");
+
+    {
+        // no item is popped
+        auto version = sProcessQueueManager->GetPopVersion();
+        auto before = chrono::steady_clock::now();
+        sProcessQueueManager->WaitForPop(version, 50);
+        APSARA_TEST_TRUE(chrono::steady_clock::now() - before >= chrono::milliseconds(40));
+    }
+    {
+        // item popped before waiting
+        auto version = sProcessQueueManager->GetPopVersion();
+        sProcessQueueManager->PushQueue(key, GenerateItem());
+        APSARA_TEST_TRUE(sProcessQueueManager->PopItem(0, item, configName));
+        auto before = chrono::steady_clock::now();
+        sProcessQueueManager->WaitForPop(version, 10000);
+        APSARA_TEST_TRUE(chrono::steady_clock::now() - before < chrono::seconds(1));
+    }
+    {
+        // item popped while waiting
+        auto version = sProcessQueueManager->GetPopVersion();
+        sProcessQueueManager->PushQueue(key, GenerateItem());
+        thread t([&]() {
+            this_thread::sleep_for(chrono::milliseconds(50));
+            unique_ptr<ProcessQueueItem> poppedItem;
+            string name;
+            sProcessQueueManager->PopItem(0, poppedItem, name);
+        });
+        auto before = chrono::steady_clock::now();
+        sProcessQueueManager->WaitForPop(version, 10000);
+        APSARA_TEST_TRUE(chrono::steady_clock::now() - before < chrono::seconds(5));
+        t.join();
+        APSARA_TEST_NOT_EQUAL(version, sProcessQueueManager->GetPopVersion());
+    }
+}
+
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestUpdateSameTypeQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestUpdateDifferentTypeQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestDeleteQueue)
@@ -459,6 +642,10 @@ UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPushQueue)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestPopItem)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestIsAllQueueEmpty)
 UNIT_TEST_CASE(ProcessQueueManagerUnittest, OnPipelineUpdate)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestShardedPopItem)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestShardedUpdateAndDeleteQueue)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestShardedPushQueue)
+UNIT_TEST_CASE(ProcessQueueManagerUnittest, TestWaitForPop)
 
 } // namespace logtail
 
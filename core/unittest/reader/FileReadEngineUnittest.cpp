@@ -0,0 +1,148 @@
+// Copyright 2025 iLogtail Authors
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstdio>
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include <fstream>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "common/LogFileOperator.h"
+#include "file_server/reader/FileReadEngine.h"
+#include "unittest/Unittest.h"
+
+DECLARE_FLAG_INT32(io_uring_queue_depth);
+
+namespace logtail {
+
+class FileReadEngineUnittest : public ::testing::Test {
+public:
+    void TestRead();
+    void TestReadByPread();
+    void TestIOUringFailure();
+
+protected:
+    static void SetUpTestCase() {
+        for (size_t i = 0; i < 1000; ++i) {
+            sContent += "line " + std::to_string(i) + "\n";
+        }
+        std::ofstream(sFilePath, std::ios::binary) << sContent;
+    }
+
+    static void TearDownTestCase() { remove(sFilePath.c_str()); }
+
+    void SetUp() override { mFileOp.Open(sFilePath.c_str()); }
+
+    void TearDown() override {
+        mFileOp.Close();
+        mBuffers.clear();
+    }
+
+    std::vector<FileReadRequest> MakeRequests() {
+        std::vector<FileReadRequest> requests;
+        // offset, size
+        std::vector<std::pair<int64_t, size_t>> ranges = {{0, 100},
+                                                          {4000, 1000},
+                                                          {static_cast<int64_t>(sContent.size()) - 10, 100},
+                                                          {static_cast<int64_t>(sContent.size()) + 10, 100}};
+        for (const auto& range : ranges) {
+            FileReadRequest request;
+            request.mFd = mFileOp.GetFd();
+            request.mOffset = range.first;
+            request.mSize = range.second;
+            mBuffers.emplace_back(range.second);
+            request.mBuffer = mBuffers.back().data();
+            requests.emplace_back(std::move(request));
+        }
+        FileReadRequest invalid;
+        invalid.mFd = -1;
+        invalid.mSize = 10;
+        mBuffers.emplace_back(10);
+        invalid.mBuffer = mBuffers.back().data();
+        requests.emplace_back(std::move(invalid));
+        return requests;
+    }
+
+    void CheckRequests(const std::vector<FileReadRequest>& requests) {
+        APSARA_TEST_EQUAL(5U, requests.size());
+        APSARA_TEST_EQUAL(100, requests[0].mResult);
+        APSARA_TEST_EQUAL(sContent.substr(0, 100), std::string(requests[0].mBuffer, 100));
+        APSARA_TEST_EQUAL(1000, requests[1].mResult);
+        APSARA_TEST_EQUAL(sContent.substr(4000, 1000), std::string(requests[1].mBuffer, 1000));
+        APSARA_TEST_EQUAL(10, requests[2].mResult);
+        APSARA_TEST_EQUAL(sContent.substr(sContent.size() - 10), std::string(requests[2].mBuffer, 10));
+        APSARA_TEST_EQUAL(0, requests[3].mResult);
+        APSARA_TEST_TRUE(requests[4].mResult < 0);
+    }
+
+    static std::string sFilePath;
+    static std::string sContent;
+    LogFileOperator mFileOp;
+    std::list<std::vector<char>> mBuffers;
+};
+
+std::string FileReadEngineUnittest::sFilePath = "file_read_engine_unittest.log";
+std::string FileReadEngineUnittest::sContent;
+
+void FileReadEngineUnittest::TestRead() {
+#if defined(__linux__)
+    APSARA_TEST_TRUE(mFileOp.IsOpen());
+    auto requests = MakeRequests();
+    APSARA_TEST_EQUAL(4U, FileReadEngine::GetInstance()->Read(requests));
+    CheckRequests(requests);
+#endif
+}
+
+void FileReadEngineUnittest::TestReadByPread() {
+#if defined(__linux__)
+    APSARA_TEST_TRUE(mFileOp.IsOpen());
+    auto requests = MakeRequests();
+    APSARA_TEST_EQUAL(4U, FileReadEngine::GetInstance()->ReadByPread(requests));
+    CheckRequests(requests);
+#endif
+}
+
+void FileReadEngineUnittest::TestIOUringFailure() {
+#if defined(__linux__)
+    auto* engine = FileReadEngine::GetInstance();
+    if (!engine->IsIOUringEnabled()) {
+        return;
+    }
+    // io_uring_enter fails on a fd which is not a ring, the batch should be completed by pread
+    int ringFd = engine->mRingFd;
+    engine->mRingFd = dup(mFileOp.GetFd());
+    auto requests = MakeRequests();
+    APSARA_TEST_EQUAL(4U, engine->Read(requests));
+    CheckRequests(requests);
+    APSARA_TEST_FALSE(engine->IsIOUringEnabled());
+    close(ringFd);
+    APSARA_TEST_TRUE(engine->InitIOUring(static_cast<uint32_t>(INT32_FLAG(io_uring_queue_depth))));
+#endif
+}
+
+UNIT_TEST_CASE(FileReadEngineUnittest, TestRead);
+UNIT_TEST_CASE(FileReadEngineUnittest, TestReadByPread);
+UNIT_TEST_CASE(FileReadEngineUnittest, TestIOUringFailure);
+
+} // namespace logtail
+
+int main(int argc, char** argv) {
+    logtail::Logger::Instance().InitGlobalLoggers();
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -69,6 +69,9 @@ public:
     }
     void TestReadGBK();
     void TestReadUTF8();
+    void TestReadUTF8ByMmap();
+    void TestReadUTF8ByMmapWhenTruncated();
+    void TestReadUTF8WithPrefetchedData();
 
     std::unique_ptr<char[]> expectedContent;
     static std::string logPathDir;
@@ -84,6 +87,9 @@ protected:
 
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadGBK);
 UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8ByMmap);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8ByMmapWhenTruncated);
+UNIT_TEST_CASE(LogFileReaderUnittest, TestReadUTF8WithPrefetchedData);
 
 std::string LogFileReaderUnittest::logPathDir;
 std::string LogFileReaderUnittest::gbkFile;
@@ -576,6 +582,177 @@ void LogFileReaderUnittest::TestReadUTF8() {
     }
 }
 
+void LogFileReaderUnittest::TestReadUTF8ByMmap() {
+#if defined(__linux__)
+    { // buffer size big enough and match pattern
+        MultilineOptions multilineOpts;
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        readerOpts.mEnableMmapRead = true;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_STREQ_FATAL(expectedContent.get(), logBuffer.rawBuffer.data());
+        APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+    }
+    { // buffer size not big enough and not match pattern
+        Json::Value config;
+        config["StartPattern"] = "no matching pattern";
+        MultilineOptions multilineOpts;
+        multilineOpts.Init(config, ctx, "");
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        readerOpts.mEnableMmapRead = true;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        LogFileReader::BUFFER_SIZE = 15;
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        reader.CheckFileSignatureAndOffset(true);
+        LogBuffer logBuffer;
+        bool moreData = false;
+        reader.ReadUTF8(logBuffer, reader.mLogFileOp.GetFileSize(), moreData);
+        APSARA_TEST_TRUE_FATAL(moreData);
+        APSARA_TEST_STREQ_FATAL(std::string(expectedContent.get(), LogFileReader::BUFFER_SIZE).c_str(),
+                                logBuffer.rawBuffer.data());
+    }
+    { // read twice, multiline, cached data is verified against the mapping
+        Json::Value config;
+        config["StartPattern"] = "iLogtail.*";
+        MultilineOptions multilineOpts;
+        multilineOpts.Init(config, ctx, "");
+        FileReaderOptions readerOpts;
+        readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+        readerOpts.mEnableMmapRead = true;
+        LogFileReader reader(logPathDir,
+                             utf8File,
+                             DevInode(),
+                             std::make_pair(&readerOpts, &ctx),
+                             std::make_pair(&multilineOpts, &ctx),
+                             std::make_pair(&fileTagOpts, &ctx));
+        reader.UpdateReaderManual();
+        reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+        int64_t fileSize = reader.mLogFileOp.GetFileSize();
+        reader.CheckFileSignatureAndOffset(true);
+        LogFileReader::BUFFER_SIZE = fileSize - 13;
+        LogBuffer logBuffer;
+        bool moreData = false;
+        // first read
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_TRUE_FATAL(moreData);
+        std::string expectedPart(expectedContent.get());
+        expectedPart.resize(expectedPart.rfind("iLogtail") - 1); // -1 for \n
+        APSARA_TEST_STREQ_FATAL(expectedPart.c_str(), logBuffer.rawBuffer.data());
+        auto lastFilePos = reader.mLastFilePos;
+        // second read, end of second part cannot be determined, nothing read
+        reader.ReadUTF8(logBuffer, fileSize, moreData);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_EQUAL_FATAL(lastFilePos, reader.mLastFilePos);
+        APSARA_TEST_EQUAL_FATAL(static_cast<size_t>(fileSize - lastFilePos), reader.mCache.size());
+        // third read, force read cache
+        LogBuffer logBuffer2;
+        reader.ReadUTF8(logBuffer2, fileSize, moreData, false);
+        APSARA_TEST_FALSE_FATAL(moreData);
+        APSARA_TEST_TRUE_FATAL(reader.mCache.empty());
+        APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+        APSARA_TEST_STREQ_FATAL(expectedContent.get() + lastFilePos, logBuffer2.rawBuffer.data());
+    }
+#endif
+}
+
+void LogFileReaderUnittest::TestReadUTF8ByMmapWhenTruncated() {
+#if defined(__linux__)
+    const std::string fileName = "mmap_truncated.txt";
+    const std::string filePath = logPathDir + PATH_SEPARATOR + fileName;
+    {
+        std::ofstream fout(filePath, std::ios::binary);
+        for (size_t i = 0; i < 1000; ++i) {
+            fout << "iLogtail line " << i << "\n";
+        }
+    }
+    MultilineOptions multilineOpts;
+    FileReaderOptions readerOpts;
+    readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    readerOpts.mEnableMmapRead = true;
+    LogFileReader reader(logPathDir,
+                         fileName,
+                         DevInode(),
+                         std::make_pair(&readerOpts, &ctx),
+                         std::make_pair(&multilineOpts, &ctx),
+                         std::make_pair(&fileTagOpts, &ctx));
+    reader.UpdateReaderManual();
+    reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+    int64_t fileSize = reader.mLogFileOp.GetFileSize();
+    reader.CheckFileSignatureAndOffset(true);
+    LogBuffer logBuffer;
+    bool moreData = false;
+    reader.ReadUTF8(logBuffer, fileSize, moreData);
+    APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+    std::string expected(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size());
+
+    // data read is not affected by truncating the file afterwards
+    APSARA_TEST_EQUAL_FATAL(0, truncate(filePath.c_str(), 0));
+    APSARA_TEST_EQUAL(expected, std::string(logBuffer.rawBuffer.data(), logBuffer.rawBuffer.size()));
+    APSARA_TEST_EQUAL(std::string("iLogtail line 0"), std::string(logBuffer.rawBuffer.data(), 15));
+    remove(filePath.c_str());
+#endif
+}
+
+void LogFileReaderUnittest::TestReadUTF8WithPrefetchedData() {
+#if defined(__linux__)
+    MultilineOptions multilineOpts;
+    FileReaderOptions readerOpts;
+    readerOpts.mInputType = FileReaderOptions::InputType::InputFile;
+    LogFileReader reader(logPathDir,
+                         utf8File,
+                         DevInode(),
+                         std::make_pair(&readerOpts, &ctx),
+                         std::make_pair(&multilineOpts, &ctx),
+                         std::make_pair(&fileTagOpts, &ctx));
+    reader.UpdateReaderManual();
+    reader.InitReader(true, LogFileReader::BACKWARD_TO_BEGINNING);
+    int64_t fileSize = reader.mLogFileOp.GetFileSize();
+    reader.CheckFileSignatureAndOffset(true);
+
+    std::vector<FileReadRequest> requests(1);
+    APSARA_TEST_TRUE_FATAL(reader.PrepareBatchRead(requests[0]));
+    APSARA_TEST_EQUAL_FATAL(0, requests[0].mOffset);
+    APSARA_TEST_EQUAL_FATAL(1U, FileReadEngine::GetInstance()->Read(requests));
+    APSARA_TEST_EQUAL_FATAL(fileSize, requests[0].mResult);
+    reader.SetPrefetchedData(std::move(requests[0]));
+    APSARA_TEST_TRUE_FATAL(reader.mPrefetchedData.mBuffer != nullptr);
+    // only one prefetch is allowed at a time
+    FileReadRequest request;
+    APSARA_TEST_FALSE_FATAL(reader.PrepareBatchRead(request));
+
+    LogBuffer logBuffer;
+    bool moreData = false;
+    const char* prefetchedString = reader.mPrefetchedString;
+    reader.ReadUTF8(logBuffer, fileSize, moreData);
+    APSARA_TEST_FALSE_FATAL(moreData);
+    APSARA_TEST_STREQ_FATAL(expectedContent.get(), logBuffer.rawBuffer.data());
+    // the prefetched data is consumed in place
+    APSARA_TEST_EQUAL_FATAL(prefetchedString, logBuffer.rawBuffer.data());
+    APSARA_TEST_TRUE_FATAL(reader.mPrefetchedData.mBuffer == nullptr);
+    APSARA_TEST_EQUAL_FATAL(fileSize, reader.mLastFilePos);
+#endif
+}
+
 class LogMultiBytesUnittest : public ::testing::Test {
 public:
     static void SetUpTestCase() {
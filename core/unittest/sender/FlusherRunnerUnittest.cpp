@@ -30,6 +30,7 @@ class FlusherRunnerUnittest : public ::testing::Test {
 public:
     void TestDispatch();
     void TestPushToHttpSink();
+    void TestDispatchThread();
 
 protected:
     static void SetUpTestCase() { AppConfig::GetInstance()->mSendRequestGlobalConcurrency = 10; }
@@ -139,8 +140,62 @@ void FlusherRunnerUnittest::TestPushToHttpSink() {
     }
 }
 
+void FlusherRunnerUnittest::TestDispatchThread() {
+    auto flusher = make_unique<FlusherHttpMock>();
+    Json::Value tmp;
+    CollectionPipelineContext ctx;
+    flusher->SetContext(ctx);
+    flusher->SetMetricsRecordRef("name", "1");
+    flusher->Init(Json::Value(), tmp);
+
+    auto runner = FlusherRunner::GetInstance();
+    runner->mDispatchThreadCnt = 2;
+    runner->mIsDispatchStopped = false;
+    for (uint32_t threadNo = 0; threadNo < runner->mDispatchThreadCnt; ++threadNo) {
+        runner->mDispatchQueues.emplace_back(make_unique<SafeQueue<FlusherRunner::DispatchItem>>());
+    }
+    for (uint32_t threadNo = 0; threadNo < runner->mDispatchThreadCnt; ++threadNo) {
+        runner->mDispatchThreadRes.emplace_back(
+            async(launch::async, &FlusherRunner::RunDispatchThread, runner, threadNo));
+    }
+
+    vector<SenderQueueItem*> realItems;
+    for (size_t i = 0; i < 3; ++i) {
+        auto item = make_unique<SenderQueueItem>("content", 10, flusher.get(), flusher->GetQueueKey());
+        realItems.push_back(item.get());
+        flusher->PushToQueue(std::move(item));
+    }
+    vector<SenderQueueItem*> items;
+    SenderQueueManager::GetInstance()->GetAvailableItems(items, -1);
+    APSARA_TEST_EQUAL(3U, items.size());
+    // items from the same queue are dispatched by the same thread
+    for (auto* item : items) {
+        ++runner->mDispatchingCnt;
+        runner->mDispatchQueues[static_cast<uint64_t>(item->mQueueKey) % runner->mDispatchThreadCnt]->Push(
+            FlusherRunner::DispatchItem{item, chrono::system_clock::now()});
+    }
+    for (size_t i = 0; i < 500 && runner->mDispatchingCnt.load() != 0; ++i) {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    APSARA_TEST_EQUAL(0, runner->mDispatchingCnt.load());
+    for (auto* item : realItems) {
+        unique_ptr<HttpSinkRequest> req;
+        APSARA_TEST_TRUE(HttpSinkMock::GetInstance()->mQueue.TryPop(req));
+        APSARA_TEST_EQUAL(item, req->mItem);
+    }
+
+    runner->mIsDispatchStopped = true;
+    for (auto& res : runner->mDispatchThreadRes) {
+        res.get();
+    }
+    runner->mDispatchThreadRes.clear();
+    runner->mDispatchQueues.clear();
+    runner->mDispatchThreadCnt = 1;
+}
+
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatch)
 UNIT_TEST_CASE(FlusherRunnerUnittest, TestPushToHttpSink)
+UNIT_TEST_CASE(FlusherRunnerUnittest, TestDispatchThread)
 
 } // namespace logtail
 
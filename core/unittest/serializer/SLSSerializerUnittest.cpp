@@ -12,11 +12,16 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <functional>
+
 #include "collection_pipeline/serializer/SLSSerializer.h"
+#include "common/compression/CompressorFactory.h"
 #include "plugin/flusher/sls/FlusherSLS.h"
 #include "unittest/Unittest.h"
 
 DECLARE_FLAG_INT32(max_send_log_group_size);
+DECLARE_FLAG_INT32(sls_serializer_chunk_size);
+DECLARE_FLAG_BOOL(debug_sls_serializer);
 
 using namespace std;
 
@@ -26,6 +31,8 @@ class SLSSerializerUnittest : public ::testing::Test {
 public:
     void TestSerializeEventGroup();
     void TestSerializeEventGroupList();
+    void TestSerializeAndCompressEventGroup();
+    void TestMetricEventContentCache();
 
 protected:
     static void SetUpTestCase() { sFlusher = make_unique<FlusherSLS>(); }
@@ -50,6 +57,7 @@ private:
     BatchedEvents
     CreateBatchedRawEvents(bool enableNanosecond, bool withEmptyContent = false, bool withNonEmptyContent = true);
     BatchedEvents CreateBatchedSpanEvents();
+    BatchedEvents CreateBatchedManyLogEvents(size_t cnt);
 
     static unique_ptr<FlusherSLS> sFlusher;
 
@@ -698,6 +706,101 @@ void SLSSerializerUnittest::TestSerializeEventGroupList() {
 }
 
 
+void SLSSerializerUnittest::TestMetricEventContentCache() {
+    MetricEventContentCache cache;
+    for (size_t round = 0; round < 2; ++round) {
+        cache.Reset(3);
+        cache.StartEvent();
+        cache.AddValue(0.1);
+        cache.SetLabelSize(10);
+        // event without values, e.g. discarded
+        cache.StartEvent();
+        cache.StartEvent();
+        cache.AddValue(1.0);
+        cache.AddValue(1e300);
+        cache.Finish();
+
+        APSARA_TEST_EQUAL(1U, cache.ValuesSize(0));
+        APSARA_TEST_EQUAL(to_string(0.1), cache.GetValue(0, 0).to_string());
+        APSARA_TEST_EQUAL(10U, cache.GetLabelSize(0));
+        APSARA_TEST_EQUAL(0U, cache.ValuesSize(1));
+        APSARA_TEST_EQUAL(0U, cache.GetLabelSize(1));
+        APSARA_TEST_EQUAL(2U, cache.ValuesSize(2));
+        APSARA_TEST_EQUAL(to_string(1.0), cache.GetValue(2, 0).to_string());
+        APSARA_TEST_EQUAL(to_string(1e300), cache.GetValue(2, 1).to_string());
+    }
+}
+
+void SLSSerializerUnittest::TestSerializeAndCompressEventGroup() {
+    SLSEventGroupSerializer serializer(sFlusher.get());
+    vector<function<BatchedEvents()>> creators = {
+        [this]() { return CreateBatchedLogEvents(true, true); },
+        [this]() { return CreateBatchedManyLogEvents(1000); },
+        [this]() { return CreateBatchedMetricEvents(true, 1, false, false); },
+        [this]() { return CreateBatchedMultiValueMetricEvents(false, 0, false, false, false, false); },
+        [this]() { return CreateBatchedRawEvents(true, true); },
+        [this]() { return CreateBatchedSpanEvents(); },
+    };
+    for (auto type : {CompressType::LZ4, CompressType::ZSTD}) {
+        auto compressor = CompressorFactory::GetInstance()->Create(type);
+        for (int32_t chunkSize : {1, 1024, 64 * 1024}) {
+            INT32_FLAG(sls_serializer_chunk_size) = chunkSize;
+            for (size_t i = 0; i < creators.size(); ++i) {
+                string serialized, compressed, errorMsg;
+                APSARA_TEST_TRUE(serializer.DoSerialize(creators[i](), serialized, errorMsg));
+                APSARA_TEST_TRUE(compressor->DoCompress(serialized, compressed, errorMsg));
+
+                string output;
+                size_t rawSize = 0;
+                bool compressFailed = true;
+                APSARA_TEST_TRUE(serializer.DoSerializeAndCompress(
+                    creators[i](), *compressor, output, rawSize, errorMsg, compressFailed));
+                APSARA_TEST_FALSE(compressFailed);
+                APSARA_TEST_EQUAL(serialized.size(), rawSize);
+                string decompressed(rawSize, '\0');
+                APSARA_TEST_TRUE(compressor->UnCompress(output, decompressed, errorMsg));
+                APSARA_TEST_TRUE(serialized == decompressed);
+                APSARA_TEST_TRUE(compressed == output);
+            }
+        }
+    }
+    INT32_FLAG(sls_serializer_chunk_size) = 64 * 1024;
+    {
+        // stream compression is skipped in debug mode
+        BOOL_FLAG(debug_sls_serializer) = true;
+        auto compressor = CompressorFactory::GetInstance()->Create(CompressType::ZSTD);
+        string serialized, compressed, errorMsg;
+        APSARA_TEST_TRUE(serializer.DoSerialize(CreateBatchedLogEvents(true, true), serialized, errorMsg));
+        APSARA_TEST_TRUE(compressor->DoCompress(serialized, compressed, errorMsg));
+        string output;
+        size_t rawSize = 0;
+        bool compressFailed = true;
+        APSARA_TEST_TRUE(serializer.DoSerializeAndCompress(
+            CreateBatchedLogEvents(true, true), *compressor, output, rawSize, errorMsg, compressFailed));
+        APSARA_TEST_FALSE(compressFailed);
+        APSARA_TEST_EQUAL(serialized.size(), rawSize);
+        APSARA_TEST_TRUE(compressed == output);
+        BOOL_FLAG(debug_sls_serializer) = false;
+    }
+    {
+        // failed to serialize
+        auto compressor = CompressorFactory::GetInstance()->Create(CompressType::LZ4);
+        PipelineEventGroup group(make_shared<SourceBuffer>());
+        BatchedEvents batch(std::move(group.MutableEvents()),
+                            std::move(group.GetSizedTags()),
+                            std::move(group.GetSourceBuffer()),
+                            group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                            std::move(group.GetExactlyOnceCheckpoint()));
+        string output, errorMsg;
+        size_t rawSize = 0;
+        bool compressFailed = true;
+        APSARA_TEST_FALSE(
+            serializer.DoSerializeAndCompress(std::move(batch), *compressor, output, rawSize, errorMsg, compressFailed));
+        APSARA_TEST_FALSE(compressFailed);
+    }
+}
+
+
 BatchedEvents
 SLSSerializerUnittest::CreateBatchedLogEvents(bool enableNanosecond, bool withEmptyContent, bool withNonEmptyContent) {
     PipelineEventGroup group(make_shared<SourceBuffer>());
@@ -900,8 +1003,29 @@ BatchedEvents SLSSerializerUnittest::CreateBatchedSpanEvents() {
     return batch;
 }
 
+BatchedEvents SLSSerializerUnittest::CreateBatchedManyLogEvents(size_t cnt) {
+    PipelineEventGroup group(make_shared<SourceBuffer>());
+    group.SetTag(LOG_RESERVED_KEY_TOPIC, "topic");
+    group.SetTag(LOG_RESERVED_KEY_PACKAGE_ID, "pack_id");
+    group.SetTag(string("tag_key"), string("tag_value"));
+    for (size_t i = 0; i < cnt; ++i) {
+        LogEvent* e = group.AddLogEvent();
+        e->SetContent(string("index"), to_string(i));
+        e->SetContent(string("content"), string(i % 300, 'a' + i % 26));
+        e->SetTimestamp(1234567890 + i, i);
+    }
+    BatchedEvents batch(std::move(group.MutableEvents()),
+                        std::move(group.GetSizedTags()),
+                        std::move(group.GetSourceBuffer()),
+                        group.GetMetadata(EventGroupMetaKey::SOURCE_ID),
+                        std::move(group.GetExactlyOnceCheckpoint()));
+    return batch;
+}
+
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroup)
 UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeEventGroupList)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestSerializeAndCompressEventGroup)
+UNIT_TEST_CASE(SLSSerializerUnittest, TestMetricEventContentCache)
 
 } // namespace logtail
 